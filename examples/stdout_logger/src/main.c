@@ -83,6 +83,27 @@ int main(int argc, char* argv[])
 
     NORMAL_LOG(log, "id = ", &id, ".");
 
+    /* we can log floating point, boolean, character, and pointer values. */
+    double rate = 1.0825;
+    float ratio = 0.1f;
+    bool enabled = true;
+    char sep = ':';
+
+    NORMAL_LOG(
+        log, "rate = ", rate, ", ratio = ", ratio, ", enabled = ", enabled,
+        ", sep = ", sep, ", log = ", (void*)log, ".");
+
+    /* we can log a hex dump of a buffer. */
+    const char greeting[] = "Hello, hex dump world!";
+
+    NORMAL_LOG(log, "greeting = ", LOG_HEXDUMP(greeting, sizeof(greeting)));
+    NORMAL_LOG(
+        log, "greeting:",
+        LOG_HEXDUMP_LAYOUT(
+            greeting, sizeof(greeting),
+            VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET
+                | VCSERVICE_LOG_HEXDUMP_FLAG_ASCII));
+
     goto cleanup_log;
 
 cleanup_log:
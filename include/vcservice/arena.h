@@ -0,0 +1,159 @@
+/**
+ * \file vcservice/arena.h
+ *
+ * \brief Arena allocator interface.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <rcpr/allocator.h>
+#include <rcpr/resource.h>
+#include <stddef.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+/**
+ * \brief Forward decl for the arena allocator.
+ */
+typedef struct vcservice_arena vcservice_arena;
+
+/**
+ * \brief The default size of an arena block.
+ */
+#define VCSERVICE_ARENA_DEFAULT_BLOCK_SIZE          (64 * 1024)
+
+/**
+ * \brief Back arena blocks with huge pages when the system has them.
+ */
+#define VCSERVICE_ARENA_FLAG_HUGE_PAGES             0x00000001
+
+/**
+ * \brief The alignment of every arena allocation.
+ */
+#define VCSERVICE_ARENA_ALIGNMENT                   16
+
+/**
+ * \brief Create a \ref vcservice_arena.
+ *
+ * An arena hands out memory by bumping a pointer through a chain of blocks.
+ * Individual allocations are never reclaimed; instead, the whole arena is
+ * reset at once, such as at the end of a request.  Blocks are kept across a
+ * reset and reused, so an arena that has reached its working size no longer
+ * asks the system for memory.
+ *
+ * \param arena             Pointer to the \ref vcservice_arena pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for the arena instance.
+ *                          Blocks are mapped directly from the system.
+ * \param block_size        The size of each block, or 0 for
+ *                          \ref VCSERVICE_ARENA_DEFAULT_BLOCK_SIZE.  An
+ *                          allocation larger than this gets a block of its
+ *                          own.
+ * \param flags             Zero or more VCSERVICE_ARENA_FLAG_* values.
+ *
+ * \note This \ref vcservice_arena instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  It is not safe to use from more than one
+ * thread at a time.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_arena_create(
+    vcservice_arena** arena, RCPR_SYM(allocator)* alloc, size_t block_size,
+    unsigned int flags);
+
+/**
+ * \brief Allocate memory from a \ref vcservice_arena.
+ *
+ * The memory is aligned to \ref VCSERVICE_ARENA_ALIGNMENT and remains valid
+ * until the arena is reset or released.  It must not be reclaimed on its own.
+ *
+ * \param arena             The arena for this operation.
+ * \param mem               Pointer to receive the memory on success.
+ * \param size              The size of the allocation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_arena_allocate(vcservice_arena* arena, void** mem, size_t size);
+
+/**
+ * \brief Copy a string into a \ref vcservice_arena.
+ *
+ * \param out               Pointer to receive the copy on success.
+ * \param arena             The arena for this operation.
+ * \param str               The string to copy.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_arena_strdup(char** out, vcservice_arena* arena, const char* str);
+
+/**
+ * \brief Get an \ref allocator backed by a \ref vcservice_arena.
+ *
+ * The allocator can be passed to any interface that takes an allocator, such
+ * as the path and log interfaces.  Reclaiming the most recent allocation
+ * gives its memory back to the arena; reclaiming any other allocation does
+ * nothing, and its memory is recovered at the next reset.  Reallocating the
+ * most recent allocation resizes it in place when its block has room.
+ *
+ * \param arena             The arena for this operation.
+ *
+ * \note The allocator belongs to the arena and lives as long as it does;
+ * releasing its resource handle does nothing.  Memory allocated through it is
+ * invalidated by \ref vcservice_arena_reset, so objects created with it must
+ * be released before the arena is reset.
+ *
+ * \returns the allocator for this arena.
+ */
+RCPR_SYM(allocator)*
+vcservice_arena_allocator(vcservice_arena* arena);
+
+/**
+ * \brief Reset a \ref vcservice_arena, invalidating every allocation made
+ * from it.
+ *
+ * This takes constant time; the blocks are kept for reuse.
+ *
+ * \param arena             The arena to reset.
+ */
+void vcservice_arena_reset(vcservice_arena* arena);
+
+/**
+ * \brief Return the number of bytes allocated from a \ref vcservice_arena
+ * since it was created or last reset, including alignment padding.
+ *
+ * \param arena             The arena to query.
+ *
+ * \returns the number of bytes in use.
+ */
+size_t vcservice_arena_bytes_used(const vcservice_arena* arena);
+
+/**
+ * \brief Given a \ref vcservice_arena instance, return its resource handle.
+ *
+ * \param arena             The \ref vcservice_arena instance from which the
+ *                          resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_arena instance.
+ */
+RCPR_SYM(resource*)
+vcservice_arena_resource_handle(vcservice_arena* arena);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
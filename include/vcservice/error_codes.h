@@ -28,6 +28,156 @@ extern "C" {
  */
 #define VCSERVICE_ERROR_LOG_STDOUT_DUP 0x6102
 
+/**
+ * \brief A log redactor pattern was empty, or the pattern set is too large.
+ */
+#define VCSERVICE_ERROR_LOG_REDACTOR_INVALID_PATTERN 0x6103
+
+/**
+ * \brief The caller supplied buffer is too small for the resulting path.
+ */
+#define VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL 0x6104
+
+/**
+ * \brief The requested command was not found in the search path.
+ */
+#define VCSERVICE_ERROR_PATH_NOT_FOUND 0x6105
+
+/**
+ * \brief An invalid parameter was passed to an arena function.
+ */
+#define VCSERVICE_ERROR_ARENA_INVALID_PARAMETER 0x6106
+
+/**
+ * \brief An invalid parameter was passed to a slab allocator function.
+ */
+#define VCSERVICE_ERROR_SLAB_INVALID_PARAMETER 0x6107
+
+/**
+ * \brief A background thread could not be started.
+ */
+#define VCSERVICE_ERROR_GENERAL_THREAD_CREATE 0x6108
+
+/**
+ * \brief An audit log entry could not be parsed.
+ */
+#define VCSERVICE_ERROR_LOG_AUDIT_MALFORMED 0x6109
+
+/**
+ * \brief An audit log chain value does not match its recomputed value.
+ */
+#define VCSERVICE_ERROR_LOG_AUDIT_CHAIN_MISMATCH 0x610A
+
+/**
+ * \brief An audit log file could not be read.
+ */
+#define VCSERVICE_ERROR_LOG_AUDIT_READ 0x610B
+
+/**
+ * \brief One or more audit records could not be queued or written.
+ */
+#define VCSERVICE_ERROR_LOG_AUDIT_WRITE 0x610C
+
+/**
+ * \brief A log segment signing key has the wrong size for the crypto suite.
+ */
+#define VCSERVICE_ERROR_LOG_SEGMENT_INVALID_KEY 0x610D
+
+/**
+ * \brief A log segment trailer could not be parsed.
+ */
+#define VCSERVICE_ERROR_LOG_SEGMENT_MALFORMED 0x610E
+
+/**
+ * \brief A log segment signature does not match its contents.
+ */
+#define VCSERVICE_ERROR_LOG_SEGMENT_BAD_SIGNATURE 0x610F
+
+/**
+ * \brief One or more log segments could not be written or signed.
+ */
+#define VCSERVICE_ERROR_LOG_SEGMENT_WRITE 0x6110
+
+/**
+ * \brief A log segment could not be read.
+ */
+#define VCSERVICE_ERROR_LOG_SEGMENT_READ 0x6111
+
+/**
+ * \brief An encrypted log key has the wrong size for the crypto suite.
+ */
+#define VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY 0x6112
+
+/**
+ * \brief An encrypted log could not be parsed.
+ */
+#define VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED 0x6113
+
+/**
+ * \brief One or more encrypted log blocks could not be written.
+ */
+#define VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE 0x6114
+
+/**
+ * \brief An encrypted log could not be read.
+ */
+#define VCSERVICE_ERROR_LOG_ENCRYPTED_READ 0x6115
+
+/**
+ * \brief A log collector socket path is too long.
+ */
+#define VCSERVICE_ERROR_LOG_SPOOL_INVALID_PATH 0x6116
+
+/**
+ * \brief A log spool file could not be opened or locked.
+ */
+#define VCSERVICE_ERROR_LOG_SPOOL_OPEN 0x6117
+
+/**
+ * \brief One or more spooled log messages were dropped.
+ */
+#define VCSERVICE_ERROR_LOG_SPOOL_WRITE 0x6118
+
+/**
+ * \brief An invalid parameter was passed to a tracer function.
+ */
+#define VCSERVICE_ERROR_TRACE_INVALID_PARAMETER 0x6119
+
+/**
+ * \brief One or more trace events could not be written.
+ */
+#define VCSERVICE_ERROR_TRACE_WRITE 0x611A
+
+/**
+ * \brief An invalid parameter was passed to a histogram function.
+ */
+#define VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER 0x611B
+
+/**
+ * \brief An invalid parameter was passed to a metrics function.
+ */
+#define VCSERVICE_ERROR_METRICS_INVALID_PARAMETER 0x611C
+
+/**
+ * \brief A metric with the same name and labels is already registered.
+ */
+#define VCSERVICE_ERROR_METRICS_DUPLICATE 0x611D
+
+/**
+ * \brief The metrics exporter socket could not be created.
+ */
+#define VCSERVICE_ERROR_METRICS_SOCKET 0x611E
+
+/**
+ * \brief A log layout pattern is not valid.
+ */
+#define VCSERVICE_ERROR_LOG_LAYOUT_INVALID 0x611F
+
+/**
+ * \brief An async-signal-safe log message could not be written.
+ */
+#define VCSERVICE_ERROR_LOG_SIGNAL_SAFE_WRITE 0x6120
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
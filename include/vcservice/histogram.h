@@ -0,0 +1,233 @@
+/**
+ * \file vcservice/histogram.h
+ *
+ * \brief Latency histogram interface.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <rcpr/allocator.h>
+#include <rcpr/resource.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vcservice/log.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+/**
+ * \brief Forward decl for the histogram.
+ */
+typedef struct vcservice_histogram vcservice_histogram;
+
+/**
+ * \brief Forward decl for the histogram reporter.
+ */
+typedef struct vcservice_histogram_reporter vcservice_histogram_reporter;
+
+/**
+ * \brief The number of bits of each value kept exactly.  Values below
+ * 2^7 are counted exactly, and larger values fall in buckets 1/64 of their
+ * magnitude wide, for a relative error under 1.6%.
+ */
+#define VCSERVICE_HISTOGRAM_SUB_BUCKET_BITS         7
+
+/**
+ * \brief The number of buckets needed to cover every 64-bit value.
+ */
+#define VCSERVICE_HISTOGRAM_BUCKET_COUNT \
+    ((1 << VCSERVICE_HISTOGRAM_SUB_BUCKET_BITS) \
+        + (64 - VCSERVICE_HISTOGRAM_SUB_BUCKET_BITS) \
+            * (1 << (VCSERVICE_HISTOGRAM_SUB_BUCKET_BITS - 1)))
+
+/**
+ * \brief A point in time copy of a histogram's counts.
+ *
+ * Snapshots of several histograms, or of one histogram over several
+ * intervals, can be combined with \ref vcservice_histogram_snapshot_merge.
+ * A snapshot is large, so it is best not kept on the stack.
+ */
+typedef struct vcservice_histogram_snapshot vcservice_histogram_snapshot;
+
+struct vcservice_histogram_snapshot
+{
+    /** \brief the number of values recorded. */
+    uint64_t count;
+    /** \brief the sum of the values recorded. */
+    uint64_t sum;
+    /** \brief the smallest value recorded, or UINT64_MAX if none. */
+    uint64_t min;
+    /** \brief the largest value recorded, or 0 if none. */
+    uint64_t max;
+    /** \brief the number of values recorded in each bucket. */
+    uint64_t counts[VCSERVICE_HISTOGRAM_BUCKET_COUNT];
+};
+
+/**
+ * \brief Create a \ref vcservice_histogram.
+ *
+ * A histogram counts values, such as latencies in nanoseconds, in
+ * log-linear buckets.  Recording a value is a few instructions and takes no
+ * locks.  Counts are spread over shards, and threads are assigned to shards
+ * in turn, so threads rarely write the same cache lines.
+ *
+ * \param histogram         Pointer to the \ref vcservice_histogram pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for this histogram.
+ *
+ * \note This \ref vcservice_histogram instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  It must not be released while other
+ * threads are still recording to it.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER if a parameter is NULL.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_histogram_create(
+    vcservice_histogram** histogram, RCPR_SYM(allocator)* alloc);
+
+/**
+ * \brief Record a value in a \ref vcservice_histogram.
+ *
+ * \param histogram         The histogram for this operation.
+ * \param value             The value to record.
+ */
+void
+vcservice_histogram_record(vcservice_histogram* histogram, uint64_t value);
+
+/**
+ * \brief Copy the counts of a \ref vcservice_histogram into a snapshot.
+ *
+ * The counts are read without stopping other threads.  With \p reset, each
+ * count is read and cleared atomically, so no value is lost or counted in two
+ * intervals, although the min, max, and sum of a value recorded during the
+ * snapshot may land in the next interval.
+ *
+ * \param snapshot          The snapshot to fill in.
+ * \param histogram         The histogram to read.
+ * \param reset             If true, clear the histogram as it is read.
+ */
+void
+vcservice_histogram_snapshot_take(
+    vcservice_histogram_snapshot* snapshot, vcservice_histogram* histogram,
+    bool reset);
+
+/**
+ * \brief Add the counts of one snapshot to another.
+ *
+ * \param dest              The snapshot to add to.
+ * \param src               The snapshot to add.
+ */
+void
+vcservice_histogram_snapshot_merge(
+    vcservice_histogram_snapshot* dest,
+    const vcservice_histogram_snapshot* src);
+
+/**
+ * \brief Get the value at the given percentile of a snapshot.
+ *
+ * \param snapshot          The snapshot to query.
+ * \param percentile        The percentile, from 0 to 100.
+ *
+ * \returns the largest value in the bucket holding the given percentile,
+ * capped at the largest value recorded, or 0 if the snapshot is empty.
+ */
+uint64_t
+vcservice_histogram_snapshot_percentile(
+    const vcservice_histogram_snapshot* snapshot, double percentile);
+
+/**
+ * \brief Log a summary of a snapshot.
+ *
+ * The summary is one message holding the name, then the count, min, mean,
+ * p50, p90, p99, p999, and max.
+ *
+ * \param log               The logger to write to.
+ * \param log_level         The level of the message.
+ * \param name              The name of the histogram.
+ * \param snapshot          The snapshot to summarize.
+ */
+void
+vcservice_histogram_report(
+    vcservice_log* log, unsigned int log_level, const char* name,
+    const vcservice_histogram_snapshot* snapshot);
+
+/**
+ * \brief Create a \ref vcservice_histogram_reporter, which periodically logs
+ * a summary of a histogram.
+ *
+ * Every \p interval_ms milliseconds, a background thread takes a snapshot of
+ * the histogram, clearing it, and logs its summary with
+ * \ref vcservice_histogram_report.  Intervals in which nothing was recorded
+ * are not logged.  A last summary is logged when the reporter is released.
+ *
+ * \param reporter          Pointer to the \ref vcservice_histogram_reporter
+ *                          pointer to receive this resource on success.
+ * \param alloc             The allocator to use for this reporter.
+ * \param histogram         The histogram to report, which must outlive the
+ *                          reporter.
+ * \param name              The name to report the histogram under, which is
+ *                          copied.
+ * \param log               The logger to write to, which must outlive the
+ *                          reporter.  A logger is not safe to use from two
+ *                          threads at once, so this should be a logger that
+ *                          only the reporter uses.
+ * \param log_level         The level of the summary messages.
+ * \param interval_ms       The reporting interval in milliseconds.
+ *
+ * \note This \ref vcservice_histogram_reporter instance is a \ref resource that
+ * must be released by calling \ref resource_release on its resource handle
+ * when it is no longer needed by the caller.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER if a parameter is NULL or
+ *        the interval is 0.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_histogram_reporter_create(
+    vcservice_histogram_reporter** reporter, RCPR_SYM(allocator)* alloc,
+    vcservice_histogram* histogram, const char* name, vcservice_log* log,
+    unsigned int log_level, unsigned int interval_ms);
+
+/**
+ * \brief Given a \ref vcservice_histogram instance, return its resource
+ * handle.
+ *
+ * \param histogram         The \ref vcservice_histogram instance from which
+ *                          the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_histogram instance.
+ */
+RCPR_SYM(resource*)
+vcservice_histogram_resource_handle(vcservice_histogram* histogram);
+
+/**
+ * \brief Given a \ref vcservice_histogram_reporter instance, return its
+ * resource handle.
+ *
+ * \param reporter          The \ref vcservice_histogram_reporter instance from
+ *                          which the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_histogram_reporter
+ * instance.
+ */
+RCPR_SYM(resource*)
+vcservice_histogram_reporter_resource_handle(
+    vcservice_histogram_reporter* reporter);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
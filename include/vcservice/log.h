@@ -12,6 +12,7 @@
 #include <rcpr/psock.h>
 #include <rcpr/resource.h>
 #include <rcpr/uuid.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /* make this header C++ friendly. */
@@ -24,6 +25,74 @@ extern "C" {
  */
 typedef struct vcservice_log vcservice_log;
 
+/**
+ * \brief Forward decl for the log redactor.
+ */
+typedef struct vcservice_log_redactor vcservice_log_redactor;
+
+/**
+ * \brief The result of verifying an audit log.
+ */
+typedef struct vcservice_log_audit_summary vcservice_log_audit_summary;
+
+struct vcservice_log_audit_summary
+{
+    uint64_t records;
+    uint64_t checkpoints;
+    size_t failure_offset;
+    bool sealed;
+};
+
+/**
+ * \brief The default number of audit records between checkpoints.
+ */
+#define VCSERVICE_LOG_AUDIT_DEFAULT_CHECKPOINT_INTERVAL 1024
+
+/**
+ * \brief The default size of a signed log segment.
+ */
+#define VCSERVICE_LOG_SEGMENT_DEFAULT_SIZE (4 * 1024 * 1024)
+
+/**
+ * \brief The default plaintext block size of an encrypted log.
+ */
+#define VCSERVICE_LOG_ENCRYPTED_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/**
+ * \brief The default limit on the size of a log spool file.
+ */
+#define VCSERVICE_LOG_SPOOL_DEFAULT_LIMIT (64 * 1024 * 1024)
+
+/**
+ * \brief The longest log layout pattern.
+ */
+#define VCSERVICE_LOG_LAYOUT_MAX_SIZE 1024
+
+/**
+ * \brief The most values a log macro formats.  Further values are replaced
+ * with " (truncated)".
+ */
+#define VCSERVICE_LOG_MAX_ARGS 50
+
+/**
+ * \brief The size of an async-signal-safe log message, including its
+ * newline.  This is the POSIX minimum PIPE_BUF, so a message written to a
+ * pipe is never interleaved with another.
+ */
+#define VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE 512
+
+/**
+ * \brief An async-signal-safe log message, built on the stack.
+ */
+typedef struct vcservice_log_signal_safe_message
+    vcservice_log_signal_safe_message;
+
+struct vcservice_log_signal_safe_message
+{
+    size_t size;
+    char data[VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE];
+};
+
 /**
  * \brief Forward decl for the default log format.
  */
@@ -67,6 +136,138 @@ enum vcservice_loglevel
     VCSERVICE_LOGLEVEL_DEBUG                =  5,
 };
 
+/**
+ * \brief The linker section holding the \ref vcservice_log_callsite
+ * descriptors.
+ */
+#define VCSERVICE_LOG_CALLSITE_SECTION "vcservice_log_callsites"
+
+/**
+ * \brief A logging call site descriptor.
+ *
+ * One of these is statically emitted into \ref VCSERVICE_LOG_CALLSITE_SECTION
+ * for every log macro expansion.  When a call site is enabled, its message is
+ * logged even if it is less critical than the logger's threshold level.
+ */
+typedef struct vcservice_log_callsite vcservice_log_callsite;
+
+struct vcservice_log_callsite
+{
+    const char* file;
+    const char* function;
+    unsigned int line;
+    unsigned int level;
+    uint8_t enabled;
+};
+
+/**
+ * \brief The number of per-level message counters in
+ * \ref vcservice_log_stats.
+ */
+#define VCSERVICE_LOG_STATS_LEVEL_COUNT (VCSERVICE_LOGLEVEL_DEBUG + 1)
+
+/**
+ * \brief The counters kept by each logger.
+ *
+ * Each counter is updated with a relaxed atomic add, so another thread must
+ * read it with an atomic load.
+ */
+typedef struct vcservice_log_stats vcservice_log_stats;
+
+struct vcservice_log_stats
+{
+    uint64_t messages[VCSERVICE_LOG_STATS_LEVEL_COUNT];
+    uint64_t bytes;
+    uint64_t dropped;
+};
+
+/**
+ * \brief Hex dump layout flags.
+ */
+#define VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET       0x0001
+#define VCSERVICE_LOG_HEXDUMP_FLAG_ASCII        0x0002
+#define VCSERVICE_LOG_HEXDUMP_LAYOUT_MASK \
+    (VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET | VCSERVICE_LOG_HEXDUMP_FLAG_ASCII)
+
+/**
+ * \brief A hex dump log argument, as built by \ref LOG_HEXDUMP.
+ */
+typedef struct vcservice_log_hexdump vcservice_log_hexdump;
+
+struct vcservice_log_hexdump
+{
+    const void* data;
+    size_t size;
+    unsigned int flags;
+};
+
+/**
+ * \brief Argument type tags for the compact log expansion.
+ */
+enum vcservice_log_arg_type
+{
+    VCSERVICE_LOG_ARG_INT8                  =  0,
+    VCSERVICE_LOG_ARG_UINT8                 =  1,
+    VCSERVICE_LOG_ARG_INT16                 =  2,
+    VCSERVICE_LOG_ARG_UINT16                =  3,
+    VCSERVICE_LOG_ARG_INT32                 =  4,
+    VCSERVICE_LOG_ARG_UINT32                =  5,
+    VCSERVICE_LOG_ARG_INT64                 =  6,
+    VCSERVICE_LOG_ARG_UINT64                =  7,
+    VCSERVICE_LOG_ARG_STRING                =  8,
+    VCSERVICE_LOG_ARG_UUID                  =  9,
+    VCSERVICE_LOG_ARG_FORMAT_DEFAULT        = 10,
+    VCSERVICE_LOG_ARG_FORMAT_HEX            = 11,
+    VCSERVICE_LOG_ARG_DOUBLE                = 12,
+    VCSERVICE_LOG_ARG_FLOAT                 = 13,
+    VCSERVICE_LOG_ARG_BOOL                  = 14,
+    VCSERVICE_LOG_ARG_CHAR                  = 15,
+    VCSERVICE_LOG_ARG_POINTER               = 16,
+    VCSERVICE_LOG_ARG_HEXDUMP               = 17,
+    VCSERVICE_LOG_ARG_UPPER_BOUND,
+};
+
+/**
+ * \brief A log argument value, as built by the compact log expansion.  The
+ * type of each value is given by a separate \ref vcservice_log_arg_type tag.
+ */
+typedef union vcservice_log_arg_value vcservice_log_arg_value;
+
+union vcservice_log_arg_value
+{
+    int64_t i64;
+    uint64_t u64;
+    double f64;
+    const char* str;
+    const RCPR_SYM(rcpr_uuid)* uuid;
+    const void* ptr;
+};
+
+/**
+ * \brief The size of the rendered text of a \ref vcservice_log_trace_context:
+ * "trace=", a 36 character UUID, " span=", 16 hex digits, and a space.
+ */
+#define VCSERVICE_LOG_TRACE_CONTEXT_TEXT_SIZE (6 + 36 + 6 + 16 + 1)
+
+/**
+ * \brief A trace context, correlating every message logged while it is
+ * current.
+ *
+ * The context is rendered once by \ref vcservice_log_trace_context_init, and
+ * the rendered text is copied into each message by
+ * \ref vcservice_log_message_start.  The caller owns the storage, so a
+ * context can live in a request or a fiber and be made current with
+ * \ref vcservice_log_trace_context_swap.
+ */
+typedef struct vcservice_log_trace_context vcservice_log_trace_context;
+
+struct vcservice_log_trace_context
+{
+    RCPR_SYM(rcpr_uuid) trace_id;
+    uint64_t span_id;
+    char text[VCSERVICE_LOG_TRACE_CONTEXT_TEXT_SIZE];
+};
+
 /******************************************************************************/
 /* Start of constructors.                                                     */
 /******************************************************************************/
@@ -113,225 +314,1050 @@ enum vcservice_loglevel
  *      - On failure, \p log is set to NULL and an error status is returned.
  */
 status FN_DECL_MUST_CHECK
-vcservice_log_create_from_psock(
-    vcservice_log** log, RCPR_SYM(allocator)* alloc, RCPR_SYM(psock)* sock,
-    unsigned int threshold_level);
+vcservice_log_create_from_psock(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, RCPR_SYM(psock)* sock,
+    unsigned int threshold_level);
+
+/**
+ * \brief Create a \ref vcservice_log instance that logs to standard output,
+ * using the given threshold log level.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * Log messages are written to standard output if they are more critical than
+ * (less than or equal to) the threshold log level.
+ *
+ * \note This \ref vcservice_log instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  The resource handle can be accessed by
+ * calling \ref vcservice_log_resource_handle on this \ref vcservice_log
+ * instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ *
+ * \pre
+ *      - \p log must not reference a valid logger instance and must not be
+ *        NULL.
+ *      - \p alloc must reference a valid \ref allocator and must not be NULL.
+ *      - \p threshold_level must be a valid log level belonging to
+ *        \ref vcservice_loglevel.
+ *
+ * \post
+ *      - On success, \p log is set to a pointer to a valid \ref vcservice_log
+ *        instance.
+ *      - On failure, \p log is set to NULL and an error status is returned.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_using_standard_output(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc,
+    unsigned int threshold_level);
+
+/**
+ * \brief Create a hash-chained audit \ref vcservice_log that writes to the
+ * given descriptor.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param desc                  The descriptor to which audit records are
+ *                              written.  This descriptor is owned by this
+ *                              logger instance and will be closed when it is
+ *                              released.
+ * \param checkpoint_interval   The number of records between checkpoints, or
+ *                              0 for the default interval.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * Each committed message becomes a record carrying a sequence number and a
+ * running SHA-512 chain value, computed over the previous chain value, the
+ * sequence number, and the message.  Hashing and writing are done in batches
+ * by a background thread, so committing a message only copies it to a queue.
+ * A checkpoint entry repeating the current chain value is written every
+ * \p checkpoint_interval records, and when the logger is released.  The
+ * resulting file can be checked with \ref vcservice_log_audit_verify.
+ *
+ * \note This \ref vcservice_log instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  Releasing it writes any queued records and
+ * the final checkpoint, and returns VCSERVICE_ERROR_LOG_AUDIT_WRITE if any
+ * record could not be queued or written.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ *
+ * \pre
+ *      - \p log must not reference a valid logger instance and must not be
+ *        NULL.
+ *      - \p alloc must reference a valid \ref allocator and must not be NULL.
+ *      - \p desc must be a valid descriptor open for writing.
+ *      - \p threshold_level must be a valid log level belonging to
+ *        \ref vcservice_loglevel.
+ *
+ * \post
+ *      - On success, \p log is set to a pointer to a valid \ref vcservice_log
+ *        instance, and owns \p desc.
+ *      - On failure, \p log is set to NULL, \p desc is left open, and an
+ *        error status is returned.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_audit(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, int desc,
+    unsigned int checkpoint_interval, unsigned int threshold_level);
+
+/**
+ * \brief Create a \ref vcservice_log that writes to a series of signed
+ * segment files.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param prefix                The path prefix for segment files.  Segment N
+ *                              is written to "<prefix>.<N>", with N as eight
+ *                              decimal digits starting at 0.
+ * \param segment_size          The size at which a segment is closed, or 0
+ *                              for \ref VCSERVICE_LOG_SEGMENT_DEFAULT_SIZE.
+ *                              Messages are never split, so a segment only
+ *                              exceeds this size if it holds a single larger
+ *                              message.
+ * \param private_key           The raw signing key, which is copied.
+ * \param private_key_size      The size of the signing key.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * Messages are appended to the current segment on the calling thread.  When a
+ * segment is full, it is handed to a background thread and the next segment
+ * is started, so the writer keeps appending while the previous segment is
+ * hashed and signed.  The signer appends a trailer holding the signature over
+ * the segment index and contents, which can be checked with
+ * \ref vcservice_log_segment_verify.
+ *
+ * \note This \ref vcservice_log instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  Releasing it signs the last segment, and
+ * returns VCSERVICE_ERROR_LOG_SEGMENT_WRITE if any segment could not be
+ * written or signed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_INVALID_KEY if the key size does not
+ *        match the crypto suite.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ *
+ * \pre
+ *      - \p log must not reference a valid logger instance and must not be
+ *        NULL.
+ *      - \p alloc must reference a valid \ref allocator and must not be NULL.
+ *      - \p prefix must not be NULL, and no segment files with this prefix
+ *        may exist.
+ *      - \p threshold_level must be a valid log level belonging to
+ *        \ref vcservice_loglevel.
+ *
+ * \post
+ *      - On success, \p log is set to a pointer to a valid \ref vcservice_log
+ *        instance.
+ *      - On failure, \p log is set to NULL and an error status is returned.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_signed_segments(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, const char* prefix,
+    size_t segment_size, const void* private_key, size_t private_key_size,
+    unsigned int threshold_level);
+
+/**
+ * \brief Create a \ref vcservice_log that encrypts everything it writes to
+ * the given descriptor.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param desc                  The descriptor to which the encrypted log is
+ *                              written.  This descriptor is owned by this
+ *                              logger instance and will be closed when it is
+ *                              released.
+ * \param key                   The raw stream cipher key, which is not
+ *                              retained.
+ * \param key_size              The size of the key.
+ * \param block_size            The plaintext block size, or 0 for
+ *                              \ref VCSERVICE_LOG_ENCRYPTED_DEFAULT_BLOCK_SIZE.
+ * \param worker_count          The number of encryption threads, or 0 for one
+ *                              per online CPU.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * A header holding a random salt is written first.  The per-file key is
+ * derived from \p key and the salt, so reusing \p key across files does not
+ * reuse a keystream.  The committed byte stream is then cut into blocks of
+ * \p block_size bytes.  Each block is encrypted with the vccrypt stream
+ * cipher, using its block index as the IV, on a pool of worker threads, and
+ * blocks are written in order.  Use \ref vcservice_log_encrypted_decrypt to
+ * read the log back.
+ *
+ * A partial block is submitted for encryption when an ERROR or CRITICAL
+ * message is written, when it has been filling for a second, and when the
+ * logger is released.  If the process dies, what is lost is the messages
+ * committed since the last such flush, along with any submitted blocks that
+ * have not been written yet: at most 2 * \p worker_count + 1 blocks of
+ * \p block_size bytes.  A reader tailing the file sees each block about a
+ * second after it was started.  The stream cipher provides confidentiality,
+ * not integrity; combine this with a signed or audit sink if the log must
+ * also be tamper evident.
+ *
+ * \note This \ref vcservice_log instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  Releasing it writes the last block, and
+ * returns VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE if any block could not be
+ * encrypted or written.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY if the key size does not
+ *        match the crypto suite.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE if the header could not be
+ *        created or written.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if no worker thread could be
+ *        started.
+ *      - a non-zero error code on failure.
+ *
+ * \pre
+ *      - \p log must not reference a valid logger instance and must not be
+ *        NULL.
+ *      - \p alloc must reference a valid \ref allocator and must not be NULL.
+ *      - \p desc must be a valid descriptor open for writing.
+ *      - \p threshold_level must be a valid log level belonging to
+ *        \ref vcservice_loglevel.
+ *
+ * \post
+ *      - On success, \p log is set to a pointer to a valid \ref vcservice_log
+ *        instance, and owns \p desc.
+ *      - On failure, \p log is set to NULL, \p desc is left open, and an
+ *        error status is returned.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_encrypted(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, int desc,
+    const void* key, size_t key_size, size_t block_size,
+    unsigned int worker_count, unsigned int threshold_level);
+
+/**
+ * \brief Create a \ref vcservice_log that writes to a log collector's Unix
+ * socket, spooling to a local file while the collector is unreachable.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param socket_path           The path of the collector's Unix socket.
+ * \param spool_path            The path of the spool file, which is created
+ *                              if it does not exist.
+ * \param spool_limit           The maximum size of the spool file, or 0 for
+ *                              \ref VCSERVICE_LOG_SPOOL_DEFAULT_LIMIT.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * Messages are sent straight to the collector while it keeps up.  When a send
+ * fails or would block, that message and every later one are queued for a
+ * background thread, which appends them to the spool file in batches.  The
+ * thread reconnects as needed, replays the spool in order, and truncates it.
+ * Once the spool is drained, messages go straight to the collector again.
+ *
+ * A spool left behind by an earlier process is replayed first.  Delivery is
+ * at least once: a message may be sent again if the process stops while the
+ * spool is being replayed.  When a batch would grow the spool past
+ * \p spool_limit, the batch is dropped.
+ *
+ * \note This \ref vcservice_log instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  Releasing it spools any queued messages and
+ * makes a last attempt to replay them; whatever is not replayed stays in the
+ * spool file.  It returns VCSERVICE_ERROR_LOG_SPOOL_WRITE if any message was
+ * dropped.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SPOOL_INVALID_PATH if \p socket_path is too long
+ *        for a Unix socket address.
+ *      - VCSERVICE_ERROR_LOG_SPOOL_OPEN if the spool file could not be opened
+ *        or is in use by another logger.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ *
+ * \pre
+ *      - \p log must not reference a valid logger instance and must not be
+ *        NULL.
+ *      - \p alloc must reference a valid \ref allocator and must not be NULL.
+ *      - \p socket_path and \p spool_path must not be NULL.
+ *      - \p threshold_level must be a valid log level belonging to
+ *        \ref vcservice_loglevel.
+ *
+ * \post
+ *      - On success, \p log is set to a pointer to a valid \ref vcservice_log
+ *        instance.
+ *      - On failure, \p log is set to NULL and an error status is returned.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_spooled(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, const char* socket_path,
+    const char* spool_path, size_t spool_limit, unsigned int threshold_level);
+
+/**
+ * \brief Create a \ref vcservice_log_redactor instance.
+ *
+ * A redactor masks sensitive data in committed log messages before they are
+ * written.  Card numbers (runs of 13 to 19 digits, optionally grouped with
+ * single spaces or dashes, that pass the Luhn check) are always masked, leaving
+ * only the last four digits.  Tokens beginning with a prefix added via
+ * \ref vcservice_log_redactor_add_pattern are masked after the prefix.
+ *
+ * \param redactor              Pointer to the \ref vcservice_log_redactor
+ *                              pointer to receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log_redactor instance.
+ *
+ * \note This \ref vcservice_log_redactor instance is a \ref resource that must
+ * be released by calling \ref resource_release on its resource handle when it
+ * is no longer needed by the caller, unless ownership is passed to a logger
+ * with \ref vcservice_log_set_redactor.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ *
+ * \pre
+ *      - \p redactor must not reference a valid redactor instance and must not
+ *        be NULL.
+ *      - \p alloc must reference a valid \ref allocator and must not be NULL.
+ *
+ * \post
+ *      - On success, \p redactor is set to a pointer to a valid
+ *        \ref vcservice_log_redactor instance.
+ *      - On failure, \p redactor is set to NULL and an error status is
+ *        returned.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_redactor_create(
+    vcservice_log_redactor** redactor, RCPR_SYM(allocator)* alloc);
+
+/******************************************************************************/
+/* Start of public methods.                                                   */
+/******************************************************************************/
+
+/**
+ * \brief Start a new logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ */
+void
+vcservice_log_message_start(vcservice_log* log);
+
+/**
+ * \brief Append the log level to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param level         The logging level to log.
+ */
+void
+vcservice_log_append_log_level(vcservice_log* log, unsigned int level);
+
+/**
+ * \brief Append a string value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The string value to append.
+ */
+void
+vcservice_log_append_string(vcservice_log* log, const char* val);
+
+/**
+ * \brief Append an 8-bit integer value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The integer value to append.
+ */
+void
+vcservice_log_append_int8(vcservice_log* log, int8_t val);
+
+/**
+ * \brief Append an 8-bit unsigned integer value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The unsigned integer value to append.
+ */
+void
+vcservice_log_append_uint8(vcservice_log* log, uint8_t val);
+
+/**
+ * \brief Append a 16-bit integer value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The integer value to append.
+ */
+void
+vcservice_log_append_int16(vcservice_log* log, int16_t val);
+
+/**
+ * \brief Append a 16-bit unsigned integer value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The unsigned integer value to append.
+ */
+void
+vcservice_log_append_uint16(vcservice_log* log, uint16_t val);
+
+/**
+ * \brief Append a 32-bit integer value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The integer value to append.
+ */
+void
+vcservice_log_append_int32(vcservice_log* log, int32_t val);
+
+/**
+ * \brief Append a 32-bit unsigned integer value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The unsigned integer value to append.
+ */
+void
+vcservice_log_append_uint32(vcservice_log* log, uint32_t val);
+
+/**
+ * \brief Append a 64-bit integer value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The integer value to append.
+ */
+void
+vcservice_log_append_int64(vcservice_log* log, int64_t val);
+
+/**
+ * \brief Append a 64-bit unsigned integer value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The unsigned integer value to append.
+ */
+void
+vcservice_log_append_uint64(vcservice_log* log, uint64_t val);
+
+/**
+ * \brief Append a double precision floating point value to the logging
+ * message, using the shortest representation that round-trips.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The floating point value to append.
+ */
+void
+vcservice_log_append_double(vcservice_log* log, double val);
+
+/**
+ * \brief Append a single precision floating point value to the logging
+ * message, using the shortest representation that round-trips.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The floating point value to append.
+ */
+void
+vcservice_log_append_float(vcservice_log* log, float val);
+
+/**
+ * \brief Append a boolean value to the logging message as "true" or "false".
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The boolean value to append.
+ */
+void
+vcservice_log_append_bool(vcservice_log* log, bool val);
+
+/**
+ * \brief Append a character to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The character to append.
+ */
+void
+vcservice_log_append_char(vcservice_log* log, char val);
+
+/**
+ * \brief Append a pointer value to the logging message as a zero-padded
+ * hexadecimal address.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The pointer value to append.
+ */
+void
+vcservice_log_append_pointer(vcservice_log* log, const void* val);
+
+/**
+ * \brief Append a hex dump of the given buffer to the logging message.
+ *
+ * With no flags, the bytes are written as one run of lowercase hex digits.
+ * With \ref VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET and / or
+ * \ref VCSERVICE_LOG_HEXDUMP_FLAG_ASCII, the bytes are written as rows of
+ * sixteen, each starting on a new line, with the offset and / or printable
+ * characters shown alongside.
+ *
+ * If the dump does not fit in the remaining message capacity, as much as fits
+ * is written, followed by a marker giving the number of bytes elided.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param data          The buffer to dump.
+ * \param size          The size of the buffer.
+ * \param flags         Layout flags.
+ *
+ * \returns the number of bytes of \p data that were elided.
+ */
+size_t
+vcservice_log_append_hexdump(
+    vcservice_log* log, const void* data, size_t size, unsigned int flags);
+
+/**
+ * \brief Append a hex dump log argument to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The hex dump argument.
+ */
+void
+vcservice_log_append_hexdump_arg(
+    vcservice_log* log, const vcservice_log_hexdump* val);
+
+/**
+ * \brief Append a UUID value to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The uuid value to append.
+ */
+void
+vcservice_log_append_uuid(vcservice_log* log, const RCPR_SYM(rcpr_uuid)* val);
+
+/**
+ * \brief Set the log formatting mode to the default.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The sentry value for this operation.
+ */
+void
+vcservice_log_format_set_default(
+    vcservice_log* log, const vcservice_log_format_default* val);
+
+/**
+ * \brief Set the log formatting mode to hex.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The sentry value for this operation.
+ */
+void
+vcservice_log_format_set_hex(
+    vcservice_log* log, const vcservice_log_format_hex* val);
+
+/**
+ * \brief Handle a no-operation, needed for type resolution in the debug macro.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The dummy value for this operation.
+ */
+void
+vcservice_log_no_op(
+    vcservice_log* log, const void* val);
+
+/**
+ * \brief Commit the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ */
+void
+vcservice_log_message_commit(vcservice_log* log);
+
+/**
+ * \brief Mark the next committed message as coming from a call site enabled
+ * with \ref vcservice_log_callsite_set_enabled.
+ *
+ * Such a message is written even inside a request scope, instead of being
+ * buffered with the scope's detail.  The mark is cleared when the message is
+ * committed.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ */
+void
+vcservice_log_message_callsite_enabled(vcservice_log* log);
+
+/**
+ * \brief Start, format, and commit a logging message from an array of typed
+ * arguments.
+ *
+ * This is the out-of-line half of the compact log expansion.  It is equivalent
+ * to calling \ref vcservice_log_message_start, then
+ * \ref vcservice_log_append_log_level, then the append method for each
+ * argument, and finally \ref vcservice_log_message_commit.
+ *
+ * As with the inline expansion, arguments past the first
+ * \ref VCSERVICE_LOG_MAX_ARGS are replaced with " (truncated)".
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param level         The logging level of this message.
+ * \param types         The array of \ref vcservice_log_arg_type tags, one per
+ *                      argument.
+ * \param values        The array of argument values.
+ * \param count         The number of arguments in each array.
+ */
+void
+vcservice_log_message_emit(
+    vcservice_log* log, unsigned int level, const uint8_t* types,
+    const vcservice_log_arg_value* values, size_t count);
+
+/**
+ * \brief Add a token prefix to be redacted by this redactor.
+ *
+ * Whenever the prefix appears in a log message, the characters following it,
+ * up to the next whitespace, quote, or punctuation delimiter, are masked.
+ *
+ * \param redactor      The \ref vcservice_log_redactor instance for this
+ *                      operation.
+ * \param prefix        The token prefix to add (e.g. "sk_live_").
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_REDACTOR_INVALID_PATTERN if the prefix is empty or
+ *        the pattern set is too large.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_redactor_add_pattern(
+    vcservice_log_redactor* redactor, const char* prefix);
+
+/**
+ * \brief Mask sensitive data in the given message in place.
+ *
+ * \param redactor      The \ref vcservice_log_redactor instance for this
+ *                      operation.
+ * \param message       The message to redact.
+ * \param size          The size of the message.
+ *
+ * \returns the number of redactions made.
+ */
+size_t
+vcservice_log_redactor_apply(
+    const vcservice_log_redactor* redactor, char* message, size_t size);
+
+/**
+ * \brief Set the redactor for this logger.
+ *
+ * Every committed message is passed through the redactor before it is written.
+ * The logger takes ownership of the redactor, and releases it when the logger
+ * is released or when another redactor is set.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param redactor      The redactor to use, or NULL to disable redaction.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code if releasing the previous redactor failed.
+ */
+status
+vcservice_log_set_redactor(
+    vcservice_log* log, vcservice_log_redactor* redactor);
+
+/**
+ * \brief Set the line layout for this logger.
+ *
+ * The pattern is compiled once into a short program of literal copies and
+ * field emitters, which is run as each message is committed.  The fields are:
+ *      - %D the local date, as YYYY-MM-DD.
+ *      - %T the local time, as HH:MM:SS.
+ *      - %u the microseconds within the second, as six digits.
+ *      - %L the level, padded to eight characters.  With the space that
+ *        follows it, this matches the nine character level column of the
+ *        default line.
+ *      - %C the trace context, or nothing if there is none.
+ *      - %t the thread id.
+ *      - %m the message.
+ *      - %% a percent sign.
+ *
+ * Without a layout, messages are laid out as "%D %T %C %L %m", except that
+ * an absent trace context takes no space.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param pattern       The layout pattern, such as "%T.%u %L [%C] %t %m", or
+ *                      NULL to restore the default layout.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_LAYOUT_INVALID if the pattern has an unknown
+ *        field, has no %m, or is longer than
+ *        \ref VCSERVICE_LOG_LAYOUT_MAX_SIZE.
+ *      - a non-zero error code on failure, in which case the layout is
+ *        unchanged.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_set_layout(vcservice_log* log, const char* pattern);
+
+/**
+ * \brief Verify the hash chain of an audit log.
+ *
+ * Every record's chain value is recomputed from the start of the log, and
+ * every checkpoint is compared against the chain value at that point.
+ *
+ * \param summary       Pointer to the summary to receive the record and
+ *                      checkpoint counts.  On failure, its failure_offset is
+ *                      set to the offset of the first entry that could not be
+ *                      verified.
+ * \param desc          The descriptor of the audit log to verify.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS if the whole log verified.
+ *      - VCSERVICE_ERROR_LOG_AUDIT_MALFORMED if an entry could not be parsed,
+ *        or if sequence numbers are not consecutive.
+ *      - VCSERVICE_ERROR_LOG_AUDIT_CHAIN_MISMATCH if a chain value does not
+ *        match.
+ *      - VCSERVICE_ERROR_LOG_AUDIT_READ if the log could not be read.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_audit_verify(vcservice_log_audit_summary* summary, int desc);
+
+/**
+ * \brief Verify the signature of a log segment.
+ *
+ * \param index                 Pointer to receive the index of this segment.
+ * \param size                  Pointer to receive the size of the segment
+ *                              contents, which start at offset 0 and precede
+ *                              the trailer.
+ * \param desc                  The descriptor of the segment to verify.
+ * \param public_key            The raw public key matching the signing key.
+ * \param public_key_size       The size of the public key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS if the signature is valid.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_INVALID_KEY if the key size does not
+ *        match the crypto suite.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_MALFORMED if the segment has no valid
+ *        trailer, for instance because it was never closed.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_BAD_SIGNATURE if the signature does not
+ *        match.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_READ if the segment could not be read.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_segment_verify(
+    uint64_t* index, size_t* size, int desc, const void* public_key,
+    size_t public_key_size);
 
 /**
- * \brief Create a \ref vcservice_log instance that logs to standard output,
- * using the given threshold log level.
- *
- * \param log                   Pointer to the \ref vcservice_log pointer to
- *                              receive this resource on success.
- * \param alloc                 Pointer to the allocator to use for creating
- *                              this \ref vcservice_log instance.
- * \param threshold_level       The threshold level for logging messages.
+ * \brief Decrypt an encrypted log, writing the plaintext to a descriptor.
  *
- * Log messages are written to standard output if they are more critical than
- * (less than or equal to) the threshold log level.
+ * \param alloc                 The allocator to use for block buffers.
+ * \param out_desc              The descriptor to which plaintext is written.
+ * \param in_desc               The descriptor of the encrypted log.
+ * \param key                   The raw key the log was written with.
+ * \param key_size              The size of the key.
  *
- * \note This \ref vcservice_log instance is a \ref resource that must be
- * released by calling \ref resource_release on its resource handle when it is
- * no longer needed by the caller.  The resource handle can be accessed by
- * calling \ref vcservice_log_resource_handle on this \ref vcservice_log
- * instance.
+ * The log is read and decrypted one block at a time, so memory use does not
+ * depend on the size of the log.
  *
  * \returns a status code indicating success or failure.
  *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY if the key size does not
+ *        match the crypto suite.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED if the header or a block is
+ *        malformed, truncated, or out of order.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_READ if the log could not be read.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE if the plaintext could not be
+ *        written.
  *      - a non-zero error code on failure.
- *
- * \pre
- *      - \p log must not reference a valid logger instance and must not be
- *        NULL.
- *      - \p alloc must reference a valid \ref allocator and must not be NULL.
- *      - \p threshold_level must be a valid log level belonging to
- *        \ref vcservice_loglevel.
- *
- * \post
- *      - On success, \p log is set to a pointer to a valid \ref vcservice_log
- *        instance.
- *      - On failure, \p log is set to NULL and an error status is returned.
  */
 status FN_DECL_MUST_CHECK
-vcservice_log_create_using_standard_output(
-    vcservice_log** log, RCPR_SYM(allocator)* alloc,
-    unsigned int threshold_level);
+vcservice_log_encrypted_decrypt(
+    RCPR_SYM(allocator)* alloc, int out_desc, int in_desc, const void* key,
+    size_t key_size);
 
 /******************************************************************************/
-/* Start of public methods.                                                   */
+/* Start of accessors.                                                        */
 /******************************************************************************/
 
 /**
- * \brief Start a new logging message.
+ * \brief Given a \ref vcservice_log instance, return its resource handle.
  *
- * \param log           The \ref vcservice_log instance for this operation.
+ * \param log           The \ref vcservice_log instance from which the resource
+ *                      handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_log instance.
  */
-void
-vcservice_log_message_start(vcservice_log* log);
+RCPR_SYM(resource*)
+vcservice_log_resource_handle(vcservice_log* log);
 
 /**
- * \brief Append the log level to the logging message.
+ * \brief Given a \ref vcservice_log instance, return its logging threshold
+ * level.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param level         The logging level to log.
+ * \param log           The \ref vcservice_log instance from which the resource
+ *                      handle is returned.
+ *
+ * \returns the logging threshold for this \ref vcservice_log instance.
  */
-void
-vcservice_log_append_log_level(vcservice_log* log, unsigned int level);
+unsigned int
+vcservice_log_threshold_level(const vcservice_log* log);
 
 /**
- * \brief Append a string value to the logging message.
+ * \brief Check whether a message at the given level passes the logger's
+ * threshold level, or the capture level of the current request scope.
+ *
+ * This is the level check made by the log macros.
  *
  * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The string value to append.
+ * \param level         The logging level of the message.
+ *
+ * \returns true if a message at this level should be formatted and committed,
+ * or false if it would be dropped.
  */
-void
-vcservice_log_append_string(vcservice_log* log, const char* val);
+bool
+vcservice_log_level_enabled(const vcservice_log* log, unsigned int level);
 
 /**
- * \brief Append an 8-bit integer value to the logging message.
+ * \brief Given a \ref vcservice_log_redactor instance, return its resource
+ * handle.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The integer value to append.
+ * \param redactor      The \ref vcservice_log_redactor instance from which the
+ *                      resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_log_redactor instance.
  */
-void
-vcservice_log_append_int8(vcservice_log* log, int8_t val);
+RCPR_SYM(resource*)
+vcservice_log_redactor_resource_handle(vcservice_log_redactor* redactor);
+
+/******************************************************************************/
+/* Start of call site control.                                                */
+/******************************************************************************/
 
 /**
- * \brief Append an 8-bit unsigned integer value to the logging message.
+ * \brief Get the list of logging call sites linked into this program.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The unsigned integer value to append.
+ * \param sites         Pointer to receive the first call site descriptor.
+ *
+ * \note Only call sites in the same linked image (the executable, or the
+ * shared object containing this library) are visible.
+ *
+ * \returns the number of call site descriptors in the list.
  */
-void
-vcservice_log_append_uint8(vcservice_log* log, uint8_t val);
+size_t
+vcservice_log_callsite_list(const vcservice_log_callsite** sites);
 
 /**
- * \brief Append a 16-bit integer value to the logging message.
+ * \brief Enable or disable every logging call site matching the given
+ * criteria.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The integer value to append.
+ * An enabled call site logs its message regardless of the logger's threshold
+ * level.  A disabled call site is subject to the threshold level as usual.
+ *
+ * \param file_pattern      A glob pattern matched against the full source path
+ *                          or the base name of the call site, or NULL to match
+ *                          any file.
+ * \param function_pattern  A glob pattern matched against the function name of
+ *                          the call site, or NULL to match any function.
+ * \param line              The line number of the call site, or 0 to match any
+ *                          line.
+ * \param enabled           true to enable the matching call sites, false to
+ *                          disable them.
+ *
+ * \returns the number of call sites matched.
  */
-void
-vcservice_log_append_int16(vcservice_log* log, int16_t val);
+size_t
+vcservice_log_callsite_set_enabled(
+    const char* file_pattern, const char* function_pattern, unsigned int line,
+    bool enabled);
+
+/******************************************************************************/
+/* Start of trace context.                                                    */
+/******************************************************************************/
 
 /**
- * \brief Append a 16-bit unsigned integer value to the logging message.
+ * \brief Initialize a trace context with the given trace and span ids,
+ * rendering its text.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The unsigned integer value to append.
+ * \param ctx           The trace context to initialize.
+ * \param trace_id      The trace id, typically the request's correlation
+ *                      UUID.
+ * \param span_id       The span id.
  */
 void
-vcservice_log_append_uint16(vcservice_log* log, uint16_t val);
+vcservice_log_trace_context_init(
+    vcservice_log_trace_context* ctx, const RCPR_SYM(rcpr_uuid)* trace_id,
+    uint64_t span_id);
 
 /**
- * \brief Append a 32-bit integer value to the logging message.
+ * \brief Make the given trace context current on the calling thread,
+ * returning the previous one.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The integer value to append.
+ * While a context is current, every message started on this thread is
+ * prefixed with its text after the timestamp.  A fiber scheduler swaps in the
+ * context of the fiber it is about to run, and swaps it back out when the
+ * fiber yields.  The context is not copied, so it must stay valid while it is
+ * current.
+ *
+ * \param ctx           The trace context to make current, or NULL to clear
+ *                      the current context.
+ *
+ * \returns the previously current trace context, or NULL if there was none.
  */
-void
-vcservice_log_append_int32(vcservice_log* log, int32_t val);
+vcservice_log_trace_context*
+vcservice_log_trace_context_swap(vcservice_log_trace_context* ctx);
 
 /**
- * \brief Append a 32-bit unsigned integer value to the logging message.
+ * \brief Get the trace context that is current on the calling thread.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The unsigned integer value to append.
+ * \returns the current trace context, or NULL if there is none.
  */
-void
-vcservice_log_append_uint32(vcservice_log* log, uint32_t val);
+vcservice_log_trace_context*
+vcservice_log_trace_context_current(void);
+
+/******************************************************************************/
+/* Start of request scopes.                                                   */
+/******************************************************************************/
 
 /**
- * \brief Append a 64-bit integer value to the logging message.
+ * \brief Begin a request scope on the given logger.
+ *
+ * Inside a request scope, messages less critical than the logger's threshold
+ * level, down to \p capture_level, are formatted into a small buffer instead
+ * of being written.  If an ERROR or CRITICAL message is logged in the scope,
+ * the buffered messages are written ahead of it, so a failed request carries
+ * its full detail.  Otherwise, they are discarded when the scope ends.  When
+ * the buffer fills, the oldest messages are dropped.
+ *
+ * Scopes nest.  A nested scope may lower the capture level, and the buffer is
+ * kept until the outermost scope ends.
  *
  * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The integer value to append.
+ * \param capture_level The least critical level to buffer, belonging to
+ *                      \ref vcservice_loglevel.
+ *
+ * \note Messages from call sites enabled with
+ * \ref vcservice_log_callsite_set_enabled are always written, as they are
+ * outside of a scope.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure, in which case no scope is begun.
  */
-void
-vcservice_log_append_int64(vcservice_log* log, int64_t val);
+status FN_DECL_MUST_CHECK
+vcservice_log_scope_begin(vcservice_log* log, unsigned int capture_level);
 
 /**
- * \brief Append a 64-bit unsigned integer value to the logging message.
+ * \brief End a request scope on the given logger.
+ *
+ * When the outermost scope ends, any buffered messages are discarded.
  *
  * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The unsigned integer value to append.
  */
 void
-vcservice_log_append_uint64(vcservice_log* log, uint64_t val);
+vcservice_log_scope_end(vcservice_log* log);
+
+/******************************************************************************/
+/* Start of logger stats.                                                     */
+/******************************************************************************/
 
 /**
- * \brief Append a UUID value to the logging message.
+ * \brief Get the counters of the given logger.
+ *
+ * Every message handed to the logger's sink is counted by level, along with
+ * its size in bytes.  A message is dropped when a request scope buffer
+ * overflows, or when a sink could not queue it.  Use
+ * \ref vcservice_metrics_log_register to export these counters.
  *
  * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The uuid value to append.
+ *
+ * \returns the logger's counters, which are valid until it is released.
  */
-void
-vcservice_log_append_uuid(vcservice_log* log, const RCPR_SYM(rcpr_uuid)* val);
+const vcservice_log_stats*
+vcservice_log_stats_get(const vcservice_log* log);
+
+/******************************************************************************/
+/* Start of async-signal-safe logging.                                        */
+/******************************************************************************/
 
 /**
- * \brief Set the log formatting mode to the default.
+ * \brief Start an async-signal-safe log message.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The sentry value for this operation.
+ * The vcservice_log_signal_safe_* methods can be called from a signal
+ * handler.  They format into the given message, which is typically on the
+ * handler's stack, without allocating, locking, or touching the time zone,
+ * and \ref vcservice_log_signal_safe_write writes it with a single write(2).
+ * They do not use a \ref vcservice_log, whose sinks are not safe to enter
+ * from a handler.
+ *
+ * The message starts with the UTC time, as "YYYY-MM-DD HH:MM:SSZ ", and the
+ * level, padded as in other log messages.
+ *
+ * \param msg           The message to start.
+ * \param level         The logging level of this message, belonging to
+ *                      \ref vcservice_loglevel.
  */
 void
-vcservice_log_format_set_default(
-    vcservice_log* log, const vcservice_log_format_default* val);
+vcservice_log_signal_safe_start(
+    vcservice_log_signal_safe_message* msg, unsigned int level);
 
 /**
- * \brief Set the log formatting mode to hex.
+ * \brief Append a string to an async-signal-safe log message.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The sentry value for this operation.
+ * Text past the end of the message is dropped.
+ *
+ * \param msg           The message for this operation.
+ * \param val           The string value to append.
  */
 void
-vcservice_log_format_set_hex(
-    vcservice_log* log, const vcservice_log_format_hex* val);
+vcservice_log_signal_safe_append_string(
+    vcservice_log_signal_safe_message* msg, const char* val);
 
 /**
- * \brief Handle a no-operation, needed for type resolution in the debug macro.
+ * \brief Append a signed integer to an async-signal-safe log message.
  *
- * \param log           The \ref vcservice_log instance for this operation.
- * \param val           The dummy value for this operation.
+ * \param msg           The message for this operation.
+ * \param val           The value to append in decimal.
  */
 void
-vcservice_log_no_op(
-    vcservice_log* log, const void* val);
+vcservice_log_signal_safe_append_int64(
+    vcservice_log_signal_safe_message* msg, int64_t val);
 
 /**
- * \brief Commit the logging message.
+ * \brief Append an unsigned integer to an async-signal-safe log message.
  *
- * \param log           The \ref vcservice_log instance for this operation.
+ * \param msg           The message for this operation.
+ * \param val           The value to append in decimal.
  */
 void
-vcservice_log_message_commit(vcservice_log* log);
-
-/******************************************************************************/
-/* Start of accessors.                                                        */
-/******************************************************************************/
+vcservice_log_signal_safe_append_uint64(
+    vcservice_log_signal_safe_message* msg, uint64_t val);
 
 /**
- * \brief Given a \ref vcservice_log instance, return its resource handle.
- *
- * \param log           The \ref vcservice_log instance from which the resource
- *                      handle is returned.
+ * \brief Write an async-signal-safe log message, ending it with a newline.
  *
- * \returns the resource handle for this \ref vcservice_log instance.
- */
-RCPR_SYM(resource*)
-vcservice_log_resource_handle(vcservice_log* log);
-
-/**
- * \brief Given a \ref vcservice_log instance, return its logging threshold
- * level.
+ * The message is written with a single write(2), which is only repeated if
+ * it is interrupted or only partly completes.  errno is preserved, so this
+ * can be called from a handler without disturbing the interrupted code.  The
+ * newline is kept in the message, so writing it again, such as to retry after
+ * a failure, writes the same line.
  *
- * \param log           The \ref vcservice_log instance from which the resource
- *                      handle is returned.
+ * \param desc          The descriptor to write to, such as STDERR_FILENO or
+ *                      a log file opened before the handler was installed.
+ * \param msg           The message to write.
  *
- * \returns the logging threshold for this \ref vcservice_log instance.
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SIGNAL_SAFE_WRITE if the message could not be
+ *        written in full.
  */
-unsigned int
-vcservice_log_threshold_level(const vcservice_log* log);
+status
+vcservice_log_signal_safe_write(
+    int desc, vcservice_log_signal_safe_message* msg);
 
 /******************************************************************************/
 /* Start of utility macros.                                                   */
@@ -400,6 +1426,14 @@ vcservice_log_threshold_level(const vcservice_log* log);
 #define CRITICAL_LOG(log, ...) \
     LOG_WITH_LEVEL(log, VCSERVICE_LOGLEVEL_CRITICAL, __VA_ARGS__)
 
+/*
+ * Log macro arguments are dispatched on their exact type.  Note that in C,
+ * character constants such as 'a' have type int, and true and false are int
+ * constants; use char and bool variables to log those types.  Pointers other
+ * than char pointers and UUIDs must be cast to void* to be logged as an
+ * address.  size_t is logged through the matching fixed-width unsigned type.
+ */
+
 /**
  * \brief Format the given value as hexadecimal if that is supported for this
  * type.
@@ -412,9 +1446,66 @@ vcservice_log_threshold_level(const vcservice_log* log);
     &vcservice_log_format_hex_sentry, (arg), \
     &vcservice_log_format_default_sentry
 
+/**
+ * \brief Log a hex dump of the given buffer as one run of hex digits.
+ *
+ * \param data          The buffer to dump.
+ * \param size          The size of the buffer.
+ *
+ * \note This macro must be used as an argument to a log macro.
+ */
+#define LOG_HEXDUMP(data, size) \
+    LOG_HEXDUMP_LAYOUT((data), (size), 0)
+
+/**
+ * \brief Log a hex dump of the given buffer with the given layout flags.
+ *
+ * \param data          The buffer to dump.
+ * \param size          The size of the buffer.
+ * \param flags         Layout flags, e.g. VCSERVICE_LOG_HEXDUMP_FLAG_ASCII.
+ *
+ * \note This macro must be used as an argument to a log macro.
+ */
+#define LOG_HEXDUMP_LAYOUT(data, size, flags) \
+    ((const vcservice_log_hexdump*)&(vcservice_log_hexdump){ \
+        (data), (size), (flags) })
+
+/**
+ * \brief Log a message with the given level to the given logger.
+ *
+ * By default, each argument is dispatched inline at the call site.  If
+ * VCSERVICE_LOG_COMPACT is defined, the compact expansion is used instead,
+ * which trades a small on-stack argument array for a much smaller call site.
+ *
+ * \param log           The logger for this operation.
+ * \param level         The logging level of this message.
+ * \param ...           A comma separated list of values to append to this log
+ *                      message.
+ */
+#if defined(VCSERVICE_LOG_COMPACT)
 #define LOG_WITH_LEVEL(log, level, ...) \
+    LOG_WITH_LEVEL_COMPACT(log, level, __VA_ARGS__)
+#else
+#define LOG_WITH_LEVEL(log, level, ...) \
+    LOG_WITH_LEVEL_EXPANDED(log, level, __VA_ARGS__)
+#endif
+
+/**
+ * \brief Log a message, dispatching each argument inline at the call site.
+ *
+ * \param log           The logger for this operation.
+ * \param level         The logging level of this message.
+ * \param ...           A comma separated list of values to append to this log
+ *                      message.  Values past the 50th are truncated.
+ */
+#define LOG_WITH_LEVEL_EXPANDED(log, level, ...) \
     do { \
-    if ((int)vcservice_log_threshold_level(log) >= (int)(level)) { \
+    VCSERVICE_LOG_CALLSITE_DECL(level); \
+    const bool vcservice_log_callsite_on = VCSERVICE_LOG_CALLSITE_ENABLED(); \
+    if (vcservice_log_callsite_on \
+     || vcservice_log_level_enabled(log, (level))) { \
+        if (vcservice_log_callsite_on) { \
+            vcservice_log_message_callsite_enabled(log); } \
         vcservice_log_message_start(log); \
         vcservice_log_append_log_level(log, (level)); \
         VCSERVICE_LOG01(log, __VA_ARGS__, \
@@ -428,6 +1519,57 @@ vcservice_log_threshold_level(const vcservice_log* log);
         vcservice_log_message_commit(log); \
     } } while (0)
 
+/**
+ * \brief Log a message by building an array of argument values at the call
+ * site and formatting it out of line with \ref vcservice_log_message_emit.
+ *
+ * The argument type tags are known at compile time, so they are kept in a
+ * static table instead of on the stack.
+ *
+ * \param log           The logger for this operation.
+ * \param level         The logging level of this message.
+ * \param ...           A comma separated list of values to append to this log
+ *                      message.  Values past the 50th are truncated.  Up to
+ *                      125 values are accepted, which is the most that the C
+ *                      standard guarantees a macro can be passed along with
+ *                      the logger and level.
+ */
+#define LOG_WITH_LEVEL_COMPACT(log, level, ...) \
+    do { \
+    VCSERVICE_LOG_CALLSITE_DECL(level); \
+    const bool vcservice_log_callsite_on = VCSERVICE_LOG_CALLSITE_ENABLED(); \
+    if (vcservice_log_callsite_on \
+     || vcservice_log_level_enabled(log, (level))) { \
+        if (vcservice_log_callsite_on) { \
+            vcservice_log_message_callsite_enabled(log); } \
+        static const uint8_t vcservice_log_arg_types[] = { \
+            VCSERVICE_LOG_MAP(VCSERVICE_LOG_ARG_TYPE, __VA_ARGS__) }; \
+        const vcservice_log_arg_value vcservice_log_arg_values[] = { \
+            VCSERVICE_LOG_MAP(VCSERVICE_LOG_ARG_VALUE, __VA_ARGS__) }; \
+        vcservice_log_message_emit( \
+            log, (level), vcservice_log_arg_types, vcservice_log_arg_values, \
+            sizeof(vcservice_log_arg_types)); \
+    } } while (0)
+
+/**
+ * \brief Declare the static call site descriptor for a log macro expansion.
+ *
+ * \param level         The logging level of this call site.
+ */
+#define VCSERVICE_LOG_CALLSITE_DECL(level) \
+    static vcservice_log_callsite vcservice_log_callsite_instance \
+        __attribute__(( \
+            section(VCSERVICE_LOG_CALLSITE_SECTION), used, \
+            aligned(__alignof__(vcservice_log_callsite)))) = \
+        { __FILE__, __func__, __LINE__, (level), 0 }
+
+/**
+ * \brief Check whether the call site declared by
+ * \ref VCSERVICE_LOG_CALLSITE_DECL has been enabled at runtime.
+ */
+#define VCSERVICE_LOG_CALLSITE_ENABLED() \
+    __atomic_load_n(&vcservice_log_callsite_instance.enabled, __ATOMIC_RELAXED)
+
 #define VCSERVICE_LOG_END_OF_INPUT(arg) \
     _Generic((arg), \
         vcservice_log_end_of_message*: true, \
@@ -444,10 +1586,17 @@ vcservice_log_threshold_level(const vcservice_log* log);
         uint32_t: vcservice_log_append_uint32, \
         int64_t: vcservice_log_append_int64, \
         uint64_t: vcservice_log_append_uint64, \
+        double: vcservice_log_append_double, \
+        float: vcservice_log_append_float, \
+        bool: vcservice_log_append_bool, \
+        char: vcservice_log_append_char, \
         const char*: vcservice_log_append_string, \
         char*: vcservice_log_append_string, \
+        const void*: vcservice_log_append_pointer, \
+        void*: vcservice_log_append_pointer, \
         const RCPR_SYM(rcpr_uuid)*: vcservice_log_append_uuid, \
         RCPR_SYM(rcpr_uuid)*: vcservice_log_append_uuid, \
+        const vcservice_log_hexdump*: vcservice_log_append_hexdump_arg, \
         vcservice_log_format_default*: vcservice_log_format_set_default, \
         const vcservice_log_format_default*: \
             vcservice_log_format_set_default, \
@@ -765,6 +1914,268 @@ vcservice_log_threshold_level(const vcservice_log* log);
         VCSERVICE_LOG_ITEM(log, " (truncated)"); \
     }
 
+/**
+ * \brief Argument value constructors for the compact log expansion.
+ */
+static inline vcservice_log_arg_value vcservice_log_arg_value_int(
+    int64_t val)
+{
+    vcservice_log_arg_value value;
+    value.i64 = val;
+    return value;
+}
+
+static inline vcservice_log_arg_value vcservice_log_arg_value_uint(
+    uint64_t val)
+{
+    vcservice_log_arg_value value;
+    value.u64 = val;
+    return value;
+}
+
+static inline vcservice_log_arg_value vcservice_log_arg_value_double(
+    double val)
+{
+    vcservice_log_arg_value value;
+    value.f64 = val;
+    return value;
+}
+
+static inline vcservice_log_arg_value vcservice_log_arg_value_pointer(
+    const void* val)
+{
+    vcservice_log_arg_value value;
+    value.ptr = val;
+    return value;
+}
+
+static inline vcservice_log_arg_value vcservice_log_arg_value_string(
+    const char* val)
+{
+    vcservice_log_arg_value value;
+    value.str = val;
+    return value;
+}
+
+static inline vcservice_log_arg_value vcservice_log_arg_value_uuid(
+    const RCPR_SYM(rcpr_uuid)* val)
+{
+    vcservice_log_arg_value value;
+    value.uuid = val;
+    return value;
+}
+
+static inline vcservice_log_arg_value vcservice_log_arg_value_none(
+    const void* val)
+{
+    vcservice_log_arg_value value;
+    (void)val;
+    value.u64 = 0;
+    return value;
+}
+
+#define VCSERVICE_LOG_ARG_TYPE(arg) \
+    _Generic((arg), \
+        int8_t: VCSERVICE_LOG_ARG_INT8, \
+        uint8_t: VCSERVICE_LOG_ARG_UINT8, \
+        int16_t: VCSERVICE_LOG_ARG_INT16, \
+        uint16_t: VCSERVICE_LOG_ARG_UINT16, \
+        int32_t: VCSERVICE_LOG_ARG_INT32, \
+        uint32_t: VCSERVICE_LOG_ARG_UINT32, \
+        int64_t: VCSERVICE_LOG_ARG_INT64, \
+        uint64_t: VCSERVICE_LOG_ARG_UINT64, \
+        double: VCSERVICE_LOG_ARG_DOUBLE, \
+        float: VCSERVICE_LOG_ARG_FLOAT, \
+        bool: VCSERVICE_LOG_ARG_BOOL, \
+        char: VCSERVICE_LOG_ARG_CHAR, \
+        const char*: VCSERVICE_LOG_ARG_STRING, \
+        char*: VCSERVICE_LOG_ARG_STRING, \
+        const void*: VCSERVICE_LOG_ARG_POINTER, \
+        void*: VCSERVICE_LOG_ARG_POINTER, \
+        const RCPR_SYM(rcpr_uuid)*: VCSERVICE_LOG_ARG_UUID, \
+        RCPR_SYM(rcpr_uuid)*: VCSERVICE_LOG_ARG_UUID, \
+        const vcservice_log_hexdump*: VCSERVICE_LOG_ARG_HEXDUMP, \
+        vcservice_log_format_default*: VCSERVICE_LOG_ARG_FORMAT_DEFAULT, \
+        const vcservice_log_format_default*: \
+            VCSERVICE_LOG_ARG_FORMAT_DEFAULT, \
+        vcservice_log_format_hex*: VCSERVICE_LOG_ARG_FORMAT_HEX, \
+        const vcservice_log_format_hex*: VCSERVICE_LOG_ARG_FORMAT_HEX \
+        )
+
+#define VCSERVICE_LOG_ARG_VALUE(arg) \
+    _Generic((arg), \
+        int8_t: vcservice_log_arg_value_int, \
+        uint8_t: vcservice_log_arg_value_uint, \
+        int16_t: vcservice_log_arg_value_int, \
+        uint16_t: vcservice_log_arg_value_uint, \
+        int32_t: vcservice_log_arg_value_int, \
+        uint32_t: vcservice_log_arg_value_uint, \
+        int64_t: vcservice_log_arg_value_int, \
+        uint64_t: vcservice_log_arg_value_uint, \
+        double: vcservice_log_arg_value_double, \
+        float: vcservice_log_arg_value_double, \
+        bool: vcservice_log_arg_value_uint, \
+        char: vcservice_log_arg_value_int, \
+        const char*: vcservice_log_arg_value_string, \
+        char*: vcservice_log_arg_value_string, \
+        const void*: vcservice_log_arg_value_pointer, \
+        void*: vcservice_log_arg_value_pointer, \
+        const RCPR_SYM(rcpr_uuid)*: vcservice_log_arg_value_uuid, \
+        RCPR_SYM(rcpr_uuid)*: vcservice_log_arg_value_uuid, \
+        const vcservice_log_hexdump*: vcservice_log_arg_value_pointer, \
+        default: vcservice_log_arg_value_none \
+        )(arg)
+
+/*
+ * Count the arguments, reporting any count from 51 to 125 as 51, so that the
+ * map keeps the first 51 and vcservice_log_message_emit truncates the
+ * message after the first 50.
+ */
+#define VCSERVICE_LOG_NARG(...) \
+    VCSERVICE_LOG_NARG_N(__VA_ARGS__, \
+        51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, \
+        51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, \
+        51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, \
+        51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, \
+        51, 51, 51, 51, 51, 51, 51, \
+        50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, \
+        33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, \
+        16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+
+#define VCSERVICE_LOG_NARG_N( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, \
+    _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, \
+    _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, \
+    _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, \
+    _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, \
+    _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, \
+    _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, \
+    _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, \
+    _113, _114, _115, _116, _117, _118, _119, _120, _121, _122, _123, _124, \
+    _125, N, ...) \
+    N
+
+#define VCSERVICE_LOG_MAP(m, ...) \
+    VCSERVICE_LOG_MAP_CAT( \
+        VCSERVICE_LOG_MAP_, VCSERVICE_LOG_NARG(__VA_ARGS__))(m, __VA_ARGS__)
+
+#define VCSERVICE_LOG_MAP_CAT(a, b) VCSERVICE_LOG_MAP_CAT2(a, b)
+#define VCSERVICE_LOG_MAP_CAT2(a, b) a ## b
+
+#define VCSERVICE_LOG_MAP_1(m, arg) m(arg)
+#define VCSERVICE_LOG_MAP_2(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_1(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_3(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_2(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_4(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_3(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_5(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_4(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_6(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_5(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_7(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_6(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_8(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_7(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_9(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_8(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_10(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_9(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_11(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_10(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_12(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_11(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_13(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_12(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_14(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_13(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_15(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_14(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_16(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_15(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_17(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_16(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_18(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_17(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_19(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_18(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_20(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_19(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_21(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_20(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_22(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_21(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_23(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_22(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_24(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_23(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_25(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_24(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_26(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_25(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_27(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_26(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_28(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_27(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_29(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_28(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_30(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_29(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_31(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_30(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_32(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_31(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_33(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_32(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_34(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_33(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_35(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_34(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_36(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_35(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_37(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_36(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_38(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_37(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_39(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_38(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_40(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_39(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_41(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_40(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_42(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_41(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_43(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_42(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_44(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_43(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_45(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_44(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_46(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_45(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_47(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_46(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_48(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_47(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_49(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_48(m, __VA_ARGS__)
+#define VCSERVICE_LOG_MAP_50(m, arg, ...) \
+    m(arg), VCSERVICE_LOG_MAP_49(m, __VA_ARGS__)
+
+#define VCSERVICE_LOG_MAP_51(m, ...) \
+    VCSERVICE_LOG_MAP_HEAD51(m, __VA_ARGS__, ~)
+
+#define VCSERVICE_LOG_MAP_HEAD51( \
+    m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, \
+    _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, \
+    _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, \
+    _44, _45, _46, _47, _48, _49, _50, _51, ...) \
+    VCSERVICE_LOG_MAP_50(m, \
+        _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, \
+        _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, \
+        _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, \
+        _44, _45, _46, _47, _48, _49, _50), m(_51)
+
 #define VCLEOM &vcservice_log_end_of_message_sentry
 
 #endif /* !defined(__cplusplus) */
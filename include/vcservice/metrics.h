@@ -0,0 +1,326 @@
+/**
+ * \file vcservice/metrics.h
+ *
+ * \brief Metrics registry and Prometheus exporter interface.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <rcpr/allocator.h>
+#include <rcpr/resource.h>
+#include <stdint.h>
+#include <vcservice/histogram.h>
+#include <vcservice/log.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+/**
+ * \brief Forward decl for the metrics registry.
+ */
+typedef struct vcservice_metrics_registry vcservice_metrics_registry;
+
+/**
+ * \brief Forward decl for a counter metric.
+ */
+typedef struct vcservice_metrics_counter vcservice_metrics_counter;
+
+/**
+ * \brief Forward decl for a gauge metric.
+ */
+typedef struct vcservice_metrics_gauge vcservice_metrics_gauge;
+
+/**
+ * \brief Forward decl for the metrics exporter.
+ */
+typedef struct vcservice_metrics_exporter vcservice_metrics_exporter;
+
+/**
+ * \brief Read the value of a callback counter.
+ *
+ * \param context           The context given when the counter was registered.
+ *
+ * \returns the counter's value.
+ */
+typedef uint64_t (*vcservice_metrics_counter_read_fn)(const void* context);
+
+/**
+ * \brief Create a \ref vcservice_metrics_registry.
+ *
+ * A registry holds named counters, gauges, and histograms, and renders them
+ * in the Prometheus text exposition format.  Metrics are owned by the
+ * registry and released with it.
+ *
+ * \param registry          Pointer to the \ref vcservice_metrics_registry
+ *                          pointer to receive this resource on success.
+ * \param alloc             The allocator to use for this registry.
+ *
+ * \note This \ref vcservice_metrics_registry instance is a \ref resource that
+ * must be released by calling \ref resource_release on its resource handle
+ * when it is no longer needed by the caller.  It must outlive any exporter
+ * serving it.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_registry_create(
+    vcservice_metrics_registry** registry, RCPR_SYM(allocator)* alloc);
+
+/**
+ * \brief Register a counter, a value that only goes up.
+ *
+ * Metrics with the same name must have the same type and help text, and
+ * differ by their labels.
+ *
+ * \param counter           Pointer to receive the counter on success.
+ * \param registry          The registry to add the counter to.
+ * \param name              The metric name, which must match
+ *                          [a-zA-Z_:][a-zA-Z0-9_:]*.
+ * \param labels            The labels, such as level="error", or NULL.  The
+ *                          label values must already be escaped.
+ * \param help              The help text, which must be a single line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name is not valid.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_counter_register(
+    vcservice_metrics_counter** counter, vcservice_metrics_registry* registry,
+    const char* name, const char* labels, const char* help);
+
+/**
+ * \brief Register a gauge, a value that can go up and down.
+ *
+ * \param gauge             Pointer to receive the gauge on success.
+ * \param registry          The registry to add the gauge to.
+ * \param name              The metric name, which must match
+ *                          [a-zA-Z_:][a-zA-Z0-9_:]*.
+ * \param labels            The labels, such as pool="main", or NULL.  The
+ *                          label values must already be escaped.
+ * \param help              The help text, which must be a single line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name is not valid.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_gauge_register(
+    vcservice_metrics_gauge** gauge, vcservice_metrics_registry* registry,
+    const char* name, const char* labels, const char* help);
+
+/**
+ * \brief Register a \ref vcservice_histogram, which is rendered as a
+ * Prometheus summary with its p50, p90, p99, and p999 quantiles.
+ *
+ * \param registry          The registry to add the histogram to.
+ * \param histogram         The histogram, which must outlive the registry.
+ * \param name              The metric name, which must match
+ *                          [a-zA-Z_:][a-zA-Z0-9_:]*.
+ * \param labels            The labels, such as route="pay", or NULL.  The
+ *                          label values must already be escaped.
+ * \param help              The help text, which must be a single line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name is not valid.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_histogram_register(
+    vcservice_metrics_registry* registry, vcservice_histogram* histogram,
+    const char* name, const char* labels, const char* help);
+
+/**
+ * \brief Register a counter that is kept elsewhere, whose value is read by
+ * calling \p read each time the registry is rendered.
+ *
+ * \param registry          The registry to add the counter to.
+ * \param read              The function that reads the counter.  It may be
+ *                          called from the exporter's thread.
+ * \param context           The context passed to \p read, which must stay
+ *                          valid while the registry can be rendered.
+ * \param name              The metric name, which must match
+ *                          [a-zA-Z_:][a-zA-Z0-9_:]*.
+ * \param labels            The labels, such as level="error", or NULL.  The
+ *                          label values must already be escaped.
+ * \param help              The help text, which must be a single line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name is not valid.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_counter_callback_register(
+    vcservice_metrics_registry* registry,
+    vcservice_metrics_counter_read_fn read, const void* context,
+    const char* name, const char* labels, const char* help);
+
+/**
+ * \brief Register the counters of the given logger in a metrics registry.
+ *
+ * This registers the counters vcservice_log_messages_total, with a level
+ * label, vcservice_log_bytes_total, and vcservice_log_dropped_total, each
+ * with a logger label holding \p name.  They are read from
+ * \ref vcservice_log_stats_get when the registry is rendered.
+ *
+ * \param registry          The registry to add the counters to.
+ * \param log               The logger, which must not be released while the
+ *                          registry can be rendered.  Release any exporter
+ *                          serving the registry first.
+ * \param name              The logger label value, which must not contain a
+ *                          quote, backslash, or newline.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name can not be a label value.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a logger with this name is
+ *        already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_log_register(
+    vcservice_metrics_registry* registry, const vcservice_log* log,
+    const char* name);
+
+/**
+ * \brief Add to a counter.
+ *
+ * The counter is split into per-CPU shards, so this is one uncontended
+ * atomic add.
+ *
+ * \param counter           The counter to update.
+ * \param value             The amount to add.
+ */
+void
+vcservice_metrics_counter_add(
+    vcservice_metrics_counter* counter, uint64_t value);
+
+/**
+ * \brief Get the value of a counter.
+ *
+ * \param counter           The counter to read.
+ *
+ * \returns the sum of the counter's shards.
+ */
+uint64_t
+vcservice_metrics_counter_value(const vcservice_metrics_counter* counter);
+
+/**
+ * \brief Set a gauge.
+ *
+ * \param gauge             The gauge to update.
+ * \param value             The new value.
+ */
+void
+vcservice_metrics_gauge_set(vcservice_metrics_gauge* gauge, int64_t value);
+
+/**
+ * \brief Add to a gauge.
+ *
+ * \param gauge             The gauge to update.
+ * \param value             The amount to add, which may be negative.
+ */
+void
+vcservice_metrics_gauge_add(vcservice_metrics_gauge* gauge, int64_t value);
+
+/**
+ * \brief Get the value of a gauge.
+ *
+ * \param gauge             The gauge to read.
+ *
+ * \returns the gauge's value.
+ */
+int64_t
+vcservice_metrics_gauge_value(const vcservice_metrics_gauge* gauge);
+
+/**
+ * \brief Create a \ref vcservice_metrics_exporter, which serves a registry
+ * in the Prometheus text exposition format on a Unix domain socket.
+ *
+ * Each connection gets one HTTP/1.0 response holding every metric, so the
+ * socket can be scraped with "curl --unix-socket".  Rendering only reads the
+ * metrics, so it never blocks the threads updating them.
+ *
+ * \param exporter          Pointer to the \ref vcservice_metrics_exporter
+ *                          pointer to receive this resource on success.
+ * \param alloc             The allocator to use for this exporter.
+ * \param registry          The registry to serve, which must outlive the
+ *                          exporter.
+ * \param socket_path       The path of the socket to listen on.  A stale
+ *                          socket at this path is replaced.
+ *
+ * \note This \ref vcservice_metrics_exporter instance is a \ref resource that
+ * must be released by calling \ref resource_release on its resource handle
+ * when it is no longer needed by the caller.  Releasing it removes the
+ * socket.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the socket path is too long.
+ *      - VCSERVICE_ERROR_METRICS_SOCKET if the socket could not be created.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_exporter_create(
+    vcservice_metrics_exporter** exporter, RCPR_SYM(allocator)* alloc,
+    vcservice_metrics_registry* registry, const char* socket_path);
+
+/**
+ * \brief Given a \ref vcservice_metrics_registry instance, return its
+ * resource handle.
+ *
+ * \param registry          The \ref vcservice_metrics_registry instance from
+ *                          which the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_metrics_registry
+ * instance.
+ */
+RCPR_SYM(resource*)
+vcservice_metrics_registry_resource_handle(
+    vcservice_metrics_registry* registry);
+
+/**
+ * \brief Given a \ref vcservice_metrics_exporter instance, return its
+ * resource handle.
+ *
+ * \param exporter          The \ref vcservice_metrics_exporter instance from
+ *                          which the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_metrics_exporter
+ * instance.
+ */
+RCPR_SYM(resource*)
+vcservice_metrics_exporter_resource_handle(
+    vcservice_metrics_exporter* exporter);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
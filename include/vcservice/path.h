@@ -9,12 +9,91 @@
 #pragma once
 
 #include <rcpr/allocator.h>
+#include <rcpr/resource.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 extern "C" {
 #endif  /*__cplusplus*/
 
+/**
+ * \brief Forward decl for the path resolver.
+ */
+typedef struct path_resolver path_resolver;
+
+/**
+ * \brief Forward decl for the path interning table.
+ */
+typedef struct path_intern_table path_intern_table;
+
+/**
+ * \brief An interned path.
+ *
+ * Handles are immutable and live as long as the table that interned them.  A
+ * table returns the same handle for equal paths, so handles from the same
+ * table can be compared by pointer.
+ */
+typedef struct path_handle path_handle;
+
+struct path_handle
+{
+    uint64_t hash;
+    size_t length;
+    const char* path;
+};
+
+/**
+ * \brief An entry visited by \ref path_walk.
+ */
+typedef struct path_walk_entry path_walk_entry;
+
+struct path_walk_entry
+{
+    /** \brief the full path of the entry, starting with the walk root. */
+    const char* path;
+    /** \brief the length of the path. */
+    size_t length;
+    /** \brief the last component of the path. */
+    const char* name;
+    /** \brief the type of the entry, as a DT_* value from dirent.h. */
+    unsigned char type;
+};
+
+/**
+ * \brief The results of a batch path operation.
+ *
+ * The batch, its tables, and every result share a single allocation, which
+ * the caller reclaims with the allocator that created it.  Each result is
+ * NUL terminated and starts at its offset in the buffer.  Results are in
+ * input order, and are packed end to end except where the work was split
+ * across threads.
+ */
+typedef struct path_batch path_batch;
+
+struct path_batch
+{
+    /** \brief the number of results. */
+    size_t count;
+    /** \brief the offset of each result in the buffer. */
+    size_t* offsets;
+    /** \brief the length of each result. */
+    size_t* lengths;
+    /** \brief the buffer holding every result. */
+    char* buffer;
+};
+
+/**
+ * \brief Callback invoked by \ref path_walk for each entry.
+ *
+ * The entry, including its path, is only valid during the call.  Returning a
+ * status other than STATUS_SUCCESS stops the walk, and \ref path_walk returns
+ * that status.
+ */
+typedef status (*path_walk_callback)(
+    const path_walk_entry* entry, void* context);
+
 /**
  * \brief Append the default path onto a given path.
  *
@@ -53,6 +132,365 @@ status path_append_default(
 status path_dirname(
     char** dirname, RCPR_SYM(allocator)* alloc, const char* filename);
 
+/**
+ * \brief Given a pathname, find the directory portion of this pathname without
+ * copying it.
+ *
+ * On success, offset and length are updated to describe the span of filename
+ * holding the directory portion.  A length of zero means that the directory is
+ * the current directory, ".".  The span is the same directory as returned by
+ * \ref path_dirname, but repeated separators inside it are not collapsed.
+ *
+ * \param offset            Pointer to receive the offset of the directory
+ *                          portion in filename.
+ * \param length            Pointer to receive the length of the directory
+ *                          portion.
+ * \param filename          The filename from which the directory name is
+ *                          computed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_dirname_view(
+    size_t* offset, size_t* length, const char* filename);
+
+/**
+ * \brief Normalize a pathname lexically.
+ *
+ * Repeated separators are collapsed, "." entries are removed, ".." entries
+ * remove the preceding entry, and trailing separators are stripped.  A ".." at
+ * the root of an absolute path is dropped; leading ".." entries of a relative
+ * path are kept.  An empty result is ".".  The file system is not consulted,
+ * so symbolic links are not resolved.
+ *
+ * On success, normalized is updated to the normalized path.  This value is
+ * owned by the caller and must be reclaimed using the allocator when no longer
+ * needed.
+ *
+ * \param normalized        Pointer to receive the normalized path on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param path              The path to normalize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_normalize(
+    char** normalized, RCPR_SYM(allocator)* alloc, const char* path);
+
+/**
+ * \brief Normalize a pathname lexically into a caller supplied buffer.
+ *
+ * This performs the same normalization as \ref path_normalize.  The
+ * normalized path is never longer than the input path, except that an empty
+ * result is ".", so a buffer of strlen(path) + 2 bytes is always large enough.
+ *
+ * \param buffer            The buffer to receive the zero-terminated
+ *                          normalized path.
+ * \param size              The size of the buffer.
+ * \param length            Pointer to receive the length of the normalized
+ *                          path, not counting the terminator.
+ * \param path              The path to normalize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL if the normalized path does not
+ *        fit in the buffer.
+ *      - a non-zero error code on failure.
+ */
+status path_normalize_to_buffer(
+    char* buffer, size_t size, size_t* length, const char* path);
+
+/**
+ * \brief Join path components into a single path.
+ *
+ * The components are joined with separators.  Repeated separators are
+ * collapsed, empty components are skipped, and an absolute component discards
+ * the components before it.  A trailing separator on the last component is
+ * kept.  If there are no non-empty components, the result is empty.
+ *
+ * The length of the result is computed first, so that exactly one allocation
+ * is made.  On success, out is updated to the joined path.  This value is
+ * owned by the caller and must be reclaimed using the allocator when no longer
+ * needed.
+ *
+ * \param out               Pointer to receive the joined path on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param ...               The components to join, terminated by NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_join(char** out, RCPR_SYM(allocator)* alloc, ...)
+    __attribute__((sentinel));
+
+/**
+ * \brief Join path components into a caller supplied buffer.
+ *
+ * This joins the components as \ref path_join does, without allocating.
+ *
+ * \param buffer            The buffer to receive the zero-terminated path.
+ * \param size              The size of the buffer.
+ * \param length            Pointer to receive the length of the joined path,
+ *                          not counting the terminator.
+ * \param ...               The components to join, terminated by NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL if the joined path does not fit
+ *        in the buffer.
+ *      - a non-zero error code on failure.
+ */
+status path_join_to_buffer(char* buffer, size_t size, size_t* length, ...)
+    __attribute__((sentinel));
+
+/**
+ * \brief Create a \ref path_resolver for the given search path.
+ *
+ * The search path, such as one built by \ref path_append_default, is split
+ * into its directories once.  Command names resolved through this instance
+ * are cached, including commands that are not found.  The cache is dropped
+ * when the modification time of one of the directories changes, which is
+ * checked at most once per second.
+ *
+ * \param resolver          Pointer to the \ref path_resolver pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param search_path       The colon separated search path.  An empty entry
+ *                          is the current directory.
+ *
+ * \note This \ref path_resolver instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  It is not safe to use from more than one
+ * thread at a time.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+path_resolver_create(
+    path_resolver** resolver, RCPR_SYM(allocator)* alloc,
+    const char* search_path);
+
+/**
+ * \brief Resolve a command name to the path of an executable.
+ *
+ * A command containing a separator is not searched for; it is returned as is
+ * if it names an executable file.  Otherwise, the first directory in the
+ * search path holding an executable regular file with this name is used.
+ *
+ * On success, resolved is updated to the path of the executable.  This value
+ * is owned by the caller and must be reclaimed using the allocator when no
+ * longer needed.
+ *
+ * \param resolved          Pointer to receive the resolved path on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param resolver          The \ref path_resolver for this operation.
+ * \param command           The command name to resolve.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_PATH_NOT_FOUND if no executable was found.
+ *      - a non-zero error code on failure.
+ */
+status path_resolver_resolve(
+    char** resolved, RCPR_SYM(allocator)* alloc, path_resolver* resolver,
+    const char* command);
+
+/**
+ * \brief Given a \ref path_resolver instance, return its resource handle.
+ *
+ * \param resolver          The \ref path_resolver instance from which the
+ *                          resource handle is returned.
+ *
+ * \returns the resource handle for this \ref path_resolver instance.
+ */
+RCPR_SYM(resource*)
+path_resolver_resource_handle(path_resolver* resolver);
+
+/**
+ * \brief Create a \ref path_intern_table.
+ *
+ * \param table             Pointer to the \ref path_intern_table pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for this operation.
+ *
+ * \note This \ref path_intern_table instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  Releasing it invalidates every handle that
+ * it returned.  It may be used from several threads at once: lookups do not
+ * take a lock, and interning a new path takes a lock only to insert it.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+path_intern_table_create(
+    path_intern_table** table, RCPR_SYM(allocator)* alloc);
+
+/**
+ * \brief Intern a path, returning its handle.
+ *
+ * If an equal path was already interned, its handle is returned.  Otherwise,
+ * the path is copied into the table.  Paths are compared byte for byte; use
+ * \ref path_normalize first if different spellings of the same path should
+ * share a handle.
+ *
+ * \param handle            Pointer to receive the handle on success.
+ * \param table             The \ref path_intern_table for this operation.
+ * \param path              The path to intern.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_intern(
+    const path_handle** handle, path_intern_table* table, const char* path);
+
+/**
+ * \brief Look up the handle of an interned path, without interning it.
+ *
+ * \param table             The \ref path_intern_table for this operation.
+ * \param path              The path to look up.
+ *
+ * \returns the handle, or NULL if the path has not been interned.
+ */
+const path_handle* path_intern_lookup(
+    path_intern_table* table, const char* path);
+
+/**
+ * \brief Given a \ref path_intern_table instance, return its resource handle.
+ *
+ * \param table             The \ref path_intern_table instance from which
+ *                          the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref path_intern_table instance.
+ */
+RCPR_SYM(resource*)
+path_intern_table_resource_handle(path_intern_table* table);
+
+/**
+ * \brief Compute the directory name of each of a set of paths.
+ *
+ * The results match \ref path_dirname, but are written into a single
+ * allocation instead of one allocation per path.
+ *
+ * \param batch             Pointer to receive the results on success.  The
+ *                          caller reclaims this using the allocator.
+ * \param alloc             The allocator to use for this operation.
+ * \param paths             The paths.
+ * \param count             The number of paths.
+ * \param thread_count      The number of threads to split the work across,
+ *                          including the calling thread.  Small batches are
+ *                          not split.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_dirname_batch(
+    path_batch** batch, RCPR_SYM(allocator)* alloc, const char* const* paths,
+    size_t count, unsigned int thread_count);
+
+/**
+ * \brief Normalize each of a set of paths.
+ *
+ * The results match \ref path_normalize, but are written into a single
+ * allocation instead of one allocation per path.
+ *
+ * \param batch             Pointer to receive the results on success.  The
+ *                          caller reclaims this using the allocator.
+ * \param alloc             The allocator to use for this operation.
+ * \param paths             The paths.
+ * \param count             The number of paths.
+ * \param thread_count      The number of threads to split the work across,
+ *                          including the calling thread.  Small batches are
+ *                          not split.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_normalize_batch(
+    path_batch** batch, RCPR_SYM(allocator)* alloc, const char* const* paths,
+    size_t count, unsigned int thread_count);
+
+/**
+ * \brief Join each of a set of directories with the matching name.
+ *
+ * The results match \ref path_join called with the directory and the name,
+ * but are written into a single allocation instead of one allocation per
+ * pair.
+ *
+ * \param batch             Pointer to receive the results on success.  The
+ *                          caller reclaims this using the allocator.
+ * \param alloc             The allocator to use for this operation.
+ * \param dirs              The directories.
+ * \param names             The names to join to the directories.
+ * \param count             The number of directories and of names.
+ * \param thread_count      The number of threads to split the work across,
+ *                          including the calling thread.  Small batches are
+ *                          not split.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_join_batch(
+    path_batch** batch, RCPR_SYM(allocator)* alloc, const char* const* dirs,
+    const char* const* names, size_t count, unsigned int thread_count);
+
+/**
+ * \brief Get a result of a batch path operation.
+ *
+ * \param batch             The batch.
+ * \param index             The index of the result, less than its count.
+ *
+ * \returns the result.
+ */
+static inline const char* path_batch_get(
+    const path_batch* batch, size_t index)
+{
+    return batch->buffer + batch->offsets[index];
+}
+
+/**
+ * \brief Walk a directory tree, calling a callback for every entry below the
+ * root.
+ *
+ * Directories are read in large batches with getdents64 where available, and
+ * the type of each entry is taken from the directory itself, so entries are
+ * only stat'd on file systems that do not report a type.  Each worker reuses
+ * one path buffer, so visiting an entry does not allocate.  Symbolic links
+ * are reported but not followed.  Directories that vanish or cannot be read
+ * during the walk are skipped.
+ *
+ * With more than one thread, subdirectories are spread across a pool of
+ * workers that steal from each other when idle, and the callback is called
+ * from several threads at once.  The order of entries is unspecified.
+ *
+ * \param alloc             The allocator to use for this operation.
+ * \param root              The directory to walk.
+ * \param thread_count      The number of threads to walk with, including
+ *                          the calling thread.  0 and 1 both walk in the
+ *                          calling thread only.
+ * \param callback          The callback to call for each entry.
+ * \param context           The context passed to the callback.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_PATH_NOT_FOUND if the root is not a directory.
+ *      - the status returned by the callback if it stopped the walk.
+ *      - a non-zero error code on failure.
+ */
+status path_walk(
+    RCPR_SYM(allocator)* alloc, const char* root, unsigned int thread_count,
+    path_walk_callback callback, void* context);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
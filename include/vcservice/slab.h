@@ -0,0 +1,159 @@
+/**
+ * \file vcservice/slab.h
+ *
+ * \brief Slab allocator interface.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <rcpr/allocator.h>
+#include <rcpr/resource.h>
+#include <stddef.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+/**
+ * \brief Forward decl for the slab allocator.
+ */
+typedef struct vcservice_slab vcservice_slab;
+
+/**
+ * \brief The number of size classes.
+ */
+#define VCSERVICE_SLAB_CLASS_COUNT                  12
+
+/**
+ * \brief The largest allocation served from a size class.  Larger
+ * allocations are mapped on their own.
+ */
+#define VCSERVICE_SLAB_MAX_CLASS_SIZE               1024
+
+/**
+ * \brief Occupancy counters for a \ref vcservice_slab.
+ */
+typedef struct vcservice_slab_stats vcservice_slab_stats;
+
+struct vcservice_slab_stats
+{
+    /** \brief the object size of each size class. */
+    size_t class_size[VCSERVICE_SLAB_CLASS_COUNT];
+    /** \brief the number of live objects in each size class. */
+    size_t class_in_use[VCSERVICE_SLAB_CLASS_COUNT];
+    /** \brief the number of spans mapped for size classes. */
+    size_t spans;
+    /** \brief the number of live allocations too large for a size class. */
+    size_t large_in_use;
+    /** \brief the total bytes mapped, for spans and large allocations. */
+    size_t bytes_mapped;
+};
+
+/**
+ * \brief Create a \ref vcservice_slab.
+ *
+ * A slab allocator serves small allocations from fixed size classes.  Each
+ * thread keeps a magazine of free objects per size class, so most
+ * allocations and reclaims touch no shared state.  Memory may be reclaimed
+ * from any thread, not just the one that allocated it.  Magazines are
+ * refilled from, and flushed to, a central free list per size class in
+ * batches.
+ *
+ * \param slab              Pointer to the \ref vcservice_slab pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for the slab instance and
+ *                          its per-thread magazines.  It must be safe to use
+ *                          from several threads.  Spans are mapped directly
+ *                          from the system.
+ *
+ * \note This \ref vcservice_slab instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  It must not be released while other
+ * threads are still using it.  Releasing it invalidates every allocation made
+ * from it.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_slab_create(vcservice_slab** slab, RCPR_SYM(allocator)* alloc);
+
+/**
+ * \brief Allocate memory from a \ref vcservice_slab.
+ *
+ * The memory is aligned to 16 bytes.
+ *
+ * \param slab              The slab for this operation.
+ * \param mem               Pointer to receive the memory on success.
+ * \param size              The size of the allocation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_slab_allocate(vcservice_slab* slab, void** mem, size_t size);
+
+/**
+ * \brief Reclaim memory allocated from a \ref vcservice_slab.
+ *
+ * \param slab              The slab that the memory was allocated from.
+ * \param mem               The memory to reclaim.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_slab_reclaim(vcservice_slab* slab, void* mem);
+
+/**
+ * \brief Get an \ref allocator backed by a \ref vcservice_slab.
+ *
+ * The allocator can be passed to any interface that takes an allocator, such
+ * as the path and log interfaces, and is safe to use from several threads.
+ * Reallocating keeps the memory in place while the new size fits its size
+ * class.
+ *
+ * \param slab              The slab for this operation.
+ *
+ * \note The allocator belongs to the slab and lives as long as it does;
+ * releasing its resource handle does nothing.  Objects created with it must
+ * be released before the slab is.
+ *
+ * \returns the allocator for this slab.
+ */
+RCPR_SYM(allocator)*
+vcservice_slab_allocator(vcservice_slab* slab);
+
+/**
+ * \brief Read the occupancy counters of a \ref vcservice_slab.
+ *
+ * The counts are read without stopping other threads, so they are a close
+ * approximation while other threads allocate or reclaim.
+ *
+ * \param stats             The stats structure to fill in.
+ * \param slab              The slab to query.
+ */
+void vcservice_slab_stats_get(
+    vcservice_slab_stats* stats, vcservice_slab* slab);
+
+/**
+ * \brief Given a \ref vcservice_slab instance, return its resource handle.
+ *
+ * \param slab              The \ref vcservice_slab instance from which the
+ *                          resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_slab instance.
+ */
+RCPR_SYM(resource*)
+vcservice_slab_resource_handle(vcservice_slab* slab);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
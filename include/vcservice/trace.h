@@ -0,0 +1,120 @@
+/**
+ * \file vcservice/trace.h
+ *
+ * \brief Span tracing interface.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <rcpr/allocator.h>
+#include <rcpr/resource.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+/**
+ * \brief Forward decl for the tracer.
+ */
+typedef struct vcservice_tracer vcservice_tracer;
+
+/**
+ * \brief The default number of events buffered per thread.
+ */
+#define VCSERVICE_TRACER_DEFAULT_RING_SIZE          4096
+
+/**
+ * \brief Create a \ref vcservice_tracer that writes Chrome trace-event JSON
+ * to the given descriptor.
+ *
+ * Each thread records span begin and end events into its own ring buffer,
+ * without locks or allocation after its first event.  A background thread
+ * drains the rings every 100 milliseconds and writes the events as a JSON
+ * array that chrome://tracing and Perfetto load directly.  When a thread
+ * records events faster than they are drained, and its ring is full, new
+ * events are dropped.
+ *
+ * \param tracer            Pointer to the \ref vcservice_tracer pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for the tracer and its
+ *                          per-thread rings.  It must be safe to use from
+ *                          several threads.
+ * \param desc              The descriptor to which the trace is written.
+ *                          This descriptor is owned by the tracer and will be
+ *                          closed when it is released.
+ * \param ring_size         The number of events buffered per thread, which
+ *                          must be a power of two, or 0 for
+ *                          \ref VCSERVICE_TRACER_DEFAULT_RING_SIZE.
+ *
+ * \note This \ref vcservice_tracer instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  It must not be released while other
+ * threads are still recording.  Releasing it writes the remaining events and
+ * closes the JSON array, and returns VCSERVICE_ERROR_TRACE_WRITE if any event
+ * could not be written.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_TRACE_INVALID_PARAMETER if \p ring_size is not a
+ *        power of two.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_tracer_create(
+    vcservice_tracer** tracer, RCPR_SYM(allocator)* alloc, int desc,
+    size_t ring_size);
+
+/**
+ * \brief Record the beginning of a span on the calling thread.
+ *
+ * \param tracer            The tracer for this operation.
+ * \param name              The name of the span.  Only the pointer is
+ *                          recorded, so this must outlive the tracer; a
+ *                          string literal is typical.
+ */
+void
+vcservice_trace_begin(vcservice_tracer* tracer, const char* name);
+
+/**
+ * \brief Record the end of the innermost open span on the calling thread.
+ *
+ * \param tracer            The tracer for this operation.
+ */
+void
+vcservice_trace_end(vcservice_tracer* tracer);
+
+/**
+ * \brief Get the number of events dropped because a thread's ring was full.
+ *
+ * The count is read without stopping other threads, so it is a close
+ * approximation while other threads record events.
+ *
+ * \param tracer            The tracer to query.
+ *
+ * \returns the number of dropped events.
+ */
+uint64_t
+vcservice_tracer_dropped(vcservice_tracer* tracer);
+
+/**
+ * \brief Given a \ref vcservice_tracer instance, return its resource handle.
+ *
+ * \param tracer            The \ref vcservice_tracer instance from which the
+ *                          resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_tracer instance.
+ */
+RCPR_SYM(resource*)
+vcservice_tracer_resource_handle(vcservice_tracer* tracer);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
@@ -0,0 +1,96 @@
+/**
+ * \file arena/arena_internal.h
+ *
+ * \brief Internal header for the arena allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <rcpr/allocator/protected.h>
+#include <rcpr/resource/protected.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vcservice/arena.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+/* x86-64 and aarch64 both default to 2 MiB huge pages. */
+#define ARENA_HUGE_PAGE_SIZE            (2 * 1024 * 1024)
+
+#define ARENA_ALIGN(x) \
+    (((x) + VCSERVICE_ARENA_ALIGNMENT - 1) \
+        & ~((size_t)VCSERVICE_ARENA_ALIGNMENT - 1))
+
+typedef struct vcservice_arena_block vcservice_arena_block;
+
+/**
+ * \brief A block of arena memory, which starts with this header.
+ */
+struct vcservice_arena_block
+{
+    vcservice_arena_block* next;
+    size_t size;
+};
+
+#define ARENA_BLOCK_HEADER_SIZE ARENA_ALIGN(sizeof(vcservice_arena_block))
+
+/* memory from the allocator view is preceded by its size. */
+#define ARENA_VIEW_HEADER_SIZE ARENA_ALIGN(sizeof(size_t))
+
+#define ARENA_OF_VIEW(alloc) \
+    ((vcservice_arena*)((char*)(alloc) - offsetof(vcservice_arena, view)))
+
+struct vcservice_arena
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    size_t block_size;
+    unsigned int flags;
+    vcservice_arena_block* head;
+    vcservice_arena_block* current;
+    char* next;
+    char* end;
+    size_t used;
+    RCPR_SYM(allocator) view;
+};
+
+status
+vcservice_arena_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+vcservice_arena_block_map(
+    vcservice_arena_block** block, size_t size, unsigned int flags);
+
+void
+vcservice_arena_block_unmap(vcservice_arena_block* block);
+
+status
+vcservice_arena_allocate_slow(
+    vcservice_arena* arena, void** mem, size_t size);
+
+status
+vcservice_arena_view_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+vcservice_arena_view_allocate(
+    RCPR_SYM(allocator)* alloc, void** mem, size_t size);
+
+status
+vcservice_arena_view_reclaim(
+    RCPR_SYM(allocator)* alloc, void* mem);
+
+status
+vcservice_arena_view_reallocate(
+    RCPR_SYM(allocator)* alloc, void** mem, size_t size);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
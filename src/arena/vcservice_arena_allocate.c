@@ -0,0 +1,60 @@
+/**
+ * \file arena/vcservice_arena_allocate.c
+ *
+ * \brief Allocate memory from an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcservice/error_codes.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Allocate memory from a \ref vcservice_arena.
+ *
+ * The memory is aligned to \ref VCSERVICE_ARENA_ALIGNMENT and remains valid
+ * until the arena is reset or released.  It must not be reclaimed on its own.
+ *
+ * \param arena             The arena for this operation.
+ * \param mem               Pointer to receive the memory on success.
+ * \param size              The size of the allocation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_arena_allocate(vcservice_arena* arena, void** mem, size_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+    MODEL_ASSERT(NULL != mem);
+
+    /* runtime parameter checks. */
+    if (NULL == arena || NULL == mem)
+    {
+        return VCSERVICE_ERROR_ARENA_INVALID_PARAMETER;
+    }
+
+    /* guard against overflow when rounding up. */
+    if (size > SIZE_MAX - VCSERVICE_ARENA_ALIGNMENT)
+    {
+        return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    size = ARENA_ALIGN(size);
+
+    /* the common case: bump the pointer in the current block. */
+    if (size <= (size_t)(arena->end - arena->next))
+    {
+        *mem = arena->next;
+        arena->next += size;
+        arena->used += size;
+
+        return STATUS_SUCCESS;
+    }
+
+    return vcservice_arena_allocate_slow(arena, mem, size);
+}
@@ -0,0 +1,76 @@
+/**
+ * \file arena/vcservice_arena_allocate_slow.c
+ *
+ * \brief Allocate arena memory from a block other than the current one.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcservice/error_codes.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Allocate arena memory from a block other than the current one.
+ *
+ * Blocks after the current block are free, since they were only kept from
+ * before the last reset.  The next one is reused if it is large enough.
+ * Otherwise, a new block is mapped and linked in after the current block, so
+ * that the free blocks after it stay available.
+ *
+ * \param arena             The arena for this operation.
+ * \param mem               Pointer to receive the memory on success.
+ * \param size              The size of the allocation, already aligned.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_arena_allocate_slow(
+    vcservice_arena* arena, void** mem, size_t size)
+{
+    status retval;
+    vcservice_arena_block* block = arena->current->next;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+    MODEL_ASSERT(NULL != mem);
+
+    if (NULL == block || block->size - ARENA_BLOCK_HEADER_SIZE < size)
+    {
+        size_t block_size = arena->block_size;
+        if (size > block_size)
+        {
+            block_size = size;
+        }
+
+        if (block_size > SIZE_MAX - ARENA_BLOCK_HEADER_SIZE)
+        {
+            return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+
+        retval =
+            vcservice_arena_block_map(
+                &block, ARENA_BLOCK_HEADER_SIZE + block_size, arena->flags);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        block->next = arena->current->next;
+        arena->current->next = block;
+    }
+
+    /* the remainder of the previous block is given up. */
+    arena->current = block;
+    arena->next = (char*)block + ARENA_BLOCK_HEADER_SIZE;
+    arena->end = (char*)block + block->size;
+
+    *mem = arena->next;
+    arena->next += size;
+    arena->used += size;
+
+    return STATUS_SUCCESS;
+}
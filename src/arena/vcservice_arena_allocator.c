@@ -0,0 +1,38 @@
+/**
+ * \file arena/vcservice_arena_allocator.c
+ *
+ * \brief Get the allocator view of an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Get an \ref allocator backed by a \ref vcservice_arena.
+ *
+ * The allocator can be passed to any interface that takes an allocator, such
+ * as the path and log interfaces.  Reclaiming the most recent allocation
+ * gives its memory back to the arena; reclaiming any other allocation does
+ * nothing, and its memory is recovered at the next reset.  Reallocating the
+ * most recent allocation resizes it in place when its block has room.
+ *
+ * \param arena             The arena for this operation.
+ *
+ * \note The allocator belongs to the arena and lives as long as it does;
+ * releasing its resource handle does nothing.  Memory allocated through it is
+ * invalidated by \ref vcservice_arena_reset, so objects created with it must
+ * be released before the arena is reset.
+ *
+ * \returns the allocator for this arena.
+ */
+RCPR_SYM(allocator)*
+vcservice_arena_allocator(vcservice_arena* arena)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+
+    return &arena->view;
+}
@@ -0,0 +1,91 @@
+/**
+ * \file arena/vcservice_arena_block_map.c
+ *
+ * \brief Map a block of arena memory.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Map a block of arena memory.
+ *
+ * The block is mapped directly rather than taken from the allocator, so that
+ * large blocks do not fragment the heap and so that huge pages can be used.
+ * If no huge pages are reserved, a regular mapping is used instead, and the
+ * kernel is asked to back it with transparent huge pages.
+ *
+ * \param block             Pointer to receive the block on success.
+ * \param size              The minimum size of the block, including its
+ *                          header.
+ * \param flags             Zero or more VCSERVICE_ARENA_FLAG_* values.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_arena_block_map(
+    vcservice_arena_block** block, size_t size, unsigned int flags)
+{
+    void* mem = MAP_FAILED;
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != block);
+
+    if (flags & VCSERVICE_ARENA_FLAG_HUGE_PAGES)
+    {
+        page_size = ARENA_HUGE_PAGE_SIZE;
+    }
+
+    /* round up to a whole number of pages. */
+    if (size > SIZE_MAX - page_size)
+    {
+        return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    size = (size + page_size - 1) & ~(page_size - 1);
+
+#ifdef MAP_HUGETLB
+    if (flags & VCSERVICE_ARENA_FLAG_HUGE_PAGES)
+    {
+        mem =
+            mmap(
+                NULL, size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+
+    if (MAP_FAILED == mem)
+    {
+        mem =
+            mmap(
+                NULL, size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == mem)
+        {
+            return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+
+#ifdef MADV_HUGEPAGE
+        if (flags & VCSERVICE_ARENA_FLAG_HUGE_PAGES)
+        {
+            /* this is only a hint, so its result does not matter. */
+            (void)madvise(mem, size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    *block = (vcservice_arena_block*)mem;
+    (*block)->next = NULL;
+    (*block)->size = size;
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,26 @@
+/**
+ * \file arena/vcservice_arena_block_unmap.c
+ *
+ * \brief Unmap a block of arena memory.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <sys/mman.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Unmap a block of arena memory.
+ *
+ * \param block             The block to unmap.
+ */
+void
+vcservice_arena_block_unmap(vcservice_arena_block* block)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != block);
+
+    munmap(block, block->size);
+}
@@ -0,0 +1,27 @@
+/**
+ * \file arena/vcservice_arena_bytes_used.c
+ *
+ * \brief Get the number of bytes in use in an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Return the number of bytes allocated from a \ref vcservice_arena
+ * since it was created or last reset, including alignment padding.
+ *
+ * \param arena             The arena to query.
+ *
+ * \returns the number of bytes in use.
+ */
+size_t vcservice_arena_bytes_used(const vcservice_arena* arena)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+
+    return arena->used;
+}
@@ -0,0 +1,118 @@
+/**
+ * \file arena/vcservice_arena_create.c
+ *
+ * \brief Create an arena allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "arena_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_arena.
+ *
+ * An arena hands out memory by bumping a pointer through a chain of blocks.
+ * Individual allocations are never reclaimed; instead, the whole arena is
+ * reset at once, such as at the end of a request.  Blocks are kept across a
+ * reset and reused, so an arena that has reached its working size no longer
+ * asks the system for memory.
+ *
+ * \param arena             Pointer to the \ref vcservice_arena pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for the arena instance.
+ *                          Blocks are mapped directly from the system.
+ * \param block_size        The size of each block, or 0 for
+ *                          \ref VCSERVICE_ARENA_DEFAULT_BLOCK_SIZE.  An
+ *                          allocation larger than this gets a block of its
+ *                          own.
+ * \param flags             Zero or more VCSERVICE_ARENA_FLAG_* values.
+ *
+ * \note This \ref vcservice_arena instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  It is not safe to use from more than one
+ * thread at a time.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_arena_create(
+    vcservice_arena** arena, RCPR_SYM(allocator)* alloc, size_t block_size,
+    unsigned int flags)
+{
+    status retval, release_retval;
+    vcservice_arena* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != arena);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+
+    /* runtime parameter checks. */
+    if (NULL == arena || NULL == alloc
+     || (flags & ~VCSERVICE_ARENA_FLAG_HUGE_PAGES))
+    {
+        retval = VCSERVICE_ERROR_ARENA_INVALID_PARAMETER;
+        goto done;
+    }
+
+    if (0 == block_size)
+    {
+        block_size = VCSERVICE_ARENA_DEFAULT_BLOCK_SIZE;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_arena_resource_release);
+    tmp->alloc = alloc;
+    tmp->block_size = block_size;
+    tmp->flags = flags;
+
+    /* initialize the allocator view. */
+    rcpr_allocator_init(
+        &tmp->view, &vcservice_arena_view_resource_release,
+        &vcservice_arena_view_allocate, &vcservice_arena_view_reclaim,
+        &vcservice_arena_view_reallocate);
+
+    /* map the first block, which is never given back until release. */
+    retval =
+        vcservice_arena_block_map(
+            &tmp->head, ARENA_BLOCK_HEADER_SIZE + block_size, flags);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_arena;
+    }
+
+    vcservice_arena_reset(tmp);
+
+    /* success. */
+    *arena = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_arena:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,30 @@
+/**
+ * \file arena/vcservice_arena_reset.c
+ *
+ * \brief Reset an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Reset a \ref vcservice_arena, invalidating every allocation made
+ * from it.
+ *
+ * This takes constant time; the blocks are kept for reuse.
+ *
+ * \param arena             The arena to reset.
+ */
+void vcservice_arena_reset(vcservice_arena* arena)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+
+    arena->current = arena->head;
+    arena->next = (char*)arena->head + ARENA_BLOCK_HEADER_SIZE;
+    arena->end = (char*)arena->head + arena->head->size;
+    arena->used = 0;
+}
@@ -0,0 +1,23 @@
+/**
+ * \file arena/vcservice_arena_resource_handle.c
+ *
+ * \brief Get the resource handle for an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "arena_internal.h"
+
+/**
+ * \brief Given a \ref vcservice_arena instance, return its resource handle.
+ *
+ * \param arena             The \ref vcservice_arena instance from which the
+ *                          resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_arena instance.
+ */
+RCPR_SYM(resource*)
+vcservice_arena_resource_handle(vcservice_arena* arena)
+{
+    return &arena->hdr;
+}
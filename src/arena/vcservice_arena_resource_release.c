@@ -0,0 +1,51 @@
+/**
+ * \file arena/vcservice_arena_resource_release.c
+ *
+ * \brief Release an arena resource.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "arena_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release a \ref vcservice_arena resource.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_arena_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_arena* arena = (vcservice_arena*)r;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = arena->alloc;
+
+    /* unmap every block. */
+    vcservice_arena_block* block = arena->head;
+    while (NULL != block)
+    {
+        vcservice_arena_block* next = block->next;
+        vcservice_arena_block_unmap(block);
+        block = next;
+    }
+
+    /* clear memory. */
+    memset(arena, 0, sizeof(*arena));
+
+    /* reclaim memory. */
+    return rcpr_allocator_reclaim(alloc, arena);
+}
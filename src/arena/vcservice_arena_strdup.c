@@ -0,0 +1,52 @@
+/**
+ * \file arena/vcservice_arena_strdup.c
+ *
+ * \brief Copy a string into an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Copy a string into a \ref vcservice_arena.
+ *
+ * \param out               Pointer to receive the copy on success.
+ * \param arena             The arena for this operation.
+ * \param str               The string to copy.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_arena_strdup(char** out, vcservice_arena* arena, const char* str)
+{
+    status retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != out);
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+    MODEL_ASSERT(NULL != str);
+
+    /* runtime parameter checks. */
+    if (NULL == out || NULL == arena || NULL == str)
+    {
+        return VCSERVICE_ERROR_ARENA_INVALID_PARAMETER;
+    }
+
+    size_t size = strlen(str) + 1;
+    retval = vcservice_arena_allocate(arena, (void**)out, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memcpy(*out, str, size);
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,58 @@
+/**
+ * \file arena/vcservice_arena_view_allocate.c
+ *
+ * \brief Allocate memory through the allocator view of an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcservice/error_codes.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Allocate memory through the allocator view of a
+ * \ref vcservice_arena.
+ *
+ * The size is stored ahead of the memory, so that it can be reallocated.
+ *
+ * \param alloc             The allocator view.
+ * \param mem               Pointer to receive the memory on success.
+ * \param size              The size of the allocation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_arena_view_allocate(
+    RCPR_SYM(allocator)* alloc, void** mem, size_t size)
+{
+    status retval;
+    size_t* header;
+    vcservice_arena* arena = ARENA_OF_VIEW(alloc);
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+    MODEL_ASSERT(NULL != mem);
+
+    /* guard against overflow when adding the header. */
+    if (size > SIZE_MAX - ARENA_VIEW_HEADER_SIZE)
+    {
+        return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    retval =
+        vcservice_arena_allocate(
+            arena, (void**)&header, ARENA_VIEW_HEADER_SIZE + size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    *header = size;
+    *mem = (char*)header + ARENA_VIEW_HEADER_SIZE;
+
+    return STATUS_SUCCESS;
+}
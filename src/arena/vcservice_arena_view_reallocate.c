@@ -0,0 +1,75 @@
+/**
+ * \file arena/vcservice_arena_view_reallocate.c
+ *
+ * \brief Reallocate memory through the allocator view of an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Reallocate memory through the allocator view of a
+ * \ref vcservice_arena.
+ *
+ * The most recent allocation is resized in place if its block has room.
+ * Otherwise, the contents are copied to a new allocation, and the old memory
+ * is recovered when the arena is reset.
+ *
+ * \param alloc             The allocator view.
+ * \param mem               Pointer to the memory to reallocate, updated on
+ *                          success.
+ * \param size              The new size of the allocation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_arena_view_reallocate(
+    RCPR_SYM(allocator)* alloc, void** mem, size_t size)
+{
+    status retval;
+    void* tmp;
+    vcservice_arena* arena = ARENA_OF_VIEW(alloc);
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+    MODEL_ASSERT(NULL != mem && NULL != *mem);
+
+    char* old = (char*)*mem;
+    size_t* header = (size_t*)(old - ARENA_VIEW_HEADER_SIZE);
+    size_t old_size = *header;
+
+    /* guard against overflow when rounding up. */
+    if (size > SIZE_MAX - ARENA_VIEW_HEADER_SIZE - VCSERVICE_ARENA_ALIGNMENT)
+    {
+        return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* the most recent allocation can be resized in place. */
+    if (old + ARENA_ALIGN(old_size) == arena->next
+     && ARENA_ALIGN(size) <= (size_t)(arena->end - old))
+    {
+        arena->next = old + ARENA_ALIGN(size);
+        arena->used = arena->used - ARENA_ALIGN(old_size) + ARENA_ALIGN(size);
+        *header = size;
+
+        return STATUS_SUCCESS;
+    }
+
+    retval = vcservice_arena_view_allocate(alloc, &tmp, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memcpy(tmp, old, old_size < size ? old_size : size);
+    *mem = tmp;
+
+    return STATUS_SUCCESS;
+}
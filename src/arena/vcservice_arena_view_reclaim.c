@@ -0,0 +1,44 @@
+/**
+ * \file arena/vcservice_arena_view_reclaim.c
+ *
+ * \brief Reclaim memory through the allocator view of an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "arena_internal.h"
+
+/**
+ * \brief Reclaim memory through the allocator view of a \ref vcservice_arena.
+ *
+ * Only the most recent allocation can be given back; other memory is
+ * recovered when the arena is reset.
+ *
+ * \param alloc             The allocator view.
+ * \param mem               The memory to reclaim.
+ *
+ * \returns STATUS_SUCCESS.
+ */
+status
+vcservice_arena_view_reclaim(
+    RCPR_SYM(allocator)* alloc, void* mem)
+{
+    vcservice_arena* arena = ARENA_OF_VIEW(alloc);
+    char* header = (char*)mem - ARENA_VIEW_HEADER_SIZE;
+    size_t size = ARENA_ALIGN(*(size_t*)header);
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_arena_valid(arena));
+    MODEL_ASSERT(NULL != mem);
+
+    /* rewind the bump pointer over the most recent allocation. */
+    if ((char*)mem + size == arena->next)
+    {
+        arena->next = header;
+        arena->used -= ARENA_VIEW_HEADER_SIZE + size;
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,27 @@
+/**
+ * \file arena/vcservice_arena_view_resource_release.c
+ *
+ * \brief Release the allocator view of an arena.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "arena_internal.h"
+
+/**
+ * \brief Release the allocator view of a \ref vcservice_arena.
+ *
+ * The view is part of the arena, so this does nothing.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns STATUS_SUCCESS.
+ */
+status
+vcservice_arena_view_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    (void)r;
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/**
+ * \file histogram/histogram_internal.h
+ *
+ * \brief Internal header for the latency histogram.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <rcpr/resource/protected.h>
+#include <vcservice/histogram.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+#define HISTOGRAM_SHARD_COUNT           8
+#define HISTOGRAM_SUB_BUCKET_COUNT \
+    (1 << VCSERVICE_HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_SUB_BUCKET_HALF       (HISTOGRAM_SUB_BUCKET_COUNT / 2)
+
+/**
+ * \brief One shard of a histogram's counts.  Every field is updated
+ * atomically.  The padding keeps the hot fields of neighboring shards on
+ * separate cache lines.
+ */
+typedef struct vcservice_histogram_shard vcservice_histogram_shard;
+
+struct vcservice_histogram_shard
+{
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint64_t counts[VCSERVICE_HISTOGRAM_BUCKET_COUNT];
+    char pad[64];
+};
+
+struct vcservice_histogram
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    vcservice_histogram_shard* shards;
+};
+
+struct vcservice_histogram_reporter
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    vcservice_histogram* histogram;
+    char* name;
+    vcservice_log* log;
+    unsigned int log_level;
+    unsigned int interval_ms;
+    vcservice_histogram_snapshot* snapshot;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t thread;
+    bool stop;
+};
+
+extern unsigned int vcservice_histogram_next_shard;
+extern __thread unsigned int vcservice_histogram_thread_shard;
+
+/**
+ * \brief Get the bucket holding the given value.
+ *
+ * Values below \ref HISTOGRAM_SUB_BUCKET_COUNT have a bucket each.  Above
+ * that, each power of two is split into \ref HISTOGRAM_SUB_BUCKET_HALF
+ * buckets by the value's leading bits.
+ *
+ * \param value             The value.
+ *
+ * \returns the bucket index.
+ */
+static inline size_t vcservice_histogram_bucket_index(uint64_t value)
+{
+    if (value < HISTOGRAM_SUB_BUCKET_COUNT)
+    {
+        return (size_t)value;
+    }
+
+    unsigned int shift =
+        63 - (unsigned int)__builtin_clzll(value)
+            - (VCSERVICE_HISTOGRAM_SUB_BUCKET_BITS - 1);
+
+    return
+        HISTOGRAM_SUB_BUCKET_COUNT
+            + (size_t)(shift - 1) * HISTOGRAM_SUB_BUCKET_HALF
+            + (size_t)(value >> shift) - HISTOGRAM_SUB_BUCKET_HALF;
+}
+
+/**
+ * \brief Get the largest value held by the given bucket.
+ *
+ * \param index             The bucket index.
+ *
+ * \returns the largest value in the bucket.
+ */
+uint64_t
+vcservice_histogram_bucket_max(size_t index);
+
+status
+vcservice_histogram_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+vcservice_histogram_reporter_resource_release(
+    RCPR_SYM(resource)* r);
+
+/**
+ * \brief Entry point for the reporter's background thread.
+ *
+ * \param context           The \ref vcservice_histogram_reporter for this
+ *                          thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_histogram_reporter_thread_run(void* context);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
@@ -0,0 +1,35 @@
+/**
+ * \file histogram/vcservice_histogram_bucket_max.c
+ *
+ * \brief Get the largest value held by a histogram bucket.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "histogram_internal.h"
+
+/**
+ * \brief Get the largest value held by the given bucket.
+ *
+ * \param index             The bucket index.
+ *
+ * \returns the largest value in the bucket.
+ */
+uint64_t
+vcservice_histogram_bucket_max(size_t index)
+{
+    if (index < HISTOGRAM_SUB_BUCKET_COUNT)
+    {
+        return (uint64_t)index;
+    }
+
+    index -= HISTOGRAM_SUB_BUCKET_COUNT;
+
+    unsigned int shift = (unsigned int)(index / HISTOGRAM_SUB_BUCKET_HALF) + 1;
+    uint64_t leading =
+        (uint64_t)(index % HISTOGRAM_SUB_BUCKET_HALF)
+            + HISTOGRAM_SUB_BUCKET_HALF;
+
+    /* the top bucket ends at UINT64_MAX. */
+    return ((leading + 1) << shift) - 1;
+}
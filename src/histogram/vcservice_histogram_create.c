@@ -0,0 +1,91 @@
+/**
+ * \file histogram/vcservice_histogram_create.c
+ *
+ * \brief Create a latency histogram.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "histogram_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_histogram.
+ *
+ * \param histogram         Pointer to the \ref vcservice_histogram pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for this histogram.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER if a parameter is NULL.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_histogram_create(
+    vcservice_histogram** histogram, RCPR_SYM(allocator)* alloc)
+{
+    status retval, release_retval;
+    vcservice_histogram* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != histogram);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+
+    /* runtime parameter checks. */
+    if (NULL == histogram || NULL == alloc)
+    {
+        return VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->alloc = alloc;
+
+    /* allocate the shards. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp->shards,
+            HISTOGRAM_SHARD_COUNT * sizeof(vcservice_histogram_shard));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_memory;
+    }
+
+    memset(
+        tmp->shards, 0,
+        HISTOGRAM_SHARD_COUNT * sizeof(vcservice_histogram_shard));
+    for (size_t i = 0; i < HISTOGRAM_SHARD_COUNT; ++i)
+    {
+        tmp->shards[i].min = UINT64_MAX;
+    }
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_histogram_resource_release);
+
+    /* success. */
+    *histogram = tmp;
+    return STATUS_SUCCESS;
+
+cleanup_memory:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
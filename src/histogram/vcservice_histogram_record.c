@@ -0,0 +1,61 @@
+/**
+ * \file histogram/vcservice_histogram_record.c
+ *
+ * \brief Record a value in a latency histogram.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "histogram_internal.h"
+
+/**
+ * \brief Record a value in a \ref vcservice_histogram.
+ *
+ * \param histogram         The histogram for this operation.
+ * \param value             The value to record.
+ */
+void
+vcservice_histogram_record(vcservice_histogram* histogram, uint64_t value)
+{
+    vcservice_histogram_shard* shard;
+    unsigned int index = vcservice_histogram_thread_shard;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_histogram_valid(histogram));
+
+    /* assign threads to shards in turn on their first value. */
+    if (0 == index)
+    {
+        index =
+            __atomic_fetch_add(
+                &vcservice_histogram_next_shard, 1, __ATOMIC_RELAXED)
+            % HISTOGRAM_SHARD_COUNT + 1;
+        vcservice_histogram_thread_shard = index;
+    }
+
+    shard = &histogram->shards[index - 1];
+
+    __atomic_fetch_add(
+        &shard->counts[vcservice_histogram_bucket_index(value)], 1,
+        __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shard->sum, value, __ATOMIC_RELAXED);
+
+    /* the extremes rarely change, so only then is a CAS needed. */
+    uint64_t current = __atomic_load_n(&shard->max, __ATOMIC_RELAXED);
+    while (value > current
+        && !__atomic_compare_exchange_n(
+                &shard->max, &current, value, true, __ATOMIC_RELAXED,
+                __ATOMIC_RELAXED))
+    {
+    }
+
+    current = __atomic_load_n(&shard->min, __ATOMIC_RELAXED);
+    while (value < current
+        && !__atomic_compare_exchange_n(
+                &shard->min, &current, value, true, __ATOMIC_RELAXED,
+                __ATOMIC_RELAXED))
+    {
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * \file histogram/vcservice_histogram_report.c
+ *
+ * \brief Log a summary of a histogram snapshot.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "histogram_internal.h"
+
+/**
+ * \brief The percentiles in each summary.
+ */
+static const struct
+{
+    const char* label;
+    double percentile;
+} percentiles[] = {
+    { " p50=", 50.0 },
+    { " p90=", 90.0 },
+    { " p99=", 99.0 },
+    { " p999=", 99.9 },
+};
+
+/**
+ * \brief Log a summary of a snapshot.
+ *
+ * The summary is one message holding the name, then the count, min, mean,
+ * p50, p90, p99, p999, and max.
+ *
+ * \param log               The logger to write to.
+ * \param log_level         The level of the message.
+ * \param name              The name of the histogram.
+ * \param snapshot          The snapshot to summarize.
+ */
+void
+vcservice_histogram_report(
+    vcservice_log* log, unsigned int log_level, const char* name,
+    const vcservice_histogram_snapshot* snapshot)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != log);
+    MODEL_ASSERT(NULL != name);
+    MODEL_ASSERT(NULL != snapshot);
+
+    /* the percentile walks are skipped if the message would be dropped. */
+    if (!vcservice_log_level_enabled(log, log_level))
+    {
+        return;
+    }
+
+    uint64_t count = snapshot->count;
+    uint64_t min = 0 == count ? 0 : snapshot->min;
+    uint64_t mean = 0 == count ? 0 : snapshot->sum / count;
+
+    /* the log macros need a constant level, so the message is built here. */
+    vcservice_log_message_start(log);
+    vcservice_log_append_log_level(log, log_level);
+    vcservice_log_append_string(log, name);
+    vcservice_log_append_string(log, ": count=");
+    vcservice_log_append_uint64(log, count);
+    vcservice_log_append_string(log, " min=");
+    vcservice_log_append_uint64(log, min);
+    vcservice_log_append_string(log, " mean=");
+    vcservice_log_append_uint64(log, mean);
+
+    for (size_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); ++i)
+    {
+        vcservice_log_append_string(log, percentiles[i].label);
+        vcservice_log_append_uint64(
+            log,
+            vcservice_histogram_snapshot_percentile(
+                snapshot, percentiles[i].percentile));
+    }
+
+    vcservice_log_append_string(log, " max=");
+    vcservice_log_append_uint64(log, snapshot->max);
+    vcservice_log_message_commit(log);
+}
@@ -0,0 +1,149 @@
+/**
+ * \file histogram/vcservice_histogram_reporter_create.c
+ *
+ * \brief Create a reporter that periodically logs a histogram summary.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "histogram_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_histogram_reporter, which periodically logs
+ * a summary of a histogram.
+ *
+ * Every \p interval_ms milliseconds, a background thread takes a snapshot of
+ * the histogram, clearing it, and logs its summary with
+ * \ref vcservice_histogram_report.  Intervals in which nothing was recorded
+ * are not logged.  A last summary is logged when the reporter is released.
+ *
+ * \param reporter          Pointer to the \ref vcservice_histogram_reporter
+ *                          pointer to receive this resource on success.
+ * \param alloc             The allocator to use for this reporter.
+ * \param histogram         The histogram to report, which must outlive the
+ *                          reporter.
+ * \param name              The name to report the histogram under, which is
+ *                          copied.
+ * \param log               The logger to write to, which must outlive the
+ *                          reporter.  A logger is not safe to use from two
+ *                          threads at once, so this should be a logger that
+ *                          only the reporter uses.
+ * \param log_level         The level of the summary messages.
+ * \param interval_ms       The reporting interval in milliseconds.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER if a parameter is NULL or
+ *        the interval is 0.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_histogram_reporter_create(
+    vcservice_histogram_reporter** reporter, RCPR_SYM(allocator)* alloc,
+    vcservice_histogram* histogram, const char* name, vcservice_log* log,
+    unsigned int log_level, unsigned int interval_ms)
+{
+    status retval, release_retval;
+    vcservice_histogram_reporter* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != reporter);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(prop_vcservice_histogram_valid(histogram));
+    MODEL_ASSERT(NULL != name);
+    MODEL_ASSERT(NULL != log);
+
+    /* runtime parameter checks. */
+    if (NULL == reporter || NULL == alloc || NULL == histogram || NULL == name
+     || NULL == log || 0 == interval_ms)
+    {
+        return VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->alloc = alloc;
+    tmp->histogram = histogram;
+    tmp->log = log;
+    tmp->log_level = log_level;
+    tmp->interval_ms = interval_ms;
+
+    /* copy the name. */
+    size_t name_size = strlen(name) + 1;
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp->name, name_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_memory;
+    }
+
+    memcpy(tmp->name, name, name_size);
+
+    /* the snapshot is too large for the background thread's stack. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp->snapshot, sizeof(*tmp->snapshot));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_name;
+    }
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_histogram_reporter_resource_release);
+
+    /* start the background thread. */
+    pthread_mutex_init(&tmp->mutex, NULL);
+    pthread_cond_init(&tmp->cond, NULL);
+    if (0 != pthread_create(
+                &tmp->thread, NULL, &vcservice_histogram_reporter_thread_run,
+                tmp))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_THREAD_CREATE;
+        goto cleanup_snapshot;
+    }
+
+    /* success. */
+    *reporter = tmp;
+    return STATUS_SUCCESS;
+
+cleanup_snapshot:
+    pthread_cond_destroy(&tmp->cond);
+    pthread_mutex_destroy(&tmp->mutex);
+
+    release_retval = rcpr_allocator_reclaim(alloc, tmp->snapshot);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_name:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp->name);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_memory:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
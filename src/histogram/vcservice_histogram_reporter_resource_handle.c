@@ -0,0 +1,26 @@
+/**
+ * \file histogram/vcservice_histogram_reporter_resource_handle.c
+ *
+ * \brief Get the resource handle for a histogram reporter.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "histogram_internal.h"
+
+/**
+ * \brief Given a \ref vcservice_histogram_reporter instance, return its
+ * resource handle.
+ *
+ * \param reporter          The \ref vcservice_histogram_reporter instance from
+ *                          which the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_histogram_reporter
+ * instance.
+ */
+RCPR_SYM(resource*)
+vcservice_histogram_reporter_resource_handle(
+    vcservice_histogram_reporter* reporter)
+{
+    return &reporter->hdr;
+}
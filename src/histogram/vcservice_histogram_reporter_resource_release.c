@@ -0,0 +1,72 @@
+/**
+ * \file histogram/vcservice_histogram_reporter_resource_release.c
+ *
+ * \brief Release a histogram reporter.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "histogram_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release a \ref vcservice_histogram_reporter, logging a last summary.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_histogram_reporter_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_histogram_reporter* reporter = (vcservice_histogram_reporter*)r;
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_histogram_reporter_valid(reporter));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = reporter->alloc;
+
+    /* let the background thread log the last interval. */
+    pthread_mutex_lock(&reporter->mutex);
+    reporter->stop = true;
+    pthread_cond_signal(&reporter->cond);
+    pthread_mutex_unlock(&reporter->mutex);
+    pthread_join(reporter->thread, NULL);
+
+    pthread_cond_destroy(&reporter->cond);
+    pthread_mutex_destroy(&reporter->mutex);
+
+    reclaim_retval = rcpr_allocator_reclaim(alloc, reporter->snapshot);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    reclaim_retval = rcpr_allocator_reclaim(alloc, reporter->name);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    /* clear memory. */
+    memset(reporter, 0, sizeof(*reporter));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, reporter);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
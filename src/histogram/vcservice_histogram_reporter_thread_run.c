@@ -0,0 +1,71 @@
+/**
+ * \file histogram/vcservice_histogram_reporter_thread_run.c
+ *
+ * \brief Background thread for the histogram reporter.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <time.h>
+
+#include "histogram_internal.h"
+
+/**
+ * \brief Entry point for the reporter's background thread.
+ *
+ * \param context           The \ref vcservice_histogram_reporter for this
+ *                          thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_histogram_reporter_thread_run(void* context)
+{
+    vcservice_histogram_reporter* reporter =
+        (vcservice_histogram_reporter*)context;
+    struct timespec deadline;
+    bool stopping;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    pthread_mutex_lock(&reporter->mutex);
+
+    for (;;)
+    {
+        /* intervals are measured from the start, so reports do not drift. */
+        deadline.tv_sec += reporter->interval_ms / 1000;
+        deadline.tv_nsec += (long)(reporter->interval_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000000000;
+        }
+
+        while (!reporter->stop
+            && 0 == pthread_cond_timedwait(
+                        &reporter->cond, &reporter->mutex, &deadline))
+        {
+        }
+
+        stopping = reporter->stop;
+        pthread_mutex_unlock(&reporter->mutex);
+
+        vcservice_histogram_snapshot_take(
+            reporter->snapshot, reporter->histogram, true);
+        if (reporter->snapshot->count > 0)
+        {
+            vcservice_histogram_report(
+                reporter->log, reporter->log_level, reporter->name,
+                reporter->snapshot);
+        }
+
+        if (stopping)
+        {
+            break;
+        }
+
+        pthread_mutex_lock(&reporter->mutex);
+    }
+
+    return NULL;
+}
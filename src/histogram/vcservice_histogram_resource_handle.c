@@ -0,0 +1,24 @@
+/**
+ * \file histogram/vcservice_histogram_resource_handle.c
+ *
+ * \brief Get the resource handle for a latency histogram.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "histogram_internal.h"
+
+/**
+ * \brief Given a \ref vcservice_histogram instance, return its resource
+ * handle.
+ *
+ * \param histogram         The \ref vcservice_histogram instance from which
+ *                          the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_histogram instance.
+ */
+RCPR_SYM(resource*)
+vcservice_histogram_resource_handle(vcservice_histogram* histogram)
+{
+    return &histogram->hdr;
+}
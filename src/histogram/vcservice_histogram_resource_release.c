@@ -0,0 +1,52 @@
+/**
+ * \file histogram/vcservice_histogram_resource_release.c
+ *
+ * \brief Release a latency histogram.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "histogram_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release a \ref vcservice_histogram.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_histogram_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_histogram* histogram = (vcservice_histogram*)r;
+    status shards_retval, reclaim_retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_histogram_valid(histogram));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = histogram->alloc;
+
+    shards_retval = rcpr_allocator_reclaim(alloc, histogram->shards);
+
+    /* clear memory. */
+    memset(histogram, 0, sizeof(*histogram));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, histogram);
+
+    if (STATUS_SUCCESS != shards_retval)
+    {
+        return shards_retval;
+    }
+
+    return reclaim_retval;
+}
@@ -0,0 +1,45 @@
+/**
+ * \file histogram/vcservice_histogram_snapshot_merge.c
+ *
+ * \brief Add the counts of one histogram snapshot to another.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "histogram_internal.h"
+
+/**
+ * \brief Add the counts of one snapshot to another.
+ *
+ * \param dest              The snapshot to add to.
+ * \param src               The snapshot to add.
+ */
+void
+vcservice_histogram_snapshot_merge(
+    vcservice_histogram_snapshot* dest,
+    const vcservice_histogram_snapshot* src)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != dest);
+    MODEL_ASSERT(NULL != src);
+
+    for (size_t i = 0; i < VCSERVICE_HISTOGRAM_BUCKET_COUNT; ++i)
+    {
+        dest->counts[i] += src->counts[i];
+    }
+
+    dest->count += src->count;
+    dest->sum += src->sum;
+
+    if (src->min < dest->min)
+    {
+        dest->min = src->min;
+    }
+
+    if (src->max > dest->max)
+    {
+        dest->max = src->max;
+    }
+}
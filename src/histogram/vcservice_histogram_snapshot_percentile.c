@@ -0,0 +1,69 @@
+/**
+ * \file histogram/vcservice_histogram_snapshot_percentile.c
+ *
+ * \brief Get the value at a percentile of a histogram snapshot.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "histogram_internal.h"
+
+/**
+ * \brief Get the value at the given percentile of a snapshot.
+ *
+ * \param snapshot          The snapshot to query.
+ * \param percentile        The percentile, from 0 to 100.
+ *
+ * \returns the largest value in the bucket holding the given percentile,
+ * capped at the largest value recorded, or 0 if the snapshot is empty.
+ */
+uint64_t
+vcservice_histogram_snapshot_percentile(
+    const vcservice_histogram_snapshot* snapshot, double percentile)
+{
+    uint64_t target, seen = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != snapshot);
+
+    if (0 == snapshot->count)
+    {
+        return 0;
+    }
+
+    /* the rank of the value at this percentile, counting from 1. */
+    if (percentile >= 100.0)
+    {
+        target = snapshot->count;
+    }
+    else
+    {
+        double rank = percentile / 100.0 * (double)snapshot->count;
+        target = (uint64_t)rank;
+        if ((double)target < rank)
+        {
+            target += 1;
+        }
+    }
+
+    if (target < 1)
+    {
+        target = 1;
+    }
+
+    for (size_t i = 0; i < VCSERVICE_HISTOGRAM_BUCKET_COUNT; ++i)
+    {
+        seen += snapshot->counts[i];
+        if (seen >= target)
+        {
+            uint64_t value = vcservice_histogram_bucket_max(i);
+
+            return value < snapshot->max ? value : snapshot->max;
+        }
+    }
+
+    /* the counts were read while values were still being recorded. */
+    return snapshot->max;
+}
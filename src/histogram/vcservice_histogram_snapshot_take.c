@@ -0,0 +1,90 @@
+/**
+ * \file histogram/vcservice_histogram_snapshot_take.c
+ *
+ * \brief Copy the counts of a latency histogram into a snapshot.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "histogram_internal.h"
+
+static uint64_t read_value(uint64_t* value, uint64_t reset_value, bool reset);
+
+/**
+ * \brief Copy the counts of a \ref vcservice_histogram into a snapshot.
+ *
+ * The counts are read without stopping other threads.  With \p reset, each
+ * count is read and cleared atomically, so no value is lost or counted in two
+ * intervals, although the min, max, and sum of a value recorded during the
+ * snapshot may land in the next interval.
+ *
+ * \param snapshot          The snapshot to fill in.
+ * \param histogram         The histogram to read.
+ * \param reset             If true, clear the histogram as it is read.
+ */
+void
+vcservice_histogram_snapshot_take(
+    vcservice_histogram_snapshot* snapshot, vcservice_histogram* histogram,
+    bool reset)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != snapshot);
+    MODEL_ASSERT(prop_vcservice_histogram_valid(histogram));
+
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->min = UINT64_MAX;
+
+    for (size_t i = 0; i < HISTOGRAM_SHARD_COUNT; ++i)
+    {
+        vcservice_histogram_shard* shard = &histogram->shards[i];
+
+        for (size_t j = 0; j < VCSERVICE_HISTOGRAM_BUCKET_COUNT; ++j)
+        {
+            /* most buckets are empty, so skip the write when they are. */
+            if (0 == __atomic_load_n(&shard->counts[j], __ATOMIC_RELAXED))
+            {
+                continue;
+            }
+
+            uint64_t count = read_value(&shard->counts[j], 0, reset);
+            snapshot->counts[j] += count;
+            snapshot->count += count;
+        }
+
+        snapshot->sum += read_value(&shard->sum, 0, reset);
+
+        uint64_t min = read_value(&shard->min, UINT64_MAX, reset);
+        if (min < snapshot->min)
+        {
+            snapshot->min = min;
+        }
+
+        uint64_t max = read_value(&shard->max, 0, reset);
+        if (max > snapshot->max)
+        {
+            snapshot->max = max;
+        }
+    }
+}
+
+/**
+ * \brief Read a shard value, optionally replacing it with its reset value.
+ *
+ * \param value             The value to read.
+ * \param reset_value       The value to replace it with.
+ * \param reset             If true, replace the value.
+ *
+ * \returns the value read.
+ */
+static uint64_t read_value(uint64_t* value, uint64_t reset_value, bool reset)
+{
+    if (reset)
+    {
+        return __atomic_exchange_n(value, reset_value, __ATOMIC_RELAXED);
+    }
+
+    return __atomic_load_n(value, __ATOMIC_RELAXED);
+}
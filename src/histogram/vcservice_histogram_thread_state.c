@@ -0,0 +1,19 @@
+/**
+ * \file histogram/vcservice_histogram_thread_state.c
+ *
+ * \brief Histogram shard assignment.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "histogram_internal.h"
+
+/**
+ * \brief The shard assigned to the next thread that records a value.
+ */
+unsigned int vcservice_histogram_next_shard = 0;
+
+/**
+ * \brief This thread's shard, plus one, or 0 if it has not been assigned.
+ */
+__thread unsigned int vcservice_histogram_thread_shard = 0;
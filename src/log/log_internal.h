@@ -8,8 +8,14 @@
 
 #pragma once
 
+#include <pthread.h>
 #include <rcpr/resource/protected.h>
+#include <sys/types.h>
+#include <time.h>
+#include <sys/un.h>
+#include <vccrypt/suite.h>
 #include <vcservice/log.h>
+#include <vpr/allocator/malloc_allocator.h>
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
@@ -22,6 +28,147 @@ extern "C" {
 #define LOG_BITS_FORMAT_HEX             0x00000001
 #define LOG_BITS_FORMAT_DEFAULT         0x00000000
 
+#define LOG_DTOA_BUFFER_SIZE            32
+#define LOG_UUID_TEXT_SIZE              36
+
+#define LOG_REDACTOR_MAX_STATES         UINT16_MAX
+#define LOG_REDACTOR_MAX_SCAN_PAIRS     8
+
+#define LOG_AUDIT_CHAIN_SIZE            64
+#define LOG_AUDIT_QUEUE_LIMIT           (1024 * 1024)
+#define LOG_AUDIT_RECORD_HEADER_SIZE    (2 + 16 + 1 + 8 + 1 + 128 + 1)
+#define LOG_AUDIT_CHECKPOINT_SIZE       (2 + 16 + 1 + 128 + 1)
+
+#define LOG_SEGMENT_QUEUE_DEPTH         4
+#define LOG_SEGMENT_MAGIC               "VCLOGSG1"
+#define LOG_SEGMENT_MAGIC_SIZE          8
+#define LOG_SEGMENT_MAX_SIGNATURE_SIZE  128
+#define LOG_SEGMENT_TRAILER_FIXED_SIZE  (8 + 8 + LOG_SEGMENT_MAGIC_SIZE)
+#define LOG_SEGMENT_NAME_SUFFIX_SIZE    (1 + 20 + 1)
+
+#define LOG_ENCRYPTED_MAGIC             "VCLOGEN1"
+#define LOG_ENCRYPTED_MAGIC_SIZE        8
+#define LOG_ENCRYPTED_SALT_SIZE         16
+#define LOG_ENCRYPTED_HEADER_SIZE \
+    (LOG_ENCRYPTED_MAGIC_SIZE + LOG_ENCRYPTED_SALT_SIZE + 4)
+#define LOG_ENCRYPTED_MAX_WORKERS       16
+#define LOG_ENCRYPTED_IV_SIZE           8
+#define LOG_ENCRYPTED_FLUSH_INTERVAL_MS 1000
+
+#define LOG_ENCRYPTED_SLOT_FREE         0
+#define LOG_ENCRYPTED_SLOT_READY        1
+#define LOG_ENCRYPTED_SLOT_DONE         2
+
+#define LOG_SPOOL_QUEUE_LIMIT           (1024 * 1024)
+#define LOG_SPOOL_REPLAY_CHUNK_SIZE     (64 * 1024)
+#define LOG_SPOOL_RETRY_MS              250
+#define LOG_SPOOL_REPLAY_WAIT_MS        10
+
+#define LOG_LEVEL_COUNT                 (VCSERVICE_LOGLEVEL_DEBUG + 1)
+#define LOG_LEVEL_NAME_SIZE             9
+
+#define LOG_SCOPE_BUFFER_SIZE           (16 * 1024)
+#define LOG_SCOPE_ENTRY_HEADER_SIZE     8
+
+#define LOG_LAYOUT_OP_LITERAL           0
+#define LOG_LAYOUT_OP_DATE              1
+#define LOG_LAYOUT_OP_TIME              2
+#define LOG_LAYOUT_OP_MICROSECONDS      3
+#define LOG_LAYOUT_OP_LEVEL             4
+#define LOG_LAYOUT_OP_CONTEXT           5
+#define LOG_LAYOUT_OP_THREAD            6
+#define LOG_LAYOUT_OP_MESSAGE           7
+#define LOG_LAYOUT_DATE_SIZE            10
+#define LOG_LAYOUT_TIME_SIZE            8
+#define LOG_LAYOUT_LEVEL_SIZE           (LOG_LEVEL_NAME_SIZE - 1)
+
+/**
+ * \brief Bounds of the call site section, provided by the linker.
+ *
+ * These are weak so that a program without any log call sites still links.
+ */
+extern vcservice_log_callsite __start_vcservice_log_callsites[]
+    __attribute__((weak));
+extern vcservice_log_callsite __stop_vcservice_log_callsites[]
+    __attribute__((weak));
+
+/**
+ * \brief The request scope state of a log instance.
+ *
+ * Buffered messages live in data[start, end), each as its uint32_t level,
+ * its uint32_t size, and its text.  The data allocation is followed by
+ * MAX_LOG_MESSAGE_SIZE bytes used to hold the current message while the
+ * buffer is flushed.
+ */
+typedef struct vcservice_log_scope vcservice_log_scope;
+
+struct vcservice_log_scope
+{
+    char* data;
+    size_t start;
+    size_t end;
+    unsigned int depth;
+    unsigned int capture_level;
+};
+
+/**
+ * \brief One instruction of a compiled layout.  A literal copies size bytes
+ * from offset in the layout's literal pool; the other ops emit a field.
+ */
+typedef struct vcservice_log_layout_op vcservice_log_layout_op;
+
+struct vcservice_log_layout_op
+{
+    uint16_t code;
+    uint16_t offset;
+    uint16_t size;
+};
+
+/**
+ * \brief A compiled layout.  The ops and the literal pool follow the
+ * structure in the same allocation.  The date and time text is cached for
+ * the second in cached_second, so most messages skip localtime_r.
+ */
+typedef struct vcservice_log_layout vcservice_log_layout;
+
+struct vcservice_log_layout
+{
+    vcservice_log_layout_op* ops;
+    size_t op_count;
+    const char* literals;
+    time_t cached_second;
+    char cached_date[LOG_LAYOUT_DATE_SIZE];
+    char cached_time[LOG_LAYOUT_TIME_SIZE];
+    char scratch[MAX_LOG_MESSAGE_SIZE];
+};
+
+/**
+ * \brief The trace context that is current on this thread.
+ */
+extern __thread vcservice_log_trace_context* vcservice_log_trace_current;
+
+/**
+ * \brief The level names, by log level and then for an unknown level, each
+ * padded with spaces to \ref LOG_LEVEL_NAME_SIZE.
+ */
+extern const char
+vcservice_log_level_names[LOG_LEVEL_COUNT + 1][LOG_LEVEL_NAME_SIZE + 1];
+
+/**
+ * \brief Get the padded name of a log level.
+ *
+ * \param level         The log level.
+ *
+ * \returns the \ref LOG_LEVEL_NAME_SIZE byte name, which is also
+ * zero-terminated.
+ */
+static inline const char* vcservice_log_level_name(unsigned int level)
+{
+    return
+        vcservice_log_level_names[
+            level < LOG_LEVEL_COUNT ? level : LOG_LEVEL_COUNT];
+}
+
 /**
  * \brief The log instance.
  */
@@ -32,15 +179,263 @@ struct vcservice_log
     unsigned int threshold_level;
     RCPR_SYM(resource)* user_context;
     unsigned int log_level;
+    bool log_callsite_enabled;
     char log_message[MAX_LOG_MESSAGE_SIZE];
     size_t log_idx;
     uint32_t log_bits;
+    vcservice_log_redactor* redactor;
+    vcservice_log_scope scope;
+    vcservice_log_stats stats;
+    vcservice_log_layout* layout;
 
     void (*log_write_cb)(
         vcservice_log* log, unsigned int log_level,
         RCPR_SYM(resource)* user_contex);
 };
 
+/**
+ * \brief Count a message handed to the log's sink.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param level         The level of the message.
+ * \param size          The size of the message.
+ */
+static inline void vcservice_log_stats_written(
+    vcservice_log* log, unsigned int level, size_t size)
+{
+    if (level < VCSERVICE_LOG_STATS_LEVEL_COUNT)
+    {
+        __atomic_fetch_add(&log->stats.messages[level], 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&log->stats.bytes, size, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * \brief Count messages that the log dropped.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param count         The number of messages dropped.
+ */
+static inline void vcservice_log_stats_dropped(
+    vcservice_log* log, uint64_t count)
+{
+    __atomic_fetch_add(&log->stats.dropped, count, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief The log redactor.  The token prefixes are compiled into an
+ * Aho-Corasick automaton over byte classes, with a bitmap of the byte pairs
+ * that can start a match; see \ref vcservice_log_redactor_compile.
+ */
+struct vcservice_log_redactor
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    char** patterns;
+    size_t pattern_count;
+    uint8_t byte_class[256];
+    uint8_t start_pairs[256 * 256 / 8];
+    uint8_t scan_pairs[LOG_REDACTOR_MAX_SCAN_PAIRS][2];
+    size_t scan_pair_count;
+    size_t class_count;
+    size_t state_count;
+    uint16_t* transitions;
+    uint8_t* accept;
+};
+
+/**
+ * \brief A growable byte buffer used by the log sinks.
+ */
+typedef struct vcservice_log_buffer vcservice_log_buffer;
+
+struct vcservice_log_buffer
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+
+/**
+ * \brief The user context for the audit sink.
+ *
+ * Committed messages are queued in pending, each prefixed by its uint32_t
+ * length.  The background thread swaps pending with batch, then hashes and
+ * formats the batch into output without holding the mutex.  queue_failed is
+ * guarded by the mutex; write_failed and the chain state belong to the
+ * background thread.
+ */
+typedef struct vcservice_log_audit_context vcservice_log_audit_context;
+
+struct vcservice_log_audit_context
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    int desc;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t space_cond;
+    pthread_t thread;
+    bool stop;
+    vcservice_log_buffer pending;
+    vcservice_log_buffer batch;
+    vcservice_log_buffer output;
+    uint64_t sequence;
+    uint64_t since_checkpoint;
+    unsigned int checkpoint_interval;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t chain;
+    bool queue_failed;
+    bool write_failed;
+};
+
+/**
+ * \brief A closed segment waiting to be signed.
+ */
+typedef struct vcservice_log_segment_pending vcservice_log_segment_pending;
+
+struct vcservice_log_segment_pending
+{
+    int desc;
+    uint64_t index;
+    size_t size;
+};
+
+/**
+ * \brief The user context for the signed segment sink.
+ *
+ * The desc, index, size, name, and write_failed fields belong to the writer.
+ * Closed segments are passed to the background signer through the queue,
+ * which is guarded by the mutex.  The crypto state and sign_failed belong to
+ * the signer.
+ *
+ * A signed segment is laid out as its contents, followed by the trailer:
+ * the signature, the big-endian segment index, the big-endian content size,
+ * and \ref LOG_SEGMENT_MAGIC.
+ */
+typedef struct vcservice_log_segment_context vcservice_log_segment_context;
+
+struct vcservice_log_segment_context
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    char* name;
+    size_t prefix_length;
+    size_t segment_size;
+    int desc;
+    uint64_t index;
+    size_t size;
+    bool write_failed;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t space_cond;
+    pthread_t thread;
+    bool stop;
+    vcservice_log_segment_pending queue[LOG_SEGMENT_QUEUE_DEPTH];
+    size_t queue_head;
+    size_t queue_count;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_digital_signature_context_t sign;
+    vccrypt_buffer_t private_key;
+    vccrypt_buffer_t signature;
+    vccrypt_buffer_t digest;
+    bool sign_failed;
+};
+
+/**
+ * \brief A block buffer for the encrypted sink.
+ *
+ * The cipher buffer holds the block as written: the big-endian size of the
+ * rest of the block, the IV, and the ciphertext.
+ */
+typedef struct vcservice_log_encrypted_slot vcservice_log_encrypted_slot;
+
+struct vcservice_log_encrypted_slot
+{
+    uint8_t* plain;
+    uint8_t* cipher;
+    size_t size;
+    size_t cipher_size;
+    uint64_t index;
+    int state;
+};
+
+/**
+ * \brief The user context for the encrypted sink.
+ *
+ * Block N lives in slot N % slot_count.  The writer fills the filling slot
+ * and submits it as ready when it is full or an ERROR message is written.  A
+ * worker submits it instead if it is still filling at flush_deadline, so a
+ * quiet log still reaches the descriptor.  Workers take ready blocks in order
+ * through next_encrypt and encrypt them in parallel.  Whichever worker finds
+ * the block at next_write done writes it and any done blocks after it, so
+ * blocks reach the descriptor in order.  Everything, including the filling
+ * slot's contents, is guarded by the mutex.
+ */
+typedef struct vcservice_log_encrypted_context vcservice_log_encrypted_context;
+
+struct vcservice_log_encrypted_context
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    int desc;
+    size_t block_size;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t key;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t space_cond;
+    pthread_t workers[LOG_ENCRYPTED_MAX_WORKERS];
+    unsigned int worker_count;
+    vcservice_log_encrypted_slot* slots;
+    size_t slot_count;
+    vcservice_log_encrypted_slot* filling;
+    struct timespec flush_deadline;
+    uint64_t submitted;
+    uint64_t next_encrypt;
+    uint64_t next_write;
+    bool writing;
+    bool stop;
+    bool failed;
+};
+
+/**
+ * \brief The user context for the spool sink.
+ *
+ * While spooling is false, the socket belongs to the writer, which sends
+ * messages directly.  The writer sets spooling when a send fails or would
+ * block, and from then on queues messages in pending.  The background thread
+ * owns the socket and the spool file while spooling is set, and clears it
+ * once the spool is drained.  spooling, pending, and queue_failed are guarded
+ * by the mutex.
+ */
+typedef struct vcservice_log_spool_context vcservice_log_spool_context;
+
+struct vcservice_log_spool_context
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    struct sockaddr_un addr;
+    int sock;
+    int spool_desc;
+    size_t spool_limit;
+    off_t spool_size;
+    off_t replay_offset;
+    uint64_t retry_at;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;
+    pthread_cond_t space_cond;
+    pthread_t thread;
+    bool stop;
+    bool spooling;
+    vcservice_log_buffer pending;
+    vcservice_log_buffer batch;
+    bool queue_failed;
+    bool write_failed;
+};
+
 /**
  * \brief Release the \ref vcservice_log resource.
  *
@@ -54,6 +449,13 @@ status
 vcservice_log_resource_release(
     RCPR_SYM(resource)* r);
 
+status
+vcservice_log_redactor_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+vcservice_log_redactor_compile(vcservice_log_redactor* redactor);
+
 /**
  * \brief Write the log message to the given psock (type erased as
  * user_context).
@@ -67,6 +469,359 @@ vcservice_log_write_psock(
     vcservice_log* log, unsigned int log_level,
     RCPR_SYM(resource)* user_context);
 
+/**
+ * \brief Release the audit sink user context, writing any queued records and
+ * the final checkpoint.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_audit_context_resource_release(
+    RCPR_SYM(resource)* r);
+
+/**
+ * \brief Queue the log message for the audit sink's background thread.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param log_level     The log level for the message to write.
+ * \param user_context  The type erased audit context.
+ */
+void
+vcservice_log_write_audit(
+    vcservice_log* log, unsigned int log_level,
+    RCPR_SYM(resource)* user_context);
+
+/**
+ * \brief Entry point for the audit sink's background thread.
+ *
+ * \param context       The \ref vcservice_log_audit_context for this thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_log_audit_thread_run(void* context);
+
+/**
+ * \brief Make room for at least the given number of bytes past the end of
+ * the buffer.
+ *
+ * \param alloc         The allocator to use to grow the buffer.
+ * \param buffer        The buffer to grow.
+ * \param size          The number of bytes needed past the current size.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_buffer_reserve(
+    RCPR_SYM(allocator)* alloc, vcservice_log_buffer* buffer,
+    size_t size);
+
+/**
+ * \brief Advance the audit chain by one record.
+ *
+ * The new chain value is SHA-512 over the previous chain value, the
+ * big-endian sequence number, and the record.
+ *
+ * \param suite         The crypto suite to use.
+ * \param chain         The chain value, updated in place.
+ * \param sequence      The sequence number of this record.
+ * \param record        The record.
+ * \param size          The size of the record.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_audit_chain_step(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* chain,
+    uint64_t sequence, const void* record, size_t size);
+
+/**
+ * \brief Release the signed segment sink user context, signing the last
+ * segment.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_WRITE if any segment could not be
+ *        written or signed.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_segment_context_resource_release(
+    RCPR_SYM(resource)* r);
+
+/**
+ * \brief Append the log message to the current signed segment.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param log_level     The log level for the message to write.
+ * \param user_context  The type erased segment context.
+ */
+void
+vcservice_log_write_segment(
+    vcservice_log* log, unsigned int log_level,
+    RCPR_SYM(resource)* user_context);
+
+/**
+ * \brief Hand the current segment to the signer, waiting if the signer has
+ * fallen \ref LOG_SEGMENT_QUEUE_DEPTH segments behind.
+ *
+ * \param ctx           The segment context.
+ */
+void
+vcservice_log_segment_close(vcservice_log_segment_context* ctx);
+
+/**
+ * \brief Entry point for the signed segment sink's background signer.
+ *
+ * \param context       The \ref vcservice_log_segment_context for this
+ *                      thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_log_segment_thread_run(void* context);
+
+/**
+ * \brief Compute the digest that is signed for a segment.
+ *
+ * The digest is SHA-512 over the big-endian segment index and the segment
+ * contents.
+ *
+ * \param suite         The crypto suite to use.
+ * \param digest        The buffer to receive the digest.
+ * \param index         The segment index.
+ * \param data          The segment contents.
+ * \param size          The size of the segment contents.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_segment_digest(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* digest, uint64_t index,
+    const void* data, size_t size);
+
+/**
+ * \brief Release the encrypted sink user context, writing the last block.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE if any block could not be
+ *        encrypted or written.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_encrypted_context_resource_release(
+    RCPR_SYM(resource)* r);
+
+/**
+ * \brief Append the log message to the encrypted sink's current block.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param log_level     The log level for the message to write.
+ * \param user_context  The type erased encrypted context.
+ */
+void
+vcservice_log_write_encrypted(
+    vcservice_log* log, unsigned int log_level,
+    RCPR_SYM(resource)* user_context);
+
+/**
+ * \brief Submit the block being filled to the encryption workers.
+ *
+ * \param ctx           The encrypted context, whose mutex is held.
+ */
+void
+vcservice_log_encrypted_submit(vcservice_log_encrypted_context* ctx);
+
+/**
+ * \brief Entry point for the encrypted sink's worker threads.
+ *
+ * \param context       The \ref vcservice_log_encrypted_context for this
+ *                      thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_log_encrypted_thread_run(void* context);
+
+/**
+ * \brief Derive the per-file key from the caller's key and the file's salt.
+ *
+ * The per-file key is the leading bytes of SHA-512 over the caller's key and
+ * the salt.
+ *
+ * \param suite         The crypto suite to use.
+ * \param file_key      The buffer to receive the per-file key, which must be
+ *                      initialized to the stream cipher key size.
+ * \param key           The caller's key.
+ * \param key_size      The size of the caller's key.
+ * \param salt          The salt, of \ref LOG_ENCRYPTED_SALT_SIZE bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_encrypted_derive_key(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* file_key,
+    const void* key, size_t key_size, const uint8_t* salt);
+
+/**
+ * \brief Release the spool sink user context, spooling any queued messages.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SPOOL_WRITE if any message was dropped.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_spool_context_resource_release(
+    RCPR_SYM(resource)* r);
+
+/**
+ * \brief Send the log message to the collector, or queue it for the spool.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param log_level     The log level for the message to write.
+ * \param user_context  The type erased spool context.
+ */
+void
+vcservice_log_write_spooled(
+    vcservice_log* log, unsigned int log_level,
+    RCPR_SYM(resource)* user_context);
+
+/**
+ * \brief Entry point for the spool sink's background thread.
+ *
+ * \param context       The \ref vcservice_log_spool_context for this thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_log_spool_thread_run(void* context);
+
+/**
+ * \brief Open a non-blocking connection to the collector.
+ *
+ * \param addr          The collector's socket address.
+ *
+ * \returns the connected socket, or -1 on failure.
+ */
+int
+vcservice_log_spool_connect(const struct sockaddr_un* addr);
+
+/**
+ * \brief Save the current message in the request scope buffer, dropping the
+ * oldest buffered messages if needed to make room.
+ *
+ * \param log           The \ref vcservice_log instance, which must be in a
+ *                      request scope.
+ */
+void
+vcservice_log_scope_push(vcservice_log* log);
+
+/**
+ * \brief Write every message in the request scope buffer ahead of the current
+ * message, and empty the buffer.
+ *
+ * \param log           The \ref vcservice_log instance, which must be in a
+ *                      request scope.
+ */
+void
+vcservice_log_scope_flush(vcservice_log* log);
+
+/**
+ * \brief Compile a layout pattern.
+ *
+ * \param layout        Pointer to receive the compiled layout on success.
+ *                      It is reclaimed with the given allocator.
+ * \param alloc         The allocator for the layout.
+ * \param pattern       The layout pattern.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_LAYOUT_INVALID if the pattern is not valid.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_layout_compile(
+    vcservice_log_layout** layout, RCPR_SYM(allocator)* alloc,
+    const char* pattern);
+
+/**
+ * \brief Lay out the current message with the logger's layout program.
+ *
+ * \param log           The \ref vcservice_log instance, which must have a
+ *                      layout.  The message holds just the body on entry,
+ *                      and the whole line on return.
+ */
+void
+vcservice_log_layout_apply(vcservice_log* log);
+
+/**
+ * \brief Write the canonical text form of a UUID, in lowercase hex digits
+ * grouped 8-4-4-4-12.
+ *
+ * \param out           The output buffer, which must hold
+ *                      \ref LOG_UUID_TEXT_SIZE bytes.  It is not
+ *                      zero-terminated.
+ * \param val           The UUID to write.
+ */
+void
+vcservice_log_uuid_format(char* out, const RCPR_SYM(rcpr_uuid)* val);
+
+/**
+ * \brief Write the given value as lowercase hex digits.
+ *
+ * \param out           The output buffer, which must hold 2 * size bytes.
+ * \param data          The data to write.
+ * \param size          The size of the data.
+ */
+void
+vcservice_log_hex_encode(char* out, const uint8_t* data, size_t size);
+
+/**
+ * \brief Write a value in big-endian order.
+ *
+ * \param out           The eight byte output buffer.
+ * \param value         The value to write.
+ */
+void
+vcservice_log_store_be64(uint8_t* out, uint64_t value);
+
+/**
+ * \brief Write the shortest round-trip decimal representation of the given
+ * floating point value to the given buffer.
+ *
+ * \param buffer            The buffer to receive the representation, which
+ *                          must be at least LOG_DTOA_BUFFER_SIZE bytes.  It is
+ *                          not zero-terminated.
+ * \param val               The value to convert.
+ * \param single_precision  If true, \p val holds a float, and the shortest
+ *                          representation that round-trips as a float is
+ *                          written.
+ *
+ * \returns the number of bytes written to the buffer.
+ */
+size_t
+vcservice_log_dtoa(char* buffer, double val, bool single_precision);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
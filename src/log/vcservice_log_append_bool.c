@@ -0,0 +1,24 @@
+/**
+ * \file log/vcservice_log_append_bool.c
+ *
+ * \brief Append a bool value.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Append a boolean value to the logging message as "true" or "false".
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The boolean value to append.
+ */
+void
+vcservice_log_append_bool(vcservice_log* log, bool val)
+{
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+
+    vcservice_log_append_string(log, val ? "true" : "false");
+}
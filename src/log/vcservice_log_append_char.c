@@ -0,0 +1,28 @@
+/**
+ * \file log/vcservice_log_append_char.c
+ *
+ * \brief Append a char value.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Append a character to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The character to append.
+ */
+void
+vcservice_log_append_char(vcservice_log* log, char val)
+{
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+
+    /* only append the character if there is room. */
+    if (log->log_idx < sizeof(log->log_message))
+    {
+        log->log_message[log->log_idx++] = val;
+    }
+}
@@ -0,0 +1,51 @@
+/**
+ * \file log/vcservice_log_append_double.c
+ *
+ * \brief Append a double value.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Append a double precision floating point value to the logging
+ * message, using the shortest representation that round-trips.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The floating point value to append.
+ */
+void
+vcservice_log_append_double(vcservice_log* log, double val)
+{
+    char buffer[LOG_DTOA_BUFFER_SIZE];
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+
+    /* calculate the current size of the log message. */
+    size_t message_size = sizeof(log->log_message) - log->log_idx;
+
+    /* if there is room, convert directly into the message buffer. */
+    if (message_size >= LOG_DTOA_BUFFER_SIZE)
+    {
+        log->log_idx +=
+            vcservice_log_dtoa(log->log_message + log->log_idx, val, false);
+        return;
+    }
+
+    /* otherwise, convert into a scratch buffer and truncate. */
+    size_t adjsize = vcservice_log_dtoa(buffer, val, false);
+    if (adjsize > message_size)
+    {
+        adjsize = message_size;
+    }
+
+    /* copy the value. */
+    memcpy(log->log_message + log->log_idx, buffer, adjsize);
+
+    /* adjust the size. */
+    log->log_idx += adjsize;
+}
@@ -0,0 +1,279 @@
+/**
+ * \file log/vcservice_log_append_hexdump.c
+ *
+ * \brief Append a hex dump of a byte buffer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "log_internal.h"
+
+/**
+ * \brief The number of bytes shown on each row of a laid out hex dump.
+ */
+#define HEXDUMP_ROW_BYTES 16
+
+/**
+ * \brief Room reserved for the elision marker, which is at most
+ * " ... (18446744073709551615 bytes elided)".
+ */
+#define HEXDUMP_MARKER_RESERVE 40
+
+static void hex_encode(char* out, const uint8_t* in, size_t size);
+static size_t hexdump_row_size(unsigned int flags, size_t count);
+static void hexdump_row(
+    char* out, const uint8_t* in, size_t offset, size_t count,
+    unsigned int flags);
+static void append_marker(vcservice_log* log, size_t elided);
+
+/**
+ * \brief Append a hex dump of the given buffer to the logging message.
+ *
+ * With no flags, the bytes are written as one run of lowercase hex digits.
+ * With \ref VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET and / or
+ * \ref VCSERVICE_LOG_HEXDUMP_FLAG_ASCII, the bytes are written as rows of
+ * sixteen, each starting on a new line, with the offset and / or printable
+ * characters shown alongside.
+ *
+ * If the dump does not fit in the remaining message capacity, as much as fits
+ * is written, followed by a marker giving the number of bytes elided.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param data          The buffer to dump.
+ * \param size          The size of the buffer.
+ * \param flags         Layout flags.
+ *
+ * \returns the number of bytes of \p data that were elided.
+ */
+size_t
+vcservice_log_append_hexdump(
+    vcservice_log* log, const void* data, size_t size, unsigned int flags)
+{
+    const uint8_t* in = (const uint8_t*)data;
+    size_t written = 0;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(NULL != data || 0 == size);
+
+    /* calculate the current size of the log message. */
+    size_t message_size = sizeof(log->log_message) - log->log_idx;
+
+    if (0 == (flags & VCSERVICE_LOG_HEXDUMP_LAYOUT_MASK))
+    {
+        /* a run of hex digits: two characters per byte. */
+        written = size;
+        if (written > message_size / 2)
+        {
+            written =
+                message_size > HEXDUMP_MARKER_RESERVE
+                    ? (message_size - HEXDUMP_MARKER_RESERVE) / 2 : 0;
+        }
+
+        hex_encode(log->log_message + log->log_idx, in, written);
+        log->log_idx += 2 * written;
+    }
+    else
+    {
+        /* rows of bytes, each of which must fit in its entirety. */
+        while (written < size)
+        {
+            size_t count = size - written;
+            if (count > HEXDUMP_ROW_BYTES)
+            {
+                count = HEXDUMP_ROW_BYTES;
+            }
+
+            /* leave room for the marker unless this is the last row. */
+            size_t needed = hexdump_row_size(flags, count);
+            if (written + count < size)
+            {
+                needed += HEXDUMP_MARKER_RESERVE;
+            }
+
+            if (needed > sizeof(log->log_message) - log->log_idx)
+            {
+                break;
+            }
+
+            hexdump_row(
+                log->log_message + log->log_idx, in + written, written, count,
+                flags);
+            log->log_idx += hexdump_row_size(flags, count);
+            written += count;
+        }
+    }
+
+    /* report anything that did not fit. */
+    if (written < size)
+    {
+        append_marker(log, size - written);
+    }
+
+    return size - written;
+}
+
+/**
+ * \brief Append a hex dump log argument to the logging message.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The hex dump argument.
+ */
+void
+vcservice_log_append_hexdump_arg(
+    vcservice_log* log, const vcservice_log_hexdump* val)
+{
+    (void)vcservice_log_append_hexdump(log, val->data, val->size, val->flags);
+}
+
+/**
+ * \brief Encode the input bytes as lowercase hex digits, two per byte.
+ */
+static void hex_encode(char* out, const uint8_t* in, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i ascii_zero = _mm_set1_epi8('0');
+    const __m128i alpha_offset = _mm_set1_epi8('a' - '0' - 10);
+
+    /* sixteen bytes at a time: split into nibbles, map to ASCII, and
+     * interleave the high and low nibbles of each byte. */
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble_mask);
+        __m128i lo = _mm_and_si128(v, nibble_mask);
+
+        hi =
+            _mm_add_epi8(
+                _mm_add_epi8(hi, ascii_zero),
+                _mm_and_si128(_mm_cmpgt_epi8(hi, nine), alpha_offset));
+        lo =
+            _mm_add_epi8(
+                _mm_add_epi8(lo, ascii_zero),
+                _mm_and_si128(_mm_cmpgt_epi8(lo, nine), alpha_offset));
+
+        _mm_storeu_si128(
+            (__m128i*)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(
+            (__m128i*)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+
+    /* scalar tail / fallback. */
+    for (; i < size; ++i)
+    {
+        out[2 * i] = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0x0F];
+    }
+}
+
+/**
+ * \brief Compute the size of a laid out row holding count bytes.
+ */
+static size_t hexdump_row_size(unsigned int flags, size_t count)
+{
+    /* the newline, then each byte with a separator, with an extra space in
+     * the middle of the row. */
+    size_t size = 1 + 3 * count + (count >= 8);
+
+    /* an eight digit offset and two spaces. */
+    if (flags & VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET)
+    {
+        size += 10;
+    }
+
+    /* pad the bytes out to a full row, then add the bracketed characters. */
+    if (flags & VCSERVICE_LOG_HEXDUMP_FLAG_ASCII)
+    {
+        size += 3 * (HEXDUMP_ROW_BYTES - count) + (count < 8);
+        size += count + 3;
+    }
+
+    return size;
+}
+
+/**
+ * \brief Write a laid out row holding count bytes.
+ */
+static void hexdump_row(
+    char* out, const uint8_t* in, size_t offset, size_t count,
+    unsigned int flags)
+{
+    char hex[2 * HEXDUMP_ROW_BYTES];
+    size_t pos = 0;
+
+    *out++ = '\n';
+
+    /* write the offset. */
+    if (flags & VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET)
+    {
+        uint8_t be[4] = {
+            (uint8_t)(offset >> 24), (uint8_t)(offset >> 16),
+            (uint8_t)(offset >> 8), (uint8_t)offset };
+
+        hex_encode(out, be, sizeof(be));
+        out[8] = ' ';
+        out[9] = ' ';
+        out += 10;
+    }
+
+    /* encode the row, then space out the digits. */
+    hex_encode(hex, in, count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[pos++] = hex[2 * i];
+        out[pos++] = hex[2 * i + 1];
+        out[pos++] = ' ';
+        if (7 == i)
+        {
+            out[pos++] = ' ';
+        }
+    }
+
+    if (flags & VCSERVICE_LOG_HEXDUMP_FLAG_ASCII)
+    {
+        /* pad short rows so that the characters line up. */
+        for (size_t i = count; i < HEXDUMP_ROW_BYTES; ++i)
+        {
+            out[pos++] = ' ';
+            out[pos++] = ' ';
+            out[pos++] = ' ';
+            if (7 == i)
+            {
+                out[pos++] = ' ';
+            }
+        }
+
+        out[pos++] = ' ';
+        out[pos++] = '|';
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[pos++] = (in[i] >= 0x20 && in[i] < 0x7F) ? (char)in[i] : '.';
+        }
+        out[pos++] = '|';
+    }
+}
+
+/**
+ * \brief Append the elision marker.
+ */
+static void append_marker(vcservice_log* log, size_t elided)
+{
+    char marker[HEXDUMP_MARKER_RESERVE + 1];
+
+    snprintf(marker, sizeof(marker), " ... (%zu bytes elided)", elided);
+
+    vcservice_log_append_string(log, marker);
+}
@@ -10,8 +10,6 @@
 
 #include "log_internal.h"
 
-static const char* log_level_to_string(unsigned int level);
-
 /**
  * \brief Append the log level to the logging message.
  *
@@ -28,38 +26,12 @@ vcservice_log_append_log_level(vcservice_log* log, unsigned int level)
     /* save this log level to the logging instance. */
     log->log_level = level;
 
-    /* get the string to output. */
-    const char* str = log_level_to_string(level);
-
-    vcservice_log_append_string(log, str);
-}
-
-/**
- * \brief Convert the log level to a string.
- */
-static const char* log_level_to_string(unsigned int level)
-{
-    switch (level)
+    /* a layout places the level itself. */
+    if (NULL != log->layout)
     {
-        case VCSERVICE_LOGLEVEL_CRITICAL:
-            return "CRITICAL ";
-
-        case VCSERVICE_LOGLEVEL_ERROR:
-            return "ERROR    ";
-
-        case VCSERVICE_LOGLEVEL_NORMAL:
-            return "NORMAL   ";
-
-        case VCSERVICE_LOGLEVEL_INFO:
-            return "INFO     ";
-
-        case VCSERVICE_LOGLEVEL_VERBOSE:
-            return "VERBOSE  ";
-
-        case VCSERVICE_LOGLEVEL_DEBUG:
-            return "DEBUG    ";
-
-        default:
-            return "UNKNOWN  ";
+        return;
     }
+
+    /* append the padded level name. */
+    vcservice_log_append_string(log, vcservice_log_level_name(level));
 }
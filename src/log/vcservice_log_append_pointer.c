@@ -0,0 +1,53 @@
+/**
+ * \file log/vcservice_log_append_pointer.c
+ *
+ * \brief Append a pointer value.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Append a pointer value to the logging message as a zero-padded
+ * hexadecimal address.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param val           The pointer value to append.
+ */
+void
+vcservice_log_append_pointer(vcservice_log* log, const void* val)
+{
+    static const char hex[] = "0123456789abcdef";
+    char buffer[2 + 2 * sizeof(uintptr_t)];
+    uintptr_t addr = (uintptr_t)val;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+
+    /* render the address, least significant nibble first. */
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    for (size_t i = sizeof(buffer); i > 2; --i)
+    {
+        buffer[i - 1] = hex[addr & 0x0F];
+        addr >>= 4;
+    }
+
+    /* calculate the current size of the log message. */
+    size_t message_size = sizeof(log->log_message) - log->log_idx;
+
+    size_t adjsize = sizeof(buffer);
+    if (adjsize > message_size)
+    {
+        adjsize = message_size;
+    }
+
+    /* copy the address. */
+    memcpy(log->log_message + log->log_idx, buffer, adjsize);
+
+    /* adjust the size. */
+    log->log_idx += adjsize;
+}
@@ -7,11 +7,9 @@
  */
 
 #include <rcpr/uuid.h>
-#include <string.h>
 
 #include "log_internal.h"
 
-RCPR_IMPORT_allocator_as(rcpr);
 RCPR_IMPORT_uuid;
 
 /**
@@ -23,30 +21,16 @@ RCPR_IMPORT_uuid;
 void
 vcservice_log_append_uuid(vcservice_log* log, const RCPR_SYM(rcpr_uuid)* val)
 {
-    status retval;
-    char* str;
+    char str[LOG_UUID_TEXT_SIZE + 1];
 
     /* parameter sanity checks. */
     RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
     RCPR_MODEL_ASSERT(prop_uuid_valid(val));
 
-    /* convert this uuid to a string. */
-    retval = rcpr_uuid_to_string(&str, log->alloc, val);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
+    /* format on the stack rather than allocating. */
+    vcservice_log_uuid_format(str, val);
+    str[LOG_UUID_TEXT_SIZE] = 0;
 
     /* log this string. */
     vcservice_log_append_string(log, str);
-
-    /* clean up. */
-    memset(str, 0, strlen(str));
-    retval = rcpr_allocator_reclaim(log->alloc, str);
-    if (STATUS_SUCCESS != retval)
-    {
-        goto done;
-    }
-
-done:
 }
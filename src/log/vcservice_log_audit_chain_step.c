@@ -0,0 +1,82 @@
+/**
+ * \file log/vcservice_log_audit_chain_step.c
+ *
+ * \brief Advance the audit chain by one record.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Advance the audit chain by one record.
+ *
+ * The new chain value is SHA-512 over the previous chain value, the
+ * big-endian sequence number, and the record.
+ *
+ * \param suite         The crypto suite to use.
+ * \param chain         The chain value, updated in place.
+ * \param sequence      The sequence number of this record.
+ * \param record        The record.
+ * \param size          The size of the record.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_audit_chain_step(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* chain,
+    uint64_t sequence, const void* record, size_t size)
+{
+    status retval;
+    vccrypt_hash_context_t hash;
+    uint8_t encoded_sequence[sizeof(sequence)];
+
+    /* encode the sequence number in network order. */
+    vcservice_log_store_be64(encoded_sequence, sequence);
+
+    retval = vccrypt_suite_hash_init(suite, &hash);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        vccrypt_hash_digest(&hash, (const uint8_t*)chain->data, chain->size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    retval =
+        vccrypt_hash_digest(
+            &hash, encoded_sequence, sizeof(encoded_sequence));
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    retval = vccrypt_hash_digest(&hash, (const uint8_t*)record, size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    /* the previous value has been consumed, so it can be overwritten. */
+    retval = vccrypt_hash_finalize(&hash, chain);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_hash;
+
+cleanup_hash:
+    dispose((disposable_t*)&hash);
+
+done:
+    return retval;
+}
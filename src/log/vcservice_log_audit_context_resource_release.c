@@ -0,0 +1,109 @@
+/**
+ * \file log/vcservice_log_audit_context_resource_release.c
+ *
+ * \brief Release the audit sink user context.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release the audit sink user context, writing any queued records and
+ * the final checkpoint.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_AUDIT_WRITE if any record could not be queued
+ *        or written.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_audit_context_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_log_audit_context* ctx = (vcservice_log_audit_context*)r;
+    status pending_retval = STATUS_SUCCESS;
+    status batch_retval = STATUS_SUCCESS;
+    status output_retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    bool write_failed;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = ctx->alloc;
+
+    /* let the background thread drain the queue and seal the log. */
+    pthread_mutex_lock(&ctx->mutex);
+    ctx->stop = true;
+    pthread_cond_signal(&ctx->work_cond);
+    pthread_mutex_unlock(&ctx->mutex);
+    pthread_join(ctx->thread, NULL);
+    write_failed = ctx->queue_failed || ctx->write_failed;
+
+    pthread_cond_destroy(&ctx->space_cond);
+    pthread_cond_destroy(&ctx->work_cond);
+    pthread_mutex_destroy(&ctx->mutex);
+
+    /* release the crypto state. */
+    dispose((disposable_t*)&ctx->chain);
+    dispose((disposable_t*)&ctx->suite);
+    dispose((disposable_t*)&ctx->alloc_opts);
+
+    /* release the buffers. */
+    if (NULL != ctx->pending.data)
+    {
+        pending_retval = rcpr_allocator_reclaim(alloc, ctx->pending.data);
+    }
+
+    if (NULL != ctx->batch.data)
+    {
+        batch_retval = rcpr_allocator_reclaim(alloc, ctx->batch.data);
+    }
+
+    if (NULL != ctx->output.data)
+    {
+        output_retval = rcpr_allocator_reclaim(alloc, ctx->output.data);
+    }
+
+    /* the descriptor is owned by this context. */
+    if (0 != close(ctx->desc))
+    {
+        write_failed = true;
+    }
+
+    /* clear memory. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx);
+
+    /* decode return code. */
+    if (STATUS_SUCCESS != pending_retval)
+    {
+        return pending_retval;
+    }
+    else if (STATUS_SUCCESS != batch_retval)
+    {
+        return batch_retval;
+    }
+    else if (STATUS_SUCCESS != output_retval)
+    {
+        return output_retval;
+    }
+    else if (write_failed)
+    {
+        return VCSERVICE_ERROR_LOG_AUDIT_WRITE;
+    }
+    else
+    {
+        return reclaim_retval;
+    }
+}
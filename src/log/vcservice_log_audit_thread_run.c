@@ -0,0 +1,215 @@
+/**
+ * \file log/vcservice_log_audit_thread_run.c
+ *
+ * \brief Background thread for the audit sink.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "log_internal.h"
+
+static void append_checkpoint(vcservice_log_audit_context* ctx, char kind);
+static void hash_batch(vcservice_log_audit_context* ctx);
+static void write_output(vcservice_log_audit_context* ctx);
+static void format_hex_number(char* out, uint64_t value, size_t digits);
+
+/**
+ * \brief Entry point for the audit sink's background thread.
+ *
+ * \param context       The \ref vcservice_log_audit_context for this thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_log_audit_thread_run(void* context)
+{
+    vcservice_log_audit_context* ctx = (vcservice_log_audit_context*)context;
+    vcservice_log_buffer tmp;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    for (;;)
+    {
+        while (!ctx->stop && 0 == ctx->pending.size)
+        {
+            pthread_cond_wait(&ctx->work_cond, &ctx->mutex);
+        }
+
+        /* the queue is drained and the logger is being released. */
+        if (0 == ctx->pending.size)
+        {
+            break;
+        }
+
+        /* take every queued record, leaving the empty batch for callers. */
+        tmp = ctx->pending;
+        ctx->pending = ctx->batch;
+        ctx->batch = tmp;
+        pthread_cond_broadcast(&ctx->space_cond);
+        pthread_mutex_unlock(&ctx->mutex);
+
+        hash_batch(ctx);
+        write_output(ctx);
+        ctx->batch.size = 0;
+
+        pthread_mutex_lock(&ctx->mutex);
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    /* seal the log. */
+    append_checkpoint(ctx, 'S');
+    write_output(ctx);
+
+    return NULL;
+}
+
+/**
+ * \brief Chain and format every record in the current batch.
+ *
+ * \param ctx           The audit context.
+ */
+static void hash_batch(vcservice_log_audit_context* ctx)
+{
+    status retval;
+    size_t offset = 0;
+    uint32_t size;
+
+    while (offset < ctx->batch.size)
+    {
+        memcpy(&size, ctx->batch.data + offset, sizeof(size));
+        const char* record = ctx->batch.data + offset + sizeof(size);
+        offset += sizeof(size) + size;
+
+        /* room for this record and a possible checkpoint. */
+        retval =
+            vcservice_log_buffer_reserve(
+                ctx->alloc, &ctx->output,
+                LOG_AUDIT_RECORD_HEADER_SIZE + size
+                    + LOG_AUDIT_CHECKPOINT_SIZE);
+        if (STATUS_SUCCESS != retval)
+        {
+            /* the chain skips this record; report it on release. */
+            ctx->write_failed = true;
+            continue;
+        }
+
+        retval =
+            vcservice_log_audit_chain_step(
+                &ctx->suite, &ctx->chain, ctx->sequence + 1, record, size);
+        if (STATUS_SUCCESS != retval)
+        {
+            ctx->write_failed = true;
+            continue;
+        }
+
+        ++ctx->sequence;
+
+        /* R <sequence> <size> <chain> <record> */
+        char* out = ctx->output.data + ctx->output.size;
+        out[0] = 'R';
+        out[1] = ' ';
+        format_hex_number(out + 2, ctx->sequence, 16);
+        out[18] = ' ';
+        format_hex_number(out + 19, size, 8);
+        out[27] = ' ';
+        vcservice_log_hex_encode(
+            out + 28, (const uint8_t*)ctx->chain.data, LOG_AUDIT_CHAIN_SIZE);
+        out[LOG_AUDIT_RECORD_HEADER_SIZE - 1] = ' ';
+        memcpy(out + LOG_AUDIT_RECORD_HEADER_SIZE, record, size);
+        ctx->output.size += LOG_AUDIT_RECORD_HEADER_SIZE + size;
+
+        if (++ctx->since_checkpoint >= ctx->checkpoint_interval)
+        {
+            append_checkpoint(ctx, 'C');
+        }
+    }
+}
+
+/**
+ * \brief Append a checkpoint entry for the current chain value.
+ *
+ * \param ctx           The audit context.
+ * \param kind          'C' for a periodic checkpoint, or 'S' for the seal.
+ */
+static void append_checkpoint(vcservice_log_audit_context* ctx, char kind)
+{
+    status retval;
+
+    retval =
+        vcservice_log_buffer_reserve(
+            ctx->alloc, &ctx->output, LOG_AUDIT_CHECKPOINT_SIZE);
+    if (STATUS_SUCCESS != retval)
+    {
+        ctx->write_failed = true;
+        return;
+    }
+
+    /* C <sequence> <chain> */
+    char* out = ctx->output.data + ctx->output.size;
+    out[0] = kind;
+    out[1] = ' ';
+    format_hex_number(out + 2, ctx->sequence, 16);
+    out[18] = ' ';
+    vcservice_log_hex_encode(
+        out + 19, (const uint8_t*)ctx->chain.data, LOG_AUDIT_CHAIN_SIZE);
+    out[LOG_AUDIT_CHECKPOINT_SIZE - 1] = '\n';
+    ctx->output.size += LOG_AUDIT_CHECKPOINT_SIZE;
+
+    ctx->since_checkpoint = 0;
+}
+
+/**
+ * \brief Write and clear the formatted output.
+ *
+ * \param ctx           The audit context.
+ */
+static void write_output(vcservice_log_audit_context* ctx)
+{
+    size_t offset = 0;
+
+    while (offset < ctx->output.size)
+    {
+        ssize_t written =
+            write(
+                ctx->desc, ctx->output.data + offset,
+                ctx->output.size - offset);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            /* eat the failure for logging, but report it on release. */
+            ctx->write_failed = true;
+            break;
+        }
+
+        offset += (size_t)written;
+    }
+
+    ctx->output.size = 0;
+}
+
+/**
+ * \brief Write a number as a fixed number of lowercase hex digits.
+ *
+ * \param out           The output buffer.
+ * \param value         The value to write.
+ * \param digits        The number of digits to write.
+ */
+static void format_hex_number(char* out, uint64_t value, size_t digits)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    for (size_t i = digits; i > 0; --i)
+    {
+        out[i - 1] = hex[value & 0x0F];
+        value >>= 4;
+    }
+}
@@ -0,0 +1,276 @@
+/**
+ * \file log/vcservice_log_audit_verify.c
+ *
+ * \brief Verify the hash chain of an audit log.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+static bool decode_hex_number(uint64_t* value, const char* in, size_t digits);
+static bool chain_matches(const vccrypt_buffer_t* chain, const char* in);
+static status verify_entries(
+    vcservice_log_audit_summary* summary, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* chain, const char* data, size_t size);
+
+/**
+ * \brief Verify the hash chain of an audit log.
+ *
+ * Every record's chain value is recomputed from the start of the log, and
+ * every checkpoint is compared against the chain value at that point.
+ *
+ * \param summary       Pointer to the summary to receive the record and
+ *                      checkpoint counts.  On failure, its failure_offset is
+ *                      set to the offset of the first entry that could not be
+ *                      verified.
+ * \param desc          The descriptor of the audit log to verify.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS if the whole log verified.
+ *      - VCSERVICE_ERROR_LOG_AUDIT_MALFORMED if an entry could not be parsed,
+ *        or if sequence numbers are not consecutive.
+ *      - VCSERVICE_ERROR_LOG_AUDIT_CHAIN_MISMATCH if a chain value does not
+ *        match.
+ *      - VCSERVICE_ERROR_LOG_AUDIT_READ if the log could not be read.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_audit_verify(vcservice_log_audit_summary* summary, int desc)
+{
+    status retval;
+    struct stat st;
+    void* data;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t chain;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != summary);
+    RCPR_MODEL_ASSERT(desc >= 0);
+
+    memset(summary, 0, sizeof(*summary));
+
+    if (0 != fstat(desc, &st))
+    {
+        retval = VCSERVICE_ERROR_LOG_AUDIT_READ;
+        goto done;
+    }
+
+    /* an empty log is trivially valid, but not sealed. */
+    if (0 == st.st_size)
+    {
+        retval = STATUS_SUCCESS;
+        goto done;
+    }
+
+    /* map the whole log; it is read once, front to back. */
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, desc, 0);
+    if (MAP_FAILED == data)
+    {
+        retval = VCSERVICE_ERROR_LOG_AUDIT_READ;
+        goto done;
+    }
+
+    (void)madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    /* set up the crypto suite used for the chain. */
+    malloc_allocator_options_init(&alloc_opts);
+    vccrypt_suite_register_velo_v1();
+    retval =
+        vccrypt_suite_options_init(&suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc_opts;
+    }
+
+    /* the chain starts at zero. */
+    retval = vccrypt_suite_buffer_init_for_hash(&suite, &chain);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_suite;
+    }
+
+    memset(chain.data, 0, chain.size);
+
+    retval =
+        verify_entries(
+            summary, &suite, &chain, (const char*)data, (size_t)st.st_size);
+    goto cleanup_chain;
+
+cleanup_chain:
+    dispose((disposable_t*)&chain);
+
+cleanup_suite:
+    dispose((disposable_t*)&suite);
+
+cleanup_alloc_opts:
+    dispose((disposable_t*)&alloc_opts);
+    munmap(data, (size_t)st.st_size);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Walk every entry in the log, recomputing the chain.
+ *
+ * \param summary       The summary to update.
+ * \param suite         The crypto suite to use.
+ * \param chain         The chain value, starting at zero.
+ * \param data          The log contents.
+ * \param size          The size of the log.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status verify_entries(
+    vcservice_log_audit_summary* summary, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* chain, const char* data, size_t size)
+{
+    status retval;
+    size_t offset = 0;
+    uint64_t sequence, record_size;
+
+    while (offset < size)
+    {
+        const char* entry = data + offset;
+        size_t remaining = size - offset;
+
+        summary->failure_offset = offset;
+
+        if ('R' == entry[0])
+        {
+            /* R <sequence> <size> <chain> <record> */
+            if (remaining < LOG_AUDIT_RECORD_HEADER_SIZE
+             || ' ' != entry[1] || ' ' != entry[18] || ' ' != entry[27]
+             || ' ' != entry[LOG_AUDIT_RECORD_HEADER_SIZE - 1]
+             || !decode_hex_number(&sequence, entry + 2, 16)
+             || !decode_hex_number(&record_size, entry + 19, 8)
+             || sequence != summary->records + 1
+             || record_size > remaining - LOG_AUDIT_RECORD_HEADER_SIZE)
+            {
+                return VCSERVICE_ERROR_LOG_AUDIT_MALFORMED;
+            }
+
+            retval =
+                vcservice_log_audit_chain_step(
+                    suite, chain, sequence,
+                    entry + LOG_AUDIT_RECORD_HEADER_SIZE, record_size);
+            if (STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+
+            if (!chain_matches(chain, entry + 28))
+            {
+                return VCSERVICE_ERROR_LOG_AUDIT_CHAIN_MISMATCH;
+            }
+
+            ++summary->records;
+            summary->sealed = false;
+            offset += LOG_AUDIT_RECORD_HEADER_SIZE + record_size;
+        }
+        else if ('C' == entry[0] || 'S' == entry[0])
+        {
+            /* C <sequence> <chain> */
+            if (remaining < LOG_AUDIT_CHECKPOINT_SIZE
+             || ' ' != entry[1] || ' ' != entry[18]
+             || '\n' != entry[LOG_AUDIT_CHECKPOINT_SIZE - 1]
+             || !decode_hex_number(&sequence, entry + 2, 16)
+             || sequence != summary->records)
+            {
+                return VCSERVICE_ERROR_LOG_AUDIT_MALFORMED;
+            }
+
+            if (!chain_matches(chain, entry + 19))
+            {
+                return VCSERVICE_ERROR_LOG_AUDIT_CHAIN_MISMATCH;
+            }
+
+            ++summary->checkpoints;
+            summary->sealed = ('S' == entry[0]);
+            offset += LOG_AUDIT_CHECKPOINT_SIZE;
+        }
+        else
+        {
+            return VCSERVICE_ERROR_LOG_AUDIT_MALFORMED;
+        }
+    }
+
+    summary->failure_offset = 0;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Decode a single lowercase hex digit.
+ *
+ * \param ch            The digit.
+ *
+ * \returns the value of the digit, or -1 if it is not a hex digit.
+ */
+static int decode_hex_digit(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+    {
+        return ch - '0';
+    }
+    else if (ch >= 'a' && ch <= 'f')
+    {
+        return ch - 'a' + 10;
+    }
+    else
+    {
+        return -1;
+    }
+}
+
+/**
+ * \brief Decode a fixed number of lowercase hex digits.
+ *
+ * \param value         Pointer to receive the value.
+ * \param in            The digits.
+ * \param digits        The number of digits.
+ *
+ * \returns true if every digit was valid.
+ */
+static bool decode_hex_number(uint64_t* value, const char* in, size_t digits)
+{
+    *value = 0;
+
+    for (size_t i = 0; i < digits; ++i)
+    {
+        int nibble = decode_hex_digit(in[i]);
+        if (nibble < 0)
+        {
+            return false;
+        }
+
+        *value = (*value << 4) | (uint64_t)nibble;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Compare the chain value against its hex encoding in the log.
+ *
+ * \param chain         The computed chain value.
+ * \param in            The hex encoded chain value from the log.
+ *
+ * \returns true if they match.
+ */
+static bool chain_matches(const vccrypt_buffer_t* chain, const char* in)
+{
+    char expected[2 * LOG_AUDIT_CHAIN_SIZE];
+
+    vcservice_log_hex_encode(
+        expected, (const uint8_t*)chain->data, LOG_AUDIT_CHAIN_SIZE);
+
+    return 0 == memcmp(expected, in, sizeof(expected));
+}
@@ -0,0 +1,68 @@
+/**
+ * \file log/vcservice_log_buffer_reserve.c
+ *
+ * \brief Grow a log sink buffer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Make room for at least the given number of bytes past the end of
+ * the buffer.
+ *
+ * \param alloc         The allocator to use to grow the buffer.
+ * \param buffer        The buffer to grow.
+ * \param size          The number of bytes needed past the current size.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_buffer_reserve(
+    RCPR_SYM(allocator)* alloc, vcservice_log_buffer* buffer,
+    size_t size)
+{
+    status retval;
+    size_t capacity;
+    void* data;
+
+    /* nothing to do if the buffer is already large enough. */
+    if (buffer->capacity - buffer->size >= size)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* double the capacity until the new data fits. */
+    capacity =
+        (0 == buffer->capacity) ? MAX_LOG_MESSAGE_SIZE : buffer->capacity;
+    while (capacity - buffer->size < size)
+    {
+        capacity *= 2;
+    }
+
+    /* the first allocation has nothing to copy. */
+    if (NULL == buffer->data)
+    {
+        retval = rcpr_allocator_allocate(alloc, &data, capacity);
+    }
+    else
+    {
+        data = buffer->data;
+        retval = rcpr_allocator_reallocate(alloc, &data, capacity);
+    }
+
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    buffer->data = (char*)data;
+    buffer->capacity = capacity;
+
+    return STATUS_SUCCESS;
+}
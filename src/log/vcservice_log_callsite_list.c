@@ -0,0 +1,37 @@
+/**
+ * \file log/vcservice_log_callsite_list.c
+ *
+ * \brief Get the list of logging call sites.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Get the list of logging call sites linked into this program.
+ *
+ * \param sites         Pointer to receive the first call site descriptor.
+ *
+ * \note Only call sites in the same linked image (the executable, or the
+ * shared object containing this library) are visible.
+ *
+ * \returns the number of call site descriptors in the list.
+ */
+size_t
+vcservice_log_callsite_list(const vcservice_log_callsite** sites)
+{
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != sites);
+
+    /* if no call sites were linked in, the section bounds are undefined. */
+    if (NULL == __start_vcservice_log_callsites)
+    {
+        *sites = NULL;
+        return 0;
+    }
+
+    *sites = __start_vcservice_log_callsites;
+
+    return __stop_vcservice_log_callsites - __start_vcservice_log_callsites;
+}
@@ -0,0 +1,95 @@
+/**
+ * \file log/vcservice_log_callsite_set_enabled.c
+ *
+ * \brief Enable or disable matching logging call sites.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <fnmatch.h>
+#include <string.h>
+
+#include "log_internal.h"
+
+static bool callsite_matches(
+    const vcservice_log_callsite* site, const char* file_pattern,
+    const char* function_pattern, unsigned int line);
+
+/**
+ * \brief Enable or disable every logging call site matching the given
+ * criteria.
+ *
+ * An enabled call site logs its message regardless of the logger's threshold
+ * level.  A disabled call site is subject to the threshold level as usual.
+ *
+ * \param file_pattern      A glob pattern matched against the full source path
+ *                          or the base name of the call site, or NULL to match
+ *                          any file.
+ * \param function_pattern  A glob pattern matched against the function name of
+ *                          the call site, or NULL to match any function.
+ * \param line              The line number of the call site, or 0 to match any
+ *                          line.
+ * \param enabled           true to enable the matching call sites, false to
+ *                          disable them.
+ *
+ * \returns the number of call sites matched.
+ */
+size_t
+vcservice_log_callsite_set_enabled(
+    const char* file_pattern, const char* function_pattern, unsigned int line,
+    bool enabled)
+{
+    const vcservice_log_callsite* sites;
+    size_t matched = 0;
+
+    /* get the call site list. */
+    size_t count = vcservice_log_callsite_list(&sites);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (callsite_matches(sites + i, file_pattern, function_pattern, line))
+        {
+            /* the descriptors are only read-only to callers of the list. */
+            vcservice_log_callsite* site = (vcservice_log_callsite*)sites + i;
+
+            __atomic_store_n(&site->enabled, enabled, __ATOMIC_RELAXED);
+            ++matched;
+        }
+    }
+
+    return matched;
+}
+
+/**
+ * \brief Return true if the given call site matches the given criteria.
+ */
+static bool callsite_matches(
+    const vcservice_log_callsite* site, const char* file_pattern,
+    const char* function_pattern, unsigned int line)
+{
+    /* check the line number. */
+    if (0 != line && line != site->line)
+    {
+        return false;
+    }
+
+    /* check the function name. */
+    if (
+        NULL != function_pattern
+     && 0 != fnmatch(function_pattern, site->function, 0))
+    {
+        return false;
+    }
+
+    /* check the file against both the full path and the base name. */
+    if (NULL != file_pattern && 0 != fnmatch(file_pattern, site->file, 0))
+    {
+        const char* basename = strrchr(site->file, '/');
+        if (NULL == basename || 0 != fnmatch(file_pattern, basename + 1, 0))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,155 @@
+/**
+ * \file log/vcservice_log_create_audit.c
+ *
+ * \brief Create a hash-chained audit log instance.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a hash-chained audit \ref vcservice_log that writes to the
+ * given descriptor.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param desc                  The descriptor to which audit records are
+ *                              written.  This descriptor is owned by this
+ *                              logger instance and will be closed when it is
+ *                              released.
+ * \param checkpoint_interval   The number of records between checkpoints, or
+ *                              0 for the default interval.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_audit(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, int desc,
+    unsigned int checkpoint_interval, unsigned int threshold_level)
+{
+    status retval, reclaim_retval;
+    vcservice_log_audit_context* ctx;
+    vcservice_log* tmp;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != log);
+    RCPR_MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    RCPR_MODEL_ASSERT(desc >= 0);
+    RCPR_MODEL_ASSERT(
+        prop_vcservice_log_threshold_level_valid(threshold_level));
+
+    /* allocate memory for the audit context. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&ctx, sizeof(*ctx));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* initialize resource. */
+    resource_init(&ctx->hdr, &vcservice_log_audit_context_resource_release);
+    ctx->alloc = alloc;
+    ctx->checkpoint_interval =
+        (0 == checkpoint_interval)
+            ? VCSERVICE_LOG_AUDIT_DEFAULT_CHECKPOINT_INTERVAL
+            : checkpoint_interval;
+
+    /* set up the crypto suite used for the chain. */
+    malloc_allocator_options_init(&ctx->alloc_opts);
+    vccrypt_suite_register_velo_v1();
+    retval =
+        vccrypt_suite_options_init(
+            &ctx->suite, &ctx->alloc_opts, VCCRYPT_SUITE_VELO_V1);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc_opts;
+    }
+
+    /* the chain starts at zero. */
+    retval = vccrypt_suite_buffer_init_for_hash(&ctx->suite, &ctx->chain);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_suite;
+    }
+
+    memset(ctx->chain.data, 0, ctx->chain.size);
+
+    /* allocate memory for the logger. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_chain;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_log_resource_release);
+    tmp->alloc = alloc;
+    tmp->threshold_level = threshold_level;
+    tmp->user_context = &ctx->hdr;
+    tmp->log_write_cb = &vcservice_log_write_audit;
+
+    /* start the background thread. */
+    pthread_mutex_init(&ctx->mutex, NULL);
+    pthread_cond_init(&ctx->work_cond, NULL);
+    pthread_cond_init(&ctx->space_cond, NULL);
+    ctx->desc = desc;
+    if (0 != pthread_create(
+                &ctx->thread, NULL, &vcservice_log_audit_thread_run, ctx))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_THREAD_CREATE;
+        goto cleanup_log;
+    }
+
+    /* success. */
+    *log = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_log:
+    pthread_cond_destroy(&ctx->space_cond);
+    pthread_cond_destroy(&ctx->work_cond);
+    pthread_mutex_destroy(&ctx->mutex);
+    memset(tmp, 0, sizeof(*tmp));
+    reclaim_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_chain:
+    dispose((disposable_t*)&ctx->chain);
+
+cleanup_suite:
+    dispose((disposable_t*)&ctx->suite);
+
+cleanup_alloc_opts:
+    dispose((disposable_t*)&ctx->alloc_opts);
+    memset(ctx, 0, sizeof(*ctx));
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+done:
+    return retval;
+}
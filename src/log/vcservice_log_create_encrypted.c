@@ -0,0 +1,318 @@
+/**
+ * \file log/vcservice_log_create_encrypted.c
+ *
+ * \brief Create a log instance that encrypts what it writes.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/random.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+static status write_header(
+    vcservice_log_encrypted_context* ctx, const void* key, size_t key_size);
+static status create_slots(vcservice_log_encrypted_context* ctx);
+
+/**
+ * \brief Create a \ref vcservice_log that encrypts everything it writes to
+ * the given descriptor.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param desc                  The descriptor to which the encrypted log is
+ *                              written.
+ * \param key                   The raw stream cipher key, which is not
+ *                              retained.
+ * \param key_size              The size of the key.
+ * \param block_size            The plaintext block size, or 0 for the
+ *                              default.
+ * \param worker_count          The number of encryption threads, or 0 for one
+ *                              per online CPU.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY if the key size does not
+ *        match the crypto suite.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE if the header could not be
+ *        created or written.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if no worker thread could be
+ *        started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_encrypted(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, int desc,
+    const void* key, size_t key_size, size_t block_size,
+    unsigned int worker_count, unsigned int threshold_level)
+{
+    status retval, reclaim_retval;
+    vcservice_log_encrypted_context* ctx;
+    vcservice_log* tmp;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != log);
+    RCPR_MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    RCPR_MODEL_ASSERT(desc >= 0);
+    RCPR_MODEL_ASSERT(NULL != key);
+    RCPR_MODEL_ASSERT(block_size <= UINT32_MAX - 4 - LOG_ENCRYPTED_IV_SIZE);
+    RCPR_MODEL_ASSERT(
+        prop_vcservice_log_threshold_level_valid(threshold_level));
+
+    /* allocate memory for the encrypted context. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&ctx, sizeof(*ctx));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* initialize resource. */
+    resource_init(
+        &ctx->hdr, &vcservice_log_encrypted_context_resource_release);
+    ctx->alloc = alloc;
+    ctx->desc = desc;
+    ctx->block_size =
+        (0 == block_size) ? VCSERVICE_LOG_ENCRYPTED_DEFAULT_BLOCK_SIZE
+                          : block_size;
+
+    /* one worker per online CPU by default. */
+    if (0 == worker_count)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        worker_count = (cpus > 0) ? (unsigned int)cpus : 1;
+    }
+
+    if (worker_count > LOG_ENCRYPTED_MAX_WORKERS)
+    {
+        worker_count = LOG_ENCRYPTED_MAX_WORKERS;
+    }
+
+    /* enough slots to keep every worker busy while blocks wait to write. */
+    ctx->slot_count = 2 * worker_count + 1;
+
+    /* set up the crypto suite used for encryption. */
+    malloc_allocator_options_init(&ctx->alloc_opts);
+    vccrypt_suite_register_velo_v1();
+    retval =
+        vccrypt_suite_options_init(
+            &ctx->suite, &ctx->alloc_opts, VCCRYPT_SUITE_VELO_V1);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc_opts;
+    }
+
+    if (key_size != ctx->suite.stream_cipher_opts.key_size
+     || LOG_ENCRYPTED_IV_SIZE != ctx->suite.stream_cipher_opts.IV_size)
+    {
+        retval = VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY;
+        goto cleanup_suite;
+    }
+
+    retval = vccrypt_buffer_init(&ctx->key, &ctx->alloc_opts, key_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_suite;
+    }
+
+    /* pick a salt, derive the per-file key, and write the header. */
+    retval = write_header(ctx, key, key_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key;
+    }
+
+    retval = create_slots(ctx);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key;
+    }
+
+    /* allocate memory for the logger. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_slots;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_log_resource_release);
+    tmp->alloc = alloc;
+    tmp->threshold_level = threshold_level;
+    tmp->user_context = &ctx->hdr;
+    tmp->log_write_cb = &vcservice_log_write_encrypted;
+
+    /* start the workers; run with as many as could be started. */
+    pthread_mutex_init(&ctx->mutex, NULL);
+    pthread_cond_init(&ctx->work_cond, NULL);
+    pthread_cond_init(&ctx->space_cond, NULL);
+    while (
+        ctx->worker_count < worker_count
+     && 0 == pthread_create(
+                &ctx->workers[ctx->worker_count], NULL,
+                &vcservice_log_encrypted_thread_run, ctx))
+    {
+        ++ctx->worker_count;
+    }
+
+    if (0 == ctx->worker_count)
+    {
+        retval = VCSERVICE_ERROR_GENERAL_THREAD_CREATE;
+        goto cleanup_log;
+    }
+
+    /* success. */
+    *log = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_log:
+    pthread_cond_destroy(&ctx->space_cond);
+    pthread_cond_destroy(&ctx->work_cond);
+    pthread_mutex_destroy(&ctx->mutex);
+    memset(tmp, 0, sizeof(*tmp));
+    reclaim_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_slots:
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx->slots);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_key:
+    memset(ctx->key.data, 0, ctx->key.size);
+    dispose((disposable_t*)&ctx->key);
+
+cleanup_suite:
+    dispose((disposable_t*)&ctx->suite);
+
+cleanup_alloc_opts:
+    dispose((disposable_t*)&ctx->alloc_opts);
+    memset(ctx, 0, sizeof(*ctx));
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Pick a random salt, derive the per-file key, and write the header.
+ *
+ * \param ctx           The encrypted context.
+ * \param key           The caller's key.
+ * \param key_size      The size of the caller's key.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status write_header(
+    vcservice_log_encrypted_context* ctx, const void* key, size_t key_size)
+{
+    status retval;
+    uint8_t header[LOG_ENCRYPTED_HEADER_SIZE];
+    uint8_t* salt = header + LOG_ENCRYPTED_MAGIC_SIZE;
+    uint8_t* size = salt + LOG_ENCRYPTED_SALT_SIZE;
+    size_t offset = 0;
+
+    /* magic, salt, block size. */
+    memcpy(header, LOG_ENCRYPTED_MAGIC, LOG_ENCRYPTED_MAGIC_SIZE);
+    if (LOG_ENCRYPTED_SALT_SIZE
+            != getrandom(salt, LOG_ENCRYPTED_SALT_SIZE, 0))
+    {
+        return VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE;
+    }
+
+    size[0] = (uint8_t)(ctx->block_size >> 24);
+    size[1] = (uint8_t)(ctx->block_size >> 16);
+    size[2] = (uint8_t)(ctx->block_size >> 8);
+    size[3] = (uint8_t)ctx->block_size;
+
+    retval =
+        vcservice_log_encrypted_derive_key(
+            &ctx->suite, &ctx->key, key, key_size, salt);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    while (offset < sizeof(header))
+    {
+        ssize_t written =
+            write(ctx->desc, header + offset, sizeof(header) - offset);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            return VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE;
+        }
+
+        offset += (size_t)written;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Allocate the slots and their buffers in a single allocation.
+ *
+ * \param ctx           The encrypted context.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status create_slots(vcservice_log_encrypted_context* ctx)
+{
+    status retval;
+    size_t cipher_size = 4 + LOG_ENCRYPTED_IV_SIZE + ctx->block_size;
+    size_t slots_size = ctx->slot_count * sizeof(*ctx->slots);
+    uint8_t* plain;
+    uint8_t* cipher;
+
+    retval =
+        rcpr_allocator_allocate(
+            ctx->alloc, (void**)&ctx->slots,
+            slots_size + ctx->slot_count * (ctx->block_size + cipher_size));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(ctx->slots, 0, slots_size);
+
+    /* all plaintext buffers are together, so they can be wiped at once. */
+    plain = (uint8_t*)ctx->slots + slots_size;
+    cipher = plain + ctx->slot_count * ctx->block_size;
+    for (size_t i = 0; i < ctx->slot_count; ++i)
+    {
+        ctx->slots[i].plain = plain + i * ctx->block_size;
+        ctx->slots[i].cipher = cipher + i * cipher_size;
+        ctx->slots[i].state = LOG_ENCRYPTED_SLOT_FREE;
+    }
+
+    return STATUS_SUCCESS;
+}
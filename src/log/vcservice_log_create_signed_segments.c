@@ -0,0 +1,213 @@
+/**
+ * \file log/vcservice_log_create_signed_segments.c
+ *
+ * \brief Create a log instance that writes signed segments.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_log that writes to a series of signed
+ * segment files.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param prefix                The path prefix for segment files.
+ * \param segment_size          The size at which a segment is closed, or 0
+ *                              for \ref VCSERVICE_LOG_SEGMENT_DEFAULT_SIZE.
+ * \param private_key           The raw signing key, which is copied.
+ * \param private_key_size      The size of the signing key.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_INVALID_KEY if the key size does not
+ *        match the crypto suite.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_signed_segments(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, const char* prefix,
+    size_t segment_size, const void* private_key, size_t private_key_size,
+    unsigned int threshold_level)
+{
+    status retval, reclaim_retval;
+    vcservice_log_segment_context* ctx;
+    vcservice_log* tmp;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != log);
+    RCPR_MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    RCPR_MODEL_ASSERT(NULL != prefix);
+    RCPR_MODEL_ASSERT(NULL != private_key);
+    RCPR_MODEL_ASSERT(
+        prop_vcservice_log_threshold_level_valid(threshold_level));
+
+    /* allocate memory for the segment context. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&ctx, sizeof(*ctx));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* initialize resource. */
+    resource_init(&ctx->hdr, &vcservice_log_segment_context_resource_release);
+    ctx->alloc = alloc;
+    ctx->desc = -1;
+    ctx->segment_size =
+        (0 == segment_size) ? VCSERVICE_LOG_SEGMENT_DEFAULT_SIZE : segment_size;
+
+    /* the name buffer holds the prefix followed by the segment suffix. */
+    ctx->prefix_length = strlen(prefix);
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&ctx->name,
+            ctx->prefix_length + LOG_SEGMENT_NAME_SUFFIX_SIZE);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_context;
+    }
+
+    memcpy(ctx->name, prefix, ctx->prefix_length);
+
+    /* set up the crypto suite used for signing. */
+    malloc_allocator_options_init(&ctx->alloc_opts);
+    vccrypt_suite_register_velo_v1();
+    retval =
+        vccrypt_suite_options_init(
+            &ctx->suite, &ctx->alloc_opts, VCCRYPT_SUITE_VELO_V1);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc_opts;
+    }
+
+    if (private_key_size != ctx->suite.sign_opts.private_key_size
+     || ctx->suite.sign_opts.signature_size > LOG_SEGMENT_MAX_SIGNATURE_SIZE)
+    {
+        retval = VCSERVICE_ERROR_LOG_SEGMENT_INVALID_KEY;
+        goto cleanup_suite;
+    }
+
+    retval = vccrypt_suite_digital_signature_init(&ctx->suite, &ctx->sign);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_suite;
+    }
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature_private_key(
+            &ctx->suite, &ctx->private_key);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sign;
+    }
+
+    memcpy(ctx->private_key.data, private_key, private_key_size);
+
+    retval =
+        vccrypt_suite_buffer_init_for_signature(&ctx->suite, &ctx->signature);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_private_key;
+    }
+
+    retval = vccrypt_suite_buffer_init_for_hash(&ctx->suite, &ctx->digest);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_signature;
+    }
+
+    /* allocate memory for the logger. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_digest;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_log_resource_release);
+    tmp->alloc = alloc;
+    tmp->threshold_level = threshold_level;
+    tmp->user_context = &ctx->hdr;
+    tmp->log_write_cb = &vcservice_log_write_segment;
+
+    /* start the background signer. */
+    pthread_mutex_init(&ctx->mutex, NULL);
+    pthread_cond_init(&ctx->work_cond, NULL);
+    pthread_cond_init(&ctx->space_cond, NULL);
+    if (0 != pthread_create(
+                &ctx->thread, NULL, &vcservice_log_segment_thread_run, ctx))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_THREAD_CREATE;
+        goto cleanup_log;
+    }
+
+    /* success. */
+    *log = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_log:
+    pthread_cond_destroy(&ctx->space_cond);
+    pthread_cond_destroy(&ctx->work_cond);
+    pthread_mutex_destroy(&ctx->mutex);
+    memset(tmp, 0, sizeof(*tmp));
+    reclaim_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_digest:
+    dispose((disposable_t*)&ctx->digest);
+
+cleanup_signature:
+    dispose((disposable_t*)&ctx->signature);
+
+cleanup_private_key:
+    memset(ctx->private_key.data, 0, ctx->private_key.size);
+    dispose((disposable_t*)&ctx->private_key);
+
+cleanup_sign:
+    dispose((disposable_t*)&ctx->sign);
+
+cleanup_suite:
+    dispose((disposable_t*)&ctx->suite);
+
+cleanup_alloc_opts:
+    dispose((disposable_t*)&ctx->alloc_opts);
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx->name);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_context:
+    memset(ctx, 0, sizeof(*ctx));
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,175 @@
+/**
+ * \file log/vcservice_log_create_spooled.c
+ *
+ * \brief Create a log instance that spools while its collector is down.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_log that writes to a log collector's Unix
+ * socket, spooling to a local file while the collector is unreachable.
+ *
+ * \param log                   Pointer to the \ref vcservice_log pointer to
+ *                              receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log instance.
+ * \param socket_path           The path of the collector's Unix socket.
+ * \param spool_path            The path of the spool file, which is created
+ *                              if it does not exist.
+ * \param spool_limit           The maximum size of the spool file, or 0 for
+ *                              \ref VCSERVICE_LOG_SPOOL_DEFAULT_LIMIT.
+ * \param threshold_level       The threshold level for logging messages.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SPOOL_INVALID_PATH if \p socket_path is too long
+ *        for a Unix socket address.
+ *      - VCSERVICE_ERROR_LOG_SPOOL_OPEN if the spool file could not be opened
+ *        or is in use by another logger.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_create_spooled(
+    vcservice_log** log, RCPR_SYM(allocator)* alloc, const char* socket_path,
+    const char* spool_path, size_t spool_limit, unsigned int threshold_level)
+{
+    status retval, reclaim_retval;
+    vcservice_log_spool_context* ctx;
+    vcservice_log* tmp;
+    struct stat st;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != log);
+    RCPR_MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    RCPR_MODEL_ASSERT(NULL != socket_path);
+    RCPR_MODEL_ASSERT(NULL != spool_path);
+    RCPR_MODEL_ASSERT(
+        prop_vcservice_log_threshold_level_valid(threshold_level));
+
+    /* the socket path must fit in the address, with its terminator. */
+    if (strlen(socket_path) >= sizeof(((struct sockaddr_un*)0)->sun_path))
+    {
+        retval = VCSERVICE_ERROR_LOG_SPOOL_INVALID_PATH;
+        goto done;
+    }
+
+    /* allocate memory for the spool context. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&ctx, sizeof(*ctx));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* initialize resource. */
+    resource_init(&ctx->hdr, &vcservice_log_spool_context_resource_release);
+    ctx->alloc = alloc;
+    ctx->addr.sun_family = AF_UNIX;
+    strcpy(ctx->addr.sun_path, socket_path);
+    ctx->spool_limit =
+        (0 == spool_limit) ? VCSERVICE_LOG_SPOOL_DEFAULT_LIMIT : spool_limit;
+
+    /* open the spool, keeping anything an earlier process left in it. */
+    ctx->spool_desc = open(spool_path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (ctx->spool_desc < 0)
+    {
+        retval = VCSERVICE_ERROR_LOG_SPOOL_OPEN;
+        goto cleanup_ctx;
+    }
+
+    /* two loggers replaying the same spool would duplicate messages. */
+    if (0 != flock(ctx->spool_desc, LOCK_EX | LOCK_NB)
+     || 0 != fstat(ctx->spool_desc, &st))
+    {
+        retval = VCSERVICE_ERROR_LOG_SPOOL_OPEN;
+        goto cleanup_spool_desc;
+    }
+
+    ctx->spool_size = st.st_size;
+
+    /* an unreachable collector is not an error; the spool covers it. */
+    ctx->sock = vcservice_log_spool_connect(&ctx->addr);
+    ctx->spooling = ctx->sock < 0 || ctx->spool_size > 0;
+
+    /* allocate memory for the logger. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sock;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_log_resource_release);
+    tmp->alloc = alloc;
+    tmp->threshold_level = threshold_level;
+    tmp->user_context = &ctx->hdr;
+    tmp->log_write_cb = &vcservice_log_write_spooled;
+
+    /* start the background thread. */
+    pthread_mutex_init(&ctx->mutex, NULL);
+    pthread_cond_init(&ctx->work_cond, NULL);
+    pthread_cond_init(&ctx->space_cond, NULL);
+    if (0 != pthread_create(
+                &ctx->thread, NULL, &vcservice_log_spool_thread_run, ctx))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_THREAD_CREATE;
+        goto cleanup_log;
+    }
+
+    /* success. */
+    *log = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_log:
+    pthread_cond_destroy(&ctx->space_cond);
+    pthread_cond_destroy(&ctx->work_cond);
+    pthread_mutex_destroy(&ctx->mutex);
+    memset(tmp, 0, sizeof(*tmp));
+    reclaim_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_sock:
+    if (ctx->sock >= 0)
+    {
+        close(ctx->sock);
+    }
+
+cleanup_spool_desc:
+    close(ctx->spool_desc);
+
+cleanup_ctx:
+    memset(ctx, 0, sizeof(*ctx));
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+done:
+    return retval;
+}
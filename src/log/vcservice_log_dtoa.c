@@ -0,0 +1,584 @@
+/**
+ * \file log/vcservice_log_dtoa.c
+ *
+ * \brief Shortest round-trip conversion of floating point values to decimal.
+ *
+ * This is the Grisu2 algorithm from Florian Loitsch, "Printing Floating-Point
+ * Numbers Quickly and Accurately with Integers" (PLDI 2010), with the boundary
+ * handling described by Jaffer and used by most modern implementations.  The
+ * digits produced always round-trip, and are the shortest such digits for the
+ * overwhelming majority of inputs.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief A "do it yourself" floating point value, f * 2^e.
+ */
+typedef struct diyfp
+{
+    uint64_t f;
+    int e;
+} diyfp;
+
+/**
+ * \brief The normalized value and boundaries of a floating point value.
+ */
+typedef struct boundaries
+{
+    diyfp w;
+    diyfp minus;
+    diyfp plus;
+} boundaries;
+
+/**
+ * \brief A cached power of ten, c = f * 2^e ~= 10^k.
+ */
+typedef struct cached_power
+{
+    uint64_t f;
+    int e;
+    int k;
+} cached_power;
+
+#define GRISU_ALPHA                             -60
+#define GRISU_GAMMA                             -32
+#define CACHED_POWERS_MIN_DEC_EXP               -300
+#define CACHED_POWERS_DEC_STEP                  8
+
+/**
+ * \brief Normalized powers of ten from 10^-300 to 10^324 in steps of 8.
+ */
+static const cached_power cached_powers[] = {
+    { 0xAB70FE17C79AC6CA, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+    { 0xBE5691EF416BD60C, -1007, -284 },
+    { 0x8DD01FAD907FFC3C,  -980, -276 },
+    { 0xD3515C2831559A83,  -954, -268 },
+    { 0x9D71AC8FADA6C9B5,  -927, -260 },
+    { 0xEA9C227723EE8BCB,  -901, -252 },
+    { 0xAECC49914078536D,  -874, -244 },
+    { 0x823C12795DB6CE57,  -847, -236 },
+    { 0xC21094364DFB5637,  -821, -228 },
+    { 0x9096EA6F3848984F,  -794, -220 },
+    { 0xD77485CB25823AC7,  -768, -212 },
+    { 0xA086CFCD97BF97F4,  -741, -204 },
+    { 0xEF340A98172AACE5,  -715, -196 },
+    { 0xB23867FB2A35B28E,  -688, -188 },
+    { 0x84C8D4DFD2C63F3B,  -661, -180 },
+    { 0xC5DD44271AD3CDBA,  -635, -172 },
+    { 0x936B9FCEBB25C996,  -608, -164 },
+    { 0xDBAC6C247D62A584,  -582, -156 },
+    { 0xA3AB66580D5FDAF6,  -555, -148 },
+    { 0xF3E2F893DEC3F126,  -529, -140 },
+    { 0xB5B5ADA8AAFF80B8,  -502, -132 },
+    { 0x87625F056C7C4A8B,  -475, -124 },
+    { 0xC9BCFF6034C13053,  -449, -116 },
+    { 0x964E858C91BA2655,  -422, -108 },
+    { 0xDFF9772470297EBD,  -396, -100 },
+    { 0xA6DFBD9FB8E5B88F,  -369,  -92 },
+    { 0xF8A95FCF88747D94,  -343,  -84 },
+    { 0xB94470938FA89BCF,  -316,  -76 },
+    { 0x8A08F0F8BF0F156B,  -289,  -68 },
+    { 0xCDB02555653131B6,  -263,  -60 },
+    { 0x993FE2C6D07B7FAC,  -236,  -52 },
+    { 0xE45C10C42A2B3B06,  -210,  -44 },
+    { 0xAA242499697392D3,  -183,  -36 },
+    { 0xFD87B5F28300CA0E,  -157,  -28 },
+    { 0xBCE5086492111AEB,  -130,  -20 },
+    { 0x8CBCCC096F5088CC,  -103,  -12 },
+    { 0xD1B71758E219652C,   -77,   -4 },
+    { 0x9C40000000000000,   -50,    4 },
+    { 0xE8D4A51000000000,   -24,   12 },
+    { 0xAD78EBC5AC620000,     3,   20 },
+    { 0x813F3978F8940984,    30,   28 },
+    { 0xC097CE7BC90715B3,    56,   36 },
+    { 0x8F7E32CE7BEA5C70,    83,   44 },
+    { 0xD5D238A4ABE98068,   109,   52 },
+    { 0x9F4F2726179A2245,   136,   60 },
+    { 0xED63A231D4C4FB27,   162,   68 },
+    { 0xB0DE65388CC8ADA8,   189,   76 },
+    { 0x83C7088E1AAB65DB,   216,   84 },
+    { 0xC45D1DF942711D9A,   242,   92 },
+    { 0x924D692CA61BE758,   269,  100 },
+    { 0xDA01EE641A708DEA,   295,  108 },
+    { 0xA26DA3999AEF774A,   322,  116 },
+    { 0xF209787BB47D6B85,   348,  124 },
+    { 0xB454E4A179DD1877,   375,  132 },
+    { 0x865B86925B9BC5C2,   402,  140 },
+    { 0xC83553C5C8965D3D,   428,  148 },
+    { 0x952AB45CFA97A0B3,   455,  156 },
+    { 0xDE469FBD99A05FE3,   481,  164 },
+    { 0xA59BC234DB398C25,   508,  172 },
+    { 0xF6C69A72A3989F5C,   534,  180 },
+    { 0xB7DCBF5354E9BECE,   561,  188 },
+    { 0x88FCF317F22241E2,   588,  196 },
+    { 0xCC20CE9BD35C78A5,   614,  204 },
+    { 0x98165AF37B2153DF,   641,  212 },
+    { 0xE2A0B5DC971F303A,   667,  220 },
+    { 0xA8D9D1535CE3B396,   694,  228 },
+    { 0xFB9B7CD9A4A7443C,   720,  236 },
+    { 0xBB764C4CA7A44410,   747,  244 },
+    { 0x8BAB8EEFB6409C1A,   774,  252 },
+    { 0xD01FEF10A657842C,   800,  260 },
+    { 0x9B10A4E5E9913129,   827,  268 },
+    { 0xE7109BFBA19C0C9D,   853,  276 },
+    { 0xAC2820D9623BF429,   880,  284 },
+    { 0x80444B5E7AA7CF85,   907,  292 },
+    { 0xBF21E44003ACDD2D,   933,  300 },
+    { 0x8E679C2F5E44FF8F,   960,  308 },
+    { 0xD433179D9C8CB841,   986,  316 },
+    { 0x9E19DB92B4E31BA9,  1013,  324 },
+};
+
+static diyfp diyfp_sub(diyfp x, diyfp y);
+static diyfp diyfp_mul(diyfp x, diyfp y);
+static diyfp diyfp_normalize(diyfp x);
+static diyfp diyfp_normalize_to(diyfp x, int target_exponent);
+static boundaries compute_boundaries(double val, bool single_precision);
+static cached_power cached_power_for_binary_exponent(int e);
+static int find_largest_pow10(uint32_t n, uint32_t* pow10);
+static void grisu2_round(
+    char* buf, size_t len, uint64_t dist, uint64_t delta, uint64_t rest,
+    uint64_t ten_k);
+static size_t grisu2_digit_gen(
+    char* buffer, int* decimal_exponent, diyfp m_minus, diyfp w,
+    diyfp m_plus);
+static size_t format_buffer(
+    char* buf, size_t len, int decimal_exponent, int min_exp, int max_exp);
+static size_t append_exponent(char* buf, int e);
+
+/**
+ * \brief Write the shortest round-trip decimal representation of the given
+ * floating point value to the given buffer.
+ *
+ * \param buffer            The buffer to receive the representation, which
+ *                          must be at least LOG_DTOA_BUFFER_SIZE bytes.  It is
+ *                          not zero-terminated.
+ * \param val               The value to convert.
+ * \param single_precision  If true, \p val holds a float, and the shortest
+ *                          representation that round-trips as a float is
+ *                          written.
+ *
+ * \returns the number of bytes written to the buffer.
+ */
+size_t
+vcservice_log_dtoa(char* buffer, double val, bool single_precision)
+{
+    char* out = buffer;
+    int decimal_exponent = 0;
+
+    /* handle non-finite values. */
+    if (val != val)
+    {
+        memcpy(out, "nan", 3);
+        return 3;
+    }
+
+    /* handle the sign. */
+    if (__builtin_signbit(val))
+    {
+        *out++ = '-';
+        val = -val;
+    }
+
+    if (__builtin_isinf(val))
+    {
+        memcpy(out, "inf", 3);
+        return out - buffer + 3;
+    }
+
+    if (0.0 == val)
+    {
+        memcpy(out, "0.0", 3);
+        return out - buffer + 3;
+    }
+
+    /* compute the boundaries of this value. */
+    boundaries b = compute_boundaries(val, single_precision);
+
+    /* generate the digits. */
+    size_t len = grisu2_digit_gen(out, &decimal_exponent, b.minus, b.w, b.plus);
+
+    /* format the digits. */
+    len =
+        format_buffer(
+            out, len, decimal_exponent, -4, single_precision ? 6 : 15);
+
+    return out - buffer + len;
+}
+
+/**
+ * \brief Subtract y from x; the exponents must match and x must be >= y.
+ */
+static diyfp diyfp_sub(diyfp x, diyfp y)
+{
+    diyfp ret = { x.f - y.f, x.e };
+
+    return ret;
+}
+
+/**
+ * \brief Multiply x by y, rounding the 128-bit product to 64 bits.
+ */
+static diyfp diyfp_mul(diyfp x, diyfp y)
+{
+    const uint64_t u_lo = x.f & 0xFFFFFFFFu;
+    const uint64_t u_hi = x.f >> 32u;
+    const uint64_t v_lo = y.f & 0xFFFFFFFFu;
+    const uint64_t v_hi = y.f >> 32u;
+
+    const uint64_t p0 = u_lo * v_lo;
+    const uint64_t p1 = u_lo * v_hi;
+    const uint64_t p2 = u_hi * v_lo;
+    const uint64_t p3 = u_hi * v_hi;
+
+    const uint64_t p0_hi = p0 >> 32u;
+    const uint64_t p1_lo = p1 & 0xFFFFFFFFu;
+    const uint64_t p1_hi = p1 >> 32u;
+    const uint64_t p2_lo = p2 & 0xFFFFFFFFu;
+    const uint64_t p2_hi = p2 >> 32u;
+
+    uint64_t q = p0_hi + p1_lo + p2_lo;
+
+    /* round, ties up. */
+    q += (uint64_t)1u << (64u - 32u - 1u);
+
+    diyfp ret = { p3 + p2_hi + p1_hi + (q >> 32u), x.e + y.e + 64 };
+
+    return ret;
+}
+
+/**
+ * \brief Normalize x such that its most significant bit is set.
+ */
+static diyfp diyfp_normalize(diyfp x)
+{
+    int shift = __builtin_clzll(x.f);
+    diyfp ret = { x.f << shift, x.e - shift };
+
+    return ret;
+}
+
+/**
+ * \brief Normalize x such that its exponent is the target exponent.
+ */
+static diyfp diyfp_normalize_to(diyfp x, int target_exponent)
+{
+    const int delta = x.e - target_exponent;
+    diyfp ret = { x.f << delta, target_exponent };
+
+    return ret;
+}
+
+/**
+ * \brief Compute the normalized value and the normalized boundaries m- and m+
+ * of the given positive finite value.
+ */
+static boundaries compute_boundaries(double val, bool single_precision)
+{
+    uint64_t f;
+    int e;
+    bool lower_boundary_is_closer;
+
+    if (single_precision)
+    {
+        const float fval = (float)val;
+        uint32_t bits;
+        memcpy(&bits, &fval, sizeof(bits));
+
+        const uint32_t biased_e = bits >> 23u;
+        const uint32_t fraction = bits & 0x7FFFFFu;
+
+        if (0 == biased_e)
+        {
+            f = fraction;
+            e = 1 - 150;
+        }
+        else
+        {
+            f = fraction + 0x800000u;
+            e = (int)biased_e - 150;
+        }
+
+        lower_boundary_is_closer = 0 == fraction && biased_e > 1;
+    }
+    else
+    {
+        uint64_t bits;
+        memcpy(&bits, &val, sizeof(bits));
+
+        const uint64_t biased_e = bits >> 52u;
+        const uint64_t fraction = bits & 0xFFFFFFFFFFFFFull;
+
+        if (0 == biased_e)
+        {
+            f = fraction;
+            e = 1 - 1075;
+        }
+        else
+        {
+            f = fraction + 0x10000000000000ull;
+            e = (int)biased_e - 1075;
+        }
+
+        lower_boundary_is_closer = 0 == fraction && biased_e > 1;
+    }
+
+    /* the boundaries are halfway between this value and its neighbors. */
+    diyfp v = { f, e };
+    diyfp m_plus = { 2 * f + 1, e - 1 };
+    diyfp m_minus;
+    if (lower_boundary_is_closer)
+    {
+        m_minus.f = 4 * f - 1;
+        m_minus.e = e - 2;
+    }
+    else
+    {
+        m_minus.f = 2 * f - 1;
+        m_minus.e = e - 1;
+    }
+
+    boundaries ret;
+    ret.plus = diyfp_normalize(m_plus);
+    ret.minus = diyfp_normalize_to(m_minus, ret.plus.e);
+    ret.w = diyfp_normalize(v);
+
+    return ret;
+}
+
+/**
+ * \brief Get a cached power of ten, c, such that the binary exponent of the
+ * product of c and a value with binary exponent e is in [alpha, gamma].
+ */
+static cached_power cached_power_for_binary_exponent(int e)
+{
+    const int f = GRISU_ALPHA - e - 1;
+    const int k = (f * 78913) / (1 << 18) + (f > 0);
+    const int index =
+        (-CACHED_POWERS_MIN_DEC_EXP + k + (CACHED_POWERS_DEC_STEP - 1))
+            / CACHED_POWERS_DEC_STEP;
+
+    return cached_powers[index];
+}
+
+/**
+ * \brief Find the largest power of ten less than or equal to n, returning the
+ * number of decimal digits in n.
+ */
+static int find_largest_pow10(uint32_t n, uint32_t* pow10)
+{
+    static const uint32_t powers[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+        1000000000 };
+
+    int digits = 10;
+    while (digits > 1 && n < powers[digits - 1])
+    {
+        --digits;
+    }
+
+    *pow10 = powers[digits - 1];
+
+    return digits;
+}
+
+/**
+ * \brief Round the last digit of the buffer towards the exact value, while
+ * staying within the rounding interval.
+ */
+static void grisu2_round(
+    char* buf, size_t len, uint64_t dist, uint64_t delta, uint64_t rest,
+    uint64_t ten_k)
+{
+    while (
+        rest < dist
+     && delta - rest >= ten_k
+     && (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+    {
+        buf[len - 1]--;
+        rest += ten_k;
+    }
+}
+
+/**
+ * \brief Generate the shortest digits of w that lie within (m-, m+).
+ */
+static size_t grisu2_digit_gen(
+    char* buffer, int* decimal_exponent, diyfp m_minus, diyfp w,
+    diyfp m_plus)
+{
+    /* scale the value and its boundaries by a cached power of ten. */
+    const cached_power cached = cached_power_for_binary_exponent(m_plus.e);
+    const diyfp c_minus_k = { cached.f, cached.e };
+
+    const diyfp w_scaled = diyfp_mul(w, c_minus_k);
+    const diyfp w_minus = diyfp_mul(m_minus, c_minus_k);
+    const diyfp w_plus = diyfp_mul(m_plus, c_minus_k);
+
+    /* shrink the interval by one ulp on each side to stay conservative. */
+    const diyfp lo = { w_minus.f + 1, w_minus.e };
+    const diyfp hi = { w_plus.f - 1, w_plus.e };
+
+    *decimal_exponent = -cached.k;
+
+    uint64_t delta = diyfp_sub(hi, lo).f;
+    uint64_t dist = diyfp_sub(hi, w_scaled).f;
+
+    /* split hi into integral and fractional parts. */
+    const diyfp one = { (uint64_t)1 << -hi.e, hi.e };
+    uint32_t p1 = (uint32_t)(hi.f >> -one.e);
+    uint64_t p2 = hi.f & (one.f - 1);
+    size_t length = 0;
+
+    /* generate the digits of the integral part. */
+    uint32_t pow10;
+    int n = find_largest_pow10(p1, &pow10);
+    while (n > 0)
+    {
+        const uint32_t d = p1 / pow10;
+        const uint32_t r = p1 % pow10;
+
+        buffer[length++] = (char)('0' + d);
+        p1 = r;
+        --n;
+
+        const uint64_t rest = ((uint64_t)p1 << -one.e) + p2;
+        if (rest <= delta)
+        {
+            *decimal_exponent += n;
+            grisu2_round(
+                buffer, length, dist, delta, rest,
+                (uint64_t)pow10 << -one.e);
+
+            return length;
+        }
+
+        pow10 /= 10;
+    }
+
+    /* generate the digits of the fractional part. */
+    int m = 0;
+    for (;;)
+    {
+        p2 *= 10;
+        const uint64_t d = p2 >> -one.e;
+        const uint64_t r = p2 & (one.f - 1);
+
+        buffer[length++] = (char)('0' + d);
+        p2 = r;
+        ++m;
+
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta)
+        {
+            break;
+        }
+    }
+
+    *decimal_exponent -= m;
+    grisu2_round(buffer, length, dist, delta, p2, one.f);
+
+    return length;
+}
+
+/**
+ * \brief Format the digits in the buffer as fixed or scientific notation.
+ */
+static size_t format_buffer(
+    char* buf, size_t len, int decimal_exponent, int min_exp, int max_exp)
+{
+    const int k = (int)len;
+    const int n = k + decimal_exponent;
+
+    /* digits[000].0 */
+    if (k <= n && n <= max_exp)
+    {
+        memset(buf + k, '0', n - k);
+        buf[n] = '.';
+        buf[n + 1] = '0';
+
+        return n + 2;
+    }
+
+    /* dig.its */
+    if (0 < n && n <= max_exp)
+    {
+        memmove(buf + n + 1, buf + n, k - n);
+        buf[n] = '.';
+
+        return k + 1;
+    }
+
+    /* 0.[000]digits */
+    if (min_exp < n && n <= 0)
+    {
+        memmove(buf + 2 + -n, buf, k);
+        buf[0] = '0';
+        buf[1] = '.';
+        memset(buf + 2, '0', -n);
+
+        return 2 + -n + k;
+    }
+
+    /* d.igitsE+123 */
+    size_t offset;
+    if (1 == k)
+    {
+        offset = 1;
+    }
+    else
+    {
+        memmove(buf + 2, buf + 1, k - 1);
+        buf[1] = '.';
+        offset = 1 + k;
+    }
+
+    buf[offset++] = 'e';
+
+    return offset + append_exponent(buf + offset, n - 1);
+}
+
+/**
+ * \brief Append a signed exponent of at least two digits to the buffer.
+ */
+static size_t append_exponent(char* buf, int e)
+{
+    size_t offset = 0;
+
+    if (e < 0)
+    {
+        e = -e;
+        buf[offset++] = '-';
+    }
+    else
+    {
+        buf[offset++] = '+';
+    }
+
+    if (e < 10)
+    {
+        buf[offset++] = '0';
+        buf[offset++] = (char)('0' + e);
+    }
+    else if (e < 100)
+    {
+        buf[offset++] = (char)('0' + e / 10);
+        buf[offset++] = (char)('0' + e % 10);
+    }
+    else
+    {
+        buf[offset++] = (char)('0' + e / 100);
+        e %= 100;
+        buf[offset++] = (char)('0' + e / 10);
+        buf[offset++] = (char)('0' + e % 10);
+    }
+
+    return offset;
+}
@@ -0,0 +1,96 @@
+/**
+ * \file log/vcservice_log_encrypted_context_resource_release.c
+ *
+ * \brief Release the encrypted sink user context.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release the encrypted sink user context, writing the last block.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE if any block could not be
+ *        encrypted or written.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_encrypted_context_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_log_encrypted_context* ctx =
+        (vcservice_log_encrypted_context*)r;
+    status slots_retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    bool failed;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = ctx->alloc;
+
+    /* submit the partial block, then let the workers drain. */
+    pthread_mutex_lock(&ctx->mutex);
+    vcservice_log_encrypted_submit(ctx);
+    ctx->stop = true;
+    pthread_cond_broadcast(&ctx->work_cond);
+    pthread_mutex_unlock(&ctx->mutex);
+
+    for (unsigned int i = 0; i < ctx->worker_count; ++i)
+    {
+        pthread_join(ctx->workers[i], NULL);
+    }
+
+    failed = ctx->failed;
+
+    pthread_cond_destroy(&ctx->space_cond);
+    pthread_cond_destroy(&ctx->work_cond);
+    pthread_mutex_destroy(&ctx->mutex);
+
+    /* the slot buffers share one allocation. */
+    memset(
+        ctx->slots[0].plain, 0,
+        ctx->slot_count * ctx->block_size);
+    slots_retval = rcpr_allocator_reclaim(alloc, ctx->slots);
+
+    /* release the crypto state. */
+    memset(ctx->key.data, 0, ctx->key.size);
+    dispose((disposable_t*)&ctx->key);
+    dispose((disposable_t*)&ctx->suite);
+    dispose((disposable_t*)&ctx->alloc_opts);
+
+    /* the descriptor is owned by this context. */
+    if (0 != close(ctx->desc))
+    {
+        failed = true;
+    }
+
+    /* clear memory. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx);
+
+    /* decode return code. */
+    if (STATUS_SUCCESS != slots_retval)
+    {
+        return slots_retval;
+    }
+    else if (failed)
+    {
+        return VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE;
+    }
+    else
+    {
+        return reclaim_retval;
+    }
+}
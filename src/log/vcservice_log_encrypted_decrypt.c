@@ -0,0 +1,331 @@
+/**
+ * \file log/vcservice_log_encrypted_decrypt.c
+ *
+ * \brief Decrypt an encrypted log.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static status read_exactly(int desc, void* buffer, size_t size, bool* eof);
+static status write_all(int desc, const void* buffer, size_t size);
+static uint32_t decode_uint32(const uint8_t* in);
+static status decrypt_blocks(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* file_key,
+    uint8_t* cipher, uint8_t* plain, size_t block_size, int out_desc,
+    int in_desc);
+
+/**
+ * \brief Decrypt an encrypted log, writing the plaintext to a descriptor.
+ *
+ * \param alloc                 The allocator to use for block buffers.
+ * \param out_desc              The descriptor to which plaintext is written.
+ * \param in_desc               The descriptor of the encrypted log.
+ * \param key                   The raw key the log was written with.
+ * \param key_size              The size of the key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY if the key size does not
+ *        match the crypto suite.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED if the header or a block is
+ *        malformed, truncated, or out of order.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_READ if the log could not be read.
+ *      - VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE if the plaintext could not be
+ *        written.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_encrypted_decrypt(
+    RCPR_SYM(allocator)* alloc, int out_desc, int in_desc, const void* key,
+    size_t key_size)
+{
+    status retval, reclaim_retval;
+    uint8_t header[LOG_ENCRYPTED_HEADER_SIZE];
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t file_key;
+    size_t block_size;
+    uint8_t* buffers;
+    bool eof;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    RCPR_MODEL_ASSERT(out_desc >= 0);
+    RCPR_MODEL_ASSERT(in_desc >= 0);
+    RCPR_MODEL_ASSERT(NULL != key);
+
+    /* set up the crypto suite used for decryption. */
+    malloc_allocator_options_init(&alloc_opts);
+    vccrypt_suite_register_velo_v1();
+    retval =
+        vccrypt_suite_options_init(&suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc_opts;
+    }
+
+    if (key_size != suite.stream_cipher_opts.key_size
+     || LOG_ENCRYPTED_IV_SIZE != suite.stream_cipher_opts.IV_size)
+    {
+        retval = VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY;
+        goto cleanup_suite;
+    }
+
+    /* magic, salt, block size. */
+    retval = read_exactly(in_desc, header, sizeof(header), &eof);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_suite;
+    }
+
+    block_size = decode_uint32(header + sizeof(header) - 4);
+    if (eof
+     || 0 != memcmp(header, LOG_ENCRYPTED_MAGIC, LOG_ENCRYPTED_MAGIC_SIZE)
+     || 0 == block_size
+     || block_size > UINT32_MAX - 4 - LOG_ENCRYPTED_IV_SIZE)
+    {
+        retval = VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED;
+        goto cleanup_suite;
+    }
+
+    retval = vccrypt_buffer_init(&file_key, &alloc_opts, key_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_suite;
+    }
+
+    retval =
+        vcservice_log_encrypted_derive_key(
+            &suite, &file_key, key, key_size,
+            header + LOG_ENCRYPTED_MAGIC_SIZE);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_file_key;
+    }
+
+    /* one cipher block and one plaintext block. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&buffers,
+            2 * block_size + 4 + LOG_ENCRYPTED_IV_SIZE);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_file_key;
+    }
+
+    retval =
+        decrypt_blocks(
+            &suite, &file_key, buffers, buffers + block_size + 4
+                + LOG_ENCRYPTED_IV_SIZE,
+            block_size, out_desc, in_desc);
+
+    memset(buffers, 0, 2 * block_size + 4 + LOG_ENCRYPTED_IV_SIZE);
+    reclaim_retval = rcpr_allocator_reclaim(alloc, buffers);
+    if (STATUS_SUCCESS != reclaim_retval && STATUS_SUCCESS == retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_file_key:
+    memset(file_key.data, 0, file_key.size);
+    dispose((disposable_t*)&file_key);
+
+cleanup_suite:
+    dispose((disposable_t*)&suite);
+
+cleanup_alloc_opts:
+    dispose((disposable_t*)&alloc_opts);
+
+    return retval;
+}
+
+/**
+ * \brief Decrypt every block following the header.
+ *
+ * \param suite         The crypto suite to use.
+ * \param file_key      The per-file key.
+ * \param cipher        A buffer for one encrypted block.
+ * \param plain         A buffer for one plaintext block.
+ * \param block_size    The plaintext block size from the header.
+ * \param out_desc      The descriptor to which plaintext is written.
+ * \param in_desc       The descriptor of the encrypted log.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status decrypt_blocks(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* file_key,
+    uint8_t* cipher, uint8_t* plain, size_t block_size, int out_desc,
+    int in_desc)
+{
+    status retval;
+    uint8_t expected_iv[LOG_ENCRYPTED_IV_SIZE];
+    bool eof;
+
+    for (uint64_t index = 0; ; ++index)
+    {
+        vccrypt_stream_context_t stream;
+        size_t in_offset = 0, out_offset = 0;
+
+        /* the size of the IV and ciphertext that follow. */
+        retval = read_exactly(in_desc, cipher, 4, &eof);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+        else if (eof)
+        {
+            return STATUS_SUCCESS;
+        }
+
+        size_t size = decode_uint32(cipher);
+        if (size <= LOG_ENCRYPTED_IV_SIZE
+         || size > LOG_ENCRYPTED_IV_SIZE + block_size)
+        {
+            return VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED;
+        }
+
+        retval = read_exactly(in_desc, cipher, size, &eof);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* blocks must be complete and in order. */
+        vcservice_log_store_be64(expected_iv, index);
+        if (eof || 0 != memcmp(cipher, expected_iv, sizeof(expected_iv)))
+        {
+            return VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED;
+        }
+
+        retval = vccrypt_suite_stream_init(suite, &stream, file_key);
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval = vccrypt_stream_start_decryption(&stream, cipher, &in_offset);
+        if (VCCRYPT_STATUS_SUCCESS == retval)
+        {
+            retval =
+                vccrypt_stream_decrypt(
+                    &stream, cipher + in_offset, size - in_offset, plain,
+                    &out_offset);
+        }
+
+        dispose((disposable_t*)&stream);
+
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval = write_all(out_desc, plain, out_offset);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+}
+
+/**
+ * \brief Read exactly the given number of bytes, unless at end of file.
+ *
+ * \param desc          The descriptor to read.
+ * \param buffer        The buffer to receive the data.
+ * \param size          The number of bytes to read.
+ * \param eof           Set to true if end of file was reached first.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status read_exactly(int desc, void* buffer, size_t size, bool* eof)
+{
+    size_t offset = 0;
+
+    *eof = false;
+
+    while (offset < size)
+    {
+        ssize_t bytes_read =
+            read(desc, (uint8_t*)buffer + offset, size - offset);
+        if (bytes_read < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            return VCSERVICE_ERROR_LOG_ENCRYPTED_READ;
+        }
+        else if (0 == bytes_read)
+        {
+            /* a partial read at end of file is a truncated log. */
+            if (offset > 0)
+            {
+                return VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED;
+            }
+
+            *eof = true;
+            return STATUS_SUCCESS;
+        }
+
+        offset += (size_t)bytes_read;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write the whole buffer.
+ *
+ * \param desc          The descriptor to write.
+ * \param buffer        The data to write.
+ * \param size          The size of the data.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status write_all(int desc, const void* buffer, size_t size)
+{
+    size_t offset = 0;
+
+    while (offset < size)
+    {
+        ssize_t written =
+            write(desc, (const uint8_t*)buffer + offset, size - offset);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            return VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE;
+        }
+
+        offset += (size_t)written;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Read a big-endian 32-bit value.
+ *
+ * \param in            The four byte input buffer.
+ *
+ * \returns the value.
+ */
+static uint32_t decode_uint32(const uint8_t* in)
+{
+    return
+        ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16)
+      | ((uint32_t)in[2] << 8) | (uint32_t)in[3];
+}
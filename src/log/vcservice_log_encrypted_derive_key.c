@@ -0,0 +1,84 @@
+/**
+ * \file log/vcservice_log_encrypted_derive_key.c
+ *
+ * \brief Derive the per-file key for an encrypted log.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Derive the per-file key from the caller's key and the file's salt.
+ *
+ * The per-file key is the leading bytes of SHA-512 over the caller's key and
+ * the salt.
+ *
+ * \param suite         The crypto suite to use.
+ * \param file_key      The buffer to receive the per-file key, which must be
+ *                      initialized to the stream cipher key size.
+ * \param key           The caller's key.
+ * \param key_size      The size of the caller's key.
+ * \param salt          The salt, of \ref LOG_ENCRYPTED_SALT_SIZE bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_encrypted_derive_key(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* file_key,
+    const void* key, size_t key_size, const uint8_t* salt)
+{
+    status retval;
+    vccrypt_hash_context_t hash;
+    vccrypt_buffer_t digest;
+
+    retval = vccrypt_suite_buffer_init_for_hash(suite, &digest);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval = vccrypt_suite_hash_init(suite, &hash);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_digest;
+    }
+
+    retval = vccrypt_hash_digest(&hash, (const uint8_t*)key, key_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    retval = vccrypt_hash_digest(&hash, salt, LOG_ENCRYPTED_SALT_SIZE);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    retval = vccrypt_hash_finalize(&hash, &digest);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    memcpy(file_key->data, digest.data, file_key->size);
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_hash;
+
+cleanup_hash:
+    dispose((disposable_t*)&hash);
+
+cleanup_digest:
+    memset(digest.data, 0, digest.size);
+    dispose((disposable_t*)&digest);
+
+done:
+    return retval;
+}
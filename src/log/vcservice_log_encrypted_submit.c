@@ -0,0 +1,29 @@
+/**
+ * \file log/vcservice_log_encrypted_submit.c
+ *
+ * \brief Submit a block to the encrypted sink's workers.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Submit the block being filled to the encryption workers.
+ *
+ * \param ctx           The encrypted context, whose mutex is held.
+ */
+void
+vcservice_log_encrypted_submit(vcservice_log_encrypted_context* ctx)
+{
+    /* nothing to do if no block is being filled. */
+    if (NULL == ctx->filling)
+    {
+        return;
+    }
+
+    ctx->filling->state = LOG_ENCRYPTED_SLOT_READY;
+    ctx->filling = NULL;
+    ++ctx->submitted;
+    pthread_cond_signal(&ctx->work_cond);
+}
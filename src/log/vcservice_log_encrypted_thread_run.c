@@ -0,0 +1,248 @@
+/**
+ * \file log/vcservice_log_encrypted_thread_run.c
+ *
+ * \brief Worker thread for the encrypted sink.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+static status encrypt_block(
+    vcservice_log_encrypted_context* ctx, vcservice_log_encrypted_slot* slot);
+static status write_block(
+    vcservice_log_encrypted_context* ctx,
+    const vcservice_log_encrypted_slot* slot);
+static void write_done_blocks(vcservice_log_encrypted_context* ctx);
+static void wait_for_work(vcservice_log_encrypted_context* ctx);
+
+/**
+ * \brief Entry point for the encrypted sink's worker threads.
+ *
+ * \param context       The \ref vcservice_log_encrypted_context for this
+ *                      thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_log_encrypted_thread_run(void* context)
+{
+    vcservice_log_encrypted_context* ctx =
+        (vcservice_log_encrypted_context*)context;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    for (;;)
+    {
+        while (!ctx->stop && ctx->next_encrypt == ctx->submitted)
+        {
+            wait_for_work(ctx);
+        }
+
+        /* every submitted block is encrypted before the workers exit. */
+        if (ctx->next_encrypt == ctx->submitted)
+        {
+            break;
+        }
+
+        vcservice_log_encrypted_slot* slot =
+            &ctx->slots[ctx->next_encrypt % ctx->slot_count];
+        ++ctx->next_encrypt;
+        pthread_mutex_unlock(&ctx->mutex);
+
+        status retval = encrypt_block(ctx, slot);
+
+        pthread_mutex_lock(&ctx->mutex);
+        if (STATUS_SUCCESS != retval)
+        {
+            /* an empty block keeps the ordering; report it on release. */
+            slot->cipher_size = 0;
+            ctx->failed = true;
+        }
+
+        slot->state = LOG_ENCRYPTED_SLOT_DONE;
+        write_done_blocks(ctx);
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    return NULL;
+}
+
+/**
+ * \brief Wait for a block to be submitted, submitting the filling block
+ * ourselves if it is still filling at its flush deadline.
+ *
+ * \param ctx           The encrypted context, whose mutex is held.
+ */
+static void wait_for_work(vcservice_log_encrypted_context* ctx)
+{
+    struct timespec now;
+
+    if (NULL == ctx->filling)
+    {
+        pthread_cond_wait(&ctx->work_cond, &ctx->mutex);
+        return;
+    }
+
+    if (ETIMEDOUT
+            != pthread_cond_timedwait(
+                    &ctx->work_cond, &ctx->mutex, &ctx->flush_deadline))
+    {
+        return;
+    }
+
+    /* the writer may have claimed a newer block with a later deadline. */
+    clock_gettime(CLOCK_REALTIME, &now);
+    if (NULL != ctx->filling
+     && (now.tv_sec > ctx->flush_deadline.tv_sec
+      || (now.tv_sec == ctx->flush_deadline.tv_sec
+       && now.tv_nsec >= ctx->flush_deadline.tv_nsec)))
+    {
+        vcservice_log_encrypted_submit(ctx);
+    }
+}
+
+/**
+ * \brief Write the block at next_write, and any done blocks following it,
+ * unless another worker is already doing so.
+ *
+ * The mutex is held on entry and on exit, but not while writing.
+ *
+ * \param ctx           The encrypted context.
+ */
+static void write_done_blocks(vcservice_log_encrypted_context* ctx)
+{
+    if (ctx->writing)
+    {
+        /* the current writer picks up this block when it gets to it. */
+        return;
+    }
+
+    ctx->writing = true;
+
+    for (;;)
+    {
+        vcservice_log_encrypted_slot* slot =
+            &ctx->slots[ctx->next_write % ctx->slot_count];
+
+        if (LOG_ENCRYPTED_SLOT_DONE != slot->state
+         || ctx->next_write != slot->index)
+        {
+            break;
+        }
+
+        pthread_mutex_unlock(&ctx->mutex);
+        status retval = write_block(ctx, slot);
+        pthread_mutex_lock(&ctx->mutex);
+
+        if (STATUS_SUCCESS != retval)
+        {
+            ctx->failed = true;
+        }
+
+        slot->state = LOG_ENCRYPTED_SLOT_FREE;
+        ++ctx->next_write;
+        pthread_cond_signal(&ctx->space_cond);
+    }
+
+    ctx->writing = false;
+}
+
+/**
+ * \brief Encrypt a block into its cipher buffer.
+ *
+ * \param ctx           The encrypted context.
+ * \param slot          The slot holding the block.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status encrypt_block(
+    vcservice_log_encrypted_context* ctx, vcservice_log_encrypted_slot* slot)
+{
+    status retval;
+    vccrypt_stream_context_t stream;
+    uint8_t iv[LOG_ENCRYPTED_IV_SIZE];
+    size_t offset = 4;
+
+    /* the block index is unique under the per-file key. */
+    vcservice_log_store_be64(iv, slot->index);
+
+    retval = vccrypt_suite_stream_init(&ctx->suite, &stream, &ctx->key);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        vccrypt_stream_start_encryption(
+            &stream, iv, sizeof(iv), slot->cipher, &offset);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_stream;
+    }
+
+    retval =
+        vccrypt_stream_encrypt(
+            &stream, slot->plain, slot->size, slot->cipher, &offset);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_stream;
+    }
+
+    /* prefix the block with the size of the IV and ciphertext. */
+    slot->cipher[0] = (uint8_t)((offset - 4) >> 24);
+    slot->cipher[1] = (uint8_t)((offset - 4) >> 16);
+    slot->cipher[2] = (uint8_t)((offset - 4) >> 8);
+    slot->cipher[3] = (uint8_t)(offset - 4);
+    slot->cipher_size = offset;
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_stream;
+
+cleanup_stream:
+    dispose((disposable_t*)&stream);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Write an encrypted block to the descriptor.
+ *
+ * \param ctx           The encrypted context.
+ * \param slot          The slot holding the block.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status write_block(
+    vcservice_log_encrypted_context* ctx,
+    const vcservice_log_encrypted_slot* slot)
+{
+    size_t offset = 0;
+
+    while (offset < slot->cipher_size)
+    {
+        ssize_t written =
+            write(
+                ctx->desc, slot->cipher + offset, slot->cipher_size - offset);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            return VCSERVICE_ERROR_LOG_ENCRYPTED_WRITE;
+        }
+
+        offset += (size_t)written;
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,28 @@
+/**
+ * \file log/vcservice_log_hex_encode.c
+ *
+ * \brief Write a value as lowercase hex digits.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Write the given value as lowercase hex digits.
+ *
+ * \param out           The output buffer, which must hold 2 * size bytes.
+ * \param data          The data to write.
+ * \param size          The size of the data.
+ */
+void
+vcservice_log_hex_encode(char* out, const uint8_t* data, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        out[2 * i] = digits[data[i] >> 4];
+        out[2 * i + 1] = digits[data[i] & 0x0F];
+    }
+}
@@ -0,0 +1,189 @@
+/**
+ * \file log/vcservice_log_layout_apply.c
+ *
+ * \brief Lay out a log message with a compiled layout.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief This thread's id, or 0 until it is first needed.
+ */
+static __thread pid_t layout_thread_id = 0;
+
+static void refresh_time(vcservice_log_layout* layout, time_t second);
+static size_t format_digits(char* out, uint64_t value, size_t width);
+
+/**
+ * \brief Lay out the current message with the logger's layout program.
+ *
+ * \param log           The \ref vcservice_log instance, which must have a
+ *                      layout.  The message holds just the body on entry,
+ *                      and the whole line on return.
+ */
+void
+vcservice_log_layout_apply(vcservice_log* log)
+{
+    vcservice_log_layout* layout = log->layout;
+    vcservice_log_trace_context* trace;
+    struct timespec now;
+    bool have_time = false;
+    char number[20];
+    const char* field;
+    size_t size;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(NULL != layout);
+
+    /* leave room for the newline added on commit. */
+    char* out = layout->scratch;
+    char* end = layout->scratch + sizeof(layout->scratch) - 1;
+
+    for (size_t i = 0; i < layout->op_count; ++i)
+    {
+        const vcservice_log_layout_op* op = &layout->ops[i];
+
+        switch (op->code)
+        {
+            case LOG_LAYOUT_OP_LITERAL:
+                field = layout->literals + op->offset;
+                size = op->size;
+                break;
+
+            case LOG_LAYOUT_OP_DATE:
+            case LOG_LAYOUT_OP_TIME:
+            case LOG_LAYOUT_OP_MICROSECONDS:
+                /* read the clock once per message. */
+                if (!have_time)
+                {
+                    clock_gettime(CLOCK_REALTIME, &now);
+                    have_time = true;
+                    if (now.tv_sec != layout->cached_second)
+                    {
+                        refresh_time(layout, now.tv_sec);
+                    }
+                }
+
+                if (LOG_LAYOUT_OP_DATE == op->code)
+                {
+                    field = layout->cached_date;
+                    size = LOG_LAYOUT_DATE_SIZE;
+                }
+                else if (LOG_LAYOUT_OP_TIME == op->code)
+                {
+                    field = layout->cached_time;
+                    size = LOG_LAYOUT_TIME_SIZE;
+                }
+                else
+                {
+                    field = number;
+                    size = format_digits(number, now.tv_nsec / 1000, 6);
+                }
+                break;
+
+            case LOG_LAYOUT_OP_LEVEL:
+                /* the name without the default line's separating space. */
+                field = vcservice_log_level_name(log->log_level);
+                size = LOG_LAYOUT_LEVEL_SIZE;
+                break;
+
+            case LOG_LAYOUT_OP_CONTEXT:
+                /* the context text ends with a separating space. */
+                trace = vcservice_log_trace_current;
+                field = NULL == trace ? "" : trace->text;
+                size = NULL == trace ? 0 : sizeof(trace->text) - 1;
+                break;
+
+            case LOG_LAYOUT_OP_THREAD:
+                if (0 == layout_thread_id)
+                {
+                    layout_thread_id = (pid_t)syscall(SYS_gettid);
+                }
+
+                field = number;
+                size = format_digits(number, (uint64_t)layout_thread_id, 1);
+                break;
+
+            default:
+                field = log->log_message;
+                size = log->log_idx;
+                break;
+        }
+
+        if (size > (size_t)(end - out))
+        {
+            size = (size_t)(end - out);
+        }
+
+        memcpy(out, field, size);
+        out += size;
+    }
+
+    log->log_idx = (size_t)(out - layout->scratch);
+    memcpy(log->log_message, layout->scratch, log->log_idx);
+}
+
+/**
+ * \brief Format the local date and time of a new second.
+ *
+ * \param layout        The layout holding the cache.
+ * \param second        The current second.
+ */
+static void refresh_time(vcservice_log_layout* layout, time_t second)
+{
+    struct tm local;
+    char* out;
+
+    localtime_r(&second, &local);
+
+    out = layout->cached_date;
+    format_digits(out, (uint64_t)local.tm_year + 1900, 4);
+    out[4] = '-';
+    format_digits(out + 5, (uint64_t)local.tm_mon + 1, 2);
+    out[7] = '-';
+    format_digits(out + 8, (uint64_t)local.tm_mday, 2);
+
+    out = layout->cached_time;
+    format_digits(out, (uint64_t)local.tm_hour, 2);
+    out[2] = ':';
+    format_digits(out + 3, (uint64_t)local.tm_min, 2);
+    out[5] = ':';
+    format_digits(out + 6, (uint64_t)local.tm_sec, 2);
+
+    layout->cached_second = second;
+}
+
+/**
+ * \brief Format a value in decimal, with leading zeros to the given width.
+ *
+ * \param out           The output buffer, which must hold 20 bytes.
+ * \param value         The value to format.
+ * \param width         The least number of digits.
+ *
+ * \returns the number of digits written.
+ */
+static size_t format_digits(char* out, uint64_t value, size_t width)
+{
+    char digits[20];
+    size_t size = 0;
+
+    do
+    {
+        digits[size++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0 || size < width);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        out[i] = digits[size - 1 - i];
+    }
+
+    return size;
+}
@@ -0,0 +1,165 @@
+/**
+ * \file log/vcservice_log_layout_compile.c
+ *
+ * \brief Compile a log layout pattern.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static int field_code(char field);
+
+/**
+ * \brief Compile a layout pattern.
+ *
+ * \param layout        Pointer to receive the compiled layout on success.
+ *                      It is reclaimed with the given allocator.
+ * \param alloc         The allocator for the layout.
+ * \param pattern       The layout pattern.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_LAYOUT_INVALID if the pattern is not valid.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_layout_compile(
+    vcservice_log_layout** layout, RCPR_SYM(allocator)* alloc,
+    const char* pattern)
+{
+    status retval, release_retval;
+    vcservice_log_layout* tmp;
+    vcservice_log_layout_op* op;
+    char* literals;
+    size_t literal_size = 0;
+    bool has_message = false;
+
+    size_t pattern_size = strlen(pattern);
+    if (pattern_size > VCSERVICE_LOG_LAYOUT_MAX_SIZE)
+    {
+        return VCSERVICE_ERROR_LOG_LAYOUT_INVALID;
+    }
+
+    /* each character yields at most one op, and the literals are no longer
+     * than the pattern. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp,
+            sizeof(*tmp) + pattern_size * sizeof(vcservice_log_layout_op)
+                + pattern_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->ops = (vcservice_log_layout_op*)(tmp + 1);
+    literals = (char*)(tmp->ops + pattern_size);
+    tmp->literals = literals;
+    tmp->cached_second = (time_t)-1;
+
+    for (const char* i = pattern; *i; ++i)
+    {
+        int code = LOG_LAYOUT_OP_LITERAL;
+
+        if ('%' == *i)
+        {
+            ++i;
+            if ('%' != *i)
+            {
+                code = field_code(*i);
+                if (code < 0)
+                {
+                    retval = VCSERVICE_ERROR_LOG_LAYOUT_INVALID;
+                    goto cleanup_layout;
+                }
+            }
+        }
+
+        if (LOG_LAYOUT_OP_LITERAL != code)
+        {
+            has_message = has_message || LOG_LAYOUT_OP_MESSAGE == code;
+
+            op = &tmp->ops[tmp->op_count++];
+            op->code = (uint16_t)code;
+            continue;
+        }
+
+        /* runs of literal text are copied by a single op. */
+        if (0 == tmp->op_count
+         || LOG_LAYOUT_OP_LITERAL != tmp->ops[tmp->op_count - 1].code)
+        {
+            op = &tmp->ops[tmp->op_count++];
+            op->code = LOG_LAYOUT_OP_LITERAL;
+            op->offset = (uint16_t)literal_size;
+            op->size = 0;
+        }
+
+        op = &tmp->ops[tmp->op_count - 1];
+        literals[literal_size++] = *i;
+        op->size += 1;
+    }
+
+    /* a layout without the message would drop every message body. */
+    if (!has_message)
+    {
+        retval = VCSERVICE_ERROR_LOG_LAYOUT_INVALID;
+        goto cleanup_layout;
+    }
+
+    /* success. */
+    *layout = tmp;
+    return STATUS_SUCCESS;
+
+cleanup_layout:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Get the op for a field character.
+ *
+ * \param field         The character after the percent sign.
+ *
+ * \returns the op code, or -1 if the field is not known.
+ */
+static int field_code(char field)
+{
+    switch (field)
+    {
+        case 'D':
+            return LOG_LAYOUT_OP_DATE;
+
+        case 'T':
+            return LOG_LAYOUT_OP_TIME;
+
+        case 'u':
+            return LOG_LAYOUT_OP_MICROSECONDS;
+
+        case 'L':
+            return LOG_LAYOUT_OP_LEVEL;
+
+        case 'C':
+            return LOG_LAYOUT_OP_CONTEXT;
+
+        case 't':
+            return LOG_LAYOUT_OP_THREAD;
+
+        case 'm':
+            return LOG_LAYOUT_OP_MESSAGE;
+
+        default:
+            return -1;
+    }
+}
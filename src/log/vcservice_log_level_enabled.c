@@ -0,0 +1,33 @@
+/**
+ * \file log/vcservice_log_level_enabled.c
+ *
+ * \brief Check whether a message at a given level would be logged.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Check whether a message at the given level passes the logger's
+ * threshold level, or the capture level of the current request scope.
+ *
+ * This is the level check made by the log macros.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param level         The logging level of the message.
+ *
+ * \returns true if a message at this level should be formatted and committed,
+ * or false if it would be dropped.
+ */
+bool
+vcservice_log_level_enabled(const vcservice_log* log, unsigned int level)
+{
+    if (level <= log->threshold_level)
+    {
+        return true;
+    }
+
+    /* inside a request scope, less critical messages are buffered. */
+    return log->scope.depth > 0 && level <= log->scope.capture_level;
+}
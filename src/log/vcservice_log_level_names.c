@@ -0,0 +1,24 @@
+/**
+ * \file log/vcservice_log_level_names.c
+ *
+ * \brief The level names shared by every log line format.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief The level names, by log level and then for an unknown level, each
+ * padded with spaces to \ref LOG_LEVEL_NAME_SIZE.
+ */
+const char
+vcservice_log_level_names[LOG_LEVEL_COUNT + 1][LOG_LEVEL_NAME_SIZE + 1] = {
+    [VCSERVICE_LOGLEVEL_CRITICAL] = "CRITICAL ",
+    [VCSERVICE_LOGLEVEL_ERROR] = "ERROR    ",
+    [VCSERVICE_LOGLEVEL_NORMAL] = "NORMAL   ",
+    [VCSERVICE_LOGLEVEL_INFO] = "INFO     ",
+    [VCSERVICE_LOGLEVEL_VERBOSE] = "VERBOSE  ",
+    [VCSERVICE_LOGLEVEL_DEBUG] = "DEBUG    ",
+    [LOG_LEVEL_COUNT] = "UNKNOWN  ",
+};
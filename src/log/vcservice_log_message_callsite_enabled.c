@@ -0,0 +1,28 @@
+/**
+ * \file log/vcservice_log_message_callsite_enabled.c
+ *
+ * \brief Mark the next message as coming from an enabled call site.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Mark the next committed message as coming from a call site enabled
+ * with \ref vcservice_log_callsite_set_enabled.
+ *
+ * Such a message is written even inside a request scope, instead of being
+ * buffered with the scope's detail.  The mark is cleared when the message is
+ * committed.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ */
+void
+vcservice_log_message_callsite_enabled(vcservice_log* log)
+{
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+
+    log->log_callsite_enabled = true;
+}
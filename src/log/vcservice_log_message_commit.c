@@ -19,9 +19,41 @@ vcservice_log_message_commit(vcservice_log* log)
     /* parameter sanity checks. */
     RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
 
+    /* wrap the message in the configured layout. */
+    if (NULL != log->layout)
+    {
+        vcservice_log_layout_apply(log);
+    }
+
     /* append a newline. */
     vcservice_log_append_string(log, "\n");
 
+    /* mask sensitive data before any sink sees it. */
+    if (NULL != log->redactor)
+    {
+        vcservice_log_redactor_apply(
+            log->redactor, log->log_message, log->log_idx);
+    }
+
+    /* an enabled call site is written even inside a request scope. */
+    bool callsite_enabled = log->log_callsite_enabled;
+    log->log_callsite_enabled = false;
+
+    /* inside a request scope, hold back detail unless the request fails. */
+    if (log->scope.depth > 0)
+    {
+        if (!callsite_enabled && log->log_level > log->threshold_level)
+        {
+            vcservice_log_scope_push(log);
+            return;
+        }
+        else if (log->log_level <= VCSERVICE_LOGLEVEL_ERROR)
+        {
+            vcservice_log_scope_flush(log);
+        }
+    }
+
     /* call the log write handler. */
+    vcservice_log_stats_written(log, log->log_level, log->log_idx);
     log->log_write_cb(log, log->log_level, log->user_context);
 }
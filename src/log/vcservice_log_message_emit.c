@@ -0,0 +1,293 @@
+/**
+ * \file log/vcservice_log_message_emit.c
+ *
+ * \brief Format a logging message from an array of typed arguments.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+typedef void (*log_arg_fn)(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+
+static void log_arg_int8(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_uint8(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_int16(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_uint16(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_int32(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_uint32(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_int64(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_uint64(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_string(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_uuid(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_double(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_float(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_bool(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_char(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_pointer(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_hexdump(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_format_default(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+static void log_arg_format_hex(
+    vcservice_log* log, const vcservice_log_arg_value* value);
+
+/**
+ * \brief Dispatch table, indexed by \ref vcservice_log_arg_type.
+ */
+static const log_arg_fn log_arg_dispatch[VCSERVICE_LOG_ARG_UPPER_BOUND] = {
+    [VCSERVICE_LOG_ARG_INT8] = &log_arg_int8,
+    [VCSERVICE_LOG_ARG_UINT8] = &log_arg_uint8,
+    [VCSERVICE_LOG_ARG_INT16] = &log_arg_int16,
+    [VCSERVICE_LOG_ARG_UINT16] = &log_arg_uint16,
+    [VCSERVICE_LOG_ARG_INT32] = &log_arg_int32,
+    [VCSERVICE_LOG_ARG_UINT32] = &log_arg_uint32,
+    [VCSERVICE_LOG_ARG_INT64] = &log_arg_int64,
+    [VCSERVICE_LOG_ARG_UINT64] = &log_arg_uint64,
+    [VCSERVICE_LOG_ARG_STRING] = &log_arg_string,
+    [VCSERVICE_LOG_ARG_UUID] = &log_arg_uuid,
+    [VCSERVICE_LOG_ARG_FORMAT_DEFAULT] = &log_arg_format_default,
+    [VCSERVICE_LOG_ARG_FORMAT_HEX] = &log_arg_format_hex,
+    [VCSERVICE_LOG_ARG_DOUBLE] = &log_arg_double,
+    [VCSERVICE_LOG_ARG_FLOAT] = &log_arg_float,
+    [VCSERVICE_LOG_ARG_BOOL] = &log_arg_bool,
+    [VCSERVICE_LOG_ARG_CHAR] = &log_arg_char,
+    [VCSERVICE_LOG_ARG_POINTER] = &log_arg_pointer,
+    [VCSERVICE_LOG_ARG_HEXDUMP] = &log_arg_hexdump,
+};
+
+/**
+ * \brief Start, format, and commit a logging message from an array of typed
+ * arguments.
+ *
+ * This is the out-of-line half of the compact log expansion.  It is equivalent
+ * to calling \ref vcservice_log_message_start, then
+ * \ref vcservice_log_append_log_level, then the append method for each
+ * argument, and finally \ref vcservice_log_message_commit.
+ *
+ * As with the inline expansion, arguments past the first
+ * \ref VCSERVICE_LOG_MAX_ARGS are replaced with " (truncated)".
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param level         The logging level of this message.
+ * \param types         The array of \ref vcservice_log_arg_type tags, one per
+ *                      argument.
+ * \param values        The array of argument values.
+ * \param count         The number of arguments in each array.
+ */
+void
+vcservice_log_message_emit(
+    vcservice_log* log, unsigned int level, const uint8_t* types,
+    const vcservice_log_arg_value* values, size_t count)
+{
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(prop_vcservice_log_threshold_level_valid(level));
+    RCPR_MODEL_ASSERT(NULL != types || 0 == count);
+    RCPR_MODEL_ASSERT(NULL != values || 0 == count);
+
+    vcservice_log_message_start(log);
+    vcservice_log_append_log_level(log, level);
+
+    /* append each argument. */
+    for (size_t i = 0; i < count && i < VCSERVICE_LOG_MAX_ARGS; ++i)
+    {
+        if (types[i] < VCSERVICE_LOG_ARG_UPPER_BOUND)
+        {
+            log_arg_dispatch[types[i]](log, values + i);
+        }
+    }
+
+    /* mark the rest as truncated, as LOG_WITH_LEVEL_EXPANDED does. */
+    if (count > VCSERVICE_LOG_MAX_ARGS)
+    {
+        vcservice_log_format_set_default(
+            log, &vcservice_log_format_default_sentry);
+        vcservice_log_append_string(log, " (truncated)");
+    }
+
+    vcservice_log_message_commit(log);
+}
+
+/**
+ * \brief Append an int8 argument.
+ */
+static void log_arg_int8(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_int8(log, (int8_t)value->i64);
+}
+
+/**
+ * \brief Append a uint8 argument.
+ */
+static void log_arg_uint8(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_uint8(log, (uint8_t)value->u64);
+}
+
+/**
+ * \brief Append an int16 argument.
+ */
+static void log_arg_int16(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_int16(log, (int16_t)value->i64);
+}
+
+/**
+ * \brief Append a uint16 argument.
+ */
+static void log_arg_uint16(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_uint16(log, (uint16_t)value->u64);
+}
+
+/**
+ * \brief Append an int32 argument.
+ */
+static void log_arg_int32(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_int32(log, (int32_t)value->i64);
+}
+
+/**
+ * \brief Append a uint32 argument.
+ */
+static void log_arg_uint32(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_uint32(log, (uint32_t)value->u64);
+}
+
+/**
+ * \brief Append an int64 argument.
+ */
+static void log_arg_int64(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_int64(log, value->i64);
+}
+
+/**
+ * \brief Append a uint64 argument.
+ */
+static void log_arg_uint64(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_uint64(log, value->u64);
+}
+
+/**
+ * \brief Append a string argument.
+ */
+static void log_arg_string(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_string(log, value->str);
+}
+
+/**
+ * \brief Append a uuid argument.
+ */
+static void log_arg_uuid(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_uuid(log, value->uuid);
+}
+
+/**
+ * \brief Append a double argument.
+ */
+static void log_arg_double(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_double(log, value->f64);
+}
+
+/**
+ * \brief Append a float argument.
+ */
+static void log_arg_float(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_float(log, (float)value->f64);
+}
+
+/**
+ * \brief Append a bool argument.
+ */
+static void log_arg_bool(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_bool(log, 0 != value->u64);
+}
+
+/**
+ * \brief Append a char argument.
+ */
+static void log_arg_char(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_char(log, (char)value->i64);
+}
+
+/**
+ * \brief Append a pointer argument.
+ */
+static void log_arg_pointer(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_pointer(log, value->ptr);
+}
+
+/**
+ * \brief Append a hex dump argument.
+ */
+static void log_arg_hexdump(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    vcservice_log_append_hexdump_arg(
+        log, (const vcservice_log_hexdump*)value->ptr);
+}
+
+/**
+ * \brief Switch to the default format.
+ */
+static void log_arg_format_default(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    (void)value;
+
+    vcservice_log_format_set_default(log, &vcservice_log_format_default_sentry);
+}
+
+/**
+ * \brief Switch to the hex format.
+ */
+static void log_arg_format_hex(
+    vcservice_log* log, const vcservice_log_arg_value* value)
+{
+    (void)value;
+
+    vcservice_log_format_set_hex(log, &vcservice_log_format_hex_sentry);
+}
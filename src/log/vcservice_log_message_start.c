@@ -28,6 +28,12 @@ vcservice_log_message_start(vcservice_log* log)
     /* reset the index. */
     log->log_idx = 0;
 
+    /* a layout adds the fields when the message is committed. */
+    if (NULL != log->layout)
+    {
+        return;
+    }
+
     /* get the current time. */
     time_t curr = time(NULL);
 
@@ -46,4 +52,14 @@ vcservice_log_message_start(vcservice_log* log)
 
     /* adjust the size. */
     log->log_idx += adjsize;
+
+    /* correlate the message with the current trace context, if any. */
+    vcservice_log_trace_context* trace = vcservice_log_trace_current;
+    if (NULL != trace)
+    {
+        memcpy(
+            log->log_message + log->log_idx, trace->text,
+            sizeof(trace->text));
+        log->log_idx += sizeof(trace->text);
+    }
 }
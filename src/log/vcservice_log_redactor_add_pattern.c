@@ -0,0 +1,124 @@
+/**
+ * \file log/vcservice_log_redactor_add_pattern.c
+ *
+ * \brief Add a token prefix to a log redactor.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Add a token prefix to be redacted by this redactor.
+ *
+ * Whenever the prefix appears in a log message, the characters following it,
+ * up to the next whitespace, quote, or punctuation delimiter, are masked.
+ *
+ * \param redactor      The \ref vcservice_log_redactor instance for this
+ *                      operation.
+ * \param prefix        The token prefix to add (e.g. "sk_live_").
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_REDACTOR_INVALID_PATTERN if the prefix is empty or
+ *        the pattern set is too large.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_redactor_add_pattern(
+    vcservice_log_redactor* redactor, const char* prefix)
+{
+    status retval, reclaim_retval;
+    char* copy;
+    char** patterns;
+    char** old_patterns;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_redactor_valid(redactor));
+    RCPR_MODEL_ASSERT(NULL != prefix);
+
+    /* an empty prefix would match everywhere. */
+    size_t prefix_size = strlen(prefix);
+    if (0 == prefix_size)
+    {
+        retval = VCSERVICE_ERROR_LOG_REDACTOR_INVALID_PATTERN;
+        goto done;
+    }
+
+    /* copy the prefix. */
+    retval =
+        rcpr_allocator_allocate(
+            redactor->alloc, (void**)&copy, prefix_size + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    memcpy(copy, prefix, prefix_size + 1);
+
+    /* grow the pattern array. */
+    retval =
+        rcpr_allocator_allocate(
+            redactor->alloc, (void**)&patterns,
+            (redactor->pattern_count + 1) * sizeof(char*));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_copy;
+    }
+
+    if (redactor->pattern_count > 0)
+    {
+        memcpy(
+            patterns, redactor->patterns,
+            redactor->pattern_count * sizeof(char*));
+    }
+
+    patterns[redactor->pattern_count] = copy;
+
+    /* swap in the new array. */
+    old_patterns = redactor->patterns;
+    redactor->patterns = patterns;
+    redactor->pattern_count += 1;
+
+    /* rebuild the automaton. */
+    retval = vcservice_log_redactor_compile(redactor);
+    if (STATUS_SUCCESS != retval)
+    {
+        /* roll back to the previous pattern set. */
+        redactor->patterns = old_patterns;
+        redactor->pattern_count -= 1;
+        old_patterns = patterns;
+    }
+    else
+    {
+        /* the prefix is now owned by the redactor. */
+        copy = NULL;
+    }
+
+    if (NULL != old_patterns)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(redactor->alloc, old_patterns);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+cleanup_copy:
+    if (NULL != copy)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(redactor->alloc, copy);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+done:
+    return retval;
+}
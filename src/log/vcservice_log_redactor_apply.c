@@ -0,0 +1,463 @@
+/**
+ * \file log/vcservice_log_redactor_apply.c
+ *
+ * \brief Mask sensitive data in a log message.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "log_internal.h"
+
+/**
+ * \brief The shortest and longest card numbers.
+ */
+#define PAN_MIN_DIGITS 13
+#define PAN_MAX_DIGITS 19
+
+/**
+ * \brief The number of trailing card number digits left visible.
+ */
+#define PAN_VISIBLE_DIGITS 4
+
+/**
+ * \brief The character used to mask redacted data.
+ */
+#define REDACT_MASK '*'
+
+static size_t redact_pans(char* message, size_t size);
+static size_t digit_run_end(
+    const char* message, size_t offset, size_t size, size_t* digits);
+static size_t redact_pans_in_run(char* message, size_t start, size_t end);
+static size_t find_digit(const char* message, size_t offset, size_t size);
+static bool luhn_valid(const char* run, size_t size);
+static size_t find_prefix_start(
+    const vcservice_log_redactor* redactor, const char* message,
+    size_t offset, size_t size);
+static size_t redact_tokens(
+    const vcservice_log_redactor* redactor, char* message, size_t size);
+
+/**
+ * \brief Returns true if the given character is a decimal digit.
+ */
+static inline bool is_digit(char ch)
+{
+    return (unsigned char)(ch - '0') < 10;
+}
+
+/**
+ * \brief Returns true if the given character ends a token.
+ */
+static inline bool is_token_delimiter(char ch)
+{
+    return
+        (unsigned char)ch <= ' ' || '"' == ch || '\'' == ch || ',' == ch
+     || ';' == ch || '&' == ch || ')' == ch || ']' == ch || '}' == ch
+     || '>' == ch;
+}
+
+/**
+ * \brief Returns true if a prefix may start with the two given bytes.
+ */
+static inline bool starts_prefix(
+    const vcservice_log_redactor* redactor, const char* pair)
+{
+    size_t index = (size_t)(uint8_t)pair[0] * 256 + (uint8_t)pair[1];
+
+    return 0 != (redactor->start_pairs[index / 8] & (1U << (index % 8)));
+}
+
+/**
+ * \brief Mask sensitive data in the given message in place.
+ *
+ * \param redactor      The \ref vcservice_log_redactor instance for this
+ *                      operation.
+ * \param message       The message to redact.
+ * \param size          The size of the message.
+ *
+ * \returns the number of redactions made.
+ */
+size_t
+vcservice_log_redactor_apply(
+    const vcservice_log_redactor* redactor, char* message, size_t size)
+{
+    size_t count;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_redactor_valid(redactor));
+    RCPR_MODEL_ASSERT(NULL != message || 0 == size);
+
+    /* mask card numbers. */
+    count = redact_pans(message, size);
+
+    /* mask prefixed tokens. */
+    if (redactor->pattern_count > 0)
+    {
+        count += redact_tokens(redactor, message, size);
+    }
+
+    return count;
+}
+
+/**
+ * \brief Mask every Luhn-valid card number in the message.
+ */
+static size_t redact_pans(char* message, size_t size)
+{
+    size_t count = 0;
+    size_t i = 0;
+
+    for (;;)
+    {
+        /* skip to the start of the next digit run. */
+        i = find_digit(message, i, size);
+        if (i >= size)
+        {
+            break;
+        }
+
+        /* find the end of the run; most runs are too short to matter. */
+        size_t start = i;
+        size_t digits;
+        i = digit_run_end(message, i, size, &digits);
+
+        if (digits >= PAN_MIN_DIGITS)
+        {
+            count += redact_pans_in_run(message, start, i);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * \brief Find the end of the digit run starting at the given offset.
+ *
+ * A run is a sequence of digits, with single space or dash separators allowed
+ * between them.
+ *
+ * \returns the offset just past the run.
+ */
+static size_t digit_run_end(
+    const char* message, size_t offset, size_t size, size_t* digits)
+{
+    *digits = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i dash = _mm_set1_epi8('-');
+
+    /* classify sixteen bytes at a time, looking one byte ahead so that a
+     * separator is only part of the run if a digit follows it. */
+    while (offset + 17 <= size)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(message + offset));
+        __m128i next =
+            _mm_loadu_si128((const __m128i*)(message + offset + 1));
+        __m128i vd = _mm_sub_epi8(v, zero);
+        __m128i nextd = _mm_sub_epi8(next, zero);
+
+        unsigned int digit =
+            (unsigned int)_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_min_epu8(vd, nine), vd));
+        unsigned int next_digit =
+            (unsigned int)_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_min_epu8(nextd, nine), nextd));
+        unsigned int separator =
+            (unsigned int)_mm_movemask_epi8(
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, dash)));
+
+        unsigned int run = digit | (separator & next_digit);
+        if (0xFFFF != run)
+        {
+            unsigned int length = (unsigned int)__builtin_ctz(~run);
+            *digits +=
+                (size_t)__builtin_popcount(digit & ((1U << length) - 1));
+
+            return offset + length;
+        }
+
+        *digits += (size_t)__builtin_popcount(digit);
+        offset += 16;
+    }
+#endif
+
+    /* scalar tail / fallback. */
+    while (offset < size)
+    {
+        if (is_digit(message[offset]))
+        {
+            ++*digits;
+            ++offset;
+        }
+        else if (
+            (' ' == message[offset] || '-' == message[offset])
+         && offset + 1 < size && is_digit(message[offset + 1]))
+        {
+            ++offset;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return offset;
+
+}
+
+/**
+ * \brief Mask the card numbers in a run of separated digit groups.
+ *
+ * A card number is a sequence of whole groups; starting at each group, the
+ * longest Luhn-valid sequence is masked.  This keeps two card numbers joined
+ * by a single space from hiding each other.
+ */
+static size_t redact_pans_in_run(char* message, size_t start, size_t end)
+{
+    size_t count = 0;
+    size_t group = start;
+
+    while (group < end)
+    {
+        size_t digits = 0;
+        size_t best_end = 0;
+        size_t best_digits = 0;
+
+        /* extend the candidate one group at a time. */
+        for (size_t pos = group; pos < end; ++pos)
+        {
+            size_t group_end = pos;
+            while (group_end < end && is_digit(message[group_end]))
+            {
+                ++group_end;
+            }
+
+            digits += group_end - pos;
+            if (digits > PAN_MAX_DIGITS)
+            {
+                break;
+            }
+
+            if (
+                digits >= PAN_MIN_DIGITS
+             && luhn_valid(message + group, group_end - group))
+            {
+                best_end = group_end;
+                best_digits = digits;
+            }
+
+            /* skip the separator. */
+            pos = group_end;
+        }
+
+        if (0 == best_end)
+        {
+            /* no card number starts here; move to the next group. */
+            while (group < end && is_digit(message[group]))
+            {
+                ++group;
+            }
+
+            ++group;
+            continue;
+        }
+
+        /* mask all but the last digits. */
+        size_t masked = best_digits - PAN_VISIBLE_DIGITS;
+        for (size_t j = group; masked > 0; ++j)
+        {
+            if (is_digit(message[j]))
+            {
+                message[j] = REDACT_MASK;
+                --masked;
+            }
+        }
+
+        ++count;
+        group = best_end + 1;
+    }
+
+    return count;
+}
+
+/**
+ * \brief Find the offset of the next digit at or after the given offset.
+ *
+ * \returns the offset of the digit, or size if there is none.
+ */
+static size_t find_digit(const char* message, size_t offset, size_t size)
+{
+#if defined(__SSE2__)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+
+    /* most log text has few digits; skip sixteen bytes at a time. */
+    for (; offset + 16 <= size; offset += 16)
+    {
+        __m128i v =
+            _mm_sub_epi8(
+                _mm_loadu_si128((const __m128i*)(message + offset)), zero);
+        int mask =
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, nine), v));
+        if (0 != mask)
+        {
+            return offset + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+    }
+#endif
+
+    /* scalar tail / fallback. */
+    for (; offset < size; ++offset)
+    {
+        if (is_digit(message[offset]))
+        {
+            return offset;
+        }
+    }
+
+    return size;
+}
+
+/**
+ * \brief Returns true if the digits in the given run pass the Luhn check.
+ */
+static bool luhn_valid(const char* run, size_t size)
+{
+    unsigned int sum = 0;
+    bool double_digit = false;
+
+    for (size_t i = size; i > 0; --i)
+    {
+        if (!is_digit(run[i - 1]))
+        {
+            continue;
+        }
+
+        unsigned int digit = (unsigned int)(run[i - 1] - '0');
+        if (double_digit)
+        {
+            digit *= 2;
+            if (digit > 9)
+            {
+                digit -= 9;
+            }
+        }
+
+        sum += digit;
+        double_digit = !double_digit;
+    }
+
+    return 0 == sum % 10;
+}
+
+/**
+ * \brief Mask the remainder of every token starting with a redactor prefix.
+ */
+static size_t redact_tokens(
+    const vcservice_log_redactor* redactor, char* message, size_t size)
+{
+    const uint16_t* transitions = redactor->transitions;
+    const uint8_t* byte_class = redactor->byte_class;
+    const uint8_t* accept = redactor->accept;
+    const size_t class_count = redactor->class_count;
+    size_t count = 0;
+    size_t state = 0;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        /* from the root, skip bytes that cannot start a prefix.  Unlike
+         * the transitions, these lookups do not depend on each other. */
+        if (0 == state)
+        {
+            i = find_prefix_start(redactor, message, i, size);
+        }
+
+        state =
+            transitions[
+                state * class_count + byte_class[(uint8_t)message[i]]];
+
+        if (accept[state])
+        {
+            /* mask up to the end of the token. */
+            size_t j = i + 1;
+            while (j < size && !is_token_delimiter(message[j]))
+            {
+                message[j++] = REDACT_MASK;
+            }
+
+            if (j > i + 1)
+            {
+                ++count;
+            }
+
+            /* resume scanning after the token. */
+            i = j - 1;
+            state = 0;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * \brief Find the next offset at which a prefix may start.
+ *
+ * \returns the offset, or the offset of the last byte if there is none.
+ */
+static size_t find_prefix_start(
+    const vcservice_log_redactor* redactor, const char* message,
+    size_t offset, size_t size)
+{
+#if defined(__SSE2__)
+    /* test sixteen positions at a time against the listed starting pairs. */
+    if (redactor->scan_pair_count > 0)
+    {
+        for (; offset + 17 <= size; offset += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(message + offset));
+            __m128i next =
+                _mm_loadu_si128((const __m128i*)(message + offset + 1));
+            __m128i found = _mm_setzero_si128();
+
+            for (size_t j = 0; j < redactor->scan_pair_count; ++j)
+            {
+                found =
+                    _mm_or_si128(
+                        found,
+                        _mm_and_si128(
+                            _mm_cmpeq_epi8(
+                                v,
+                                _mm_set1_epi8(
+                                    (char)redactor->scan_pairs[j][0])),
+                            _mm_cmpeq_epi8(
+                                next,
+                                _mm_set1_epi8(
+                                    (char)redactor->scan_pairs[j][1]))));
+            }
+
+            int mask = _mm_movemask_epi8(found);
+            if (0 != mask)
+            {
+                return offset + (size_t)__builtin_ctz((unsigned int)mask);
+            }
+        }
+    }
+#endif
+
+    /* scalar tail / fallback. */
+    while (offset + 1 < size && !starts_prefix(redactor, message + offset))
+    {
+        ++offset;
+    }
+
+    return offset;
+}
@@ -0,0 +1,272 @@
+/**
+ * \file log/vcservice_log_redactor_compile.c
+ *
+ * \brief Compile the token prefix automaton for a log redactor.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Compile the token prefixes of this redactor into an Aho-Corasick
+ * automaton.
+ *
+ * The input alphabet is compressed into byte classes: each byte that appears
+ * in a prefix gets its own class, and every other byte shares class 0.  The
+ * failure links are folded into a complete transition table of state_count *
+ * class_count entries, so that scanning costs one table lookup per byte.
+ *
+ * A bitmap of the byte pairs that can start a match lets the scanner skip
+ * quickly over text that cannot begin a prefix.  When there are only a few
+ * such pairs, they are also listed, so that the scanner can test sixteen
+ * positions at a time.
+ *
+ * \param redactor      The \ref vcservice_log_redactor instance for this
+ *                      operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_REDACTOR_INVALID_PATTERN if the pattern set needs
+ *        too many states.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_redactor_compile(vcservice_log_redactor* redactor)
+{
+    status retval, reclaim_retval;
+    uint8_t byte_class[256];
+    uint8_t start_pairs[256 * 256 / 8];
+    uint8_t scan_pairs[LOG_REDACTOR_MAX_SCAN_PAIRS][2];
+    size_t scan_pair_count = 0;
+    bool scan_pairs_usable = true;
+    size_t class_count = 1;
+    size_t max_states = 1;
+    size_t state_count = 1;
+    uint16_t* transitions;
+    uint8_t* accept;
+    uint16_t* fail;
+    uint16_t* queue;
+    size_t head = 0, tail = 0;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_redactor_valid(redactor));
+
+    /* assign a class to each byte used by a pattern, and record the byte
+     * pairs that start a pattern. */
+    memset(byte_class, 0, sizeof(byte_class));
+    memset(start_pairs, 0, sizeof(start_pairs));
+    for (size_t i = 0; i < redactor->pattern_count; ++i)
+    {
+        const uint8_t* pattern = (const uint8_t*)redactor->patterns[i];
+
+        /* a single byte pattern can be followed by any byte. */
+        for (size_t second = 0; second < 256; ++second)
+        {
+            if (0 == pattern[1] || second == pattern[1])
+            {
+                size_t pair = pattern[0] * 256 + second;
+                start_pairs[pair / 8] |= (uint8_t)(1U << (pair % 8));
+            }
+        }
+
+        /* list the distinct starting pairs, if there are few enough. */
+        if (0 == pattern[1])
+        {
+            scan_pairs_usable = false;
+        }
+        else if (scan_pairs_usable)
+        {
+            size_t j = 0;
+            while (
+                j < scan_pair_count
+             && (scan_pairs[j][0] != pattern[0]
+              || scan_pairs[j][1] != pattern[1]))
+            {
+                ++j;
+            }
+
+            if (j == scan_pair_count)
+            {
+                if (LOG_REDACTOR_MAX_SCAN_PAIRS == scan_pair_count)
+                {
+                    scan_pairs_usable = false;
+                }
+                else
+                {
+                    scan_pairs[scan_pair_count][0] = pattern[0];
+                    scan_pairs[scan_pair_count][1] = pattern[1];
+                    ++scan_pair_count;
+                }
+            }
+        }
+
+        for (size_t j = 0; 0 != pattern[j]; ++j)
+        {
+            if (0 == byte_class[pattern[j]])
+            {
+                byte_class[pattern[j]] = (uint8_t)class_count++;
+            }
+        }
+
+        max_states += strlen((const char*)pattern);
+    }
+
+    /* the states must fit in the transition table entries. */
+    if (max_states > LOG_REDACTOR_MAX_STATES)
+    {
+        retval = VCSERVICE_ERROR_LOG_REDACTOR_INVALID_PATTERN;
+        goto done;
+    }
+
+    /* allocate the tables. */
+    retval =
+        rcpr_allocator_allocate(
+            redactor->alloc, (void**)&transitions,
+            max_states * class_count * sizeof(uint16_t));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        rcpr_allocator_allocate(redactor->alloc, (void**)&accept, max_states);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_transitions;
+    }
+
+    retval =
+        rcpr_allocator_allocate(
+            redactor->alloc, (void**)&fail, max_states * sizeof(uint16_t));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_accept;
+    }
+
+    retval =
+        rcpr_allocator_allocate(
+            redactor->alloc, (void**)&queue, max_states * sizeof(uint16_t));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_fail;
+    }
+
+    memset(transitions, 0, max_states * class_count * sizeof(uint16_t));
+    memset(accept, 0, max_states);
+    memset(fail, 0, max_states * sizeof(uint16_t));
+
+    /* build the trie.  No trie edge leads back to the root, so 0 marks a
+     * missing edge. */
+    for (size_t i = 0; i < redactor->pattern_count; ++i)
+    {
+        const uint8_t* pattern = (const uint8_t*)redactor->patterns[i];
+        size_t state = 0;
+
+        for (size_t j = 0; 0 != pattern[j]; ++j)
+        {
+            uint16_t* edge =
+                &transitions[state * class_count + byte_class[pattern[j]]];
+            if (0 == *edge)
+            {
+                *edge = (uint16_t)state_count++;
+            }
+
+            state = *edge;
+        }
+
+        accept[state] = 1;
+    }
+
+    /* seed the breadth first walk with the children of the root. */
+    for (size_t c = 1; c < class_count; ++c)
+    {
+        if (0 != transitions[c])
+        {
+            queue[tail++] = transitions[c];
+        }
+    }
+
+    /* set the failure links in breadth first order, and fold them into the
+     * missing edges. */
+    while (head < tail)
+    {
+        size_t state = queue[head++];
+        size_t fallback = fail[state];
+
+        accept[state] |= accept[fallback];
+
+        for (size_t c = 0; c < class_count; ++c)
+        {
+            uint16_t* edge = &transitions[state * class_count + c];
+            if (0 != *edge)
+            {
+                fail[*edge] = transitions[fallback * class_count + c];
+                queue[tail++] = *edge;
+            }
+            else
+            {
+                *edge = transitions[fallback * class_count + c];
+            }
+        }
+    }
+
+    /* swap in the new automaton; the previous tables are reclaimed below. */
+    uint16_t* old_transitions = redactor->transitions;
+    uint8_t* old_accept = redactor->accept;
+
+    memcpy(redactor->byte_class, byte_class, sizeof(byte_class));
+    memcpy(redactor->start_pairs, start_pairs, sizeof(start_pairs));
+    memcpy(redactor->scan_pairs, scan_pairs, sizeof(scan_pairs));
+    redactor->scan_pair_count = scan_pairs_usable ? scan_pair_count : 0;
+    redactor->class_count = class_count;
+    redactor->state_count = state_count;
+    redactor->transitions = transitions;
+    redactor->accept = accept;
+
+    transitions = old_transitions;
+    accept = old_accept;
+    goto cleanup_queue;
+
+cleanup_queue:
+    reclaim_retval = rcpr_allocator_reclaim(redactor->alloc, queue);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_fail:
+    reclaim_retval = rcpr_allocator_reclaim(redactor->alloc, fail);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+cleanup_accept:
+    if (NULL != accept)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(redactor->alloc, accept);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+cleanup_transitions:
+    if (NULL != transitions)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(redactor->alloc, transitions);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+done:
+    return retval;
+}
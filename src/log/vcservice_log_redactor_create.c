@@ -0,0 +1,96 @@
+/**
+ * \file log/vcservice_log_redactor_create.c
+ *
+ * \brief Create a log redactor instance.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_log_redactor instance.
+ *
+ * A redactor masks sensitive data in committed log messages before they are
+ * written.  Card numbers (runs of 13 to 19 digits, optionally grouped with
+ * single spaces or dashes, that pass the Luhn check) are always masked, leaving
+ * only the last four digits.  Tokens beginning with a prefix added via
+ * \ref vcservice_log_redactor_add_pattern are masked after the prefix.
+ *
+ * \param redactor              Pointer to the \ref vcservice_log_redactor
+ *                              pointer to receive this resource on success.
+ * \param alloc                 Pointer to the allocator to use for creating
+ *                              this \ref vcservice_log_redactor instance.
+ *
+ * \note This \ref vcservice_log_redactor instance is a \ref resource that must
+ * be released by calling \ref resource_release on its resource handle when it
+ * is no longer needed by the caller, unless ownership is passed to a logger
+ * with \ref vcservice_log_set_redactor.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ *
+ * \pre
+ *      - \p redactor must not reference a valid redactor instance and must not
+ *        be NULL.
+ *      - \p alloc must reference a valid \ref allocator and must not be NULL.
+ *
+ * \post
+ *      - On success, \p redactor is set to a pointer to a valid
+ *        \ref vcservice_log_redactor instance.
+ *      - On failure, \p redactor is set to NULL and an error status is
+ *        returned.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_redactor_create(
+    vcservice_log_redactor** redactor, RCPR_SYM(allocator)* alloc)
+{
+    status retval, release_retval;
+    vcservice_log_redactor* tmp;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != redactor);
+    RCPR_MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_log_redactor_resource_release);
+    tmp->alloc = alloc;
+
+    /* build the empty pattern automaton. */
+    retval = vcservice_log_redactor_compile(tmp);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_redactor;
+    }
+
+    /* success. */
+    *redactor = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_redactor:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
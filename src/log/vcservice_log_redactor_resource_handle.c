@@ -0,0 +1,24 @@
+/**
+ * \file log/vcservice_log_redactor_resource_handle.c
+ *
+ * \brief Get the resource handle for a log redactor.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Given a \ref vcservice_log_redactor instance, return its resource
+ * handle.
+ *
+ * \param redactor      The \ref vcservice_log_redactor instance from which the
+ *                      resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_log_redactor instance.
+ */
+RCPR_SYM(resource*)
+vcservice_log_redactor_resource_handle(vcservice_log_redactor* redactor)
+{
+    return &redactor->hdr;
+}
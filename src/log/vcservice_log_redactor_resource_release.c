@@ -0,0 +1,88 @@
+/**
+ * \file log/vcservice_log_redactor_resource_release.c
+ *
+ * \brief Release a log redactor resource.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Release a \ref vcservice_log_redactor resource.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_redactor_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_log_redactor* redactor = (vcservice_log_redactor*)r;
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_redactor_valid(redactor));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = redactor->alloc;
+
+    /* reclaim the patterns. */
+    for (size_t i = 0; i < redactor->pattern_count; ++i)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(alloc, redactor->patterns[i]);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    if (NULL != redactor->patterns)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(alloc, redactor->patterns);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    /* reclaim the automaton. */
+    if (NULL != redactor->transitions)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(alloc, redactor->transitions);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    if (NULL != redactor->accept)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(alloc, redactor->accept);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    /* clear memory. */
+    memset(redactor, 0, sizeof(*redactor));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, redactor);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
@@ -28,6 +28,9 @@ vcservice_log_resource_release(
 {
     vcservice_log* log = (vcservice_log*)r;
     status user_context_release_retval = STATUS_SUCCESS;
+    status redactor_release_retval = STATUS_SUCCESS;
+    status scope_reclaim_retval = STATUS_SUCCESS;
+    status layout_reclaim_retval = STATUS_SUCCESS;
     status reclaim_retval = STATUS_SUCCESS;
 
     /* parameter sanity checks. */
@@ -42,6 +45,24 @@ vcservice_log_resource_release(
         user_context_release_retval = resource_release(log->user_context);
     }
 
+    /* release the redactor if set. */
+    if (NULL != log->redactor)
+    {
+        redactor_release_retval = resource_release(&log->redactor->hdr);
+    }
+
+    /* release the request scope buffer if allocated. */
+    if (NULL != log->scope.data)
+    {
+        scope_reclaim_retval = rcpr_allocator_reclaim(alloc, log->scope.data);
+    }
+
+    /* release the layout if set. */
+    if (NULL != log->layout)
+    {
+        layout_reclaim_retval = rcpr_allocator_reclaim(alloc, log->layout);
+    }
+
     /* clear memory. */
     memset(log, 0, sizeof(*log));
 
@@ -53,6 +74,18 @@ vcservice_log_resource_release(
     {
         return user_context_release_retval;
     }
+    else if (STATUS_SUCCESS != redactor_release_retval)
+    {
+        return redactor_release_retval;
+    }
+    else if (STATUS_SUCCESS != scope_reclaim_retval)
+    {
+        return scope_reclaim_retval;
+    }
+    else if (STATUS_SUCCESS != layout_reclaim_retval)
+    {
+        return layout_reclaim_retval;
+    }
     else
     {
         return reclaim_retval;
@@ -0,0 +1,56 @@
+/**
+ * \file log/vcservice_log_scope_begin.c
+ *
+ * \brief Begin a request scope.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Begin a request scope on the given logger.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param capture_level The least critical level to buffer, belonging to
+ *                      \ref vcservice_loglevel.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure, in which case no scope is begun.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_scope_begin(vcservice_log* log, unsigned int capture_level)
+{
+    status retval;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(prop_vcservice_log_threshold_level_valid(capture_level));
+
+    /* the buffer is allocated once and kept for later scopes. */
+    if (NULL == log->scope.data)
+    {
+        retval =
+            rcpr_allocator_allocate(
+                log->alloc, (void**)&log->scope.data,
+                LOG_SCOPE_BUFFER_SIZE + MAX_LOG_MESSAGE_SIZE);
+        if (STATUS_SUCCESS != retval)
+        {
+            log->scope.data = NULL;
+            return retval;
+        }
+    }
+
+    /* a nested scope can only widen what is captured. */
+    if (0 == log->scope.depth || capture_level > log->scope.capture_level)
+    {
+        log->scope.capture_level = capture_level;
+    }
+
+    ++log->scope.depth;
+
+    return STATUS_SUCCESS;
+}
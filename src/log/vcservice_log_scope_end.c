@@ -0,0 +1,36 @@
+/**
+ * \file log/vcservice_log_scope_end.c
+ *
+ * \brief End a request scope.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief End a request scope on the given logger.
+ *
+ * When the outermost scope ends, any buffered messages are discarded.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ */
+void
+vcservice_log_scope_end(vcservice_log* log)
+{
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(log->scope.depth > 0);
+
+    if (0 == log->scope.depth)
+    {
+        return;
+    }
+
+    /* the request succeeded, so its buffered detail is not needed. */
+    if (0 == --log->scope.depth)
+    {
+        log->scope.start = 0;
+        log->scope.end = 0;
+    }
+}
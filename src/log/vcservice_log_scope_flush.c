@@ -0,0 +1,62 @@
+/**
+ * \file log/vcservice_log_scope_flush.c
+ *
+ * \brief Write the request scope buffer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Write every message in the request scope buffer ahead of the current
+ * message, and empty the buffer.
+ *
+ * \param log           The \ref vcservice_log instance, which must be in a
+ *                      request scope.
+ */
+void
+vcservice_log_scope_flush(vcservice_log* log)
+{
+    vcservice_log_scope* scope = &log->scope;
+    char* saved = scope->data + LOG_SCOPE_BUFFER_SIZE;
+    size_t saved_size = log->log_idx;
+    unsigned int saved_level = log->log_level;
+    uint32_t level, size;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(scope->depth > 0);
+
+    if (scope->start == scope->end)
+    {
+        return;
+    }
+
+    /* sinks write from the message buffer, so set the current one aside. */
+    memcpy(saved, log->log_message, saved_size);
+
+    while (scope->start < scope->end)
+    {
+        memcpy(&level, scope->data + scope->start, sizeof(level));
+        memcpy(&size, scope->data + scope->start + 4, sizeof(size));
+        memcpy(
+            log->log_message,
+            scope->data + scope->start + LOG_SCOPE_ENTRY_HEADER_SIZE, size);
+        log->log_idx = size;
+        log->log_level = level;
+        vcservice_log_stats_written(log, level, size);
+        log->log_write_cb(log, level, log->user_context);
+
+        scope->start += LOG_SCOPE_ENTRY_HEADER_SIZE + size;
+    }
+
+    scope->start = 0;
+    scope->end = 0;
+
+    memcpy(log->log_message, saved, saved_size);
+    log->log_idx = saved_size;
+    log->log_level = saved_level;
+}
@@ -0,0 +1,63 @@
+/**
+ * \file log/vcservice_log_scope_push.c
+ *
+ * \brief Save a message in the request scope buffer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Save the current message in the request scope buffer, dropping the
+ * oldest buffered messages if needed to make room.
+ *
+ * \param log           The \ref vcservice_log instance, which must be in a
+ *                      request scope.
+ */
+void
+vcservice_log_scope_push(vcservice_log* log)
+{
+    vcservice_log_scope* scope = &log->scope;
+    uint32_t level = log->log_level;
+    uint32_t size = (uint32_t)log->log_idx;
+    size_t needed = LOG_SCOPE_ENTRY_HEADER_SIZE + size;
+    uint32_t oldest;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(scope->depth > 0);
+
+    if (needed > LOG_SCOPE_BUFFER_SIZE / 2)
+    {
+        vcservice_log_stats_dropped(log, 1);
+        return;
+    }
+
+    /* out of room at the end, so drop the oldest half and compact.  Dropping
+     * half at a time keeps the compaction cost constant per byte logged. */
+    if (scope->end + needed > LOG_SCOPE_BUFFER_SIZE)
+    {
+        while (scope->end - scope->start + needed > LOG_SCOPE_BUFFER_SIZE / 2)
+        {
+            memcpy(&oldest, scope->data + scope->start + 4, sizeof(oldest));
+            scope->start += LOG_SCOPE_ENTRY_HEADER_SIZE + oldest;
+            vcservice_log_stats_dropped(log, 1);
+        }
+
+        memmove(
+            scope->data, scope->data + scope->start,
+            scope->end - scope->start);
+        scope->end -= scope->start;
+        scope->start = 0;
+    }
+
+    memcpy(scope->data + scope->end, &level, sizeof(level));
+    memcpy(scope->data + scope->end + 4, &size, sizeof(size));
+    memcpy(
+        scope->data + scope->end + LOG_SCOPE_ENTRY_HEADER_SIZE,
+        log->log_message, size);
+    scope->end += needed;
+}
@@ -0,0 +1,50 @@
+/**
+ * \file log/vcservice_log_segment_close.c
+ *
+ * \brief Hand the current log segment to the signer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Hand the current segment to the signer, waiting if the signer has
+ * fallen \ref LOG_SEGMENT_QUEUE_DEPTH segments behind.
+ *
+ * \param ctx           The segment context.
+ */
+void
+vcservice_log_segment_close(vcservice_log_segment_context* ctx)
+{
+    vcservice_log_segment_pending* pending;
+
+    /* nothing to do if no segment is open. */
+    if (ctx->desc < 0)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    while (LOG_SEGMENT_QUEUE_DEPTH == ctx->queue_count)
+    {
+        pthread_cond_wait(&ctx->space_cond, &ctx->mutex);
+    }
+
+    pending =
+        &ctx->queue[
+            (ctx->queue_head + ctx->queue_count) % LOG_SEGMENT_QUEUE_DEPTH];
+    pending->desc = ctx->desc;
+    pending->index = ctx->index;
+    pending->size = ctx->size;
+    ++ctx->queue_count;
+
+    pthread_cond_signal(&ctx->work_cond);
+    pthread_mutex_unlock(&ctx->mutex);
+
+    /* the signer now owns the descriptor. */
+    ctx->desc = -1;
+    ++ctx->index;
+    ctx->size = 0;
+}
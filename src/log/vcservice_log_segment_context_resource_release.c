@@ -0,0 +1,83 @@
+/**
+ * \file log/vcservice_log_segment_context_resource_release.c
+ *
+ * \brief Release the signed segment sink user context.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release the signed segment sink user context, signing the last
+ * segment.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_WRITE if any segment could not be
+ *        written or signed.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_segment_context_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_log_segment_context* ctx = (vcservice_log_segment_context*)r;
+    status name_retval, reclaim_retval;
+    bool write_failed;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = ctx->alloc;
+
+    /* hand off the last segment, then let the signer drain the queue. */
+    vcservice_log_segment_close(ctx);
+
+    pthread_mutex_lock(&ctx->mutex);
+    ctx->stop = true;
+    pthread_cond_signal(&ctx->work_cond);
+    pthread_mutex_unlock(&ctx->mutex);
+    pthread_join(ctx->thread, NULL);
+    write_failed = ctx->write_failed || ctx->sign_failed;
+
+    pthread_cond_destroy(&ctx->space_cond);
+    pthread_cond_destroy(&ctx->work_cond);
+    pthread_mutex_destroy(&ctx->mutex);
+
+    /* release the crypto state. */
+    dispose((disposable_t*)&ctx->digest);
+    dispose((disposable_t*)&ctx->signature);
+    memset(ctx->private_key.data, 0, ctx->private_key.size);
+    dispose((disposable_t*)&ctx->private_key);
+    dispose((disposable_t*)&ctx->sign);
+    dispose((disposable_t*)&ctx->suite);
+    dispose((disposable_t*)&ctx->alloc_opts);
+
+    name_retval = rcpr_allocator_reclaim(alloc, ctx->name);
+
+    /* clear memory. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx);
+
+    /* decode return code. */
+    if (STATUS_SUCCESS != name_retval)
+    {
+        return name_retval;
+    }
+    else if (write_failed)
+    {
+        return VCSERVICE_ERROR_LOG_SEGMENT_WRITE;
+    }
+    else
+    {
+        return reclaim_retval;
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * \file log/vcservice_log_segment_digest.c
+ *
+ * \brief Compute the digest that is signed for a log segment.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Compute the digest that is signed for a segment.
+ *
+ * The digest is SHA-512 over the big-endian segment index and the segment
+ * contents.
+ *
+ * \param suite         The crypto suite to use.
+ * \param digest        The buffer to receive the digest.
+ * \param index         The segment index.
+ * \param data          The segment contents.
+ * \param size          The size of the segment contents.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_segment_digest(
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* digest, uint64_t index,
+    const void* data, size_t size)
+{
+    status retval;
+    vccrypt_hash_context_t hash;
+    uint8_t encoded_index[sizeof(index)];
+
+    /* binding the index stops segments from being reordered or swapped. */
+    vcservice_log_store_be64(encoded_index, index);
+
+    retval = vccrypt_suite_hash_init(suite, &hash);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval = vccrypt_hash_digest(&hash, encoded_index, sizeof(encoded_index));
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    retval = vccrypt_hash_digest(&hash, (const uint8_t*)data, size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    retval = vccrypt_hash_finalize(&hash, digest);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_hash;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_hash;
+
+cleanup_hash:
+    dispose((disposable_t*)&hash);
+
+done:
+    return retval;
+}
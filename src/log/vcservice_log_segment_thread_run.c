@@ -0,0 +1,196 @@
+/**
+ * \file log/vcservice_log_segment_thread_run.c
+ *
+ * \brief Background signer for the signed segment sink.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+static void sign_segment(
+    vcservice_log_segment_context* ctx,
+    const vcservice_log_segment_pending* pending);
+static status sign_contents(
+    vcservice_log_segment_context* ctx,
+    const vcservice_log_segment_pending* pending);
+static status write_trailer(
+    vcservice_log_segment_context* ctx,
+    const vcservice_log_segment_pending* pending);
+
+/**
+ * \brief Entry point for the signed segment sink's background signer.
+ *
+ * \param context       The \ref vcservice_log_segment_context for this
+ *                      thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_log_segment_thread_run(void* context)
+{
+    vcservice_log_segment_context* ctx =
+        (vcservice_log_segment_context*)context;
+    vcservice_log_segment_pending pending;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    for (;;)
+    {
+        while (!ctx->stop && 0 == ctx->queue_count)
+        {
+            pthread_cond_wait(&ctx->work_cond, &ctx->mutex);
+        }
+
+        /* every closed segment is signed before the signer exits. */
+        if (0 == ctx->queue_count)
+        {
+            break;
+        }
+
+        pending = ctx->queue[ctx->queue_head];
+        ctx->queue_head = (ctx->queue_head + 1) % LOG_SEGMENT_QUEUE_DEPTH;
+        --ctx->queue_count;
+        pthread_cond_signal(&ctx->space_cond);
+        pthread_mutex_unlock(&ctx->mutex);
+
+        sign_segment(ctx, &pending);
+
+        pthread_mutex_lock(&ctx->mutex);
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    return NULL;
+}
+
+/**
+ * \brief Sign a closed segment and append its trailer.
+ *
+ * \param ctx           The segment context.
+ * \param pending       The segment to sign.
+ */
+static void sign_segment(
+    vcservice_log_segment_context* ctx,
+    const vcservice_log_segment_pending* pending)
+{
+    if (STATUS_SUCCESS != sign_contents(ctx, pending)
+     || STATUS_SUCCESS != write_trailer(ctx, pending))
+    {
+        /* report it on release. */
+        ctx->sign_failed = true;
+    }
+
+    if (0 != close(pending->desc))
+    {
+        ctx->sign_failed = true;
+    }
+}
+
+/**
+ * \brief Sign the digest of the segment contents into the signature buffer.
+ *
+ * \param ctx           The segment context.
+ * \param pending       The segment to sign.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status sign_contents(
+    vcservice_log_segment_context* ctx,
+    const vcservice_log_segment_pending* pending)
+{
+    status retval;
+    void* data = NULL;
+
+    /* map the contents as written through the writer's descriptor. */
+    if (pending->size > 0)
+    {
+        data =
+            mmap(NULL, pending->size, PROT_READ, MAP_SHARED, pending->desc, 0);
+        if (MAP_FAILED == data)
+        {
+            return VCSERVICE_ERROR_LOG_SEGMENT_WRITE;
+        }
+
+        (void)madvise(data, pending->size, MADV_SEQUENTIAL);
+    }
+
+    retval =
+        vcservice_log_segment_digest(
+            &ctx->suite, &ctx->digest, pending->index, data, pending->size);
+
+    if (NULL != data)
+    {
+        munmap(data, pending->size);
+    }
+
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    return
+        vccrypt_digital_signature_sign(
+            &ctx->sign, &ctx->signature, &ctx->private_key,
+            (const uint8_t*)ctx->digest.data, ctx->digest.size);
+}
+
+/**
+ * \brief Append the trailer to the segment.
+ *
+ * \param ctx           The segment context.
+ * \param pending       The segment being signed.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status write_trailer(
+    vcservice_log_segment_context* ctx,
+    const vcservice_log_segment_pending* pending)
+{
+    uint8_t trailer[
+        LOG_SEGMENT_MAX_SIGNATURE_SIZE + LOG_SEGMENT_TRAILER_FIXED_SIZE];
+    size_t trailer_size = ctx->signature.size + LOG_SEGMENT_TRAILER_FIXED_SIZE;
+    size_t offset = 0;
+
+    if (trailer_size > sizeof(trailer))
+    {
+        return VCSERVICE_ERROR_LOG_SEGMENT_WRITE;
+    }
+
+    /* signature, index, size, magic. */
+    memcpy(trailer, ctx->signature.data, ctx->signature.size);
+    vcservice_log_store_be64(
+        trailer + ctx->signature.size, pending->index);
+    vcservice_log_store_be64(
+        trailer + ctx->signature.size + 8, pending->size);
+    memcpy(
+        trailer + ctx->signature.size + 16, LOG_SEGMENT_MAGIC,
+        LOG_SEGMENT_MAGIC_SIZE);
+
+    while (offset < trailer_size)
+    {
+        ssize_t written =
+            pwrite(
+                pending->desc, trailer + offset, trailer_size - offset,
+                (off_t)(pending->size + offset));
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            return VCSERVICE_ERROR_LOG_SEGMENT_WRITE;
+        }
+
+        offset += (size_t)written;
+    }
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,233 @@
+/**
+ * \file log/vcservice_log_segment_verify.c
+ *
+ * \brief Verify the signature of a log segment.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+static uint64_t decode_uint64(const uint8_t* in);
+static status verify_mapped(
+    uint64_t* index, size_t* size, vccrypt_suite_options_t* suite,
+    const uint8_t* data, size_t file_size, const void* public_key);
+
+/**
+ * \brief Verify the signature of a log segment.
+ *
+ * \param index                 Pointer to receive the index of this segment.
+ * \param size                  Pointer to receive the size of the segment
+ *                              contents, which start at offset 0 and precede
+ *                              the trailer.
+ * \param desc                  The descriptor of the segment to verify.
+ * \param public_key            The raw public key matching the signing key.
+ * \param public_key_size       The size of the public key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS if the signature is valid.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_INVALID_KEY if the key size does not
+ *        match the crypto suite.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_MALFORMED if the segment has no valid
+ *        trailer, for instance because it was never closed.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_BAD_SIGNATURE if the signature does not
+ *        match.
+ *      - VCSERVICE_ERROR_LOG_SEGMENT_READ if the segment could not be read.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_segment_verify(
+    uint64_t* index, size_t* size, int desc, const void* public_key,
+    size_t public_key_size)
+{
+    status retval;
+    struct stat st;
+    void* data;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != index);
+    RCPR_MODEL_ASSERT(NULL != size);
+    RCPR_MODEL_ASSERT(desc >= 0);
+    RCPR_MODEL_ASSERT(NULL != public_key);
+
+    /* set up the crypto suite used for verification. */
+    malloc_allocator_options_init(&alloc_opts);
+    vccrypt_suite_register_velo_v1();
+    retval =
+        vccrypt_suite_options_init(&suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_alloc_opts;
+    }
+
+    if (public_key_size != suite.sign_opts.public_key_size)
+    {
+        retval = VCSERVICE_ERROR_LOG_SEGMENT_INVALID_KEY;
+        goto cleanup_suite;
+    }
+
+    if (0 != fstat(desc, &st))
+    {
+        retval = VCSERVICE_ERROR_LOG_SEGMENT_READ;
+        goto cleanup_suite;
+    }
+
+    if ((size_t)st.st_size
+            < suite.sign_opts.signature_size + LOG_SEGMENT_TRAILER_FIXED_SIZE)
+    {
+        retval = VCSERVICE_ERROR_LOG_SEGMENT_MALFORMED;
+        goto cleanup_suite;
+    }
+
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, desc, 0);
+    if (MAP_FAILED == data)
+    {
+        retval = VCSERVICE_ERROR_LOG_SEGMENT_READ;
+        goto cleanup_suite;
+    }
+
+    (void)madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    retval =
+        verify_mapped(
+            index, size, &suite, (const uint8_t*)data, (size_t)st.st_size,
+            public_key);
+
+    munmap(data, (size_t)st.st_size);
+
+cleanup_suite:
+    dispose((disposable_t*)&suite);
+
+cleanup_alloc_opts:
+    dispose((disposable_t*)&alloc_opts);
+
+    return retval;
+}
+
+/**
+ * \brief Parse the trailer of a mapped segment and check its signature.
+ *
+ * \param index         Pointer to receive the index of this segment.
+ * \param size          Pointer to receive the size of the segment contents.
+ * \param suite         The crypto suite to use.
+ * \param data          The mapped segment.
+ * \param file_size     The size of the segment file.
+ * \param public_key    The raw public key.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static status verify_mapped(
+    uint64_t* index, size_t* size, vccrypt_suite_options_t* suite,
+    const uint8_t* data, size_t file_size, const void* public_key)
+{
+    status retval;
+    vccrypt_digital_signature_context_t sign;
+    vccrypt_buffer_t digest, signature, key;
+    size_t signature_size = suite->sign_opts.signature_size;
+    size_t content_size =
+        file_size - signature_size - LOG_SEGMENT_TRAILER_FIXED_SIZE;
+    const uint8_t* trailer = data + content_size;
+
+    /* signature, index, size, magic. */
+    if (0 != memcmp(
+                trailer + signature_size + 16, LOG_SEGMENT_MAGIC,
+                LOG_SEGMENT_MAGIC_SIZE)
+     || decode_uint64(trailer + signature_size + 8) != content_size)
+    {
+        return VCSERVICE_ERROR_LOG_SEGMENT_MALFORMED;
+    }
+
+    *index = decode_uint64(trailer + signature_size);
+    *size = content_size;
+
+    retval = vccrypt_suite_buffer_init_for_hash(suite, &digest);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval =
+        vcservice_log_segment_digest(
+            suite, &digest, *index, data, content_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_digest;
+    }
+
+    retval = vccrypt_suite_buffer_init_for_signature(suite, &signature);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_digest;
+    }
+
+    memcpy(signature.data, trailer, signature_size);
+
+    retval = vccrypt_suite_buffer_init_for_signature_public_key(suite, &key);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_signature;
+    }
+
+    memcpy(key.data, public_key, key.size);
+
+    retval = vccrypt_suite_digital_signature_init(suite, &sign);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key;
+    }
+
+    retval =
+        vccrypt_digital_signature_verify(
+            &sign, &signature, &key, (const uint8_t*)digest.data,
+            digest.size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        retval = VCSERVICE_ERROR_LOG_SEGMENT_BAD_SIGNATURE;
+        goto cleanup_sign;
+    }
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+    goto cleanup_sign;
+
+cleanup_sign:
+    dispose((disposable_t*)&sign);
+
+cleanup_key:
+    dispose((disposable_t*)&key);
+
+cleanup_signature:
+    dispose((disposable_t*)&signature);
+
+cleanup_digest:
+    dispose((disposable_t*)&digest);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Read a big-endian value.
+ *
+ * \param in            The eight byte input buffer.
+ *
+ * \returns the value.
+ */
+static uint64_t decode_uint64(const uint8_t* in)
+{
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+        value = (value << 8) | in[i];
+    }
+
+    return value;
+}
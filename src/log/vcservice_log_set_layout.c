@@ -0,0 +1,57 @@
+/**
+ * \file log/vcservice_log_set_layout.c
+ *
+ * \brief Set the line layout for a logger.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Set the line layout for this logger.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param pattern       The layout pattern, such as "%T.%u %L [%C] %t %m", or
+ *                      NULL to restore the default layout.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_LAYOUT_INVALID if the pattern has an unknown
+ *        field, has no %m, or is longer than
+ *        \ref VCSERVICE_LOG_LAYOUT_MAX_SIZE.
+ *      - a non-zero error code on failure, in which case the layout is
+ *        unchanged.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_log_set_layout(vcservice_log* log, const char* pattern)
+{
+    status retval;
+    vcservice_log_layout* layout = NULL;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+
+    /* compile the new layout before giving up the old one. */
+    if (NULL != pattern)
+    {
+        retval = vcservice_log_layout_compile(&layout, log->alloc, pattern);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* release the previous layout. */
+    retval = STATUS_SUCCESS;
+    if (NULL != log->layout)
+    {
+        retval = rcpr_allocator_reclaim(log->alloc, log->layout);
+    }
+
+    log->layout = layout;
+
+    return retval;
+}
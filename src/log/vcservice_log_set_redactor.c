@@ -0,0 +1,47 @@
+/**
+ * \file log/vcservice_log_set_redactor.c
+ *
+ * \brief Set the redactor for a logger.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Set the redactor for this logger.
+ *
+ * Every committed message is passed through the redactor before it is written.
+ * The logger takes ownership of the redactor, and releases it when the logger
+ * is released or when another redactor is set.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ * \param redactor      The redactor to use, or NULL to disable redaction.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code if releasing the previous redactor failed.
+ */
+status
+vcservice_log_set_redactor(
+    vcservice_log* log, vcservice_log_redactor* redactor)
+{
+    status retval = STATUS_SUCCESS;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(
+        NULL == redactor || prop_vcservice_log_redactor_valid(redactor));
+
+    /* release the previous redactor. */
+    if (NULL != log->redactor && redactor != log->redactor)
+    {
+        retval = resource_release(&log->redactor->hdr);
+    }
+
+    log->redactor = redactor;
+
+    return retval;
+}
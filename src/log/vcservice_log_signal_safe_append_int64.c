@@ -0,0 +1,35 @@
+/**
+ * \file log/vcservice_log_signal_safe_append_int64.c
+ *
+ * \brief Append a signed integer to an async-signal-safe log message.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Append a signed integer to an async-signal-safe log message.
+ *
+ * \param msg           The message for this operation.
+ * \param val           The value to append in decimal.
+ */
+void
+vcservice_log_signal_safe_append_int64(
+    vcservice_log_signal_safe_message* msg, int64_t val)
+{
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != msg);
+
+    if (val < 0)
+    {
+        vcservice_log_signal_safe_append_string(msg, "-");
+
+        /* negate in unsigned arithmetic, which also covers INT64_MIN. */
+        vcservice_log_signal_safe_append_uint64(msg, -(uint64_t)val);
+    }
+    else
+    {
+        vcservice_log_signal_safe_append_uint64(msg, (uint64_t)val);
+    }
+}
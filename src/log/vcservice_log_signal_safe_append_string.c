@@ -0,0 +1,36 @@
+/**
+ * \file log/vcservice_log_signal_safe_append_string.c
+ *
+ * \brief Append a string to an async-signal-safe log message.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Append a string to an async-signal-safe log message.
+ *
+ * Text past the end of the message is dropped.
+ *
+ * \param msg           The message for this operation.
+ * \param val           The string value to append.
+ */
+void
+vcservice_log_signal_safe_append_string(
+    vcservice_log_signal_safe_message* msg, const char* val)
+{
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != msg);
+    RCPR_MODEL_ASSERT(NULL != val);
+
+    /* the last byte is kept for the newline. */
+    size_t limit = sizeof(msg->data) - 1;
+
+    /* a plain loop, since only some libc string functions are listed as
+     * async-signal-safe. */
+    while (msg->size < limit && 0 != *val)
+    {
+        msg->data[msg->size++] = *val++;
+    }
+}
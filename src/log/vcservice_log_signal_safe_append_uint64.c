@@ -0,0 +1,36 @@
+/**
+ * \file log/vcservice_log_signal_safe_append_uint64.c
+ *
+ * \brief Append an unsigned integer to an async-signal-safe log message.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Append an unsigned integer to an async-signal-safe log message.
+ *
+ * \param msg           The message for this operation.
+ * \param val           The value to append in decimal.
+ */
+void
+vcservice_log_signal_safe_append_uint64(
+    vcservice_log_signal_safe_message* msg, uint64_t val)
+{
+    char digits[21];
+    char* out = digits + sizeof(digits) - 1;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != msg);
+
+    /* format backwards into a zero-terminated string. */
+    *out = 0;
+    do
+    {
+        *--out = (char)('0' + val % 10);
+        val /= 10;
+    } while (val > 0);
+
+    vcservice_log_signal_safe_append_string(msg, out);
+}
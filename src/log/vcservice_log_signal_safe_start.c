@@ -0,0 +1,88 @@
+/**
+ * \file log/vcservice_log_signal_safe_start.c
+ *
+ * \brief Start an async-signal-safe log message.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <time.h>
+
+#include "log_internal.h"
+
+static void format_digits(char* out, unsigned int value, size_t width);
+
+/**
+ * \brief Start an async-signal-safe log message.
+ *
+ * \param msg           The message to start.
+ * \param level         The logging level of this message, belonging to
+ *                      \ref vcservice_loglevel.
+ */
+void
+vcservice_log_signal_safe_start(
+    vcservice_log_signal_safe_message* msg, unsigned int level)
+{
+    struct timespec now;
+    char* out = msg->data;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != msg);
+
+    /* clock_gettime is async-signal-safe; localtime_r is not, since it may
+     * load the time zone, so the date is worked out here in UTC. */
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    uint64_t seconds = (uint64_t)now.tv_sec;
+    unsigned int second_of_day = (unsigned int)(seconds % 86400);
+
+    /* convert days since the epoch to a civil date, counting years from
+     * March so that the leap day falls at the end. */
+    uint64_t days = seconds / 86400 + 719468;
+    uint64_t era = days / 146097;
+    unsigned int day_of_era = (unsigned int)(days - era * 146097);
+    unsigned int year_of_era =
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524
+            - day_of_era / 146096) / 365;
+    unsigned int day_of_year =
+        day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    unsigned int month_index = (5 * day_of_year + 2) / 153;
+    unsigned int day = day_of_year - (153 * month_index + 2) / 5 + 1;
+    unsigned int month = month_index < 10 ? month_index + 3 : month_index - 9;
+    unsigned int year =
+        (unsigned int)(year_of_era + era * 400) + (month <= 2 ? 1 : 0);
+
+    format_digits(out, year, 4);
+    out[4] = '-';
+    format_digits(out + 5, month, 2);
+    out[7] = '-';
+    format_digits(out + 8, day, 2);
+    out[10] = ' ';
+    format_digits(out + 11, second_of_day / 3600, 2);
+    out[13] = ':';
+    format_digits(out + 14, second_of_day / 60 % 60, 2);
+    out[16] = ':';
+    format_digits(out + 17, second_of_day % 60, 2);
+    out[19] = 'Z';
+    out[20] = ' ';
+    msg->size = 21;
+
+    vcservice_log_signal_safe_append_string(
+        msg, vcservice_log_level_name(level));
+}
+
+/**
+ * \brief Format a value in decimal with exactly the given number of digits.
+ *
+ * \param out           The output buffer.
+ * \param value         The value to format.
+ * \param width         The number of digits.
+ */
+static void format_digits(char* out, unsigned int value, size_t width)
+{
+    for (size_t i = width; i > 0; --i)
+    {
+        out[i - 1] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
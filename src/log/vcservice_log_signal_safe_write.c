@@ -0,0 +1,71 @@
+/**
+ * \file log/vcservice_log_signal_safe_write.c
+ *
+ * \brief Write an async-signal-safe log message.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Write an async-signal-safe log message, ending it with a newline.
+ *
+ * The newline is kept in the message, so writing it again, such as to retry
+ * after a failure, writes the same line.
+ *
+ * \param desc          The descriptor to write to, such as STDERR_FILENO or
+ *                      a log file opened before the handler was installed.
+ * \param msg           The message to write.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SIGNAL_SAFE_WRITE if the message could not be
+ *        written in full.
+ */
+status
+vcservice_log_signal_safe_write(
+    int desc, vcservice_log_signal_safe_message* msg)
+{
+    status retval = STATUS_SUCCESS;
+    int saved_errno = errno;
+    size_t offset = 0;
+    ssize_t written;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != msg);
+
+    /* the appenders leave room for the newline; a retried message already
+     * ends with it. */
+    if (msg->size < sizeof(msg->data)
+     && (0 == msg->size || '\n' != msg->data[msg->size - 1]))
+    {
+        msg->data[msg->size++] = '\n';
+    }
+
+    while (offset < msg->size)
+    {
+        written = write(desc, msg->data + offset, msg->size - offset);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            retval = VCSERVICE_ERROR_LOG_SIGNAL_SAFE_WRITE;
+            break;
+        }
+
+        offset += (size_t)written;
+    }
+
+    /* the interrupted code may be about to read errno. */
+    errno = saved_errno;
+
+    return retval;
+}
@@ -0,0 +1,40 @@
+/**
+ * \file log/vcservice_log_spool_connect.c
+ *
+ * \brief Connect to the spool sink's collector.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Open a non-blocking connection to the collector.
+ *
+ * \param addr          The collector's socket address.
+ *
+ * \returns the connected socket, or -1 on failure.
+ */
+int
+vcservice_log_spool_connect(const struct sockaddr_un* addr)
+{
+    int sock;
+
+    sock = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (sock < 0)
+    {
+        return -1;
+    }
+
+    /* a Unix socket connects immediately or not at all. */
+    if (0 != connect(sock, (const struct sockaddr*)addr, sizeof(*addr)))
+    {
+        close(sock);
+        return -1;
+    }
+
+    return sock;
+}
@@ -0,0 +1,94 @@
+/**
+ * \file log/vcservice_log_spool_context_resource_release.c
+ *
+ * \brief Release the spool sink user context.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release the spool sink user context, spooling any queued messages.
+ *
+ * \param r             The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_LOG_SPOOL_WRITE if any message was dropped.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_log_spool_context_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_log_spool_context* ctx = (vcservice_log_spool_context*)r;
+    status pending_retval = STATUS_SUCCESS;
+    status batch_retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    bool write_failed;
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = ctx->alloc;
+
+    /* let the background thread spool the queue and replay what it can. */
+    pthread_mutex_lock(&ctx->mutex);
+    ctx->stop = true;
+    pthread_cond_signal(&ctx->work_cond);
+    pthread_mutex_unlock(&ctx->mutex);
+    pthread_join(ctx->thread, NULL);
+    write_failed = ctx->queue_failed || ctx->write_failed;
+
+    pthread_cond_destroy(&ctx->space_cond);
+    pthread_cond_destroy(&ctx->work_cond);
+    pthread_mutex_destroy(&ctx->mutex);
+
+    /* release the buffers. */
+    if (NULL != ctx->pending.data)
+    {
+        pending_retval = rcpr_allocator_reclaim(alloc, ctx->pending.data);
+    }
+
+    if (NULL != ctx->batch.data)
+    {
+        batch_retval = rcpr_allocator_reclaim(alloc, ctx->batch.data);
+    }
+
+    /* close the connection and the spool, which also drops its lock. */
+    if (ctx->sock >= 0)
+    {
+        close(ctx->sock);
+    }
+
+    close(ctx->spool_desc);
+
+    /* clear memory. */
+    memset(ctx, 0, sizeof(*ctx));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, ctx);
+
+    /* decode return code. */
+    if (STATUS_SUCCESS != pending_retval)
+    {
+        return pending_retval;
+    }
+    else if (STATUS_SUCCESS != batch_retval)
+    {
+        return batch_retval;
+    }
+    else if (write_failed)
+    {
+        return VCSERVICE_ERROR_LOG_SPOOL_WRITE;
+    }
+    else
+    {
+        return reclaim_retval;
+    }
+}
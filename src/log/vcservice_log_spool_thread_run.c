@@ -0,0 +1,310 @@
+/**
+ * \file log/vcservice_log_spool_thread_run.c
+ *
+ * \brief Background thread for the spool sink.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "log_internal.h"
+
+static void send_batch(vcservice_log_spool_context* ctx);
+static void spool_batch(vcservice_log_spool_context* ctx);
+static void replay(vcservice_log_spool_context* ctx, bool stopping);
+static void disconnect(vcservice_log_spool_context* ctx);
+static uint64_t monotonic_ms(void);
+static void wait_ms(vcservice_log_spool_context* ctx, unsigned int ms);
+
+/**
+ * \brief Entry point for the spool sink's background thread.
+ *
+ * \param context       The \ref vcservice_log_spool_context for this thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_log_spool_thread_run(void* context)
+{
+    vcservice_log_spool_context* ctx = (vcservice_log_spool_context*)context;
+    vcservice_log_buffer tmp;
+    bool spooling, stopping;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    for (;;)
+    {
+        /* wait for messages, or for the next reconnect or replay attempt. */
+        if (!ctx->stop && 0 == ctx->pending.size)
+        {
+            if (!ctx->spooling)
+            {
+                pthread_cond_wait(&ctx->work_cond, &ctx->mutex);
+            }
+            else if (ctx->sock >= 0)
+            {
+                wait_ms(ctx, LOG_SPOOL_REPLAY_WAIT_MS);
+            }
+            else
+            {
+                wait_ms(ctx, LOG_SPOOL_RETRY_MS);
+            }
+        }
+
+        spooling = ctx->spooling;
+        stopping = ctx->stop;
+
+        /* take every queued byte, leaving the empty batch for the writer. */
+        tmp = ctx->pending;
+        ctx->pending = ctx->batch;
+        ctx->batch = tmp;
+        pthread_cond_broadcast(&ctx->space_cond);
+        pthread_mutex_unlock(&ctx->mutex);
+
+        if (spooling)
+        {
+            send_batch(ctx);
+            spool_batch(ctx);
+            replay(ctx, stopping);
+        }
+
+        pthread_mutex_lock(&ctx->mutex);
+
+        /* hand the socket back to the writer once the spool is drained. */
+        if (ctx->spooling && ctx->sock >= 0
+         && 0 == ctx->pending.size && 0 == ctx->spool_size)
+        {
+            ctx->spooling = false;
+        }
+
+        if (stopping)
+        {
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+
+    return NULL;
+}
+
+/**
+ * \brief Send as much of the batch as the collector takes without blocking,
+ * if nothing is waiting in the spool ahead of it.
+ *
+ * \param ctx           The spool context.
+ */
+static void send_batch(vcservice_log_spool_context* ctx)
+{
+    ssize_t sent;
+
+    if (ctx->sock < 0 || ctx->spool_size > 0 || 0 == ctx->batch.size)
+    {
+        return;
+    }
+
+    sent =
+        send(
+            ctx->sock, ctx->batch.data, ctx->batch.size,
+            MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sent < 0)
+    {
+        if (EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno)
+        {
+            disconnect(ctx);
+        }
+
+        return;
+    }
+
+    memmove(
+        ctx->batch.data, ctx->batch.data + sent,
+        ctx->batch.size - (size_t)sent);
+    ctx->batch.size -= (size_t)sent;
+}
+
+/**
+ * \brief Append the batch to the spool file with a single write.
+ *
+ * \param ctx           The spool context.
+ */
+static void spool_batch(vcservice_log_spool_context* ctx)
+{
+    size_t offset = 0;
+    ssize_t written;
+
+    if (0 == ctx->batch.size)
+    {
+        return;
+    }
+
+    /* keep the spool bounded; the oldest messages are kept. */
+    if ((size_t)ctx->spool_size + ctx->batch.size > ctx->spool_limit)
+    {
+        ctx->write_failed = true;
+        goto done;
+    }
+
+    while (offset < ctx->batch.size)
+    {
+        written =
+            pwrite(
+                ctx->spool_desc, ctx->batch.data + offset,
+                ctx->batch.size - offset, ctx->spool_size);
+        if (written < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        else if (written <= 0)
+        {
+            /* eat the failure for logging, but report it on release. */
+            ctx->write_failed = true;
+            goto done;
+        }
+
+        offset += (size_t)written;
+        ctx->spool_size += written;
+    }
+
+done:
+    ctx->batch.size = 0;
+}
+
+/**
+ * \brief Reconnect if needed, then send the spool to the collector until it
+ * is drained or the collector backs up.
+ *
+ * \param ctx           The spool context.
+ * \param stopping      If true, reconnect regardless of the retry interval.
+ */
+static void replay(vcservice_log_spool_context* ctx, bool stopping)
+{
+    status retval;
+    uint64_t now;
+    ssize_t size, sent;
+
+    if (0 == ctx->spool_size)
+    {
+        return;
+    }
+
+    if (ctx->sock < 0)
+    {
+        now = monotonic_ms();
+        if (!stopping && now < ctx->retry_at)
+        {
+            return;
+        }
+
+        ctx->sock = vcservice_log_spool_connect(&ctx->addr);
+        if (ctx->sock < 0)
+        {
+            ctx->retry_at = now + LOG_SPOOL_RETRY_MS;
+            return;
+        }
+    }
+
+    /* the batch is empty here, so it serves as the read buffer. */
+    retval =
+        vcservice_log_buffer_reserve(
+            ctx->alloc, &ctx->batch, LOG_SPOOL_REPLAY_CHUNK_SIZE);
+    if (STATUS_SUCCESS != retval)
+    {
+        return;
+    }
+
+    while (ctx->replay_offset < ctx->spool_size)
+    {
+        size =
+            pread(
+                ctx->spool_desc, ctx->batch.data,
+                LOG_SPOOL_REPLAY_CHUNK_SIZE, ctx->replay_offset);
+        if (size < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        else if (size <= 0)
+        {
+            /* the rest of the spool is unreadable, so give it up. */
+            ctx->write_failed = true;
+            ctx->replay_offset = ctx->spool_size;
+            break;
+        }
+
+        sent =
+            send(
+                ctx->sock, ctx->batch.data, (size_t)size,
+                MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            if (EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno)
+            {
+                disconnect(ctx);
+            }
+
+            return;
+        }
+
+        ctx->replay_offset += sent;
+    }
+
+    /* the spool has been replayed, so reclaim the disk space. */
+    if (0 == ftruncate(ctx->spool_desc, 0))
+    {
+        ctx->spool_size = 0;
+        ctx->replay_offset = 0;
+    }
+}
+
+/**
+ * \brief Close the connection to the collector.
+ *
+ * \param ctx           The spool context.
+ */
+static void disconnect(vcservice_log_spool_context* ctx)
+{
+    close(ctx->sock);
+    ctx->sock = -1;
+    ctx->retry_at = monotonic_ms() + LOG_SPOOL_RETRY_MS;
+}
+
+/**
+ * \brief Get the monotonic clock in milliseconds.
+ *
+ * \returns the current monotonic time in milliseconds.
+ */
+static uint64_t monotonic_ms(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+/**
+ * \brief Wait on the work condition for at most the given time.
+ *
+ * \param ctx           The spool context, whose mutex is held.
+ * \param ms            The maximum time to wait, in milliseconds.
+ */
+static void wait_ms(vcservice_log_spool_context* ctx, unsigned int ms)
+{
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += ms / 1000;
+    deadline.tv_nsec += (long)(ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_cond_timedwait(&ctx->work_cond, &ctx->mutex, &deadline);
+}
@@ -0,0 +1,22 @@
+/**
+ * \file log/vcservice_log_stats_get.c
+ *
+ * \brief Get the counters of a logger.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Get the counters of the given logger.
+ *
+ * \param log           The \ref vcservice_log instance for this operation.
+ *
+ * \returns the logger's counters, which are valid until it is released.
+ */
+const vcservice_log_stats*
+vcservice_log_stats_get(const vcservice_log* log)
+{
+    return &log->stats;
+}
@@ -0,0 +1,24 @@
+/**
+ * \file log/vcservice_log_store_be64.c
+ *
+ * \brief Write a value in big-endian order.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Write a value in big-endian order.
+ *
+ * \param out           The eight byte output buffer.
+ * \param value         The value to write.
+ */
+void
+vcservice_log_store_be64(uint8_t* out, uint64_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+        out[i] = (uint8_t)(value >> (8 * (sizeof(value) - 1 - i)));
+    }
+}
@@ -0,0 +1,20 @@
+/**
+ * \file log/vcservice_log_trace_context_current.c
+ *
+ * \brief Get the current trace context.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Get the trace context that is current on the calling thread.
+ *
+ * \returns the current trace context, or NULL if there is none.
+ */
+vcservice_log_trace_context*
+vcservice_log_trace_context_current(void)
+{
+    return vcservice_log_trace_current;
+}
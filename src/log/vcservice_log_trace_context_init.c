@@ -0,0 +1,48 @@
+/**
+ * \file log/vcservice_log_trace_context_init.c
+ *
+ * \brief Initialize a trace context.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Initialize a trace context with the given trace and span ids,
+ * rendering its text.
+ *
+ * \param ctx           The trace context to initialize.
+ * \param trace_id      The trace id, typically the request's correlation
+ *                      UUID.
+ * \param span_id       The span id.
+ */
+void
+vcservice_log_trace_context_init(
+    vcservice_log_trace_context* ctx, const RCPR_SYM(rcpr_uuid)* trace_id,
+    uint64_t span_id)
+{
+    uint8_t span[8];
+    char* out = ctx->text;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(NULL != ctx);
+    RCPR_MODEL_ASSERT(NULL != trace_id);
+
+    memcpy(&ctx->trace_id, trace_id, sizeof(ctx->trace_id));
+    ctx->span_id = span_id;
+
+    /* render the text once, so each message only copies it. */
+    memcpy(out, "trace=", 6);
+    out += 6;
+    vcservice_log_uuid_format(out, trace_id);
+    out += LOG_UUID_TEXT_SIZE;
+    memcpy(out, " span=", 6);
+    out += 6;
+    vcservice_log_store_be64(span, span_id);
+    vcservice_log_hex_encode(out, span, sizeof(span));
+    out += 2 * sizeof(span);
+    *out = ' ';
+}
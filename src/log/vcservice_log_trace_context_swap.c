@@ -0,0 +1,33 @@
+/**
+ * \file log/vcservice_log_trace_context_swap.c
+ *
+ * \brief Swap the current trace context.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief The trace context that is current on this thread.
+ */
+__thread vcservice_log_trace_context* vcservice_log_trace_current;
+
+/**
+ * \brief Make the given trace context current on the calling thread,
+ * returning the previous one.
+ *
+ * \param ctx           The trace context to make current, or NULL to clear
+ *                      the current context.
+ *
+ * \returns the previously current trace context, or NULL if there was none.
+ */
+vcservice_log_trace_context*
+vcservice_log_trace_context_swap(vcservice_log_trace_context* ctx)
+{
+    vcservice_log_trace_context* prev = vcservice_log_trace_current;
+
+    vcservice_log_trace_current = ctx;
+
+    return prev;
+}
@@ -0,0 +1,32 @@
+/**
+ * \file log/vcservice_log_uuid_format.c
+ *
+ * \brief Write the text form of a UUID.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "log_internal.h"
+
+/**
+ * \brief Write the canonical text form of a UUID, in lowercase hex digits
+ * grouped 8-4-4-4-12.
+ *
+ * \param out           The output buffer, which must hold
+ *                      \ref LOG_UUID_TEXT_SIZE bytes.  It is not
+ *                      zero-terminated.
+ * \param val           The UUID to write.
+ */
+void
+vcservice_log_uuid_format(char* out, const RCPR_SYM(rcpr_uuid)* val)
+{
+    vcservice_log_hex_encode(out, val->data, 4);
+    out[8] = '-';
+    vcservice_log_hex_encode(out + 9, val->data + 4, 2);
+    out[13] = '-';
+    vcservice_log_hex_encode(out + 14, val->data + 6, 2);
+    out[18] = '-';
+    vcservice_log_hex_encode(out + 19, val->data + 8, 2);
+    out[23] = '-';
+    vcservice_log_hex_encode(out + 24, val->data + 10, 6);
+}
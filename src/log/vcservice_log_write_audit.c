@@ -0,0 +1,69 @@
+/**
+ * \file log/vcservice_log_write_audit.c
+ *
+ * \brief Queue a log message for the audit sink.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Queue the log message for the audit sink's background thread.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param log_level     The log level for the message to write.
+ * \param user_context  The type erased audit context.
+ */
+void
+vcservice_log_write_audit(
+    vcservice_log* log, unsigned int log_level,
+    RCPR_SYM(resource)* user_context)
+{
+    status retval;
+    vcservice_log_audit_context* ctx =
+        (vcservice_log_audit_context*)user_context;
+    uint32_t size = (uint32_t)log->log_idx;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(prop_vcservice_log_threshold_level_valid(log_level));
+
+    /* this interface ignores the log level. */
+    (void)log_level;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    /* apply back pressure rather than drop audit records. */
+    while (
+        ctx->pending.size > 0
+     && ctx->pending.size + sizeof(size) + size > LOG_AUDIT_QUEUE_LIMIT)
+    {
+        pthread_cond_wait(&ctx->space_cond, &ctx->mutex);
+    }
+
+    retval =
+        vcservice_log_buffer_reserve(
+            ctx->alloc, &ctx->pending, sizeof(size) + size);
+    if (STATUS_SUCCESS != retval)
+    {
+        /* eat the failure for logging, but report it on release. */
+        ctx->queue_failed = true;
+        vcservice_log_stats_dropped(log, 1);
+        goto unlock;
+    }
+
+    /* queue the length prefixed message. */
+    memcpy(ctx->pending.data + ctx->pending.size, &size, sizeof(size));
+    memcpy(
+        ctx->pending.data + ctx->pending.size + sizeof(size),
+        log->log_message, size);
+    ctx->pending.size += sizeof(size) + size;
+
+    pthread_cond_signal(&ctx->work_cond);
+
+unlock:
+    pthread_mutex_unlock(&ctx->mutex);
+}
@@ -0,0 +1,106 @@
+/**
+ * \file log/vcservice_log_write_encrypted.c
+ *
+ * \brief Append a log message to the encrypted sink.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "log_internal.h"
+
+static void set_flush_deadline(vcservice_log_encrypted_context* ctx);
+
+/**
+ * \brief Append the log message to the encrypted sink's current block.
+ *
+ * ERROR and CRITICAL messages submit the block straight away, so that they
+ * reach the descriptor even if the process dies soon after.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param log_level     The log level for the message to write.
+ * \param user_context  The type erased encrypted context.
+ */
+void
+vcservice_log_write_encrypted(
+    vcservice_log* log, unsigned int log_level,
+    RCPR_SYM(resource)* user_context)
+{
+    vcservice_log_encrypted_context* ctx =
+        (vcservice_log_encrypted_context*)user_context;
+    size_t offset = 0;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(prop_vcservice_log_threshold_level_valid(log_level));
+
+    /* a worker may submit the filling block on its flush deadline. */
+    pthread_mutex_lock(&ctx->mutex);
+
+    while (offset < log->log_idx)
+    {
+        /* claim the next slot once the workers are done with it. */
+        if (NULL == ctx->filling)
+        {
+            vcservice_log_encrypted_slot* slot =
+                &ctx->slots[ctx->submitted % ctx->slot_count];
+
+            while (LOG_ENCRYPTED_SLOT_FREE != slot->state)
+            {
+                pthread_cond_wait(&ctx->space_cond, &ctx->mutex);
+            }
+
+            slot->index = ctx->submitted;
+            slot->size = 0;
+            ctx->filling = slot;
+            set_flush_deadline(ctx);
+        }
+
+        /* the byte stream is cut at block boundaries, not message ones. */
+        size_t size = log->log_idx - offset;
+        if (size > ctx->block_size - ctx->filling->size)
+        {
+            size = ctx->block_size - ctx->filling->size;
+        }
+
+        memcpy(
+            ctx->filling->plain + ctx->filling->size,
+            log->log_message + offset, size);
+        ctx->filling->size += size;
+        offset += size;
+
+        if (ctx->filling->size == ctx->block_size)
+        {
+            vcservice_log_encrypted_submit(ctx);
+        }
+    }
+
+    if (log_level <= VCSERVICE_LOGLEVEL_ERROR)
+    {
+        vcservice_log_encrypted_submit(ctx);
+    }
+
+    pthread_mutex_unlock(&ctx->mutex);
+}
+
+/**
+ * \brief Set the time at which a worker submits the block just claimed, and
+ * wake a worker to wait for it.
+ *
+ * \param ctx           The encrypted context, whose mutex is held.
+ */
+static void set_flush_deadline(vcservice_log_encrypted_context* ctx)
+{
+    clock_gettime(CLOCK_REALTIME, &ctx->flush_deadline);
+    ctx->flush_deadline.tv_sec += LOG_ENCRYPTED_FLUSH_INTERVAL_MS / 1000;
+    ctx->flush_deadline.tv_nsec +=
+        (long)(LOG_ENCRYPTED_FLUSH_INTERVAL_MS % 1000) * 1000000;
+    if (ctx->flush_deadline.tv_nsec >= 1000000000)
+    {
+        ctx->flush_deadline.tv_sec += 1;
+        ctx->flush_deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_cond_signal(&ctx->work_cond);
+}
@@ -0,0 +1,82 @@
+/**
+ * \file log/vcservice_log_write_segment.c
+ *
+ * \brief Append a log message to the current signed segment.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Append the log message to the current signed segment.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param log_level     The log level for the message to write.
+ * \param user_context  The type erased segment context.
+ */
+void
+vcservice_log_write_segment(
+    vcservice_log* log, unsigned int log_level,
+    RCPR_SYM(resource)* user_context)
+{
+    vcservice_log_segment_context* ctx =
+        (vcservice_log_segment_context*)user_context;
+    size_t offset = 0;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(prop_vcservice_log_threshold_level_valid(log_level));
+
+    /* this interface ignores the log level. */
+    (void)log_level;
+
+    /* messages are never split across segments. */
+    if (ctx->size > 0 && ctx->size + log->log_idx > ctx->segment_size)
+    {
+        vcservice_log_segment_close(ctx);
+    }
+
+    /* segments are opened on demand, so an empty one is never signed. */
+    if (ctx->desc < 0)
+    {
+        snprintf(
+            ctx->name + ctx->prefix_length, LOG_SEGMENT_NAME_SUFFIX_SIZE,
+            ".%08" PRIu64, ctx->index);
+        ctx->desc =
+            open(ctx->name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0640);
+        if (ctx->desc < 0)
+        {
+            /* eat the failure for logging, but report it on release. */
+            ctx->write_failed = true;
+            return;
+        }
+    }
+
+    while (offset < log->log_idx)
+    {
+        ssize_t written =
+            write(
+                ctx->desc, log->log_message + offset, log->log_idx - offset);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            ctx->write_failed = true;
+            break;
+        }
+
+        offset += (size_t)written;
+    }
+
+    ctx->size += offset;
+}
@@ -0,0 +1,99 @@
+/**
+ * \file log/vcservice_log_write_spooled.c
+ *
+ * \brief Send a log message to the collector, or queue it for the spool.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "log_internal.h"
+
+/**
+ * \brief Send the log message to the collector, or queue it for the spool.
+ *
+ * \param log           The \ref vcservice_log instance.
+ * \param log_level     The log level for the message to write.
+ * \param user_context  The type erased spool context.
+ */
+void
+vcservice_log_write_spooled(
+    vcservice_log* log, unsigned int log_level,
+    RCPR_SYM(resource)* user_context)
+{
+    status retval;
+    vcservice_log_spool_context* ctx =
+        (vcservice_log_spool_context*)user_context;
+    const char* data = log->log_message;
+    size_t size = log->log_idx;
+    ssize_t sent;
+
+    /* parameter sanity checks. */
+    RCPR_MODEL_ASSERT(prop_vcservice_log_valid(log));
+    RCPR_MODEL_ASSERT(prop_vcservice_log_threshold_level_valid(log_level));
+
+    /* this interface ignores the log level. */
+    (void)log_level;
+
+    pthread_mutex_lock(&ctx->mutex);
+
+    if (!ctx->spooling)
+    {
+        /* the socket belongs to the writer until the first failure. */
+        pthread_mutex_unlock(&ctx->mutex);
+
+        sent = send(ctx->sock, data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent == (ssize_t)size)
+        {
+            return;
+        }
+
+        if (sent < 0)
+        {
+            /* drop the connection unless the collector is just behind. */
+            if (EAGAIN != errno && EWOULDBLOCK != errno && EINTR != errno)
+            {
+                close(ctx->sock);
+                ctx->sock = -1;
+            }
+
+            sent = 0;
+        }
+
+        /* spool the rest of this message and everything after it. */
+        data += sent;
+        size -= (size_t)sent;
+
+        pthread_mutex_lock(&ctx->mutex);
+        ctx->spooling = true;
+    }
+
+    /* apply back pressure; the spool thread only writes to local disk. */
+    while (
+        ctx->pending.size > 0
+     && ctx->pending.size + size > LOG_SPOOL_QUEUE_LIMIT)
+    {
+        pthread_cond_wait(&ctx->space_cond, &ctx->mutex);
+    }
+
+    retval = vcservice_log_buffer_reserve(ctx->alloc, &ctx->pending, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        /* eat the failure for logging, but report it on release. */
+        ctx->queue_failed = true;
+        vcservice_log_stats_dropped(log, 1);
+        goto unlock;
+    }
+
+    memcpy(ctx->pending.data + ctx->pending.size, data, size);
+    ctx->pending.size += size;
+
+    pthread_cond_signal(&ctx->work_cond);
+
+unlock:
+    pthread_mutex_unlock(&ctx->mutex);
+}
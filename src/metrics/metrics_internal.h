@@ -0,0 +1,222 @@
+/**
+ * \file metrics/metrics_internal.h
+ *
+ * \brief Internal header for the metrics registry and exporter.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <rcpr/resource/protected.h>
+#include <stdbool.h>
+#include <sys/un.h>
+#include <vcservice/metrics.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+#define METRICS_SHARD_COUNT             16
+#define METRICS_SHARD_SIZE              64
+#define METRICS_REQUEST_SIZE            4096
+#define METRICS_REQUEST_TIMEOUT_MS      1000
+#define METRICS_LISTEN_BACKLOG          8
+#define METRICS_NUMBER_SIZE             24
+#define METRICS_BUFFER_INITIAL_SIZE     4096
+
+#define METRICS_TYPE_COUNTER            0
+#define METRICS_TYPE_GAUGE              1
+#define METRICS_TYPE_SUMMARY            2
+#define METRICS_TYPE_CALLBACK           3
+
+/**
+ * \brief One shard of a counter, padded to its own cache line.
+ */
+typedef struct vcservice_metrics_shard vcservice_metrics_shard;
+
+struct vcservice_metrics_shard
+{
+    uint64_t value;
+    char pad[METRICS_SHARD_SIZE - sizeof(uint64_t)];
+};
+
+struct vcservice_metrics_counter
+{
+    vcservice_metrics_shard shards[METRICS_SHARD_COUNT];
+};
+
+struct vcservice_metrics_gauge
+{
+    int64_t value;
+};
+
+/**
+ * \brief A counter kept elsewhere, read through a callback.
+ */
+typedef struct vcservice_metrics_callback vcservice_metrics_callback;
+
+struct vcservice_metrics_callback
+{
+    vcservice_metrics_counter_read_fn read;
+    const void* context;
+};
+
+/**
+ * \brief A registered metric.  The name, labels, and help text are stored
+ * after the entry in the same allocation.
+ */
+typedef struct vcservice_metrics_entry vcservice_metrics_entry;
+
+struct vcservice_metrics_entry
+{
+    vcservice_metrics_entry* next;
+    int type;
+    const char* name;
+    const char* labels;
+    const char* help;
+    union
+    {
+        vcservice_metrics_counter* counter;
+        vcservice_metrics_gauge* gauge;
+        vcservice_histogram* histogram;
+        vcservice_metrics_callback* callback;
+    } value;
+};
+
+/**
+ * \brief Get the Prometheus type of a metric type.  Metrics sharing a name
+ * must have the same Prometheus type.
+ *
+ * \param type              The metric type.
+ *
+ * \returns the Prometheus type.
+ */
+static inline int vcservice_metrics_family_type(int type)
+{
+    return METRICS_TYPE_CALLBACK == type ? METRICS_TYPE_COUNTER : type;
+}
+
+/**
+ * \brief A growable buffer holding rendered metrics.
+ */
+typedef struct vcservice_metrics_buffer vcservice_metrics_buffer;
+
+struct vcservice_metrics_buffer
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+};
+
+/**
+ * \brief The registry.  The mutex guards the entry list, which is kept with
+ * the entries of each metric name together.  It is never taken by updates.
+ */
+struct vcservice_metrics_registry
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    pthread_mutex_t mutex;
+    vcservice_metrics_entry* entries;
+};
+
+struct vcservice_metrics_exporter
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    vcservice_metrics_registry* registry;
+    struct sockaddr_un addr;
+    int listen_sock;
+    int stop_pipe[2];
+    pthread_t thread;
+    vcservice_metrics_buffer output;
+    vcservice_histogram_snapshot* snapshot;
+};
+
+/**
+ * \brief Add a metric to the registry.
+ *
+ * \param registry          The registry to add the metric to.
+ * \param type              The metric type.
+ * \param value             The counter, gauge, histogram, or callback.  On
+ *                          success, all but a histogram are owned by the
+ *                          registry.
+ * \param name              The metric name.
+ * \param labels            The labels, or NULL.
+ * \param help              The help text.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL,
+ *        the name is not valid, or the name is registered with another type.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_register(
+    vcservice_metrics_registry* registry, int type, void* value,
+    const char* name, const char* labels, const char* help);
+
+/**
+ * \brief Render every metric in the registry in the Prometheus text
+ * exposition format.
+ *
+ * \param buffer            The buffer to append to.
+ * \param alloc             The allocator for the buffer.
+ * \param registry          The registry to render.
+ * \param snapshot          Scratch space for rendering histograms.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_render(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc,
+    vcservice_metrics_registry* registry,
+    vcservice_histogram_snapshot* snapshot);
+
+/**
+ * \brief Append data to a metrics buffer, growing it if needed.
+ *
+ * \param buffer            The buffer to append to.
+ * \param alloc             The allocator for the buffer.
+ * \param data              The data to append.
+ * \param size              The size of the data.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_buffer_append(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc,
+    const void* data, size_t size);
+
+status
+vcservice_metrics_registry_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+vcservice_metrics_exporter_resource_release(
+    RCPR_SYM(resource)* r);
+
+/**
+ * \brief Entry point for the exporter's background thread.
+ *
+ * \param context           The \ref vcservice_metrics_exporter for this
+ *                          thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_metrics_exporter_thread_run(void* context);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
@@ -0,0 +1,71 @@
+/**
+ * \file metrics/vcservice_metrics_buffer_append.c
+ *
+ * \brief Append data to a metrics buffer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Append data to a metrics buffer, growing it if needed.
+ *
+ * \param buffer            The buffer to append to.
+ * \param alloc             The allocator for the buffer.
+ * \param data              The data to append.
+ * \param size              The size of the data.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_buffer_append(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc,
+    const void* data, size_t size)
+{
+    status retval;
+    size_t capacity;
+    void* tmp;
+
+    if (buffer->capacity - buffer->size < size)
+    {
+        /* double the capacity until the new data fits. */
+        capacity =
+            (0 == buffer->capacity)
+                ? METRICS_BUFFER_INITIAL_SIZE : buffer->capacity;
+        while (capacity - buffer->size < size)
+        {
+            capacity *= 2;
+        }
+
+        /* the first allocation has nothing to copy. */
+        if (NULL == buffer->data)
+        {
+            retval = rcpr_allocator_allocate(alloc, &tmp, capacity);
+        }
+        else
+        {
+            tmp = buffer->data;
+            retval = rcpr_allocator_reallocate(alloc, &tmp, capacity);
+        }
+
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        buffer->data = (char*)tmp;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+
+    return STATUS_SUCCESS;
+}
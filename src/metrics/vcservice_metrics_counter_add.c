@@ -0,0 +1,41 @@
+/**
+ * \file metrics/vcservice_metrics_counter_add.c
+ *
+ * \brief Add to a counter metric.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+/* sched_getcpu is a GNU extension. */
+#define _GNU_SOURCE
+
+#include <cbmc/model_assert.h>
+#include <sched.h>
+
+#include "metrics_internal.h"
+
+/**
+ * \brief Add to a counter.
+ *
+ * The counter is split into per-CPU shards, so this is one uncontended
+ * atomic add.
+ *
+ * \param counter           The counter to update.
+ * \param value             The amount to add.
+ */
+void
+vcservice_metrics_counter_add(
+    vcservice_metrics_counter* counter, uint64_t value)
+{
+    int cpu = sched_getcpu();
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != counter);
+
+    /* without a CPU number, every thread shares the first shard. */
+    unsigned int shard = cpu < 0 ? 0 : (unsigned int)cpu % METRICS_SHARD_COUNT;
+
+    /* a thread moved off this CPU still adds atomically, so no count is
+     * lost, it just shares a cache line for that one add. */
+    __atomic_fetch_add(&counter->shards[shard].value, value, __ATOMIC_RELAXED);
+}
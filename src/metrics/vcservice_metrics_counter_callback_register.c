@@ -0,0 +1,87 @@
+/**
+ * \file metrics/vcservice_metrics_counter_callback_register.c
+ *
+ * \brief Register a counter that is read through a callback.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcservice/error_codes.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Register a counter that is kept elsewhere, whose value is read by
+ * calling \p read each time the registry is rendered.
+ *
+ * \param registry          The registry to add the counter to.
+ * \param read              The function that reads the counter.  It may be
+ *                          called from the exporter's thread.
+ * \param context           The context passed to \p read, which must stay
+ *                          valid while the registry can be rendered.
+ * \param name              The metric name, which must match
+ *                          [a-zA-Z_:][a-zA-Z0-9_:]*.
+ * \param labels            The labels, such as level="error", or NULL.  The
+ *                          label values must already be escaped.
+ * \param help              The help text, which must be a single line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name is not valid.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_counter_callback_register(
+    vcservice_metrics_registry* registry,
+    vcservice_metrics_counter_read_fn read, const void* context,
+    const char* name, const char* labels, const char* help)
+{
+    status retval, release_retval;
+    vcservice_metrics_callback* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_metrics_registry_valid(registry));
+    MODEL_ASSERT(NULL != read);
+
+    /* runtime parameter checks. */
+    if (NULL == registry || NULL == read)
+    {
+        return VCSERVICE_ERROR_METRICS_INVALID_PARAMETER;
+    }
+
+    retval =
+        rcpr_allocator_allocate(registry->alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    tmp->read = read;
+    tmp->context = context;
+
+    retval =
+        vcservice_metrics_register(
+            registry, METRICS_TYPE_CALLBACK, tmp, name, labels, help);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_memory;
+    }
+
+    /* success. */
+    return STATUS_SUCCESS;
+
+cleanup_memory:
+    release_retval = rcpr_allocator_reclaim(registry->alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
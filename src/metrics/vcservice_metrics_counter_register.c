@@ -0,0 +1,83 @@
+/**
+ * \file metrics/vcservice_metrics_counter_register.c
+ *
+ * \brief Register a counter metric.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Register a counter, a value that only goes up.
+ *
+ * \param counter           Pointer to receive the counter on success.
+ * \param registry          The registry to add the counter to.
+ * \param name              The metric name, which must match
+ *                          [a-zA-Z_:][a-zA-Z0-9_:]*.
+ * \param labels            The labels, such as level="error", or NULL.  The
+ *                          label values must already be escaped.
+ * \param help              The help text, which must be a single line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name is not valid.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_counter_register(
+    vcservice_metrics_counter** counter, vcservice_metrics_registry* registry,
+    const char* name, const char* labels, const char* help)
+{
+    status retval, release_retval;
+    vcservice_metrics_counter* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != counter);
+    MODEL_ASSERT(prop_vcservice_metrics_registry_valid(registry));
+
+    /* runtime parameter checks. */
+    if (NULL == counter || NULL == registry)
+    {
+        return VCSERVICE_ERROR_METRICS_INVALID_PARAMETER;
+    }
+
+    retval =
+        rcpr_allocator_allocate(registry->alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+
+    retval =
+        vcservice_metrics_register(
+            registry, METRICS_TYPE_COUNTER, tmp, name, labels, help);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_memory;
+    }
+
+    /* success. */
+    *counter = tmp;
+    return STATUS_SUCCESS;
+
+cleanup_memory:
+    release_retval = rcpr_allocator_reclaim(registry->alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
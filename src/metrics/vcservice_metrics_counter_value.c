@@ -0,0 +1,34 @@
+/**
+ * \file metrics/vcservice_metrics_counter_value.c
+ *
+ * \brief Get the value of a counter metric.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "metrics_internal.h"
+
+/**
+ * \brief Get the value of a counter.
+ *
+ * \param counter           The counter to read.
+ *
+ * \returns the sum of the counter's shards.
+ */
+uint64_t
+vcservice_metrics_counter_value(const vcservice_metrics_counter* counter)
+{
+    uint64_t value = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != counter);
+
+    for (size_t i = 0; i < METRICS_SHARD_COUNT; ++i)
+    {
+        value += __atomic_load_n(&counter->shards[i].value, __ATOMIC_RELAXED);
+    }
+
+    return value;
+}
@@ -0,0 +1,166 @@
+/**
+ * \file metrics/vcservice_metrics_exporter_create.c
+ *
+ * \brief Create a Prometheus exporter for a metrics registry.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_metrics_exporter, which serves a registry
+ * in the Prometheus text exposition format on a Unix domain socket.
+ *
+ * \param exporter          Pointer to the \ref vcservice_metrics_exporter
+ *                          pointer to receive this resource on success.
+ * \param alloc             The allocator to use for this exporter.
+ * \param registry          The registry to serve, which must outlive the
+ *                          exporter.
+ * \param socket_path       The path of the socket to listen on.  A stale
+ *                          socket at this path is replaced.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the socket path is too long.
+ *      - VCSERVICE_ERROR_METRICS_SOCKET if the socket could not be created.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_exporter_create(
+    vcservice_metrics_exporter** exporter, RCPR_SYM(allocator)* alloc,
+    vcservice_metrics_registry* registry, const char* socket_path)
+{
+    status retval, release_retval;
+    vcservice_metrics_exporter* tmp;
+    struct stat st;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != exporter);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(prop_vcservice_metrics_registry_valid(registry));
+    MODEL_ASSERT(NULL != socket_path);
+
+    /* runtime parameter checks. */
+    if (NULL == exporter || NULL == alloc || NULL == registry
+     || NULL == socket_path
+     || strlen(socket_path) >= sizeof(((struct sockaddr_un*)0)->sun_path))
+    {
+        return VCSERVICE_ERROR_METRICS_INVALID_PARAMETER;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->alloc = alloc;
+    tmp->registry = registry;
+    tmp->addr.sun_family = AF_UNIX;
+    strcpy(tmp->addr.sun_path, socket_path);
+    tmp->listen_sock = -1;
+    tmp->stop_pipe[0] = tmp->stop_pipe[1] = -1;
+
+    /* histograms are rendered from this snapshot. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp->snapshot, sizeof(*tmp->snapshot));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_memory;
+    }
+
+    /* the stop pipe wakes the background thread on release. */
+    if (0 != pipe(tmp->stop_pipe))
+    {
+        retval = VCSERVICE_ERROR_METRICS_SOCKET;
+        goto cleanup_snapshot;
+    }
+
+    fcntl(tmp->stop_pipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(tmp->stop_pipe[1], F_SETFD, FD_CLOEXEC);
+
+    tmp->listen_sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (tmp->listen_sock < 0)
+    {
+        retval = VCSERVICE_ERROR_METRICS_SOCKET;
+        goto cleanup_sockets;
+    }
+
+    /* replace a socket left behind by an earlier run, but nothing else. */
+    if (0 == lstat(socket_path, &st) && S_ISSOCK(st.st_mode))
+    {
+        unlink(socket_path);
+    }
+
+    if (0 != bind(
+                tmp->listen_sock, (const struct sockaddr*)&tmp->addr,
+                sizeof(tmp->addr))
+     || 0 != listen(tmp->listen_sock, METRICS_LISTEN_BACKLOG))
+    {
+        retval = VCSERVICE_ERROR_METRICS_SOCKET;
+        goto cleanup_sockets;
+    }
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_metrics_exporter_resource_release);
+
+    /* start the background thread. */
+    if (0 != pthread_create(
+                &tmp->thread, NULL, &vcservice_metrics_exporter_thread_run,
+                tmp))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_THREAD_CREATE;
+        goto cleanup_path;
+    }
+
+    /* success. */
+    *exporter = tmp;
+    return STATUS_SUCCESS;
+
+cleanup_path:
+    unlink(socket_path);
+
+cleanup_sockets:
+    if (tmp->listen_sock >= 0)
+    {
+        close(tmp->listen_sock);
+    }
+
+    close(tmp->stop_pipe[0]);
+    close(tmp->stop_pipe[1]);
+
+cleanup_snapshot:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp->snapshot);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_memory:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
@@ -0,0 +1,26 @@
+/**
+ * \file metrics/vcservice_metrics_exporter_resource_handle.c
+ *
+ * \brief Get the resource handle for a metrics exporter.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "metrics_internal.h"
+
+/**
+ * \brief Given a \ref vcservice_metrics_exporter instance, return its
+ * resource handle.
+ *
+ * \param exporter          The \ref vcservice_metrics_exporter instance from
+ *                          which the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_metrics_exporter
+ * instance.
+ */
+RCPR_SYM(resource*)
+vcservice_metrics_exporter_resource_handle(
+    vcservice_metrics_exporter* exporter)
+{
+    return &exporter->hdr;
+}
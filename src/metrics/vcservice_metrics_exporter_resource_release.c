@@ -0,0 +1,80 @@
+/**
+ * \file metrics/vcservice_metrics_exporter_resource_release.c
+ *
+ * \brief Release a Prometheus exporter.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release a \ref vcservice_metrics_exporter, removing its socket.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_metrics_exporter_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_metrics_exporter* exporter = (vcservice_metrics_exporter*)r;
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    ssize_t written;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_metrics_exporter_valid(exporter));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = exporter->alloc;
+
+    /* wake the background thread and wait for it to exit. */
+    do
+    {
+        written = write(exporter->stop_pipe[1], "", 1);
+    } while (written < 0 && EINTR == errno);
+    pthread_join(exporter->thread, NULL);
+
+    close(exporter->listen_sock);
+    unlink(exporter->addr.sun_path);
+    close(exporter->stop_pipe[0]);
+    close(exporter->stop_pipe[1]);
+
+    if (NULL != exporter->output.data)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(alloc, exporter->output.data);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    reclaim_retval = rcpr_allocator_reclaim(alloc, exporter->snapshot);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    /* clear memory. */
+    memset(exporter, 0, sizeof(*exporter));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, exporter);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
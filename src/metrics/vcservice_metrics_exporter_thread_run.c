@@ -0,0 +1,177 @@
+/**
+ * \file metrics/vcservice_metrics_exporter_thread_run.c
+ *
+ * \brief Background thread for the Prometheus exporter.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_psock;
+RCPR_IMPORT_resource;
+
+static void serve(vcservice_metrics_exporter* exporter, int desc);
+static void read_request(int desc);
+
+/**
+ * \brief Entry point for the exporter's background thread.
+ *
+ * \param context           The \ref vcservice_metrics_exporter for this
+ *                          thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_metrics_exporter_thread_run(void* context)
+{
+    vcservice_metrics_exporter* exporter =
+        (vcservice_metrics_exporter*)context;
+    struct pollfd fds[2];
+    int desc;
+
+    fds[0].fd = exporter->listen_sock;
+    fds[0].events = POLLIN;
+    fds[1].fd = exporter->stop_pipe[0];
+    fds[1].events = POLLIN;
+
+    for (;;)
+    {
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        /* any byte on the stop pipe means release. */
+        if (0 != fds[1].revents)
+        {
+            break;
+        }
+
+        desc = accept(exporter->listen_sock, NULL, NULL);
+        if (desc >= 0)
+        {
+            serve(exporter, desc);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Answer one scrape with every metric, then close the connection.
+ *
+ * \param exporter          The exporter.
+ * \param desc              The client connection, which this closes.
+ */
+static void serve(vcservice_metrics_exporter* exporter, int desc)
+{
+    status retval;
+    psock* sock;
+    char header[128];
+    int header_size;
+    struct timeval timeout = {
+        METRICS_REQUEST_TIMEOUT_MS / 1000,
+        (METRICS_REQUEST_TIMEOUT_MS % 1000) * 1000 };
+
+    /* a stalled client can only hold up the next scrape so long. */
+    setsockopt(desc, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(desc, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    read_request(desc);
+
+    exporter->output.size = 0;
+    retval =
+        vcservice_metrics_render(
+            &exporter->output, exporter->alloc, exporter->registry,
+            exporter->snapshot);
+    if (STATUS_SUCCESS == retval)
+    {
+        header_size =
+            snprintf(
+                header, sizeof(header),
+                "HTTP/1.0 200 OK\r\n"
+                "Content-Type: text/plain; version=0.0.4\r\n"
+                "Content-Length: %zu\r\n"
+                "\r\n", exporter->output.size);
+    }
+    else
+    {
+        exporter->output.size = 0;
+        header_size =
+            snprintf(
+                header, sizeof(header),
+                "HTTP/1.0 500 Internal Server Error\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+    }
+
+    /* the psock owns the descriptor from here on. */
+    retval = psock_create_from_descriptor(&sock, exporter->alloc, desc);
+    if (STATUS_SUCCESS != retval)
+    {
+        close(desc);
+        return;
+    }
+
+    retval = psock_write_raw_data(sock, header, (size_t)header_size);
+    if (STATUS_SUCCESS == retval && exporter->output.size > 0)
+    {
+        retval =
+            psock_write_raw_data(
+                sock, exporter->output.data, exporter->output.size);
+    }
+
+    /* a client that went away has nothing to be told. */
+    (void)retval;
+
+    retval = resource_release(psock_resource_handle(sock));
+    (void)retval;
+}
+
+/**
+ * \brief Read the request headers, which are ignored, so that the response
+ * is not cut short by a reset.  Any path gets the metrics.
+ *
+ * \param desc              The client connection.
+ */
+static void read_request(int desc)
+{
+    char request[METRICS_REQUEST_SIZE + 1];
+    size_t size = 0;
+    ssize_t received;
+
+    while (size < METRICS_REQUEST_SIZE)
+    {
+        received = recv(desc, request + size, METRICS_REQUEST_SIZE - size, 0);
+        if (received < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        else if (received <= 0)
+        {
+            return;
+        }
+
+        size += (size_t)received;
+        request[size] = 0;
+
+        if (NULL != strstr(request, "\r\n\r\n")
+         || NULL != strstr(request, "\n\n"))
+        {
+            return;
+        }
+    }
+}
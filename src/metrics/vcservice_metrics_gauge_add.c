@@ -0,0 +1,26 @@
+/**
+ * \file metrics/vcservice_metrics_gauge_add.c
+ *
+ * \brief Add to a gauge metric.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "metrics_internal.h"
+
+/**
+ * \brief Add to a gauge.
+ *
+ * \param gauge             The gauge to update.
+ * \param value             The amount to add, which may be negative.
+ */
+void
+vcservice_metrics_gauge_add(vcservice_metrics_gauge* gauge, int64_t value)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != gauge);
+
+    __atomic_fetch_add(&gauge->value, value, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,26 @@
+/**
+ * \file metrics/vcservice_metrics_gauge_set.c
+ *
+ * \brief Set a gauge metric.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "metrics_internal.h"
+
+/**
+ * \brief Set a gauge.
+ *
+ * \param gauge             The gauge to update.
+ * \param value             The new value.
+ */
+void
+vcservice_metrics_gauge_set(vcservice_metrics_gauge* gauge, int64_t value)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != gauge);
+
+    __atomic_store_n(&gauge->value, value, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,27 @@
+/**
+ * \file metrics/vcservice_metrics_gauge_value.c
+ *
+ * \brief Get the value of a gauge metric.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "metrics_internal.h"
+
+/**
+ * \brief Get the value of a gauge.
+ *
+ * \param gauge             The gauge to read.
+ *
+ * \returns the gauge's value.
+ */
+int64_t
+vcservice_metrics_gauge_value(const vcservice_metrics_gauge* gauge)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != gauge);
+
+    return __atomic_load_n(&gauge->value, __ATOMIC_RELAXED);
+}
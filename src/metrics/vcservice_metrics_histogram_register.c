@@ -0,0 +1,52 @@
+/**
+ * \file metrics/vcservice_metrics_histogram_register.c
+ *
+ * \brief Register a histogram metric.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcservice/error_codes.h>
+
+#include "metrics_internal.h"
+
+/**
+ * \brief Register a \ref vcservice_histogram, which is rendered as a
+ * Prometheus summary with its p50, p90, p99, and p999 quantiles.
+ *
+ * \param registry          The registry to add the histogram to.
+ * \param histogram         The histogram, which must outlive the registry.
+ * \param name              The metric name, which must match
+ *                          [a-zA-Z_:][a-zA-Z0-9_:]*.
+ * \param labels            The labels, such as route="pay", or NULL.  The
+ *                          label values must already be escaped.
+ * \param help              The help text, which must be a single line.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name is not valid.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_histogram_register(
+    vcservice_metrics_registry* registry, vcservice_histogram* histogram,
+    const char* name, const char* labels, const char* help)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_metrics_registry_valid(registry));
+    MODEL_ASSERT(prop_vcservice_histogram_valid(histogram));
+
+    /* runtime parameter checks. */
+    if (NULL == registry || NULL == histogram)
+    {
+        return VCSERVICE_ERROR_METRICS_INVALID_PARAMETER;
+    }
+
+    return
+        vcservice_metrics_register(
+            registry, METRICS_TYPE_SUMMARY, histogram, name, labels, help);
+}
@@ -0,0 +1,134 @@
+/**
+ * \file metrics/vcservice_metrics_log_register.c
+ *
+ * \brief Register the counters of a logger in a metrics registry.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static uint64_t read_log_counter(const void* context);
+
+/**
+ * \brief The level label of each message counter, by log level.
+ */
+static const char* level_labels[VCSERVICE_LOG_STATS_LEVEL_COUNT] = {
+    "critical", "error", "normal", "info", "verbose", "debug" };
+
+/**
+ * \brief Register the counters of the given logger in a metrics registry.
+ *
+ * \param registry          The registry to add the counters to.
+ * \param log               The logger, which must not be released while the
+ *                          registry can be rendered.  Release any exporter
+ *                          serving the registry first.
+ * \param name              The logger label value, which must not contain a
+ *                          quote, backslash, or newline.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL or
+ *        the name can not be a label value.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a logger with this name is
+ *        already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_log_register(
+    vcservice_metrics_registry* registry, const vcservice_log* log,
+    const char* name)
+{
+    status retval, release_retval;
+    char* labels;
+    size_t labels_size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_metrics_registry_valid(registry));
+    MODEL_ASSERT(NULL != log);
+
+    /* runtime parameter checks. */
+    if (NULL == registry || NULL == log || NULL == name
+     || NULL != strpbrk(name, "\"\\\n"))
+    {
+        return VCSERVICE_ERROR_METRICS_INVALID_PARAMETER;
+    }
+
+    const vcservice_log_stats* stats = vcservice_log_stats_get(log);
+
+    /* room for logger="name",level="verbose". */
+    labels_size = strlen(name) + 32;
+    retval =
+        rcpr_allocator_allocate(
+            registry->alloc, (void**)&labels, labels_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    for (unsigned int i = 0; i < VCSERVICE_LOG_STATS_LEVEL_COUNT; ++i)
+    {
+        snprintf(
+            labels, labels_size, "logger=\"%s\",level=\"%s\"", name,
+            level_labels[i]);
+        retval =
+            vcservice_metrics_counter_callback_register(
+                registry, &read_log_counter, &stats->messages[i],
+                "vcservice_log_messages_total", labels,
+                "Log messages written, by level.");
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_labels;
+        }
+    }
+
+    snprintf(labels, labels_size, "logger=\"%s\"", name);
+
+    retval =
+        vcservice_metrics_counter_callback_register(
+            registry, &read_log_counter, &stats->bytes,
+            "vcservice_log_bytes_total", labels,
+            "Bytes of log messages written.");
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_labels;
+    }
+
+    retval =
+        vcservice_metrics_counter_callback_register(
+            registry, &read_log_counter, &stats->dropped,
+            "vcservice_log_dropped_total", labels,
+            "Log messages dropped before reaching the sink.");
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_labels;
+    }
+
+cleanup_labels:
+    release_retval = rcpr_allocator_reclaim(registry->alloc, labels);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Read one of a logger's counters, which it updates atomically.
+ *
+ * \param context           The counter to read.
+ *
+ * \returns the counter's value.
+ */
+static uint64_t read_log_counter(const void* context)
+{
+    return __atomic_load_n((const uint64_t*)context, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,168 @@
+/**
+ * \file metrics/vcservice_metrics_register.c
+ *
+ * \brief Add a metric to a registry.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static bool name_valid(const char* name);
+
+/**
+ * \brief Add a metric to the registry.
+ *
+ * \param registry          The registry to add the metric to.
+ * \param type              The metric type.
+ * \param value             The counter, gauge, histogram, or callback.  On
+ *                          success, all but a histogram are owned by the
+ *                          registry.
+ * \param name              The metric name.
+ * \param labels            The labels, or NULL.
+ * \param help              The help text.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL,
+ *        the name is not valid, or the name is registered with another type.
+ *      - VCSERVICE_ERROR_METRICS_DUPLICATE if a metric with this name and
+ *        these labels is already registered.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_register(
+    vcservice_metrics_registry* registry, int type, void* value,
+    const char* name, const char* labels, const char* help)
+{
+    status retval, release_retval;
+    vcservice_metrics_entry* tmp;
+    vcservice_metrics_entry** insert;
+    char* strings;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_metrics_registry_valid(registry));
+    MODEL_ASSERT(NULL != value);
+
+    if (NULL == labels)
+    {
+        labels = "";
+    }
+
+    /* runtime parameter checks; the text must not break the format. */
+    if (NULL == registry || NULL == name || NULL == help || !name_valid(name)
+     || NULL != strchr(labels, '\n') || NULL != strchr(help, '\n'))
+    {
+        return VCSERVICE_ERROR_METRICS_INVALID_PARAMETER;
+    }
+
+    size_t name_size = strlen(name) + 1;
+    size_t labels_size = strlen(labels) + 1;
+    size_t help_size = strlen(help) + 1;
+
+    /* the strings follow the entry. */
+    retval =
+        rcpr_allocator_allocate(
+            registry->alloc, (void**)&tmp,
+            sizeof(*tmp) + name_size + labels_size + help_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    strings = (char*)(tmp + 1);
+    memcpy(strings, name, name_size);
+    tmp->name = strings;
+    strings += name_size;
+    memcpy(strings, labels, labels_size);
+    tmp->labels = strings;
+    strings += labels_size;
+    memcpy(strings, help, help_size);
+    tmp->help = strings;
+    tmp->type = type;
+    tmp->value.counter = (vcservice_metrics_counter*)value;
+
+    pthread_mutex_lock(&registry->mutex);
+
+    /* insert after the last entry with this name, keeping each family
+     * together, or at the end. */
+    insert = NULL;
+    vcservice_metrics_entry** i = &registry->entries;
+    for (; NULL != *i; i = &(*i)->next)
+    {
+        if (strcmp((*i)->name, name))
+        {
+            continue;
+        }
+
+        if (vcservice_metrics_family_type((*i)->type)
+                != vcservice_metrics_family_type(type))
+        {
+            retval = VCSERVICE_ERROR_METRICS_INVALID_PARAMETER;
+            goto cleanup_entry;
+        }
+
+        if (!strcmp((*i)->labels, labels))
+        {
+            retval = VCSERVICE_ERROR_METRICS_DUPLICATE;
+            goto cleanup_entry;
+        }
+
+        insert = &(*i)->next;
+    }
+
+    if (NULL == insert)
+    {
+        insert = i;
+    }
+
+    tmp->next = *insert;
+    *insert = tmp;
+
+    pthread_mutex_unlock(&registry->mutex);
+
+    return STATUS_SUCCESS;
+
+cleanup_entry:
+    pthread_mutex_unlock(&registry->mutex);
+
+    release_retval = rcpr_allocator_reclaim(registry->alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Check that a metric name matches [a-zA-Z_:][a-zA-Z0-9_:]*.
+ *
+ * \param name              The name to check.
+ *
+ * \returns true if the name is valid.
+ */
+static bool name_valid(const char* name)
+{
+    for (const char* i = name; *i; ++i)
+    {
+        char c = *i;
+        bool alpha =
+            (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || '_' == c
+         || ':' == c;
+
+        if (!alpha && (i == name || c < '0' || c > '9'))
+        {
+            return false;
+        }
+    }
+
+    return 0 != *name;
+}
@@ -0,0 +1,65 @@
+/**
+ * \file metrics/vcservice_metrics_registry_create.c
+ *
+ * \brief Create a metrics registry.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_metrics_registry.
+ *
+ * \param registry          Pointer to the \ref vcservice_metrics_registry
+ *                          pointer to receive this resource on success.
+ * \param alloc             The allocator to use for this registry.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_METRICS_INVALID_PARAMETER if a parameter is NULL.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_registry_create(
+    vcservice_metrics_registry** registry, RCPR_SYM(allocator)* alloc)
+{
+    status retval;
+    vcservice_metrics_registry* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != registry);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+
+    /* runtime parameter checks. */
+    if (NULL == registry || NULL == alloc)
+    {
+        return VCSERVICE_ERROR_METRICS_INVALID_PARAMETER;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->alloc = alloc;
+    pthread_mutex_init(&tmp->mutex, NULL);
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_metrics_registry_resource_release);
+
+    /* success. */
+    *registry = tmp;
+    return STATUS_SUCCESS;
+}
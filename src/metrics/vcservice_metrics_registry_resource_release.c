@@ -0,0 +1,88 @@
+/**
+ * \file metrics/vcservice_metrics_registry_resource_release.c
+ *
+ * \brief Release a metrics registry.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "metrics_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release a \ref vcservice_metrics_registry and its metrics.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_metrics_registry_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_metrics_registry* registry = (vcservice_metrics_registry*)r;
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_metrics_registry_valid(registry));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = registry->alloc;
+
+    vcservice_metrics_entry* entry = registry->entries;
+    while (NULL != entry)
+    {
+        vcservice_metrics_entry* next = entry->next;
+
+        /* histograms belong to the caller. */
+        reclaim_retval = STATUS_SUCCESS;
+        if (METRICS_TYPE_COUNTER == entry->type)
+        {
+            reclaim_retval =
+                rcpr_allocator_reclaim(alloc, entry->value.counter);
+        }
+        else if (METRICS_TYPE_GAUGE == entry->type)
+        {
+            reclaim_retval = rcpr_allocator_reclaim(alloc, entry->value.gauge);
+        }
+        else if (METRICS_TYPE_CALLBACK == entry->type)
+        {
+            reclaim_retval =
+                rcpr_allocator_reclaim(alloc, entry->value.callback);
+        }
+
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+
+        reclaim_retval = rcpr_allocator_reclaim(alloc, entry);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+
+        entry = next;
+    }
+
+    pthread_mutex_destroy(&registry->mutex);
+
+    /* clear memory. */
+    memset(registry, 0, sizeof(*registry));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, registry);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
@@ -0,0 +1,256 @@
+/**
+ * \file metrics/vcservice_metrics_render.c
+ *
+ * \brief Render a metrics registry in the Prometheus text format.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "metrics_internal.h"
+
+static const char* metric_types[] = { "counter", "gauge", "summary" };
+
+/**
+ * \brief The quantiles rendered for each histogram.
+ */
+static const struct
+{
+    const char* label;
+    double percentile;
+} quantiles[] = {
+    { "quantile=\"0.5\"", 50.0 },
+    { "quantile=\"0.9\"", 90.0 },
+    { "quantile=\"0.99\"", 99.0 },
+    { "quantile=\"0.999\"", 99.9 },
+};
+
+static status render_entry(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc,
+    const vcservice_metrics_entry* entry, bool first,
+    vcservice_histogram_snapshot* snapshot);
+static status append_sample(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc,
+    const char* name, const char* suffix, const char* labels,
+    const char* extra_label, uint64_t value, bool negative);
+static status append_strings(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc, ...);
+
+/**
+ * \brief Render every metric in the registry in the Prometheus text
+ * exposition format.
+ *
+ * \param buffer            The buffer to append to.
+ * \param alloc             The allocator for the buffer.
+ * \param registry          The registry to render.
+ * \param snapshot          Scratch space for rendering histograms.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_metrics_render(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc,
+    vcservice_metrics_registry* registry,
+    vcservice_histogram_snapshot* snapshot)
+{
+    status retval = STATUS_SUCCESS;
+    const char* family = NULL;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != buffer);
+    MODEL_ASSERT(prop_vcservice_metrics_registry_valid(registry));
+    MODEL_ASSERT(NULL != snapshot);
+
+    /* the lock only keeps registration out; the values are read with atomic
+     * loads, so writers never wait on a scrape. */
+    pthread_mutex_lock(&registry->mutex);
+
+    for (const vcservice_metrics_entry* entry = registry->entries;
+         NULL != entry; entry = entry->next)
+    {
+        /* each family gets its help and type once. */
+        bool first = NULL == family || strcmp(family, entry->name);
+        family = entry->name;
+
+        retval = render_entry(buffer, alloc, entry, first, snapshot);
+        if (STATUS_SUCCESS != retval)
+        {
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&registry->mutex);
+
+    return retval;
+}
+
+/**
+ * \brief Render one metric.
+ */
+static status render_entry(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc,
+    const vcservice_metrics_entry* entry, bool first,
+    vcservice_histogram_snapshot* snapshot)
+{
+    status retval;
+    int64_t gauge;
+
+    if (first)
+    {
+        retval =
+            append_strings(
+                buffer, alloc, "# HELP ", entry->name, " ", entry->help,
+                "\n# TYPE ", entry->name, " ",
+                metric_types[vcservice_metrics_family_type(entry->type)], "\n",
+                NULL);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    switch (entry->type)
+    {
+        case METRICS_TYPE_COUNTER:
+            return
+                append_sample(
+                    buffer, alloc, entry->name, "", entry->labels, NULL,
+                    vcservice_metrics_counter_value(entry->value.counter),
+                    false);
+
+        case METRICS_TYPE_CALLBACK:
+            return
+                append_sample(
+                    buffer, alloc, entry->name, "", entry->labels, NULL,
+                    entry->value.callback->read(
+                        entry->value.callback->context),
+                    false);
+
+        case METRICS_TYPE_GAUGE:
+            gauge = vcservice_metrics_gauge_value(entry->value.gauge);
+            return
+                append_sample(
+                    buffer, alloc, entry->name, "", entry->labels, NULL,
+                    gauge < 0 ? -(uint64_t)gauge : (uint64_t)gauge,
+                    gauge < 0);
+
+        default:
+            vcservice_histogram_snapshot_take(
+                snapshot, entry->value.histogram, false);
+
+            for (size_t i = 0; i < sizeof(quantiles) / sizeof(quantiles[0]);
+                 ++i)
+            {
+                retval =
+                    append_sample(
+                        buffer, alloc, entry->name, "", entry->labels,
+                        quantiles[i].label,
+                        vcservice_histogram_snapshot_percentile(
+                            snapshot, quantiles[i].percentile),
+                        false);
+                if (STATUS_SUCCESS != retval)
+                {
+                    return retval;
+                }
+            }
+
+            retval =
+                append_sample(
+                    buffer, alloc, entry->name, "_sum", entry->labels, NULL,
+                    snapshot->sum, false);
+            if (STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+
+            return
+                append_sample(
+                    buffer, alloc, entry->name, "_count", entry->labels, NULL,
+                    snapshot->count, false);
+    }
+}
+
+/**
+ * \brief Append one sample line, such as name_sum{labels,extra} 42.
+ */
+static status append_sample(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc,
+    const char* name, const char* suffix, const char* labels,
+    const char* extra_label, uint64_t value, bool negative)
+{
+    status retval;
+    char number[METRICS_NUMBER_SIZE];
+    char* out = number + sizeof(number);
+
+    /* format the value backwards, ending with the newline. */
+    *--out = '\n';
+    do
+    {
+        *--out = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    if (negative)
+    {
+        *--out = '-';
+    }
+
+    *--out = ' ';
+
+    if (0 == *labels && NULL == extra_label)
+    {
+        retval = append_strings(buffer, alloc, name, suffix, NULL);
+    }
+    else if (NULL == extra_label)
+    {
+        retval =
+            append_strings(buffer, alloc, name, suffix, "{", labels, "}", NULL);
+    }
+    else
+    {
+        retval =
+            append_strings(
+                buffer, alloc, name, suffix, "{", labels,
+                0 == *labels ? "" : ",", extra_label, "}", NULL);
+    }
+
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    return
+        vcservice_metrics_buffer_append(
+            buffer, alloc, out, (size_t)(number + sizeof(number) - out));
+}
+
+/**
+ * \brief Append each string argument, up to a NULL.
+ */
+static status append_strings(
+    vcservice_metrics_buffer* buffer, RCPR_SYM(allocator)* alloc, ...)
+{
+    status retval = STATUS_SUCCESS;
+    const char* str;
+    va_list args;
+
+    va_start(args, alloc);
+    while (NULL != (str = va_arg(args, const char*)))
+    {
+        retval =
+            vcservice_metrics_buffer_append(buffer, alloc, str, strlen(str));
+        if (STATUS_SUCCESS != retval)
+        {
+            break;
+        }
+    }
+
+    va_end(args);
+
+    return retval;
+}
@@ -0,0 +1,199 @@
+/**
+ * \file path/path_batch_run.c
+ *
+ * \brief Run a batch path operation.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief A contiguous range of a batch, written by one thread.
+ */
+typedef struct path_batch_range path_batch_range;
+
+struct path_batch_range
+{
+    path_batch* batch;
+    const char* const* first;
+    const char* const* second;
+    path_batch_op op;
+    size_t offset;
+    size_t limit;
+    size_t begin;
+    size_t end;
+};
+
+static void* run_range(void* range);
+
+/**
+ * \brief Run a batch path operation.
+ *
+ * The first pass measures each input, which bounds the length of its result,
+ * so that a single allocation holds the whole batch.  The batch is split into
+ * contiguous ranges, one per thread, and the first pass also finds where each
+ * range's results start.  The second pass writes the results, each range into
+ * its own part of the buffer, without any locking.  Within a range, results
+ * are packed end to end.
+ *
+ * \param batch             Pointer to receive the results on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param first             The first input of each operation.
+ * \param second            The second input of each operation, or NULL for
+ *                          an operation with a single input.
+ * \param count             The number of operations.
+ * \param thread_count      The number of threads to split the work across.
+ * \param op                The operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+path_batch_run(
+    path_batch** batch, RCPR_SYM(allocator)* alloc, const char* const* first,
+    const char* const* second, size_t count, unsigned int thread_count,
+    path_batch_op op)
+{
+    status retval;
+    path_batch* tmp;
+    size_t buffer_size = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != op);
+
+    /* runtime parameter checks. */
+    if (NULL == batch || NULL == alloc || (count > 0 && NULL == first))
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    /* split the batch only if each thread gets a worthwhile share. */
+    size_t threads = thread_count;
+    if (threads > count / PATH_BATCH_MIN_PER_THREAD)
+    {
+        threads = count / PATH_BATCH_MIN_PER_THREAD;
+    }
+
+    if (threads > PATH_BATCH_MAX_THREADS)
+    {
+        threads = PATH_BATCH_MAX_THREADS;
+    }
+
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+
+    path_batch_range ranges[PATH_BATCH_MAX_THREADS];
+    pthread_t thread_ids[PATH_BATCH_MAX_THREADS];
+    bool started[PATH_BATCH_MAX_THREADS];
+
+    /* measure each input, which must be present; this bounds its result and
+     * its terminator. */
+    for (size_t i = 0; i < threads; ++i)
+    {
+        ranges[i].first = first;
+        ranges[i].second = second;
+        ranges[i].op = op;
+        ranges[i].offset = buffer_size;
+        ranges[i].begin = count * i / threads;
+        ranges[i].end = count * (i + 1) / threads;
+
+        for (size_t j = ranges[i].begin; j < ranges[i].end; ++j)
+        {
+            if (NULL == first[j] || (NULL != second && NULL == second[j]))
+            {
+                return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+            }
+
+            buffer_size += strlen(first[j]) + 2;
+            if (NULL != second)
+            {
+                buffer_size += strlen(second[j]);
+            }
+        }
+    }
+
+    size_t tables_size = sizeof(*tmp) + 2 * count * sizeof(size_t);
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp, tables_size + buffer_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    tmp->count = count;
+    tmp->offsets = (size_t*)(tmp + 1);
+    tmp->lengths = tmp->offsets + count;
+    tmp->buffer = (char*)(tmp->lengths + count);
+
+    for (size_t i = 0; i < threads; ++i)
+    {
+        ranges[i].batch = tmp;
+        ranges[i].limit =
+            (i + 1 < threads) ? ranges[i + 1].offset : buffer_size;
+    }
+
+    /* the calling thread takes the first range. */
+    for (size_t i = 1; i < threads; ++i)
+    {
+        started[i] =
+            0 == pthread_create(&thread_ids[i], NULL, &run_range, &ranges[i]);
+    }
+
+    run_range(&ranges[0]);
+
+    /* a range whose thread failed to start is run here instead. */
+    for (size_t i = 1; i < threads; ++i)
+    {
+        if (started[i])
+        {
+            pthread_join(thread_ids[i], NULL);
+        }
+        else
+        {
+            run_range(&ranges[i]);
+        }
+    }
+
+    *batch = tmp;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write the results of one range of a batch.
+ */
+static void* run_range(void* range)
+{
+    path_batch_range* r = (path_batch_range*)range;
+    path_batch* batch = r->batch;
+
+    size_t offset = r->offset;
+
+    /* each result fits its bound, so the results that precede it in this
+     * range leave it at least that much room. */
+    for (size_t i = r->begin; i < r->end; ++i)
+    {
+        const char* second = (NULL != r->second) ? r->second[i] : NULL;
+        size_t length =
+            r->op(
+                batch->buffer + offset, r->limit - offset, r->first[i],
+                second);
+
+        batch->offsets[i] = offset;
+        batch->lengths[i] = length;
+        offset += length + 1;
+    }
+
+    return NULL;
+}
@@ -12,6 +12,8 @@
 #include <vcservice/error_codes.h>
 #include <vcservice/path.h>
 
+#include "path_internal.h"
+
 RCPR_IMPORT_allocator_as(rcpr);
 RCPR_IMPORT_string_as(rcpr);
 
@@ -34,11 +36,8 @@ RCPR_IMPORT_string_as(rcpr);
 status path_dirname(
     char** dirname, RCPR_SYM(allocator)* alloc, const char* filename)
 {
-    status retval, release_retval;
-    char* workpath = NULL;
-    char* dirpath = NULL;
-    char* pathlast = NULL;
-    const char* dirsep = NULL;
+    status retval;
+    size_t offset, length;
 
     /* parameter sanity checks. */
     MODEL_ASSERT(NULL != dirname);
@@ -52,99 +51,34 @@ status path_dirname(
         goto done;
     }
 
-    /* if the filename is an empty string, then return the current directory. */
-    if (0 == filename[0])
+    /* find the directory portion with a single backward scan. */
+    retval = path_dirname_view(&offset, &length, filename);
+    if (STATUS_SUCCESS != retval)
     {
-        /* attempt to duplicate the local directory symbol. */
-        retval = rcpr_strdup(dirname, alloc, ".");
         goto done;
     }
-    else
-    {
-        /* copy the filename for the working path. */
-        retval = rcpr_strdup(&workpath, alloc, filename);
-        if (STATUS_SUCCESS != retval)
-        {
-            goto done;
-        }
-
-        /* the maximum size of the path is the size of the filename. */
-        size_t pathmax = strlen(filename);
-        size_t pathrem = pathmax;
-        retval = rcpr_allocator_allocate(alloc, (void**)dirname, pathmax + 1);
-        if (STATUS_SUCCESS != retval)
-        {
-            goto cleanup_workpath;
-        }
-
-        /* clear dirname. */
-        (*dirname)[0] = 0;
-
-        /* iterate through directories, copying these to the string. */
-        for (
-            /* initialize pathent with the first path entry. */
-            char* pathent = strtok_r(workpath, "/", &pathlast);
-            /* continue while there are more path entries. */
-            NULL != pathent;
-            /* get the next entry. */
-            pathent = strtok_r(NULL, "/", &pathlast))
-        {
-            /* if dirpath exists, append it. */
-            if (NULL != dirpath)
-            {
-                /* if dirsep exists, append it. */
-                if (NULL != dirsep)
-                {
-                    strncat(*dirname, dirsep, pathrem);
-                    pathrem -= strlen(dirsep);
-                }
-                else
-                {
-                    /* this is the first pass. If the filename is absolute, copy
-                     * a slash to the beginning of dirname.
-                     */
-                    if ('/' == filename[0])
-                    {
-                        strncat(*dirname, "/", pathrem);
-                        pathrem -= 1;
-                    }
-
-                    /* set the directory separator. */
-                    dirsep = "/";
-                }
-
-                /* append dirpath. */
-                strncat(*dirname, dirpath, pathrem);
-                pathrem -= strlen(dirpath);
-            }
-
-            /* update dirpath. */
-            dirpath = pathent;
-        }
 
-        /* if we only encountered one entry or fewer, set *dirname to "." */
-        if (NULL == dirsep)
-        {
-            strncpy(*dirname, ".", pathrem);
-        }
-
-        /* firce dirname to be zero-terminated. */
-        (*dirname)[pathmax] = 0;
-
-        /* success. */
-        retval = STATUS_SUCCESS;
+    /* if there is no directory portion, return the current directory. */
+    if (0 == length)
+    {
+        /* attempt to duplicate the local directory symbol. */
+        retval = rcpr_strdup(dirname, alloc, ".");
+        goto done;
     }
 
-cleanup_workpath:
-    if (NULL != workpath)
+    /* the directory name is no longer than the span. */
+    retval = rcpr_allocator_allocate(alloc, (void**)dirname, length + 1);
+    if (STATUS_SUCCESS != retval)
     {
-        release_retval = rcpr_allocator_reclaim(alloc, workpath);
-        if (STATUS_SUCCESS != release_retval)
-        {
-            retval = release_retval;
-        }
+        goto done;
     }
 
+    /* copy the span, collapsing repeated separators. */
+    path_dirname_copy(*dirname, filename + offset, length);
+
+    /* success. */
+    retval = STATUS_SUCCESS;
+
 done:
     return retval;
 }
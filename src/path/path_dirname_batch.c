@@ -0,0 +1,70 @@
+/**
+ * \file path/path_dirname_batch.c
+ *
+ * \brief Compute the directory name of each of a set of paths.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "path_internal.h"
+
+static size_t dirname_op(
+    char* buffer, size_t size, const char* path, const char* unused);
+
+/**
+ * \brief Compute the directory name of each of a set of paths.
+ *
+ * The results match \ref path_dirname, but are written into a single
+ * allocation instead of one allocation per path.
+ *
+ * \param batch             Pointer to receive the results on success.  The
+ *                          caller reclaims this using the allocator.
+ * \param alloc             The allocator to use for this operation.
+ * \param paths             The paths.
+ * \param count             The number of paths.
+ * \param thread_count      The number of threads to split the work across,
+ *                          including the calling thread.  Small batches are
+ *                          not split.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_dirname_batch(
+    path_batch** batch, RCPR_SYM(allocator)* alloc, const char* const* paths,
+    size_t count, unsigned int thread_count)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(NULL != paths || 0 == count);
+
+    return
+        path_batch_run(
+            batch, alloc, paths, NULL, count, thread_count, &dirname_op);
+}
+
+/**
+ * \brief Write the directory name of one path.
+ */
+static size_t dirname_op(
+    char* buffer, size_t size, const char* path, const char* unused)
+{
+    size_t offset, length;
+
+    (void)size;
+    (void)unused;
+
+    /* the view only fails for a NULL path, which the batch rejects. */
+    if (STATUS_SUCCESS != path_dirname_view(&offset, &length, path)
+     || 0 == length)
+    {
+        memcpy(buffer, ".", 2);
+        return 1;
+    }
+
+    return path_dirname_copy(buffer, path + offset, length);
+}
@@ -0,0 +1,46 @@
+/**
+ * \file path/path_dirname_copy.c
+ *
+ * \brief Copy the directory span of a path.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "path_internal.h"
+
+/**
+ * \brief Copy the directory span found by \ref path_dirname_view, collapsing
+ * repeated separators, and terminate it.
+ *
+ * \param out               The output, which holds at least length + 1
+ *                          bytes.
+ * \param span              The start of the directory span.
+ * \param length            The length of the directory span, which must not
+ *                          be 0.
+ *
+ * \returns the length of the directory name.
+ */
+size_t
+path_dirname_copy(char* out, const char* span, size_t length)
+{
+    char* start = out;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != out);
+    MODEL_ASSERT(NULL != span);
+    MODEL_ASSERT(length > 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        if ('/' != span[i] || out == start || '/' != out[-1])
+        {
+            *out++ = span[i];
+        }
+    }
+
+    *out = 0;
+
+    return (size_t)(out - start);
+}
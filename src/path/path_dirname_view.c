@@ -0,0 +1,88 @@
+/**
+ * \file path/path_dirname_view.c
+ *
+ * \brief Given a pathname, find the directory portion of this pathname without
+ * copying it.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+/**
+ * \brief Given a pathname, find the directory portion of this pathname without
+ * copying it.
+ *
+ * On success, offset and length are updated to describe the span of filename
+ * holding the directory portion.  A length of zero means that the directory is
+ * the current directory, ".".  The span is the same directory as returned by
+ * \ref path_dirname, but repeated separators inside it are not collapsed.
+ *
+ * \param offset            Pointer to receive the offset of the directory
+ *                          portion in filename.
+ * \param length            Pointer to receive the length of the directory
+ *                          portion.
+ * \param filename          The filename from which the directory name is
+ *                          computed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_dirname_view(
+    size_t* offset, size_t* length, const char* filename)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != length);
+    MODEL_ASSERT(NULL != filename);
+
+    /* runtime parameter checks. */
+    if (NULL == offset || NULL == length || NULL == filename)
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    size_t end = strlen(filename);
+
+    /* skip trailing separators. */
+    while (end > 0 && '/' == filename[end - 1])
+    {
+        --end;
+    }
+
+    /* skip the last path entry. */
+    while (end > 0 && '/' != filename[end - 1])
+    {
+        --end;
+    }
+
+    /* skip the separators before it. */
+    while (end > 0 && '/' == filename[end - 1])
+    {
+        --end;
+    }
+
+    /* if there is no path entry before the last one, this is the current
+     * directory. */
+    if (0 == end)
+    {
+        *offset = 0;
+        *length = 0;
+        return STATUS_SUCCESS;
+    }
+
+    /* an absolute path keeps only the last of its leading separators. */
+    size_t start = 0;
+    while ('/' == filename[start] && '/' == filename[start + 1])
+    {
+        ++start;
+    }
+
+    *offset = start;
+    *length = end - start;
+    return STATUS_SUCCESS;
+}
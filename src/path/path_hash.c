@@ -0,0 +1,31 @@
+/**
+ * \file path/path_hash.c
+ *
+ * \brief Hash a path.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "path_internal.h"
+
+/**
+ * \brief Hash a path (FNV-1a).
+ *
+ * \param path              The path to hash.
+ * \param length            The length of the path.
+ *
+ * \returns the hash of the path.
+ */
+uint64_t
+path_hash(const char* path, size_t length)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (uint8_t)path[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
@@ -0,0 +1,164 @@
+/**
+ * \file path/path_intern.c
+ *
+ * \brief Intern a path.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static status grow(path_intern_table* table);
+
+/**
+ * \brief Intern a path, returning its handle.
+ *
+ * If an equal path was already interned, its handle is returned.  Otherwise,
+ * the path is copied into the table.  Paths are compared byte for byte; use
+ * \ref path_normalize first if different spellings of the same path should
+ * share a handle.
+ *
+ * \param handle            Pointer to receive the handle on success.
+ * \param table             The \ref path_intern_table for this operation.
+ * \param path              The path to intern.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_intern(
+    const path_handle** handle, path_intern_table* table, const char* path)
+{
+    status retval;
+    path_handle* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != handle);
+    MODEL_ASSERT(prop_path_intern_table_valid(table));
+    MODEL_ASSERT(NULL != path);
+
+    /* runtime parameter checks. */
+    if (NULL == handle || NULL == table || NULL == path)
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    size_t length = strlen(path);
+    uint64_t hash = path_hash(path, length);
+
+    /* the common case: the path is already interned. */
+    const path_intern_slots* slots =
+        __atomic_load_n(&table->slots, __ATOMIC_ACQUIRE);
+    size_t index = path_intern_probe(slots, hash, path, length);
+    const path_handle* found =
+        __atomic_load_n(&slots->slots[index], __ATOMIC_ACQUIRE);
+    if (NULL != found)
+    {
+        *handle = found;
+        return STATUS_SUCCESS;
+    }
+
+    /* probe again under the lock, since another writer may have won. */
+    pthread_mutex_lock(&table->mutex);
+
+    index = path_intern_probe(table->slots, hash, path, length);
+    if (NULL != table->slots->slots[index])
+    {
+        *handle = table->slots->slots[index];
+        retval = STATUS_SUCCESS;
+        goto unlock;
+    }
+
+    /* keep the load at or below one half so probe chains stay short. */
+    if (2 * (table->count + 1) > table->slots->capacity)
+    {
+        retval = grow(table);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto unlock;
+        }
+
+        index = path_intern_probe(table->slots, hash, path, length);
+    }
+
+    /* the string is stored directly after its handle. */
+    retval =
+        rcpr_allocator_allocate(
+            table->alloc, (void**)&tmp, sizeof(*tmp) + length + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto unlock;
+    }
+
+    char* str = (char*)(tmp + 1);
+    memcpy(str, path, length + 1);
+    tmp->hash = hash;
+    tmp->length = length;
+    tmp->path = str;
+
+    /* publish the handle only once it is fully written. */
+    __atomic_store_n(&table->slots->slots[index], tmp, __ATOMIC_RELEASE);
+    table->count += 1;
+
+    *handle = tmp;
+    retval = STATUS_SUCCESS;
+
+unlock:
+    pthread_mutex_unlock(&table->mutex);
+
+    return retval;
+}
+
+/**
+ * \brief Replace the slot array with one twice the size.
+ *
+ * The old array is kept until the table is released, since readers may still
+ * be probing it.  Every handle it holds is also in the new array.
+ */
+static status grow(path_intern_table* table)
+{
+    status retval;
+    path_intern_slots* old = table->slots;
+    path_intern_slots* tmp;
+    size_t capacity = 2 * old->capacity;
+    size_t slots_size =
+        sizeof(path_intern_slots) + capacity * sizeof(path_handle*);
+
+    retval = rcpr_allocator_allocate(table->alloc, (void**)&tmp, slots_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(tmp, 0, slots_size);
+    tmp->capacity = capacity;
+    tmp->retired = old;
+
+    /* rehash using the stored hashes. */
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < old->capacity; ++i)
+    {
+        path_handle* handle = old->slots[i];
+        if (NULL != handle)
+        {
+            size_t j = handle->hash & mask;
+            while (NULL != tmp->slots[j])
+            {
+                j = (j + 1) & mask;
+            }
+
+            tmp->slots[j] = handle;
+        }
+    }
+
+    /* publish the new array once it is fully populated. */
+    __atomic_store_n(&table->slots, tmp, __ATOMIC_RELEASE);
+
+    return STATUS_SUCCESS;
+}
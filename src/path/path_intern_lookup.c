@@ -0,0 +1,45 @@
+/**
+ * \file path/path_intern_lookup.c
+ *
+ * \brief Look up an interned path.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "path_internal.h"
+
+/**
+ * \brief Look up the handle of an interned path, without interning it.
+ *
+ * \param table             The \ref path_intern_table for this operation.
+ * \param path              The path to look up.
+ *
+ * \returns the handle, or NULL if the path has not been interned.
+ */
+const path_handle* path_intern_lookup(
+    path_intern_table* table, const char* path)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_path_intern_table_valid(table));
+    MODEL_ASSERT(NULL != path);
+
+    /* runtime parameter checks. */
+    if (NULL == table || NULL == path)
+    {
+        return NULL;
+    }
+
+    size_t length = strlen(path);
+    uint64_t hash = path_hash(path, length);
+
+    /* a writer may replace the slot array, but never reclaims the old one. */
+    const path_intern_slots* slots =
+        __atomic_load_n(&table->slots, __ATOMIC_ACQUIRE);
+
+    size_t index = path_intern_probe(slots, hash, path, length);
+
+    return __atomic_load_n(&slots->slots[index], __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,47 @@
+/**
+ * \file path/path_intern_probe.c
+ *
+ * \brief Find the slot for a path in an intern slot array.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <string.h>
+
+#include "path_internal.h"
+
+/**
+ * \brief Find the slot for a path in an intern slot array.
+ *
+ * This is safe to call without holding the table mutex.  Slots are only ever
+ * filled, never cleared or moved, and a handle is fully written before it is
+ * published to its slot.
+ *
+ * \param slots             The slot array to probe.
+ * \param hash              The hash of the path.
+ * \param path              The path.
+ * \param length            The length of the path.
+ *
+ * \returns the index of the slot holding this path, or of the empty slot where
+ * it belongs.
+ */
+size_t
+path_intern_probe(
+    const path_intern_slots* slots, uint64_t hash, const char* path,
+    size_t length)
+{
+    size_t mask = slots->capacity - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+        const path_handle* handle =
+            __atomic_load_n(&slots->slots[i], __ATOMIC_ACQUIRE);
+
+        if (NULL == handle
+         || (hash == handle->hash && length == handle->length
+             && !memcmp(path, handle->path, length)))
+        {
+            return i;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/**
+ * \file path/path_intern_table_create.c
+ *
+ * \brief Create a path intern table.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref path_intern_table.
+ *
+ * \param table             Pointer to the \ref path_intern_table pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for this operation.
+ *
+ * \note This \ref path_intern_table instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  Releasing it invalidates every handle that
+ * it returned.  It may be used from several threads at once: lookups do not
+ * take a lock, and interning a new path takes a lock only to insert it.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+path_intern_table_create(
+    path_intern_table** table, RCPR_SYM(allocator)* alloc)
+{
+    status retval, release_retval;
+    path_intern_table* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+
+    /* runtime parameter checks. */
+    if (NULL == table || NULL == alloc)
+    {
+        retval = VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+        goto done;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* the mutex serializes writers; readers never take it. */
+    if (0 != pthread_mutex_init(&tmp->mutex, NULL))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_memory;
+    }
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &path_intern_table_resource_release);
+    tmp->alloc = alloc;
+
+    /* allocate the first slot array. */
+    size_t slots_size =
+        sizeof(path_intern_slots)
+      + PATH_INTERN_INITIAL_CAPACITY * sizeof(path_handle*);
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp->slots, slots_size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_table;
+    }
+
+    memset(tmp->slots, 0, slots_size);
+    tmp->slots->capacity = PATH_INTERN_INITIAL_CAPACITY;
+
+    /* success. */
+    *table = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_table:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+    goto done;
+
+cleanup_memory:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,23 @@
+/**
+ * \file path/path_intern_table_resource_handle.c
+ *
+ * \brief Get the resource handle for a path intern table.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "path_internal.h"
+
+/**
+ * \brief Given a \ref path_intern_table instance, return its resource handle.
+ *
+ * \param table             The \ref path_intern_table instance from which
+ *                          the resource handle is returned.
+ *
+ * \returns the resource handle for this \ref path_intern_table instance.
+ */
+RCPR_SYM(resource*)
+path_intern_table_resource_handle(path_intern_table* table)
+{
+    return &table->hdr;
+}
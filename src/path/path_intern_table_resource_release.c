@@ -0,0 +1,83 @@
+/**
+ * \file path/path_intern_table_resource_release.c
+ *
+ * \brief Release a path intern table resource.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release a \ref path_intern_table resource.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+path_intern_table_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    path_intern_table* table = (path_intern_table*)r;
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_path_intern_table_valid(table));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = table->alloc;
+
+    /* the current slot array holds every handle. */
+    path_intern_slots* slots = table->slots;
+    if (NULL != slots)
+    {
+        for (size_t i = 0; i < slots->capacity; ++i)
+        {
+            if (NULL != slots->slots[i])
+            {
+                reclaim_retval = rcpr_allocator_reclaim(alloc, slots->slots[i]);
+                if (STATUS_SUCCESS != reclaim_retval)
+                {
+                    retval = reclaim_retval;
+                }
+            }
+        }
+    }
+
+    /* reclaim the current slot array and every array it replaced. */
+    while (NULL != slots)
+    {
+        path_intern_slots* retired = slots->retired;
+
+        reclaim_retval = rcpr_allocator_reclaim(alloc, slots);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+
+        slots = retired;
+    }
+
+    pthread_mutex_destroy(&table->mutex);
+
+    /* clear memory. */
+    memset(table, 0, sizeof(*table));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, table);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
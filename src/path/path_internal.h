@@ -0,0 +1,183 @@
+/**
+ * \file path/path_internal.h
+ *
+ * \brief Internal data types and functions for the path module.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <rcpr/resource/protected.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <vcservice/path.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+#define PATH_RESOLVER_CHECK_INTERVAL_NS     1000000000ULL
+#define PATH_RESOLVER_INITIAL_CAPACITY      32
+#define PATH_INTERN_INITIAL_CAPACITY        64
+#define PATH_WALK_DENTS_SIZE                (64 * 1024)
+#define PATH_WALK_QUEUE_INITIAL_CAPACITY    64
+#define PATH_BATCH_MIN_PER_THREAD           4096
+#define PATH_BATCH_MAX_THREADS              64
+
+typedef struct path_resolver_dir path_resolver_dir;
+
+struct path_resolver_dir
+{
+    char* path;
+    bool exists;
+    struct timespec mtime;
+};
+
+typedef struct path_resolver_entry path_resolver_entry;
+
+struct path_resolver_entry
+{
+    uint64_t hash;
+    char* name;
+    char* resolved;
+};
+
+struct path_resolver
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    path_resolver_dir* dirs;
+    size_t dir_count;
+    path_resolver_entry* entries;
+    size_t capacity;
+    size_t count;
+    uint64_t last_check;
+};
+
+typedef struct path_intern_slots path_intern_slots;
+
+struct path_intern_slots
+{
+    size_t capacity;
+    path_intern_slots* retired;
+    path_handle* slots[];
+};
+
+struct path_intern_table
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    pthread_mutex_t mutex;
+    path_intern_slots* slots;
+    size_t count;
+};
+
+/**
+ * \brief Write the result of a batch operation for one input.
+ *
+ * The buffer holds at least the combined length of the inputs plus two
+ * bytes.  Returns the length of the result.
+ */
+typedef size_t (*path_batch_op)(
+    char* buffer, size_t size, const char* first, const char* second);
+
+typedef struct path_walk_queue path_walk_queue;
+typedef struct path_walk_state path_walk_state;
+typedef struct path_walk_worker path_walk_worker;
+
+/**
+ * \brief A worker's queue of directories still to read.
+ *
+ * The owner pushes and pops at the tail, walking depth first; idle workers
+ * steal from the head, taking the directories closest to the root, which
+ * tend to hold the most work.
+ */
+struct path_walk_queue
+{
+    pthread_mutex_t mutex;
+    char** items;
+    size_t capacity;
+    size_t head;
+    size_t count;
+};
+
+struct path_walk_worker
+{
+    path_walk_state* state;
+    pthread_t thread;
+    bool started;
+    path_walk_queue queue;
+    char* path;
+    char* dents;
+} __attribute__((aligned(64)));
+
+struct path_walk_state
+{
+    RCPR_SYM(allocator)* alloc;
+    path_walk_callback callback;
+    void* context;
+    path_walk_worker* workers;
+    size_t worker_count;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    size_t pending;
+    size_t queued;
+    size_t idle;
+    status result;
+};
+
+status
+path_resolver_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+path_resolver_cache_clear(path_resolver* resolver);
+
+bool
+path_resolver_dirs_changed(path_resolver* resolver);
+
+uint64_t
+path_monotonic_ns(void);
+
+size_t
+path_join_va(char* out, size_t* first, va_list args);
+
+size_t
+path_dirname_copy(char* out, const char* span, size_t length);
+
+status
+path_batch_run(
+    path_batch** batch, RCPR_SYM(allocator)* alloc, const char* const* first,
+    const char* const* second, size_t count, unsigned int thread_count,
+    path_batch_op op);
+
+uint64_t
+path_hash(const char* path, size_t length);
+
+status
+path_intern_table_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+path_walk_push(path_walk_worker* worker, char* dir);
+
+void*
+path_walk_worker_run(void* worker);
+
+status
+path_walk_directory(path_walk_worker* worker, const char* dir);
+
+size_t
+path_intern_probe(
+    const path_intern_slots* slots, uint64_t hash, const char* path,
+    size_t length);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
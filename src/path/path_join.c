@@ -0,0 +1,71 @@
+/**
+ * \file path/path_join.c
+ *
+ * \brief Join path components into a single path.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Join path components into a single path.
+ *
+ * The components are joined with separators.  Repeated separators are
+ * collapsed, empty components are skipped, and an absolute component discards
+ * the components before it.  A trailing separator on the last component is
+ * kept.  If there are no non-empty components, the result is empty.
+ *
+ * The length of the result is computed first, so that exactly one allocation
+ * is made.  On success, out is updated to the joined path.  This value is
+ * owned by the caller and must be reclaimed using the allocator when no longer
+ * needed.
+ *
+ * \param out               Pointer to receive the joined path on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param ...               The components to join, terminated by NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_join(char** out, RCPR_SYM(allocator)* alloc, ...)
+{
+    status retval;
+    va_list args;
+    size_t first = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != out);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+
+    /* runtime parameter checks. */
+    if (NULL == out || NULL == alloc)
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    /* measure the joined path. */
+    va_start(args, alloc);
+    size_t length = path_join_va(NULL, &first, args);
+    va_end(args);
+
+    /* allocate it. */
+    retval = rcpr_allocator_allocate(alloc, (void**)out, length + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* write it. */
+    va_start(args, alloc);
+    path_join_va(*out, &first, args);
+    va_end(args);
+
+    return STATUS_SUCCESS;
+}
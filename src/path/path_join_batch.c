@@ -0,0 +1,76 @@
+/**
+ * \file path/path_join_batch.c
+ *
+ * \brief Join each of a set of directories with the matching name.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+static size_t join_op(
+    char* buffer, size_t size, const char* dir, const char* name);
+
+/**
+ * \brief Join each of a set of directories with the matching name.
+ *
+ * The results match \ref path_join called with the directory and the name,
+ * but are written into a single allocation instead of one allocation per
+ * pair.
+ *
+ * \param batch             Pointer to receive the results on success.  The
+ *                          caller reclaims this using the allocator.
+ * \param alloc             The allocator to use for this operation.
+ * \param dirs              The directories.
+ * \param names             The names to join to the directories.
+ * \param count             The number of directories and of names.
+ * \param thread_count      The number of threads to split the work across,
+ *                          including the calling thread.  Small batches are
+ *                          not split.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_join_batch(
+    path_batch** batch, RCPR_SYM(allocator)* alloc, const char* const* dirs,
+    const char* const* names, size_t count, unsigned int thread_count)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(NULL != dirs || 0 == count);
+    MODEL_ASSERT(NULL != names || 0 == count);
+
+    /* runtime parameter checks. */
+    if (count > 0 && NULL == names)
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    return
+        path_batch_run(
+            batch, alloc, dirs, names, count, thread_count, &join_op);
+}
+
+/**
+ * \brief Write the join of one directory and name.
+ */
+static size_t join_op(
+    char* buffer, size_t size, const char* dir, const char* name)
+{
+    size_t length = 0;
+
+    /* a join is never longer than its parts and one separator. */
+    if (STATUS_SUCCESS
+            != path_join_to_buffer(buffer, size, &length, dir, name, NULL))
+    {
+        buffer[0] = 0;
+        return 0;
+    }
+
+    return length;
+}
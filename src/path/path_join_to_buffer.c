@@ -0,0 +1,64 @@
+/**
+ * \file path/path_join_to_buffer.c
+ *
+ * \brief Join path components into a caller supplied buffer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+/**
+ * \brief Join path components into a caller supplied buffer.
+ *
+ * This joins the components as \ref path_join does, without allocating.
+ *
+ * \param buffer            The buffer to receive the zero-terminated path.
+ * \param size              The size of the buffer.
+ * \param length            Pointer to receive the length of the joined path,
+ *                          not counting the terminator.
+ * \param ...               The components to join, terminated by NULL.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL if the joined path does not fit
+ *        in the buffer.
+ *      - a non-zero error code on failure.
+ */
+status path_join_to_buffer(char* buffer, size_t size, size_t* length, ...)
+{
+    va_list args;
+    size_t first = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != buffer);
+    MODEL_ASSERT(NULL != length);
+
+    /* runtime parameter checks. */
+    if (NULL == buffer || NULL == length)
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    /* measure the joined path. */
+    va_start(args, length);
+    size_t joined_length = path_join_va(NULL, &first, args);
+    va_end(args);
+
+    if (joined_length + 1 > size)
+    {
+        return VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL;
+    }
+
+    /* write it. */
+    va_start(args, length);
+    path_join_va(buffer, &first, args);
+    va_end(args);
+
+    *length = joined_length;
+
+    return STATUS_SUCCESS;
+}
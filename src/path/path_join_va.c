@@ -0,0 +1,93 @@
+/**
+ * \file path/path_join_va.c
+ *
+ * \brief Measure or write a joined path.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "path_internal.h"
+
+/**
+ * \brief Measure or write the path joined from a NULL terminated list of
+ * components.
+ *
+ * This is called twice with the same components: first with out set to NULL,
+ * to measure the joined path, and then with a buffer of at least the measured
+ * length plus one, to write it.  Only the components from the last absolute
+ * one onward contribute, so the first call records its index in first and the
+ * second call skips the components before it.
+ *
+ * \param out               The buffer to write, or NULL to only measure.
+ * \param first             The index of the first contributing component,
+ *                          which must be 0 when measuring.
+ * \param args              The components.
+ *
+ * \returns the length of the joined path, not counting the terminator, which
+ * is written if out is not NULL.
+ */
+size_t
+path_join_va(char* out, size_t* first, va_list args)
+{
+    size_t length = 0;
+    char prev = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != first);
+
+    const char* component;
+    for (size_t index = 0; NULL != (component = va_arg(args, const char*));
+         ++index)
+    {
+        /* skip components before the last absolute one. */
+        if (index < *first || 0 == component[0])
+        {
+            continue;
+        }
+
+        /* an absolute component starts over. */
+        if ('/' == component[0])
+        {
+            *first = index;
+            length = 0;
+            prev = 0;
+        }
+        /* otherwise, separate it from the previous component. */
+        else if (length > 0 && '/' != prev)
+        {
+            if (NULL != out)
+            {
+                out[length] = '/';
+            }
+
+            ++length;
+            prev = '/';
+        }
+
+        /* copy the component, collapsing repeated separators. */
+        for (const char* ch = component; 0 != *ch; ++ch)
+        {
+            if ('/' == *ch && '/' == prev)
+            {
+                continue;
+            }
+
+            if (NULL != out)
+            {
+                out[length] = *ch;
+            }
+
+            ++length;
+            prev = *ch;
+        }
+    }
+
+    if (NULL != out)
+    {
+        out[length] = 0;
+    }
+
+    return length;
+}
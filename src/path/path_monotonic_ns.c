@@ -0,0 +1,24 @@
+/**
+ * \file path/path_monotonic_ns.c
+ *
+ * \brief Read the monotonic clock.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "path_internal.h"
+
+/**
+ * \brief Read the monotonic clock.
+ *
+ * \returns the monotonic clock time in nanoseconds.
+ */
+uint64_t
+path_monotonic_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
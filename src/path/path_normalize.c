@@ -0,0 +1,85 @@
+/**
+ * \file path/path_normalize.c
+ *
+ * \brief Normalize a pathname lexically.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Normalize a pathname lexically.
+ *
+ * Repeated separators are collapsed, "." entries are removed, ".." entries
+ * remove the preceding entry, and trailing separators are stripped.  A ".." at
+ * the root of an absolute path is dropped; leading ".." entries of a relative
+ * path are kept.  An empty result is ".".  The file system is not consulted,
+ * so symbolic links are not resolved.
+ *
+ * On success, normalized is updated to the normalized path.  This value is
+ * owned by the caller and must be reclaimed using the allocator when no longer
+ * needed.
+ *
+ * \param normalized        Pointer to receive the normalized path on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param path              The path to normalize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_normalize(
+    char** normalized, RCPR_SYM(allocator)* alloc, const char* path)
+{
+    status retval, release_retval;
+    char* tmp;
+    size_t length;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != normalized);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(NULL != path);
+
+    /* runtime parameter checks. */
+    if (NULL == normalized || NULL == alloc || NULL == path)
+    {
+        retval = VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+        goto done;
+    }
+
+    /* the normalized path is no longer than the path, or ".". */
+    size_t size = strlen(path) + 2;
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* normalize the path. */
+    retval = path_normalize_to_buffer(tmp, size, &length, path);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* success. */
+    *normalized = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_tmp:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,67 @@
+/**
+ * \file path/path_normalize_batch.c
+ *
+ * \brief Normalize each of a set of paths.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "path_internal.h"
+
+static size_t normalize_op(
+    char* buffer, size_t size, const char* path, const char* unused);
+
+/**
+ * \brief Normalize each of a set of paths.
+ *
+ * The results match \ref path_normalize, but are written into a single
+ * allocation instead of one allocation per path.
+ *
+ * \param batch             Pointer to receive the results on success.  The
+ *                          caller reclaims this using the allocator.
+ * \param alloc             The allocator to use for this operation.
+ * \param paths             The paths.
+ * \param count             The number of paths.
+ * \param thread_count      The number of threads to split the work across,
+ *                          including the calling thread.  Small batches are
+ *                          not split.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status path_normalize_batch(
+    path_batch** batch, RCPR_SYM(allocator)* alloc, const char* const* paths,
+    size_t count, unsigned int thread_count)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != batch);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(NULL != paths || 0 == count);
+
+    return
+        path_batch_run(
+            batch, alloc, paths, NULL, count, thread_count, &normalize_op);
+}
+
+/**
+ * \brief Write the normalized form of one path.
+ */
+static size_t normalize_op(
+    char* buffer, size_t size, const char* path, const char* unused)
+{
+    size_t length = 0;
+
+    (void)unused;
+
+    /* a normalized path is never longer than the path, or ".". */
+    if (STATUS_SUCCESS != path_normalize_to_buffer(buffer, size, &length, path))
+    {
+        buffer[0] = 0;
+        return 0;
+    }
+
+    return length;
+}
@@ -0,0 +1,150 @@
+/**
+ * \file path/path_normalize_to_buffer.c
+ *
+ * \brief Normalize a pathname lexically into a caller supplied buffer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+/**
+ * \brief Normalize a pathname lexically into a caller supplied buffer.
+ *
+ * This performs the same normalization as \ref path_normalize.  The
+ * normalized path is never longer than the input path, except that an empty
+ * result is ".", so a buffer of strlen(path) + 2 bytes is always large enough.
+ *
+ * \param buffer            The buffer to receive the zero-terminated
+ *                          normalized path.
+ * \param size              The size of the buffer.
+ * \param length            Pointer to receive the length of the normalized
+ *                          path, not counting the terminator.
+ * \param path              The path to normalize.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL if the normalized path does not
+ *        fit in the buffer.
+ *      - a non-zero error code on failure.
+ */
+status path_normalize_to_buffer(
+    char* buffer, size_t size, size_t* length, const char* path)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != buffer);
+    MODEL_ASSERT(NULL != length);
+    MODEL_ASSERT(NULL != path);
+
+    /* runtime parameter checks. */
+    if (NULL == buffer || NULL == length || NULL == path)
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    const char* in = path;
+    const char* end = path + strlen(path);
+    size_t out = 0;
+
+    /* an absolute path keeps a single leading separator. */
+    if ('/' == *in)
+    {
+        if (size < 2)
+        {
+            return VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL;
+        }
+
+        buffer[out++] = '/';
+    }
+
+    /* nothing before root can be removed; nothing before floor may be
+     * removed by "..", since it holds leading ".." entries. */
+    const size_t root = out;
+    size_t floor = out;
+
+    while (in < end)
+    {
+        /* find the end of this entry; memchr scans a word or vector at a
+         * time. */
+        const char* sep = memchr(in, '/', (size_t)(end - in));
+        const char* entry_end = (NULL != sep) ? sep : end;
+        size_t entry_size = (size_t)(entry_end - in);
+
+        if (0 == entry_size || (1 == entry_size && '.' == in[0]))
+        {
+            /* skip empty and current directory entries. */
+        }
+        else if (2 == entry_size && '.' == in[0] && '.' == in[1])
+        {
+            if (out > floor)
+            {
+                /* remove the previous entry and its separator. */
+                while (out > root && '/' != buffer[out - 1])
+                {
+                    --out;
+                }
+
+                if (out > root)
+                {
+                    --out;
+                }
+            }
+            else if (0 == root)
+            {
+                /* keep a leading ".." of a relative path. */
+                size_t needed = (out > 0) + 2;
+                if (out + needed + 1 > size)
+                {
+                    return VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL;
+                }
+
+                if (out > 0)
+                {
+                    buffer[out++] = '/';
+                }
+
+                buffer[out++] = '.';
+                buffer[out++] = '.';
+                floor = out;
+            }
+        }
+        else
+        {
+            /* append the entry. */
+            size_t needed = (out > root) + entry_size;
+            if (out + needed + 1 > size)
+            {
+                return VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL;
+            }
+
+            if (out > root)
+            {
+                buffer[out++] = '/';
+            }
+
+            memcpy(buffer + out, in, entry_size);
+            out += entry_size;
+        }
+
+        in = entry_end + 1;
+    }
+
+    /* an empty relative path is the current directory. */
+    if (0 == out)
+    {
+        if (size < 2)
+        {
+            return VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL;
+        }
+
+        buffer[out++] = '.';
+    }
+
+    buffer[out] = 0;
+    *length = out;
+
+    return STATUS_SUCCESS;
+}
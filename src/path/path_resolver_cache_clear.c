@@ -0,0 +1,65 @@
+/**
+ * \file path/path_resolver_cache_clear.c
+ *
+ * \brief Clear the cache of a path resolver.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Remove every entry from the cache of this resolver.
+ *
+ * \param resolver          The \ref path_resolver for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+path_resolver_cache_clear(path_resolver* resolver)
+{
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_path_resolver_valid(resolver));
+
+    for (size_t i = 0; i < resolver->capacity; ++i)
+    {
+        path_resolver_entry* entry = &resolver->entries[i];
+
+        if (NULL != entry->name)
+        {
+            reclaim_retval =
+                rcpr_allocator_reclaim(resolver->alloc, entry->name);
+            if (STATUS_SUCCESS != reclaim_retval)
+            {
+                retval = reclaim_retval;
+            }
+        }
+
+        if (NULL != entry->resolved)
+        {
+            reclaim_retval =
+                rcpr_allocator_reclaim(resolver->alloc, entry->resolved);
+            if (STATUS_SUCCESS != reclaim_retval)
+            {
+                retval = reclaim_retval;
+            }
+        }
+
+        entry->hash = 0;
+        entry->name = NULL;
+        entry->resolved = NULL;
+    }
+
+    resolver->count = 0;
+
+    return retval;
+}
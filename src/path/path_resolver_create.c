@@ -0,0 +1,160 @@
+/**
+ * \file path/path_resolver_create.c
+ *
+ * \brief Create a path resolver for a search path.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref path_resolver for the given search path.
+ *
+ * The search path, such as one built by \ref path_append_default, is split
+ * into its directories once.  Command names resolved through this instance
+ * are cached, including commands that are not found.  The cache is dropped
+ * when the modification time of one of the directories changes, which is
+ * checked at most once per second.
+ *
+ * \param resolver          Pointer to the \ref path_resolver pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param search_path       The colon separated search path.  An empty entry
+ *                          is the current directory.
+ *
+ * \note This \ref path_resolver instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  It is not safe to use from more than one
+ * thread at a time.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+path_resolver_create(
+    path_resolver** resolver, RCPR_SYM(allocator)* alloc,
+    const char* search_path)
+{
+    status retval, release_retval;
+    path_resolver* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != resolver);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(NULL != search_path);
+
+    /* runtime parameter checks. */
+    if (NULL == resolver || NULL == alloc || NULL == search_path)
+    {
+        retval = VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+        goto done;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &path_resolver_resource_release);
+    tmp->alloc = alloc;
+
+    /* there is one more directory than there are separators. */
+    size_t dir_max = 1;
+    for (const char* ch = search_path; 0 != *ch; ++ch)
+    {
+        dir_max += (':' == *ch);
+    }
+
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp->dirs, dir_max * sizeof(path_resolver_dir));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_resolver;
+    }
+
+    memset(tmp->dirs, 0, dir_max * sizeof(path_resolver_dir));
+
+    /* split the search path. */
+    const char* entry = search_path;
+    for (;;)
+    {
+        const char* sep = strchr(entry, ':');
+        size_t entry_size =
+            (NULL != sep) ? (size_t)(sep - entry) : strlen(entry);
+
+        /* an empty entry is the current directory. */
+        if (0 == entry_size)
+        {
+            entry = ".";
+            entry_size = 1;
+        }
+
+        char** path = &tmp->dirs[tmp->dir_count].path;
+        retval = rcpr_allocator_allocate(alloc, (void**)path, entry_size + 1);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_resolver;
+        }
+
+        memcpy(*path, entry, entry_size);
+        (*path)[entry_size] = 0;
+        tmp->dir_count += 1;
+
+        if (NULL == sep)
+        {
+            break;
+        }
+
+        entry = sep + 1;
+    }
+
+    /* allocate the cache. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp->entries,
+            PATH_RESOLVER_INITIAL_CAPACITY * sizeof(path_resolver_entry));
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_resolver;
+    }
+
+    memset(
+        tmp->entries, 0,
+        PATH_RESOLVER_INITIAL_CAPACITY * sizeof(path_resolver_entry));
+    tmp->capacity = PATH_RESOLVER_INITIAL_CAPACITY;
+
+    /* take the first snapshot of the directories. */
+    (void)path_resolver_dirs_changed(tmp);
+    tmp->last_check = path_monotonic_ns();
+
+    /* success. */
+    *resolver = tmp;
+    retval = STATUS_SUCCESS;
+    goto done;
+
+cleanup_resolver:
+    release_retval = resource_release(&tmp->hdr);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,61 @@
+/**
+ * \file path/path_resolver_dirs_changed.c
+ *
+ * \brief Check whether the search path directories have changed.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <sys/stat.h>
+
+#include "path_internal.h"
+
+/**
+ * \brief Check whether any of the search path directories of this resolver
+ * has been created, removed, or modified since the last check.
+ *
+ * Adding, removing, or renaming a directory entry updates the directory's
+ * modification time.  Changing the mode of an existing file does not, so a
+ * file made executable in place is not noticed until something else changes.
+ *
+ * \param resolver          The \ref path_resolver for this operation.
+ *
+ * \returns true if a directory changed, and false otherwise.
+ */
+bool
+path_resolver_dirs_changed(path_resolver* resolver)
+{
+    bool changed = false;
+    struct stat st;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_path_resolver_valid(resolver));
+
+    for (size_t i = 0; i < resolver->dir_count; ++i)
+    {
+        path_resolver_dir* dir = &resolver->dirs[i];
+        bool exists = (0 == stat(dir->path, &st) && S_ISDIR(st.st_mode));
+
+        if (exists != dir->exists)
+        {
+            changed = true;
+        }
+        else if (
+            exists
+         && (st.st_mtim.tv_sec != dir->mtime.tv_sec
+          || st.st_mtim.tv_nsec != dir->mtime.tv_nsec))
+        {
+            changed = true;
+        }
+
+        /* update the snapshot. */
+        dir->exists = exists;
+        if (exists)
+        {
+            dir->mtime = st.st_mtim;
+        }
+    }
+
+    return changed;
+}
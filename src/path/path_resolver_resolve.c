@@ -0,0 +1,291 @@
+/**
+ * \file path/path_resolver_resolve.c
+ *
+ * \brief Resolve a command name to the path of an executable.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <limits.h>
+#include <rcpr/string.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_string_as(rcpr);
+
+static bool is_executable(const char* path);
+static path_resolver_entry* find_entry(
+    path_resolver* resolver, uint64_t hash, const char* name);
+static status search(
+    char** resolved, path_resolver* resolver, const char* command);
+static status insert_entry(
+    path_resolver* resolver, uint64_t hash, const char* name, char* resolved);
+static status grow(path_resolver* resolver);
+
+/**
+ * \brief Resolve a command name to the path of an executable.
+ *
+ * A command containing a separator is not searched for; it is returned as is
+ * if it names an executable file.  Otherwise, the first directory in the
+ * search path holding an executable regular file with this name is used.
+ *
+ * On success, resolved is updated to the path of the executable.  This value
+ * is owned by the caller and must be reclaimed using the allocator when no
+ * longer needed.
+ *
+ * \param resolved          Pointer to receive the resolved path on success.
+ * \param alloc             The allocator to use for this operation.
+ * \param resolver          The \ref path_resolver for this operation.
+ * \param command           The command name to resolve.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_PATH_NOT_FOUND if no executable was found.
+ *      - a non-zero error code on failure.
+ */
+status path_resolver_resolve(
+    char** resolved, RCPR_SYM(allocator)* alloc, path_resolver* resolver,
+    const char* command)
+{
+    status retval, release_retval;
+    char* found = NULL;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != resolved);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(prop_path_resolver_valid(resolver));
+    MODEL_ASSERT(NULL != command);
+
+    /* runtime parameter checks. */
+    if (
+        NULL == resolved || NULL == alloc || NULL == resolver
+     || NULL == command || 0 == command[0])
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    /* a command with a separator is used as is. */
+    if (NULL != strchr(command, '/'))
+    {
+        if (!is_executable(command))
+        {
+            return VCSERVICE_ERROR_PATH_NOT_FOUND;
+        }
+
+        return rcpr_strdup(resolved, alloc, command);
+    }
+
+    /* drop the cache if a directory changed, checking at most once per
+     * interval. */
+    uint64_t now = path_monotonic_ns();
+    if (now - resolver->last_check >= PATH_RESOLVER_CHECK_INTERVAL_NS)
+    {
+        resolver->last_check = now;
+        if (path_resolver_dirs_changed(resolver))
+        {
+            retval = path_resolver_cache_clear(resolver);
+            if (STATUS_SUCCESS != retval)
+            {
+                return retval;
+            }
+        }
+    }
+
+    /* look in the cache. */
+    uint64_t hash = path_hash(command, strlen(command));
+    path_resolver_entry* entry = find_entry(resolver, hash, command);
+    if (NULL != entry->name)
+    {
+        found = entry->resolved;
+        goto copy_found;
+    }
+
+    /* not cached; search the directories. */
+    retval = search(&found, resolver, command);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* cache the result, whether or not it was found. */
+    retval = insert_entry(resolver, hash, command, found);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_found;
+    }
+
+copy_found:
+    if (NULL == found)
+    {
+        return VCSERVICE_ERROR_PATH_NOT_FOUND;
+    }
+
+    /* return a copy owned by the caller. */
+    return rcpr_strdup(resolved, alloc, found);
+
+cleanup_found:
+    if (NULL != found)
+    {
+        release_retval = rcpr_allocator_reclaim(resolver->alloc, found);
+        if (STATUS_SUCCESS != release_retval)
+        {
+            retval = release_retval;
+        }
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Returns true if the path names an executable regular file.
+ */
+static bool is_executable(const char* path)
+{
+    struct stat st;
+
+    return
+        0 == stat(path, &st) && S_ISREG(st.st_mode)
+     && 0 == access(path, X_OK);
+}
+
+/**
+ * \brief Find the cache slot for the given name, which is either the slot
+ * holding it or the empty slot where it belongs.
+ */
+static path_resolver_entry* find_entry(
+    path_resolver* resolver, uint64_t hash, const char* name)
+{
+    size_t mask = resolver->capacity - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask)
+    {
+        path_resolver_entry* entry = &resolver->entries[i];
+
+        if (
+            NULL == entry->name
+         || (hash == entry->hash && !strcmp(name, entry->name)))
+        {
+            return entry;
+        }
+    }
+}
+
+/**
+ * \brief Search the directories for the command.
+ *
+ * On success, resolved is set to a path owned by the resolver, or to NULL if
+ * the command was not found.
+ */
+static status search(
+    char** resolved, path_resolver* resolver, const char* command)
+{
+    char candidate[PATH_MAX];
+    size_t command_size = strlen(command);
+
+    *resolved = NULL;
+
+    for (size_t i = 0; i < resolver->dir_count; ++i)
+    {
+        const path_resolver_dir* dir = &resolver->dirs[i];
+        if (!dir->exists)
+        {
+            continue;
+        }
+
+        /* build the candidate path, skipping it if it is too long. */
+        size_t dir_size = strlen(dir->path);
+        if (dir_size + 1 + command_size + 1 > sizeof(candidate))
+        {
+            continue;
+        }
+
+        memcpy(candidate, dir->path, dir_size);
+        candidate[dir_size] = '/';
+        memcpy(candidate + dir_size + 1, command, command_size + 1);
+
+        if (is_executable(candidate))
+        {
+            return rcpr_strdup(resolved, resolver->alloc, candidate);
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Insert a result into the cache, taking ownership of resolved.
+ */
+static status insert_entry(
+    path_resolver* resolver, uint64_t hash, const char* name, char* resolved)
+{
+    status retval;
+    char* name_copy;
+
+    /* keep the load factor below three quarters. */
+    if (4 * (resolver->count + 1) > 3 * resolver->capacity)
+    {
+        retval = grow(resolver);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    retval = rcpr_strdup(&name_copy, resolver->alloc, name);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    path_resolver_entry* entry = find_entry(resolver, hash, name);
+    entry->hash = hash;
+    entry->name = name_copy;
+    entry->resolved = resolved;
+    resolver->count += 1;
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Double the capacity of the cache.
+ */
+static status grow(path_resolver* resolver)
+{
+    status retval;
+    path_resolver_entry* entries;
+    path_resolver_entry* old_entries = resolver->entries;
+    size_t old_capacity = resolver->capacity;
+    size_t capacity = 2 * old_capacity;
+
+    retval =
+        rcpr_allocator_allocate(
+            resolver->alloc, (void**)&entries,
+            capacity * sizeof(path_resolver_entry));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(entries, 0, capacity * sizeof(path_resolver_entry));
+
+    /* move the entries to the new table. */
+    resolver->entries = entries;
+    resolver->capacity = capacity;
+    for (size_t i = 0; i < old_capacity; ++i)
+    {
+        if (NULL != old_entries[i].name)
+        {
+            *find_entry(
+                resolver, old_entries[i].hash, old_entries[i].name) =
+                    old_entries[i];
+        }
+    }
+
+    return rcpr_allocator_reclaim(resolver->alloc, old_entries);
+}
@@ -0,0 +1,23 @@
+/**
+ * \file path/path_resolver_resource_handle.c
+ *
+ * \brief Get the resource handle for a path resolver.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "path_internal.h"
+
+/**
+ * \brief Given a \ref path_resolver instance, return its resource handle.
+ *
+ * \param resolver          The \ref path_resolver instance from which the
+ *                          resource handle is returned.
+ *
+ * \returns the resource handle for this \ref path_resolver instance.
+ */
+RCPR_SYM(resource*)
+path_resolver_resource_handle(path_resolver* resolver)
+{
+    return &resolver->hdr;
+}
@@ -0,0 +1,81 @@
+/**
+ * \file path/path_resolver_resource_release.c
+ *
+ * \brief Release a path resolver resource.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release a \ref path_resolver resource.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+path_resolver_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    path_resolver* resolver = (path_resolver*)r;
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_path_resolver_valid(resolver));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = resolver->alloc;
+
+    /* reclaim the cache. */
+    if (NULL != resolver->entries)
+    {
+        retval = path_resolver_cache_clear(resolver);
+
+        reclaim_retval = rcpr_allocator_reclaim(alloc, resolver->entries);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    /* reclaim the directories. */
+    for (size_t i = 0; i < resolver->dir_count; ++i)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(alloc, resolver->dirs[i].path);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    if (NULL != resolver->dirs)
+    {
+        reclaim_retval = rcpr_allocator_reclaim(alloc, resolver->dirs);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+    }
+
+    /* clear memory. */
+    memset(resolver, 0, sizeof(*resolver));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, resolver);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
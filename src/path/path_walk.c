@@ -0,0 +1,251 @@
+/**
+ * \file path/path_walk.c
+ *
+ * \brief Walk a directory tree.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <limits.h>
+#include <rcpr/string.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_string_as(rcpr);
+
+static status workers_init(path_walk_state* state);
+static status workers_cleanup(path_walk_state* state);
+
+/**
+ * \brief Walk a directory tree, calling a callback for every entry below the
+ * root.
+ *
+ * Directories are read in large batches with getdents64 where available, and
+ * the type of each entry is taken from the directory itself, so entries are
+ * only stat'd on file systems that do not report a type.  Each worker reuses
+ * one path buffer, so visiting an entry does not allocate.  Symbolic links
+ * are reported but not followed.  Directories that vanish or cannot be read
+ * during the walk are skipped.
+ *
+ * With more than one thread, subdirectories are spread across a pool of
+ * workers that steal from each other when idle, and the callback is called
+ * from several threads at once.  The order of entries is unspecified.
+ *
+ * \param alloc             The allocator to use for this operation.
+ * \param root              The directory to walk.
+ * \param thread_count      The number of threads to walk with, including
+ *                          the calling thread.  0 and 1 both walk in the
+ *                          calling thread only.
+ * \param callback          The callback to call for each entry.
+ * \param context           The context passed to the callback.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_PATH_NOT_FOUND if the root is not a directory.
+ *      - the status returned by the callback if it stopped the walk.
+ *      - a non-zero error code on failure.
+ */
+status path_walk(
+    RCPR_SYM(allocator)* alloc, const char* root, unsigned int thread_count,
+    path_walk_callback callback, void* context)
+{
+    status retval, release_retval;
+    path_walk_state state;
+    struct stat st;
+    char* dir;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+    MODEL_ASSERT(NULL != root);
+    MODEL_ASSERT(NULL != callback);
+
+    /* runtime parameter checks. */
+    if (NULL == alloc || NULL == root || NULL == callback)
+    {
+        return VCSERVICE_ERROR_PATH_INVALID_PARAMETER;
+    }
+
+    if (0 != stat(root, &st) || !S_ISDIR(st.st_mode))
+    {
+        return VCSERVICE_ERROR_PATH_NOT_FOUND;
+    }
+
+    memset(&state, 0, sizeof(state));
+    state.alloc = alloc;
+    state.callback = callback;
+    state.context = context;
+    state.worker_count = (thread_count > 1) ? thread_count : 1;
+
+    retval = workers_init(&state);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_workers;
+    }
+
+    /* the root is the first directory of the first worker. */
+    retval = rcpr_strdup(&dir, alloc, root);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_workers;
+    }
+
+    retval = path_walk_push(&state.workers[0], dir);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_workers;
+    }
+
+    /* a worker that fails to start leaves its share to the others. */
+    for (size_t i = 1; i < state.worker_count; ++i)
+    {
+        path_walk_worker* worker = &state.workers[i];
+        worker->started =
+            0 == pthread_create(
+                    &worker->thread, NULL, &path_walk_worker_run, worker);
+    }
+
+    (void)path_walk_worker_run(&state.workers[0]);
+
+    for (size_t i = 1; i < state.worker_count; ++i)
+    {
+        if (state.workers[i].started)
+        {
+            pthread_join(state.workers[i].thread, NULL);
+        }
+    }
+
+    retval = state.result;
+
+cleanup_workers:
+    release_retval = workers_cleanup(&state);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Allocate the workers, their buffers, and the walk's locks.
+ */
+static status workers_init(path_walk_state* state)
+{
+    status retval;
+    size_t size = state->worker_count * sizeof(path_walk_worker);
+
+    retval =
+        rcpr_allocator_allocate(state->alloc, (void**)&state->workers, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(state->workers, 0, size);
+    pthread_mutex_init(&state->mutex, NULL);
+    pthread_cond_init(&state->cond, NULL);
+
+    for (size_t i = 0; i < state->worker_count; ++i)
+    {
+        state->workers[i].state = state;
+        pthread_mutex_init(&state->workers[i].queue.mutex, NULL);
+    }
+
+    for (size_t i = 0; i < state->worker_count; ++i)
+    {
+        path_walk_worker* worker = &state->workers[i];
+
+        retval =
+            rcpr_allocator_allocate(
+                state->alloc, (void**)&worker->path, PATH_MAX);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval =
+            rcpr_allocator_allocate(
+                state->alloc, (void**)&worker->dents, PATH_WALK_DENTS_SIZE);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval =
+            rcpr_allocator_allocate(
+                state->alloc, (void**)&worker->queue.items,
+                PATH_WALK_QUEUE_INITIAL_CAPACITY * sizeof(char*));
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        worker->queue.capacity = PATH_WALK_QUEUE_INITIAL_CAPACITY;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Reclaim the workers, including any directories still queued.
+ */
+static status workers_cleanup(path_walk_state* state)
+{
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+
+    if (NULL == state->workers)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    for (size_t i = 0; i < state->worker_count; ++i)
+    {
+        path_walk_worker* worker = &state->workers[i];
+        path_walk_queue* queue = &worker->queue;
+        void* buffers[] = { worker->path, worker->dents, queue->items };
+
+        for (size_t j = 0; j < queue->count; ++j)
+        {
+            reclaim_retval =
+                rcpr_allocator_reclaim(
+                    state->alloc,
+                    queue->items[(queue->head + j) % queue->capacity]);
+            if (STATUS_SUCCESS != reclaim_retval)
+            {
+                retval = reclaim_retval;
+            }
+        }
+
+        for (size_t j = 0; j < sizeof(buffers) / sizeof(buffers[0]); ++j)
+        {
+            if (NULL != buffers[j])
+            {
+                reclaim_retval =
+                    rcpr_allocator_reclaim(state->alloc, buffers[j]);
+                if (STATUS_SUCCESS != reclaim_retval)
+                {
+                    retval = reclaim_retval;
+                }
+            }
+        }
+
+        pthread_mutex_destroy(&queue->mutex);
+    }
+
+    pthread_cond_destroy(&state->cond);
+    pthread_mutex_destroy(&state->mutex);
+
+    reclaim_retval = rcpr_allocator_reclaim(state->alloc, state->workers);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
@@ -0,0 +1,207 @@
+/**
+ * \file path/path_walk_directory.c
+ *
+ * \brief Read one directory of a path walk.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static status visit(
+    path_walk_worker* worker, int fd, size_t dir_length, const char* name,
+    unsigned char type);
+static unsigned char stat_type(int fd, const char* name);
+
+#ifdef SYS_getdents64
+/**
+ * \brief The record layout returned by getdents64.
+ */
+struct linux_dirent64
+{
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+#endif
+
+/**
+ * \brief Read one directory, visiting each entry and queuing each
+ * subdirectory.
+ *
+ * \param worker            The worker reading the directory.
+ * \param dir               The directory to read.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success, including when the directory has vanished
+ *        or cannot be read.
+ *      - a non-zero error code on failure.
+ */
+status
+path_walk_directory(path_walk_worker* worker, const char* dir)
+{
+    status retval = STATUS_SUCCESS;
+    size_t dir_length = strlen(dir);
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != dir);
+
+    if (dir_length + 1 > PATH_MAX)
+    {
+        return VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL;
+    }
+
+    int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* entries are appended to the directory in the worker's buffer. */
+    memcpy(worker->path, dir, dir_length);
+    if ('/' != worker->path[dir_length - 1])
+    {
+        worker->path[dir_length++] = '/';
+    }
+
+#ifdef SYS_getdents64
+    for (;;)
+    {
+        long size =
+            syscall(
+                SYS_getdents64, fd, worker->dents, PATH_WALK_DENTS_SIZE);
+        if (size <= 0)
+        {
+            break;
+        }
+
+        for (long offset = 0; offset < size; )
+        {
+            struct linux_dirent64* ent =
+                (struct linux_dirent64*)(worker->dents + offset);
+            offset += ent->d_reclen;
+
+            retval = visit(worker, fd, dir_length, ent->d_name, ent->d_type);
+            if (STATUS_SUCCESS != retval)
+            {
+                goto cleanup_fd;
+            }
+        }
+    }
+
+cleanup_fd:
+    close(fd);
+#else
+    DIR* d = fdopendir(fd);
+    if (NULL == d)
+    {
+        close(fd);
+        return STATUS_SUCCESS;
+    }
+
+    for (struct dirent* ent = readdir(d); NULL != ent; ent = readdir(d))
+    {
+        retval = visit(worker, fd, dir_length, ent->d_name, ent->d_type);
+        if (STATUS_SUCCESS != retval)
+        {
+            break;
+        }
+    }
+
+    closedir(d);
+#endif
+
+    return retval;
+}
+
+/**
+ * \brief Visit one entry of a directory.
+ */
+static status visit(
+    path_walk_worker* worker, int fd, size_t dir_length, const char* name,
+    unsigned char type)
+{
+    status retval;
+    path_walk_state* state = worker->state;
+    path_walk_entry entry;
+    char* subdir;
+
+    /* skip the self and parent links. */
+    if ('.' == name[0]
+     && (0 == name[1] || ('.' == name[1] && 0 == name[2])))
+    {
+        return STATUS_SUCCESS;
+    }
+
+    size_t name_length = strlen(name);
+    if (dir_length + name_length + 1 > PATH_MAX)
+    {
+        return VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL;
+    }
+
+    memcpy(worker->path + dir_length, name, name_length + 1);
+
+    /* only stat when the file system does not report the type. */
+    if (DT_UNKNOWN == type)
+    {
+        type = stat_type(fd, name);
+    }
+
+    entry.path = worker->path;
+    entry.length = dir_length + name_length;
+    entry.name = worker->path + dir_length;
+    entry.type = type;
+
+    retval = state->callback(&entry, state->context);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (DT_DIR != type)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    /* queue the subdirectory. */
+    retval =
+        rcpr_allocator_allocate(
+            state->alloc, (void**)&subdir, entry.length + 1);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memcpy(subdir, worker->path, entry.length + 1);
+
+    return path_walk_push(worker, subdir);
+}
+
+/**
+ * \brief Get the type of a directory entry with fstatat.
+ */
+static unsigned char stat_type(int fd, const char* name)
+{
+    struct stat st;
+
+    if (0 != fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW))
+    {
+        return DT_UNKNOWN;
+    }
+
+    return (unsigned char)IFTODT(st.st_mode);
+}
@@ -0,0 +1,97 @@
+/**
+ * \file path/path_walk_push.c
+ *
+ * \brief Queue a directory for a path walk.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Queue a directory on a worker's queue.
+ *
+ * \param worker            The worker whose queue receives the directory.
+ * \param dir               The directory, allocated with the walk's
+ *                          allocator.  This function takes ownership of it,
+ *                          even on failure.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+path_walk_push(path_walk_worker* worker, char* dir)
+{
+    status retval = STATUS_SUCCESS;
+    status release_retval;
+    path_walk_state* state = worker->state;
+    path_walk_queue* queue = &worker->queue;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != dir);
+
+    /* count the directory before anyone can take it. */
+    __atomic_add_fetch(&state->pending, 1, __ATOMIC_SEQ_CST);
+
+    pthread_mutex_lock(&queue->mutex);
+
+    /* grow the ring, unwrapping it into the new array. */
+    if (queue->count == queue->capacity)
+    {
+        char** items;
+        size_t capacity = 2 * queue->capacity;
+
+        retval =
+            rcpr_allocator_allocate(
+                state->alloc, (void**)&items, capacity * sizeof(char*));
+        if (STATUS_SUCCESS != retval)
+        {
+            goto cleanup_dir;
+        }
+
+        for (size_t i = 0; i < queue->count; ++i)
+        {
+            items[i] = queue->items[(queue->head + i) % queue->capacity];
+        }
+
+        /* the directory is queued even if this fails. */
+        retval = rcpr_allocator_reclaim(state->alloc, queue->items);
+        queue->items = items;
+        queue->capacity = capacity;
+        queue->head = 0;
+    }
+
+    queue->items[(queue->head + queue->count) % queue->capacity] = dir;
+    queue->count += 1;
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    /* wake an idle worker to steal it. */
+    __atomic_add_fetch(&state->queued, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&state->idle, __ATOMIC_SEQ_CST) > 0)
+    {
+        pthread_mutex_lock(&state->mutex);
+        pthread_cond_signal(&state->cond);
+        pthread_mutex_unlock(&state->mutex);
+    }
+
+    return retval;
+
+cleanup_dir:
+    pthread_mutex_unlock(&queue->mutex);
+    __atomic_sub_fetch(&state->pending, 1, __ATOMIC_SEQ_CST);
+
+    release_retval = rcpr_allocator_reclaim(state->alloc, dir);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
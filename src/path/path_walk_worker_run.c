@@ -0,0 +1,153 @@
+/**
+ * \file path/path_walk_worker_run.c
+ *
+ * \brief The main loop of a path walk worker.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "path_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static char* take(path_walk_queue* queue, bool steal);
+static char* next_directory(path_walk_worker* worker);
+static void set_result(path_walk_state* state, status retval);
+
+/**
+ * \brief The main loop of a path walk worker.
+ *
+ * The worker reads directories from its own queue, then steals from other
+ * workers, and sleeps when every queue is empty.  It returns once no
+ * directory is queued or being read anywhere, since only a directory being
+ * read can queue more.
+ *
+ * \param worker            The \ref path_walk_worker.
+ *
+ * \returns NULL.
+ */
+void*
+path_walk_worker_run(void* worker)
+{
+    path_walk_worker* self = (path_walk_worker*)worker;
+    path_walk_state* state = self->state;
+    status retval;
+
+    for (;;)
+    {
+        char* dir = next_directory(self);
+        if (NULL != dir)
+        {
+            /* after a failure, drain the queues without reading. */
+            if (STATUS_SUCCESS
+                    == __atomic_load_n(&state->result, __ATOMIC_RELAXED))
+            {
+                retval = path_walk_directory(self, dir);
+                if (STATUS_SUCCESS != retval)
+                {
+                    set_result(state, retval);
+                }
+            }
+
+            retval = rcpr_allocator_reclaim(state->alloc, dir);
+            if (STATUS_SUCCESS != retval)
+            {
+                set_result(state, retval);
+            }
+
+            if (0 == __atomic_sub_fetch(&state->pending, 1, __ATOMIC_SEQ_CST))
+            {
+                pthread_mutex_lock(&state->mutex);
+                pthread_cond_broadcast(&state->cond);
+                pthread_mutex_unlock(&state->mutex);
+            }
+
+            continue;
+        }
+
+        /* nothing to steal; wait for a push or for the walk to end. */
+        bool done;
+        pthread_mutex_lock(&state->mutex);
+        __atomic_add_fetch(&state->idle, 1, __ATOMIC_SEQ_CST);
+        while (0 == __atomic_load_n(&state->queued, __ATOMIC_SEQ_CST)
+            && 0 != __atomic_load_n(&state->pending, __ATOMIC_SEQ_CST))
+        {
+            pthread_cond_wait(&state->cond, &state->mutex);
+        }
+        __atomic_sub_fetch(&state->idle, 1, __ATOMIC_SEQ_CST);
+        done = (0 == __atomic_load_n(&state->pending, __ATOMIC_SEQ_CST));
+        pthread_mutex_unlock(&state->mutex);
+
+        if (done)
+        {
+            return NULL;
+        }
+    }
+}
+
+/**
+ * \brief Take the next directory from this worker's queue, or steal one.
+ */
+static char* next_directory(path_walk_worker* worker)
+{
+    path_walk_state* state = worker->state;
+    size_t index = (size_t)(worker - state->workers);
+    char* dir = take(&worker->queue, false);
+
+    for (size_t i = 1; NULL == dir && i < state->worker_count; ++i)
+    {
+        path_walk_worker* victim =
+            &state->workers[(index + i) % state->worker_count];
+        dir = take(&victim->queue, true);
+    }
+
+    if (NULL != dir)
+    {
+        __atomic_sub_fetch(&state->queued, 1, __ATOMIC_SEQ_CST);
+    }
+
+    return dir;
+}
+
+/**
+ * \brief Take a directory from the tail of a queue, or steal from its head.
+ */
+static char* take(path_walk_queue* queue, bool steal)
+{
+    char* dir = NULL;
+
+    pthread_mutex_lock(&queue->mutex);
+
+    if (queue->count > 0)
+    {
+        queue->count -= 1;
+        if (steal)
+        {
+            dir = queue->items[queue->head];
+            queue->head = (queue->head + 1) % queue->capacity;
+        }
+        else
+        {
+            dir =
+                queue->items[(queue->head + queue->count) % queue->capacity];
+        }
+    }
+
+    pthread_mutex_unlock(&queue->mutex);
+
+    return dir;
+}
+
+/**
+ * \brief Record the first failure of the walk.
+ */
+static void set_result(path_walk_state* state, status retval)
+{
+    status expected = STATUS_SUCCESS;
+
+    __atomic_compare_exchange_n(
+        &state->result, &expected, retval, false, __ATOMIC_SEQ_CST,
+        __ATOMIC_SEQ_CST);
+}
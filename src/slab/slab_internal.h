@@ -0,0 +1,147 @@
+/**
+ * \file slab/slab_internal.h
+ *
+ * \brief Internal header for the slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <rcpr/allocator/protected.h>
+#include <rcpr/resource/protected.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vcservice/slab.h>
+
+#include "../thread_slot/thread_slot_internal.h"
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+/* every span, including a large allocation, starts on this boundary. */
+#define SLAB_SPAN_SIZE                  (64 * 1024)
+#define SLAB_SPAN_HEADER_SIZE           64
+#define SLAB_CLASS_LARGE                UINT32_MAX
+
+/* objects held by a thread, and objects moved to or from the central list. */
+#define SLAB_MAGAZINE_SIZE              64
+#define SLAB_BATCH_SIZE                 32
+
+#define SLAB_SPAN_OF(mem) \
+    ((vcservice_slab_span*) \
+        ((uintptr_t)(mem) & ~(uintptr_t)(SLAB_SPAN_SIZE - 1)))
+
+#define SLAB_OF_VIEW(alloc) \
+    ((vcservice_slab*)((char*)(alloc) - offsetof(vcservice_slab, view)))
+
+typedef struct vcservice_slab_span vcservice_slab_span;
+typedef struct vcservice_slab_class vcservice_slab_class;
+typedef struct vcservice_slab_cache vcservice_slab_cache;
+
+/**
+ * \brief The header at the start of each span.
+ */
+struct vcservice_slab_span
+{
+    uint32_t size_class;
+    size_t size;
+    vcservice_slab_span* prev;
+    vcservice_slab_span* next;
+};
+
+/**
+ * \brief The central free list of a size class.
+ */
+struct vcservice_slab_class
+{
+    pthread_mutex_t mutex;
+    void* free_list;
+    char* bump;
+    char* bump_end;
+} __attribute__((aligned(64)));
+
+/**
+ * \brief A thread's magazines for one slab.
+ *
+ * Only the owning thread writes to a cache; the counters are stored
+ * atomically so that \ref vcservice_slab_stats_get can read them.
+ */
+struct vcservice_slab_cache
+{
+    vcservice_slab* slab;
+    vcservice_slab_cache* prev;
+    vcservice_slab_cache* next;
+    uint64_t allocs[VCSERVICE_SLAB_CLASS_COUNT];
+    uint64_t reclaims[VCSERVICE_SLAB_CLASS_COUNT];
+    unsigned int count[VCSERVICE_SLAB_CLASS_COUNT];
+    void* objects[VCSERVICE_SLAB_CLASS_COUNT][SLAB_MAGAZINE_SIZE];
+};
+
+struct vcservice_slab
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    RCPR_SYM(allocator) view;
+    uint64_t id;
+    pthread_key_t key;
+    pthread_mutex_t mutex;
+    vcservice_slab_cache* caches;
+    vcservice_slab_span* spans;
+    vcservice_slab_span* large;
+    uint64_t retired_in_use[VCSERVICE_SLAB_CLASS_COUNT];
+    size_t span_count;
+    size_t large_count;
+    size_t bytes_mapped;
+    vcservice_slab_class classes[VCSERVICE_SLAB_CLASS_COUNT];
+};
+
+extern __thread vcservice_thread_slot vcservice_slab_last_cache;
+
+extern const uint32_t vcservice_slab_class_size[VCSERVICE_SLAB_CLASS_COUNT];
+extern const uint8_t vcservice_slab_size_class[
+    VCSERVICE_SLAB_MAX_CLASS_SIZE / 16 + 1];
+
+status
+vcservice_slab_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+vcservice_slab_view_resource_release(
+    RCPR_SYM(resource)* r);
+
+status
+vcservice_slab_view_allocate(
+    RCPR_SYM(allocator)* alloc, void** mem, size_t size);
+
+status
+vcservice_slab_view_reclaim(
+    RCPR_SYM(allocator)* alloc, void* mem);
+
+status
+vcservice_slab_view_reallocate(
+    RCPR_SYM(allocator)* alloc, void** mem, size_t size);
+
+status
+vcservice_slab_span_map(vcservice_slab_span** span, size_t size);
+
+status
+vcservice_slab_cache_get(vcservice_slab_cache** cache, vcservice_slab* slab);
+
+void
+vcservice_slab_cache_destroy(void* cache);
+
+status
+vcservice_slab_refill(vcservice_slab_cache* cache, uint32_t size_class);
+
+void
+vcservice_slab_flush(
+    vcservice_slab_cache* cache, uint32_t size_class, unsigned int count);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
@@ -0,0 +1,118 @@
+/**
+ * \file slab/vcservice_slab_allocate.c
+ *
+ * \brief Allocate memory from a slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "slab_internal.h"
+
+static status allocate_large(vcservice_slab* slab, void** mem, size_t size);
+
+/**
+ * \brief Allocate memory from a \ref vcservice_slab.
+ *
+ * The memory is aligned to 16 bytes.
+ *
+ * \param slab              The slab for this operation.
+ * \param mem               Pointer to receive the memory on success.
+ * \param size              The size of the allocation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_slab_allocate(vcservice_slab* slab, void** mem, size_t size)
+{
+    status retval;
+    vcservice_slab_cache* cache;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_slab_valid(slab));
+    MODEL_ASSERT(NULL != mem);
+
+    /* runtime parameter checks. */
+    if (NULL == slab || NULL == mem)
+    {
+        return VCSERVICE_ERROR_SLAB_INVALID_PARAMETER;
+    }
+
+    if (size > VCSERVICE_SLAB_MAX_CLASS_SIZE)
+    {
+        return allocate_large(slab, mem, size);
+    }
+
+    uint32_t size_class = vcservice_slab_size_class[(size + 15) / 16];
+
+    retval = vcservice_slab_cache_get(&cache, slab);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (0 == cache->count[size_class])
+    {
+        retval = vcservice_slab_refill(cache, size_class);
+        if (STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    cache->count[size_class] -= 1;
+    *mem = cache->objects[size_class][cache->count[size_class]];
+
+    /* only this thread writes its counters. */
+    __atomic_store_n(
+        &cache->allocs[size_class], cache->allocs[size_class] + 1,
+        __ATOMIC_RELAXED);
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Map an allocation too large for a size class as its own span.
+ */
+static status allocate_large(vcservice_slab* slab, void** mem, size_t size)
+{
+    status retval;
+    vcservice_slab_span* span;
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    if (size > SIZE_MAX - SLAB_SPAN_HEADER_SIZE - page_size)
+    {
+        return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    size = (SLAB_SPAN_HEADER_SIZE + size + page_size - 1) & ~(page_size - 1);
+
+    retval = vcservice_slab_span_map(&span, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    span->size_class = SLAB_CLASS_LARGE;
+
+    /* track the span so that release can unmap it. */
+    pthread_mutex_lock(&slab->mutex);
+    span->next = slab->large;
+    if (NULL != slab->large)
+    {
+        slab->large->prev = span;
+    }
+    slab->large = span;
+    slab->large_count += 1;
+    slab->bytes_mapped += size;
+    pthread_mutex_unlock(&slab->mutex);
+
+    *mem = (char*)span + SLAB_SPAN_HEADER_SIZE;
+
+    return STATUS_SUCCESS;
+}
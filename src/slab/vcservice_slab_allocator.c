@@ -0,0 +1,36 @@
+/**
+ * \file slab/vcservice_slab_allocator.c
+ *
+ * \brief Get the allocator view of a slab.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "slab_internal.h"
+
+/**
+ * \brief Get an \ref allocator backed by a \ref vcservice_slab.
+ *
+ * The allocator can be passed to any interface that takes an allocator, such
+ * as the path and log interfaces, and is safe to use from several threads.
+ * Reallocating keeps the memory in place while the new size fits its size
+ * class.
+ *
+ * \param slab              The slab for this operation.
+ *
+ * \note The allocator belongs to the slab and lives as long as it does;
+ * releasing its resource handle does nothing.  Objects created with it must
+ * be released before the slab is.
+ *
+ * \returns the allocator for this slab.
+ */
+RCPR_SYM(allocator)*
+vcservice_slab_allocator(vcservice_slab* slab)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_slab_valid(slab));
+
+    return &slab->view;
+}
@@ -0,0 +1,71 @@
+/**
+ * \file slab/vcservice_slab_cache_destroy.c
+ *
+ * \brief Flush and destroy a thread's magazines when the thread exits.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "slab_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Flush and destroy a thread's magazines when the thread exits.
+ *
+ * This is the destructor of the slab's thread key.  The cached objects go
+ * back to the central free lists, so that other threads can use them, and
+ * the thread's counters are folded into the slab.
+ *
+ * \param cache             The cache to destroy.
+ */
+void
+vcservice_slab_cache_destroy(void* cache)
+{
+    vcservice_slab_cache* c = (vcservice_slab_cache*)cache;
+    vcservice_slab* slab = c->slab;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_slab_valid(slab));
+
+    for (uint32_t i = 0; i < VCSERVICE_SLAB_CLASS_COUNT; ++i)
+    {
+        while (c->count[i] > 0)
+        {
+            unsigned int count =
+                c->count[i] < SLAB_BATCH_SIZE ? c->count[i] : SLAB_BATCH_SIZE;
+            vcservice_slab_flush(c, i, count);
+        }
+    }
+
+    pthread_mutex_lock(&slab->mutex);
+
+    for (uint32_t i = 0; i < VCSERVICE_SLAB_CLASS_COUNT; ++i)
+    {
+        slab->retired_in_use[i] += c->allocs[i] - c->reclaims[i];
+    }
+
+    if (NULL != c->prev)
+    {
+        c->prev->next = c->next;
+    }
+    else
+    {
+        slab->caches = c->next;
+    }
+
+    if (NULL != c->next)
+    {
+        c->next->prev = c->prev;
+    }
+
+    pthread_mutex_unlock(&slab->mutex);
+
+    vcservice_thread_slot_clear(&vcservice_slab_last_cache, c);
+
+    /* a destructor has no one to report a failure to. */
+    status retval = rcpr_allocator_reclaim(slab->alloc, c);
+    (void)retval;
+}
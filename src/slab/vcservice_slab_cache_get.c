@@ -0,0 +1,85 @@
+/**
+ * \file slab/vcservice_slab_cache_get.c
+ *
+ * \brief Get the calling thread's magazines for a slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "slab_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Get the calling thread's magazines for a slab allocator, creating
+ * them on first use.
+ *
+ * \param cache             Pointer to receive the cache on success.
+ * \param slab              The slab for this operation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_slab_cache_get(vcservice_slab_cache** cache, vcservice_slab* slab)
+{
+    status retval, release_retval;
+    vcservice_slab_cache* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cache);
+    MODEL_ASSERT(prop_vcservice_slab_valid(slab));
+
+    tmp =
+        (vcservice_slab_cache*)vcservice_thread_slot_get(
+            &vcservice_slab_last_cache, slab->id, slab->key);
+    if (NULL != tmp)
+    {
+        *cache = tmp;
+        return STATUS_SUCCESS;
+    }
+
+    retval = rcpr_allocator_allocate(slab->alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->slab = slab;
+
+    if (0 != pthread_setspecific(slab->key, tmp))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_cache;
+    }
+
+    /* the slab tracks every cache so that its counters can be read. */
+    pthread_mutex_lock(&slab->mutex);
+    tmp->next = slab->caches;
+    if (NULL != slab->caches)
+    {
+        slab->caches->prev = tmp;
+    }
+    slab->caches = tmp;
+    pthread_mutex_unlock(&slab->mutex);
+
+    vcservice_thread_slot_set(&vcservice_slab_last_cache, slab->id, tmp);
+
+    *cache = tmp;
+    return STATUS_SUCCESS;
+
+cleanup_cache:
+    release_retval = rcpr_allocator_reclaim(slab->alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
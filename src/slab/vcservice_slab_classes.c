@@ -0,0 +1,39 @@
+/**
+ * \file slab/vcservice_slab_classes.c
+ *
+ * \brief Slab allocator size classes.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "slab_internal.h"
+
+/**
+ * \brief The object size of each size class.
+ *
+ * Classes step by a quarter to a half of their size, which bounds internal
+ * waste while keeping every object 16 byte aligned.
+ */
+const uint32_t vcservice_slab_class_size[VCSERVICE_SLAB_CLASS_COUNT] = {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024
+};
+
+/**
+ * \brief The size class for each size, indexed by the size in 16 byte units,
+ * rounded up.
+ */
+const uint8_t vcservice_slab_size_class[
+    VCSERVICE_SLAB_MAX_CLASS_SIZE / 16 + 1] = {
+    /* 0 - 64 */
+    0, 0, 1, 2, 3,
+    /* 80 - 128 */
+    4, 4, 5, 5,
+    /* 144 - 256 */
+    6, 6, 6, 6, 7, 7, 7, 7,
+    /* 272 - 512 */
+    8, 8, 8, 8, 8, 8, 8, 8, 9, 9, 9, 9, 9, 9, 9, 9,
+    /* 528 - 768 */
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+    /* 784 - 1024 */
+    11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11
+};
@@ -0,0 +1,127 @@
+/**
+ * \file slab/vcservice_slab_create.c
+ *
+ * \brief Create a slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "slab_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_slab.
+ *
+ * A slab allocator serves small allocations from fixed size classes.  Each
+ * thread keeps a magazine of free objects per size class, so most
+ * allocations and reclaims touch no shared state.  Memory may be reclaimed
+ * from any thread, not just the one that allocated it.  Magazines are
+ * refilled from, and flushed to, a central free list per size class in
+ * batches.
+ *
+ * \param slab              Pointer to the \ref vcservice_slab pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for the slab instance and
+ *                          its per-thread magazines.  It must be safe to use
+ *                          from several threads.  Spans are mapped directly
+ *                          from the system.
+ *
+ * \note This \ref vcservice_slab instance is a \ref resource that must be
+ * released by calling \ref resource_release on its resource handle when it is
+ * no longer needed by the caller.  It must not be released while other
+ * threads are still using it.  Releasing it invalidates every allocation made
+ * from it.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_slab_create(vcservice_slab** slab, RCPR_SYM(allocator)* alloc)
+{
+    status retval, release_retval;
+    vcservice_slab* tmp;
+    size_t classes_ready = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != slab);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+
+    /* runtime parameter checks. */
+    if (NULL == slab || NULL == alloc)
+    {
+        return VCSERVICE_ERROR_SLAB_INVALID_PARAMETER;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->alloc = alloc;
+    tmp->id = vcservice_thread_slot_id_create();
+
+    /* set up the locks. */
+    if (0 != pthread_mutex_init(&tmp->mutex, NULL))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_memory;
+    }
+
+    for (; classes_ready < VCSERVICE_SLAB_CLASS_COUNT; ++classes_ready)
+    {
+        if (0 != pthread_mutex_init(&tmp->classes[classes_ready].mutex, NULL))
+        {
+            retval = VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto cleanup_mutexes;
+        }
+    }
+
+    /* a thread's magazines are flushed when it exits. */
+    if (0 != pthread_key_create(&tmp->key, &vcservice_slab_cache_destroy))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_mutexes;
+    }
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_slab_resource_release);
+
+    /* initialize the allocator view. */
+    rcpr_allocator_init(
+        &tmp->view, &vcservice_slab_view_resource_release,
+        &vcservice_slab_view_allocate, &vcservice_slab_view_reclaim,
+        &vcservice_slab_view_reallocate);
+
+    /* success. */
+    *slab = tmp;
+    return STATUS_SUCCESS;
+
+cleanup_mutexes:
+    while (classes_ready > 0)
+    {
+        classes_ready -= 1;
+        pthread_mutex_destroy(&tmp->classes[classes_ready].mutex);
+    }
+
+    pthread_mutex_destroy(&tmp->mutex);
+
+cleanup_memory:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
@@ -0,0 +1,49 @@
+/**
+ * \file slab/vcservice_slab_flush.c
+ *
+ * \brief Move objects from a thread's magazine to the central free list.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "slab_internal.h"
+
+/**
+ * \brief Move objects from the top of a thread's magazine to the central
+ * free list of their size class.
+ *
+ * The objects are linked together before the lock is taken, so the lock is
+ * held only to splice the chain in.
+ *
+ * \param cache             The thread's cache.
+ * \param size_class        The size class of the magazine.
+ * \param count             The number of objects to move, no more than the
+ *                          number in the magazine.
+ */
+void
+vcservice_slab_flush(
+    vcservice_slab_cache* cache, uint32_t size_class, unsigned int count)
+{
+    vcservice_slab_class* cls = &cache->slab->classes[size_class];
+    void** objects = cache->objects[size_class];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(count > 0 && count <= cache->count[size_class]);
+
+    /* link the objects through their first word. */
+    unsigned int top = cache->count[size_class];
+    unsigned int bottom = top - count;
+    for (unsigned int i = bottom; i + 1 < top; ++i)
+    {
+        *(void**)objects[i] = objects[i + 1];
+    }
+
+    pthread_mutex_lock(&cls->mutex);
+    *(void**)objects[top - 1] = cls->free_list;
+    cls->free_list = objects[bottom];
+    pthread_mutex_unlock(&cls->mutex);
+
+    cache->count[size_class] = bottom;
+}
@@ -0,0 +1,102 @@
+/**
+ * \file slab/vcservice_slab_reclaim.c
+ *
+ * \brief Reclaim memory allocated from a slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <sys/mman.h>
+#include <vcservice/error_codes.h>
+
+#include "slab_internal.h"
+
+static void reclaim_large(vcservice_slab* slab, vcservice_slab_span* span);
+
+/**
+ * \brief Reclaim memory allocated from a \ref vcservice_slab.
+ *
+ * \param slab              The slab that the memory was allocated from.
+ * \param mem               The memory to reclaim.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_slab_reclaim(vcservice_slab* slab, void* mem)
+{
+    status retval;
+    vcservice_slab_cache* cache;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_slab_valid(slab));
+    MODEL_ASSERT(NULL != mem);
+
+    /* runtime parameter checks. */
+    if (NULL == slab || NULL == mem)
+    {
+        return VCSERVICE_ERROR_SLAB_INVALID_PARAMETER;
+    }
+
+    /* the span header says which size class this memory belongs to. */
+    vcservice_slab_span* span = SLAB_SPAN_OF(mem);
+    uint32_t size_class = span->size_class;
+    if (SLAB_CLASS_LARGE == size_class)
+    {
+        reclaim_large(slab, span);
+        return STATUS_SUCCESS;
+    }
+
+    /* memory from another thread goes into this thread's magazine. */
+    retval = vcservice_slab_cache_get(&cache, slab);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    if (SLAB_MAGAZINE_SIZE == cache->count[size_class])
+    {
+        vcservice_slab_flush(cache, size_class, SLAB_BATCH_SIZE);
+    }
+
+    cache->objects[size_class][cache->count[size_class]] = mem;
+    cache->count[size_class] += 1;
+
+    /* only this thread writes its counters. */
+    __atomic_store_n(
+        &cache->reclaims[size_class], cache->reclaims[size_class] + 1,
+        __ATOMIC_RELAXED);
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Unmap an allocation that was too large for a size class.
+ */
+static void reclaim_large(vcservice_slab* slab, vcservice_slab_span* span)
+{
+    pthread_mutex_lock(&slab->mutex);
+
+    if (NULL != span->prev)
+    {
+        span->prev->next = span->next;
+    }
+    else
+    {
+        slab->large = span->next;
+    }
+
+    if (NULL != span->next)
+    {
+        span->next->prev = span->prev;
+    }
+
+    slab->large_count -= 1;
+    slab->bytes_mapped -= span->size;
+
+    pthread_mutex_unlock(&slab->mutex);
+
+    munmap(span, span->size);
+}
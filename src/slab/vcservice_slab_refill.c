@@ -0,0 +1,83 @@
+/**
+ * \file slab/vcservice_slab_refill.c
+ *
+ * \brief Refill a thread's magazine from the central free list.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "slab_internal.h"
+
+/**
+ * \brief Refill an empty magazine with up to \ref SLAB_BATCH_SIZE objects.
+ *
+ * Objects come from the central free list first, then from the unused end of
+ * the size class's newest span.  A new span is mapped only when both are
+ * empty.
+ *
+ * \param cache             The thread's cache.
+ * \param size_class        The size class of the magazine.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_slab_refill(vcservice_slab_cache* cache, uint32_t size_class)
+{
+    status retval = STATUS_SUCCESS;
+    vcservice_slab* slab = cache->slab;
+    vcservice_slab_class* cls = &slab->classes[size_class];
+    void** objects = cache->objects[size_class];
+    size_t size = vcservice_slab_class_size[size_class];
+    unsigned int count = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(0 == cache->count[size_class]);
+
+    pthread_mutex_lock(&cls->mutex);
+
+    while (count < SLAB_BATCH_SIZE && NULL != cls->free_list)
+    {
+        objects[count++] = cls->free_list;
+        cls->free_list = *(void**)cls->free_list;
+    }
+
+    if (0 == count && (size_t)(cls->bump_end - cls->bump) < size)
+    {
+        vcservice_slab_span* span;
+
+        retval = vcservice_slab_span_map(&span, SLAB_SPAN_SIZE);
+        if (STATUS_SUCCESS != retval)
+        {
+            goto unlock;
+        }
+
+        span->size_class = size_class;
+        cls->bump = (char*)span + SLAB_SPAN_HEADER_SIZE;
+        cls->bump_end = (char*)span + SLAB_SPAN_SIZE;
+
+        pthread_mutex_lock(&slab->mutex);
+        span->next = slab->spans;
+        slab->spans = span;
+        slab->span_count += 1;
+        slab->bytes_mapped += SLAB_SPAN_SIZE;
+        pthread_mutex_unlock(&slab->mutex);
+    }
+
+    while (count < SLAB_BATCH_SIZE
+        && (size_t)(cls->bump_end - cls->bump) >= size)
+    {
+        objects[count++] = cls->bump;
+        cls->bump += size;
+    }
+
+unlock:
+    pthread_mutex_unlock(&cls->mutex);
+
+    cache->count[size_class] = count;
+
+    return retval;
+}
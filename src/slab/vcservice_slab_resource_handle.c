@@ -0,0 +1,23 @@
+/**
+ * \file slab/vcservice_slab_resource_handle.c
+ *
+ * \brief Get the resource handle for a slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "slab_internal.h"
+
+/**
+ * \brief Given a \ref vcservice_slab instance, return its resource handle.
+ *
+ * \param slab              The \ref vcservice_slab instance from which the
+ *                          resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_slab instance.
+ */
+RCPR_SYM(resource*)
+vcservice_slab_resource_handle(vcservice_slab* slab)
+{
+    return &slab->hdr;
+}
@@ -0,0 +1,94 @@
+/**
+ * \file slab/vcservice_slab_resource_release.c
+ *
+ * \brief Release a slab allocator resource.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "slab_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static void unmap_spans(vcservice_slab_span* span);
+
+/**
+ * \brief Release a \ref vcservice_slab resource.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_slab_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_slab* slab = (vcservice_slab*)r;
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_slab_valid(slab));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = slab->alloc;
+
+    /* threads that exit from here on no longer flush their caches. */
+    pthread_key_delete(slab->key);
+
+    /* the caches hold only slab memory, which is unmapped below. */
+    vcservice_slab_cache* cache = slab->caches;
+    while (NULL != cache)
+    {
+        vcservice_slab_cache* next = cache->next;
+
+        reclaim_retval = rcpr_allocator_reclaim(alloc, cache);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+
+        cache = next;
+    }
+
+    unmap_spans(slab->spans);
+    unmap_spans(slab->large);
+
+    for (size_t i = 0; i < VCSERVICE_SLAB_CLASS_COUNT; ++i)
+    {
+        pthread_mutex_destroy(&slab->classes[i].mutex);
+    }
+
+    pthread_mutex_destroy(&slab->mutex);
+
+    /* clear memory. */
+    memset(slab, 0, sizeof(*slab));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, slab);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Unmap a list of spans.
+ */
+static void unmap_spans(vcservice_slab_span* span)
+{
+    while (NULL != span)
+    {
+        vcservice_slab_span* next = span->next;
+        munmap(span, span->size);
+        span = next;
+    }
+}
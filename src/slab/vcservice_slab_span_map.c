@@ -0,0 +1,73 @@
+/**
+ * \file slab/vcservice_slab_span_map.c
+ *
+ * \brief Map a span for the slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <vcservice/error_codes.h>
+
+#include "slab_internal.h"
+
+/**
+ * \brief Map a span aligned to \ref SLAB_SPAN_SIZE.
+ *
+ * The alignment lets \ref vcservice_slab_reclaim find the span header of any
+ * allocation by masking its address.  The mapping is over-allocated by one
+ * span and trimmed to the aligned part.
+ *
+ * \param span              Pointer to receive the span on success.
+ * \param size              The size of the span, a multiple of the page size.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_slab_span_map(vcservice_slab_span** span, size_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != span);
+
+    if (size > SIZE_MAX - SLAB_SPAN_SIZE)
+    {
+        return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    size_t map_size = size + SLAB_SPAN_SIZE;
+    char* mem =
+        mmap(
+            NULL, map_size, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == (void*)mem)
+    {
+        return VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* trim the unaligned head and the unused tail. */
+    char* aligned =
+        (char*)(((uintptr_t)mem + SLAB_SPAN_SIZE - 1)
+            & ~(uintptr_t)(SLAB_SPAN_SIZE - 1));
+    size_t head = (size_t)(aligned - mem);
+    size_t tail = map_size - head - size;
+
+    if (head > 0)
+    {
+        munmap(mem, head);
+    }
+
+    if (tail > 0)
+    {
+        munmap(aligned + size, tail);
+    }
+
+    *span = (vcservice_slab_span*)aligned;
+    memset(*span, 0, sizeof(**span));
+    (*span)->size = size;
+
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/**
+ * \file slab/vcservice_slab_stats_get.c
+ *
+ * \brief Read the occupancy counters of a slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "slab_internal.h"
+
+/**
+ * \brief Read the occupancy counters of a \ref vcservice_slab.
+ *
+ * The counts are read without stopping other threads, so they are a close
+ * approximation while other threads allocate or reclaim.
+ *
+ * \param stats             The stats structure to fill in.
+ * \param slab              The slab to query.
+ */
+void vcservice_slab_stats_get(
+    vcservice_slab_stats* stats, vcservice_slab* slab)
+{
+    uint64_t in_use[VCSERVICE_SLAB_CLASS_COUNT];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != stats);
+    MODEL_ASSERT(prop_vcservice_slab_valid(slab));
+
+    memset(stats, 0, sizeof(*stats));
+
+    pthread_mutex_lock(&slab->mutex);
+
+    memcpy(in_use, slab->retired_in_use, sizeof(in_use));
+
+    /* memory reclaimed by another thread makes a single cache negative, so
+     * the counts only make sense once summed. */
+    for (vcservice_slab_cache* c = slab->caches; NULL != c; c = c->next)
+    {
+        for (size_t i = 0; i < VCSERVICE_SLAB_CLASS_COUNT; ++i)
+        {
+            in_use[i] +=
+                __atomic_load_n(&c->allocs[i], __ATOMIC_RELAXED)
+              - __atomic_load_n(&c->reclaims[i], __ATOMIC_RELAXED);
+        }
+    }
+
+    stats->spans = slab->span_count;
+    stats->large_in_use = slab->large_count;
+    stats->bytes_mapped = slab->bytes_mapped;
+
+    pthread_mutex_unlock(&slab->mutex);
+
+    for (size_t i = 0; i < VCSERVICE_SLAB_CLASS_COUNT; ++i)
+    {
+        stats->class_size[i] = vcservice_slab_class_size[i];
+
+        /* a racing reclaim can be seen before its allocation. */
+        stats->class_in_use[i] =
+            (int64_t)in_use[i] < 0 ? 0 : (size_t)in_use[i];
+    }
+}
@@ -0,0 +1,14 @@
+/**
+ * \file slab/vcservice_slab_thread_state.c
+ *
+ * \brief The per-thread cache lookup of the slab allocator.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "slab_internal.h"
+
+/**
+ * \brief The id of the slab this thread used last, and its cache.
+ */
+__thread vcservice_thread_slot vcservice_slab_last_cache;
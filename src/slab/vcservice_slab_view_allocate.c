@@ -0,0 +1,27 @@
+/**
+ * \file slab/vcservice_slab_view_allocate.c
+ *
+ * \brief Allocate memory through the allocator view of a slab.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "slab_internal.h"
+
+/**
+ * \brief Allocate memory through the allocator view of a \ref vcservice_slab.
+ *
+ * \param alloc             The allocator view.
+ * \param mem               Pointer to receive the memory on success.
+ * \param size              The size of the allocation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_slab_view_allocate(
+    RCPR_SYM(allocator)* alloc, void** mem, size_t size)
+{
+    return vcservice_slab_allocate(SLAB_OF_VIEW(alloc), mem, size);
+}
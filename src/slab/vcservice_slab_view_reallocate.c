@@ -0,0 +1,73 @@
+/**
+ * \file slab/vcservice_slab_view_reallocate.c
+ *
+ * \brief Reallocate memory through the allocator view of a slab.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "slab_internal.h"
+
+/**
+ * \brief Reallocate memory through the allocator view of a
+ * \ref vcservice_slab.
+ *
+ * The memory stays in place if the new size fits in its size class, or in
+ * its span for a large allocation.  Otherwise, the contents are copied to a
+ * new allocation and the old memory is reclaimed.
+ *
+ * \param alloc             The allocator view.
+ * \param mem               Pointer to the memory to reallocate, updated on
+ *                          success.
+ * \param size              The new size of the allocation.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_slab_view_reallocate(
+    RCPR_SYM(allocator)* alloc, void** mem, size_t size)
+{
+    status retval;
+    void* tmp;
+    size_t capacity;
+    vcservice_slab* slab = SLAB_OF_VIEW(alloc);
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_slab_valid(slab));
+    MODEL_ASSERT(NULL != mem && NULL != *mem);
+
+    /* the span header gives the usable size of the old memory. */
+    vcservice_slab_span* span = SLAB_SPAN_OF(*mem);
+    if (SLAB_CLASS_LARGE == span->size_class)
+    {
+        capacity = span->size - SLAB_SPAN_HEADER_SIZE;
+    }
+    else
+    {
+        capacity = vcservice_slab_class_size[span->size_class];
+    }
+
+    if (size <= capacity)
+    {
+        return STATUS_SUCCESS;
+    }
+
+    retval = vcservice_slab_allocate(slab, &tmp, size);
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    memcpy(tmp, *mem, capacity);
+
+    /* hand back the copy even if the old memory can't be reclaimed. */
+    void* old = *mem;
+    *mem = tmp;
+
+    return vcservice_slab_reclaim(slab, old);
+}
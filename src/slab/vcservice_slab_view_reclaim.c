@@ -0,0 +1,26 @@
+/**
+ * \file slab/vcservice_slab_view_reclaim.c
+ *
+ * \brief Reclaim memory through the allocator view of a slab.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "slab_internal.h"
+
+/**
+ * \brief Reclaim memory through the allocator view of a \ref vcservice_slab.
+ *
+ * \param alloc             The allocator view.
+ * \param mem               The memory to reclaim.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_slab_view_reclaim(
+    RCPR_SYM(allocator)* alloc, void* mem)
+{
+    return vcservice_slab_reclaim(SLAB_OF_VIEW(alloc), mem);
+}
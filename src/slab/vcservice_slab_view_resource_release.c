@@ -0,0 +1,27 @@
+/**
+ * \file slab/vcservice_slab_view_resource_release.c
+ *
+ * \brief Release the allocator view of a slab.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "slab_internal.h"
+
+/**
+ * \brief Release the allocator view of a \ref vcservice_slab.
+ *
+ * The view is part of the slab, so this does nothing.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns STATUS_SUCCESS.
+ */
+status
+vcservice_slab_view_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    (void)r;
+
+    return STATUS_SUCCESS;
+}
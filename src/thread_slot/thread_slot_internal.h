@@ -0,0 +1,117 @@
+/**
+ * \file thread_slot/thread_slot_internal.h
+ *
+ * \brief Internal header for the per-thread lookup shared by the slab
+ * allocator and the tracer.
+ *
+ * Both keep one value per thread under a pthread key, and remember the last
+ * one a thread used so that the common case skips pthread_getspecific.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+typedef struct vcservice_thread_slot vcservice_thread_slot;
+
+/**
+ * \brief The id of the owner a thread used last, and its value for it.
+ *
+ * Each user keeps its own thread-local slot, so that tracing does not evict
+ * the slab allocator's remembered cache, or the other way around.
+ */
+struct vcservice_thread_slot
+{
+    uint64_t id;
+    void* value;
+};
+
+extern uint64_t vcservice_thread_slot_next_id;
+
+/**
+ * \brief Create an id for a new owner of a pthread key.
+ *
+ * Ids are never reused, so a thread's remembered value can never be mistaken
+ * for one of a newer owner at the same address.  Zero is never returned.
+ *
+ * \returns the new id.
+ */
+static inline uint64_t vcservice_thread_slot_id_create(void)
+{
+    return
+        __atomic_add_fetch(&vcservice_thread_slot_next_id, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Get the calling thread's value for an owner, remembering it.
+ *
+ * \param slot              The calling thread's slot.
+ * \param id                The id of the owner.
+ * \param key               The owner's pthread key.
+ *
+ * \returns the value, or NULL if this thread has none yet.
+ */
+static inline void* vcservice_thread_slot_get(
+    vcservice_thread_slot* slot, uint64_t id, pthread_key_t key)
+{
+    void* value;
+
+    /* the common case: the last owner this thread used. */
+    if (id == slot->id)
+    {
+        return slot->value;
+    }
+
+    value = pthread_getspecific(key);
+    if (NULL != value)
+    {
+        slot->id = id;
+        slot->value = value;
+    }
+
+    return value;
+}
+
+/**
+ * \brief Remember a value just created for the calling thread.
+ *
+ * \param slot              The calling thread's slot.
+ * \param id                The id of the owner.
+ * \param value             The value.
+ */
+static inline void vcservice_thread_slot_set(
+    vcservice_thread_slot* slot, uint64_t id, void* value)
+{
+    slot->id = id;
+    slot->value = value;
+}
+
+/**
+ * \brief Forget a value that is being destroyed.
+ *
+ * \param slot              The calling thread's slot.
+ * \param value             The value being destroyed.
+ */
+static inline void vcservice_thread_slot_clear(
+    vcservice_thread_slot* slot, void* value)
+{
+    if (value == slot->value)
+    {
+        slot->id = 0;
+        slot->value = NULL;
+    }
+}
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
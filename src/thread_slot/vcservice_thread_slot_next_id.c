@@ -0,0 +1,15 @@
+/**
+ * \file thread_slot/vcservice_thread_slot_next_id.c
+ *
+ * \brief The id counter shared by every owner of a thread slot.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "thread_slot_internal.h"
+
+/**
+ * \brief The id of the next owner.  Zero is never handed out, so it marks an
+ * empty slot.
+ */
+uint64_t vcservice_thread_slot_next_id = 0;
@@ -0,0 +1,144 @@
+/**
+ * \file trace/trace_internal.h
+ *
+ * \brief Internal header for the tracer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <rcpr/resource/protected.h>
+#include <stdbool.h>
+#include <vcservice/trace.h>
+
+#include "../thread_slot/thread_slot_internal.h"
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+extern "C" {
+#endif  /*__cplusplus*/
+
+#define TRACE_FLUSH_INTERVAL_MS         100
+#define TRACE_OUTPUT_SIZE               (64 * 1024)
+#define TRACE_MAX_EVENT_SIZE            512
+
+#define TRACE_PHASE_BEGIN               'B'
+#define TRACE_PHASE_END                 'E'
+
+typedef struct vcservice_trace_event vcservice_trace_event;
+typedef struct vcservice_trace_ring vcservice_trace_ring;
+
+/**
+ * \brief A recorded event.  The timestamp is in monotonic nanoseconds.
+ */
+struct vcservice_trace_event
+{
+    uint64_t timestamp;
+    const char* name;
+    uint32_t phase;
+};
+
+/**
+ * \brief A thread's event ring.
+ *
+ * Only the owning thread writes head and dropped, and only the background
+ * thread writes tail; each is stored atomically so the other side can read
+ * it.  head and tail are kept on separate cache lines.  Events in
+ * [tail, head) are ready to be written.  The ring is retired when its thread
+ * exits, and freed by the background thread once drained.
+ */
+struct vcservice_trace_ring
+{
+    vcservice_tracer* tracer;
+    vcservice_trace_ring* next;
+    uint64_t tid;
+    uint64_t mask;
+    uint64_t head;
+    char head_pad[56];
+    uint64_t tail;
+    uint64_t dropped;
+    bool retired;
+    vcservice_trace_event events[];
+};
+
+struct vcservice_tracer
+{
+    RCPR_SYM(resource) hdr;
+    RCPR_SYM(allocator)* alloc;
+    uint64_t id;
+    pthread_key_t key;
+    int desc;
+    int pid;
+    size_t ring_size;
+    uint64_t epoch;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t thread;
+    bool stop;
+    vcservice_trace_ring* rings;
+    uint64_t retired_dropped;
+    char* output;
+    size_t output_size;
+    bool first_event;
+    bool write_failed;
+};
+
+extern __thread vcservice_thread_slot vcservice_trace_last_ring;
+
+status
+vcservice_tracer_resource_release(
+    RCPR_SYM(resource)* r);
+
+/**
+ * \brief Record an event on the calling thread's ring.
+ *
+ * \param tracer            The tracer for this operation.
+ * \param name              The event name, or NULL.
+ * \param phase             The Chrome trace-event phase.
+ */
+void
+vcservice_trace_record(
+    vcservice_tracer* tracer, const char* name, uint32_t phase);
+
+/**
+ * \brief Get the calling thread's ring, creating it on first use.
+ *
+ * \param tracer            The tracer for this operation.
+ *
+ * \returns the ring, or NULL if it could not be created.
+ */
+vcservice_trace_ring*
+vcservice_trace_ring_get(vcservice_tracer* tracer);
+
+/**
+ * \brief Retire a ring when its thread exits.
+ *
+ * \param ring              The ring to retire.
+ */
+void
+vcservice_trace_ring_retire(void* ring);
+
+/**
+ * \brief Entry point for the tracer's background thread.
+ *
+ * \param context           The \ref vcservice_tracer for this thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_tracer_thread_run(void* context);
+
+/**
+ * \brief Get the monotonic clock in nanoseconds.
+ *
+ * \returns the current monotonic time in nanoseconds.
+ */
+uint64_t
+vcservice_trace_now(void);
+
+/* make this header C++ friendly. */
+#ifdef __cplusplus
+}
+#endif  /*__cplusplus*/
@@ -0,0 +1,29 @@
+/**
+ * \file trace/vcservice_trace_begin.c
+ *
+ * \brief Record the beginning of a span.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "trace_internal.h"
+
+/**
+ * \brief Record the beginning of a span on the calling thread.
+ *
+ * \param tracer            The tracer for this operation.
+ * \param name              The name of the span.  Only the pointer is
+ *                          recorded, so this must outlive the tracer; a
+ *                          string literal is typical.
+ */
+void
+vcservice_trace_begin(vcservice_tracer* tracer, const char* name)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_tracer_valid(tracer));
+    MODEL_ASSERT(NULL != name);
+
+    vcservice_trace_record(tracer, name, TRACE_PHASE_BEGIN);
+}
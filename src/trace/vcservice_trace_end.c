@@ -0,0 +1,25 @@
+/**
+ * \file trace/vcservice_trace_end.c
+ *
+ * \brief Record the end of a span.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "trace_internal.h"
+
+/**
+ * \brief Record the end of the innermost open span on the calling thread.
+ *
+ * \param tracer            The tracer for this operation.
+ */
+void
+vcservice_trace_end(vcservice_tracer* tracer)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_tracer_valid(tracer));
+
+    vcservice_trace_record(tracer, NULL, TRACE_PHASE_END);
+}
@@ -0,0 +1,27 @@
+/**
+ * \file trace/vcservice_trace_now.c
+ *
+ * \brief Read the tracer's clock.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <time.h>
+
+#include "trace_internal.h"
+
+/**
+ * \brief Get the monotonic clock in nanoseconds.
+ *
+ * \returns the current monotonic time in nanoseconds.
+ */
+uint64_t
+vcservice_trace_now(void)
+{
+    struct timespec now;
+
+    /* served from the vDSO, so this does not enter the kernel. */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
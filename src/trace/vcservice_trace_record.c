@@ -0,0 +1,59 @@
+/**
+ * \file trace/vcservice_trace_record.c
+ *
+ * \brief Record a trace event.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "trace_internal.h"
+
+/**
+ * \brief Record an event on the calling thread's ring.
+ *
+ * \param tracer            The tracer for this operation.
+ * \param name              The event name, or NULL.
+ * \param phase             The Chrome trace-event phase.
+ */
+void
+vcservice_trace_record(
+    vcservice_tracer* tracer, const char* name, uint32_t phase)
+{
+    vcservice_trace_ring* ring;
+    vcservice_trace_event* event;
+    uint64_t head, tail;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_tracer_valid(tracer));
+
+    ring =
+        (vcservice_trace_ring*)vcservice_thread_slot_get(
+            &vcservice_trace_last_ring, tracer->id, tracer->key);
+    if (NULL == ring)
+    {
+        ring = vcservice_trace_ring_get(tracer);
+        if (NULL == ring)
+        {
+            return;
+        }
+    }
+
+    /* only this thread writes head, so it can be read plainly. */
+    head = ring->head;
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head - tail > ring->mask)
+    {
+        __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    event = &ring->events[head & ring->mask];
+    event->timestamp = vcservice_trace_now();
+    event->name = name;
+    event->phase = phase;
+
+    /* publish the event to the background thread. */
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,72 @@
+/**
+ * \file trace/vcservice_trace_ring_get.c
+ *
+ * \brief Get the calling thread's event ring.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "trace_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Get the calling thread's ring, creating it on first use.
+ *
+ * \param tracer            The tracer for this operation.
+ *
+ * \returns the ring, or NULL if it could not be created.
+ */
+vcservice_trace_ring*
+vcservice_trace_ring_get(vcservice_tracer* tracer)
+{
+    status retval;
+    vcservice_trace_ring* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_tracer_valid(tracer));
+
+    tmp =
+        (vcservice_trace_ring*)vcservice_thread_slot_get(
+            &vcservice_trace_last_ring, tracer->id, tracer->key);
+    if (NULL != tmp)
+    {
+        return tmp;
+    }
+
+    retval =
+        rcpr_allocator_allocate(
+            tracer->alloc, (void**)&tmp,
+            sizeof(*tmp) + tracer->ring_size * sizeof(vcservice_trace_event));
+    if (STATUS_SUCCESS != retval)
+    {
+        return NULL;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->tracer = tracer;
+    tmp->tid = (uint64_t)syscall(SYS_gettid);
+    tmp->mask = tracer->ring_size - 1;
+
+    if (0 != pthread_setspecific(tracer->key, tmp))
+    {
+        retval = rcpr_allocator_reclaim(tracer->alloc, tmp);
+        (void)retval;
+        return NULL;
+    }
+
+    /* the background thread drains every ring on the list. */
+    pthread_mutex_lock(&tracer->mutex);
+    tmp->next = tracer->rings;
+    tracer->rings = tmp;
+    pthread_mutex_unlock(&tracer->mutex);
+
+    vcservice_thread_slot_set(&vcservice_trace_last_ring, tracer->id, tmp);
+
+    return tmp;
+}
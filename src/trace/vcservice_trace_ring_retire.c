@@ -0,0 +1,25 @@
+/**
+ * \file trace/vcservice_trace_ring_retire.c
+ *
+ * \brief Retire a thread's event ring when the thread exits.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "trace_internal.h"
+
+/**
+ * \brief Retire a ring when its thread exits.
+ *
+ * \param ring              The ring to retire.
+ */
+void
+vcservice_trace_ring_retire(void* ring)
+{
+    vcservice_trace_ring* r = (vcservice_trace_ring*)ring;
+
+    vcservice_thread_slot_clear(&vcservice_trace_last_ring, r);
+
+    /* the background thread frees the ring once it has been drained. */
+    __atomic_store_n(&r->retired, true, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,14 @@
+/**
+ * \file trace/vcservice_trace_thread_state.c
+ *
+ * \brief The per-thread ring lookup of the tracer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "trace_internal.h"
+
+/**
+ * \brief The id of the tracer this thread used last, and its ring.
+ */
+__thread vcservice_thread_slot vcservice_trace_last_ring;
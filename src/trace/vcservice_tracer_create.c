@@ -0,0 +1,140 @@
+/**
+ * \file trace/vcservice_tracer_create.c
+ *
+ * \brief Create a tracer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "trace_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+/**
+ * \brief Create a \ref vcservice_tracer that writes Chrome trace-event JSON
+ * to the given descriptor.
+ *
+ * \param tracer            Pointer to the \ref vcservice_tracer pointer to
+ *                          receive this resource on success.
+ * \param alloc             The allocator to use for the tracer and its
+ *                          per-thread rings.  It must be safe to use from
+ *                          several threads.
+ * \param desc              The descriptor to which the trace is written.
+ *                          This descriptor is owned by the tracer and will be
+ *                          closed when it is released.
+ * \param ring_size         The number of events buffered per thread, which
+ *                          must be a power of two, or 0 for
+ *                          \ref VCSERVICE_TRACER_DEFAULT_RING_SIZE.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_TRACE_INVALID_PARAMETER if \p ring_size is not a
+ *        power of two.
+ *      - VCSERVICE_ERROR_GENERAL_THREAD_CREATE if the background thread could
+ *        not be started.
+ *      - a non-zero error code on failure.
+ */
+status FN_DECL_MUST_CHECK
+vcservice_tracer_create(
+    vcservice_tracer** tracer, RCPR_SYM(allocator)* alloc, int desc,
+    size_t ring_size)
+{
+    status retval, release_retval;
+    vcservice_tracer* tmp;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != tracer);
+    MODEL_ASSERT(rcpr_prop_allocator_valid(alloc));
+
+    if (0 == ring_size)
+    {
+        ring_size = VCSERVICE_TRACER_DEFAULT_RING_SIZE;
+    }
+
+    /* runtime parameter checks. */
+    if (NULL == tracer || NULL == alloc || desc < 0
+     || 0 != (ring_size & (ring_size - 1)))
+    {
+        return VCSERVICE_ERROR_TRACE_INVALID_PARAMETER;
+    }
+
+    /* allocate memory for this instance. */
+    retval = rcpr_allocator_allocate(alloc, (void**)&tmp, sizeof(*tmp));
+    if (STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* clear memory. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->alloc = alloc;
+    tmp->id = vcservice_thread_slot_id_create();
+    tmp->desc = desc;
+    tmp->pid = (int)getpid();
+    tmp->ring_size = ring_size;
+    tmp->epoch = vcservice_trace_now();
+    tmp->first_event = true;
+
+    /* the output buffer starts with the opening of the event array. */
+    retval =
+        rcpr_allocator_allocate(
+            alloc, (void**)&tmp->output, TRACE_OUTPUT_SIZE);
+    if (STATUS_SUCCESS != retval)
+    {
+        goto cleanup_memory;
+    }
+
+    memcpy(tmp->output, "[\n", 2);
+    tmp->output_size = 2;
+
+    /* a thread's ring is retired when it exits. */
+    if (0 != pthread_key_create(&tmp->key, &vcservice_trace_ring_retire))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_output;
+    }
+
+    /* initialize resource. */
+    resource_init(&tmp->hdr, &vcservice_tracer_resource_release);
+
+    /* start the background thread. */
+    pthread_mutex_init(&tmp->mutex, NULL);
+    pthread_cond_init(&tmp->cond, NULL);
+    if (0 != pthread_create(
+                &tmp->thread, NULL, &vcservice_tracer_thread_run, tmp))
+    {
+        retval = VCSERVICE_ERROR_GENERAL_THREAD_CREATE;
+        goto cleanup_key;
+    }
+
+    /* success. */
+    *tracer = tmp;
+    return STATUS_SUCCESS;
+
+cleanup_key:
+    pthread_cond_destroy(&tmp->cond);
+    pthread_mutex_destroy(&tmp->mutex);
+    pthread_key_delete(tmp->key);
+
+cleanup_output:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp->output);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+cleanup_memory:
+    release_retval = rcpr_allocator_reclaim(alloc, tmp);
+    if (STATUS_SUCCESS != release_retval)
+    {
+        retval = release_retval;
+    }
+
+    return retval;
+}
@@ -0,0 +1,40 @@
+/**
+ * \file trace/vcservice_tracer_dropped.c
+ *
+ * \brief Count the events a tracer has dropped.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "trace_internal.h"
+
+/**
+ * \brief Get the number of events dropped because a thread's ring was full.
+ *
+ * \param tracer            The tracer to query.
+ *
+ * \returns the number of dropped events.
+ */
+uint64_t
+vcservice_tracer_dropped(vcservice_tracer* tracer)
+{
+    uint64_t dropped;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_tracer_valid(tracer));
+
+    pthread_mutex_lock(&tracer->mutex);
+
+    dropped = tracer->retired_dropped;
+    for (vcservice_trace_ring* ring = tracer->rings; NULL != ring;
+         ring = ring->next)
+    {
+        dropped += __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock(&tracer->mutex);
+
+    return dropped;
+}
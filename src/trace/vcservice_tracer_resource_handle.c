@@ -0,0 +1,23 @@
+/**
+ * \file trace/vcservice_tracer_resource_handle.c
+ *
+ * \brief Get the resource handle for a tracer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include "trace_internal.h"
+
+/**
+ * \brief Given a \ref vcservice_tracer instance, return its resource handle.
+ *
+ * \param tracer            The \ref vcservice_tracer instance from which the
+ *                          resource handle is returned.
+ *
+ * \returns the resource handle for this \ref vcservice_tracer instance.
+ */
+RCPR_SYM(resource*)
+vcservice_tracer_resource_handle(vcservice_tracer* tracer)
+{
+    return &tracer->hdr;
+}
@@ -0,0 +1,100 @@
+/**
+ * \file trace/vcservice_tracer_resource_release.c
+ *
+ * \brief Release a tracer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "trace_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+/**
+ * \brief Release a \ref vcservice_tracer, writing its remaining events.
+ *
+ * \param r                 The resource to release.
+ *
+ * \returns a status code indicating success or failure.
+ *      - STATUS_SUCCESS on success.
+ *      - VCSERVICE_ERROR_TRACE_WRITE if any event could not be written.
+ *      - a non-zero error code on failure.
+ */
+status
+vcservice_tracer_resource_release(
+    RCPR_SYM(resource)* r)
+{
+    vcservice_tracer* tracer = (vcservice_tracer*)r;
+    status retval = STATUS_SUCCESS;
+    status reclaim_retval;
+    bool write_failed;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(prop_vcservice_tracer_valid(tracer));
+
+    /* cache allocator. */
+    rcpr_allocator* alloc = tracer->alloc;
+
+    /* threads that exit from here on no longer retire their rings. */
+    pthread_key_delete(tracer->key);
+
+    /* let the background thread write the remaining events. */
+    pthread_mutex_lock(&tracer->mutex);
+    tracer->stop = true;
+    pthread_cond_signal(&tracer->cond);
+    pthread_mutex_unlock(&tracer->mutex);
+    pthread_join(tracer->thread, NULL);
+    write_failed = tracer->write_failed;
+
+    pthread_cond_destroy(&tracer->cond);
+    pthread_mutex_destroy(&tracer->mutex);
+
+    /* the rings of threads that are still running are freed here. */
+    vcservice_trace_ring* ring = tracer->rings;
+    while (NULL != ring)
+    {
+        vcservice_trace_ring* next = ring->next;
+
+        reclaim_retval = rcpr_allocator_reclaim(alloc, ring);
+        if (STATUS_SUCCESS != reclaim_retval)
+        {
+            retval = reclaim_retval;
+        }
+
+        ring = next;
+    }
+
+    reclaim_retval = rcpr_allocator_reclaim(alloc, tracer->output);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    /* the descriptor is owned by the tracer. */
+    if (0 != close(tracer->desc))
+    {
+        write_failed = true;
+    }
+
+    /* clear memory. */
+    memset(tracer, 0, sizeof(*tracer));
+
+    /* reclaim memory. */
+    reclaim_retval = rcpr_allocator_reclaim(alloc, tracer);
+    if (STATUS_SUCCESS != reclaim_retval)
+    {
+        retval = reclaim_retval;
+    }
+
+    if (STATUS_SUCCESS == retval && write_failed)
+    {
+        retval = VCSERVICE_ERROR_TRACE_WRITE;
+    }
+
+    return retval;
+}
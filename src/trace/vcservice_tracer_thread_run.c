@@ -0,0 +1,261 @@
+/**
+ * \file trace/vcservice_tracer_thread_run.c
+ *
+ * \brief Background thread for the tracer.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "trace_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+
+static void drain_rings(vcservice_tracer* tracer);
+static void format_event(
+    vcservice_tracer* tracer, const vcservice_trace_ring* ring,
+    const vcservice_trace_event* event);
+static size_t format_uint(char* out, uint64_t value);
+static void write_output(vcservice_tracer* tracer);
+
+/**
+ * \brief Entry point for the tracer's background thread.
+ *
+ * \param context           The \ref vcservice_tracer for this thread.
+ *
+ * \returns NULL.
+ */
+void*
+vcservice_tracer_thread_run(void* context)
+{
+    vcservice_tracer* tracer = (vcservice_tracer*)context;
+    struct timespec deadline;
+    bool stopping;
+
+    pthread_mutex_lock(&tracer->mutex);
+
+    for (;;)
+    {
+        if (!tracer->stop)
+        {
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += TRACE_FLUSH_INTERVAL_MS * 1000000L;
+            if (deadline.tv_nsec >= 1000000000)
+            {
+                deadline.tv_sec += 1;
+                deadline.tv_nsec -= 1000000000;
+            }
+
+            pthread_cond_timedwait(&tracer->cond, &tracer->mutex, &deadline);
+        }
+
+        stopping = tracer->stop;
+        drain_rings(tracer);
+        pthread_mutex_unlock(&tracer->mutex);
+
+        write_output(tracer);
+
+        if (stopping)
+        {
+            break;
+        }
+
+        pthread_mutex_lock(&tracer->mutex);
+    }
+
+    /* close the event array. */
+    memcpy(tracer->output + tracer->output_size, "\n]\n", 3);
+    tracer->output_size += 3;
+    write_output(tracer);
+
+    return NULL;
+}
+
+/**
+ * \brief Format the ready events of every ring, and free drained rings whose
+ * threads have exited.
+ *
+ * \param tracer            The tracer, whose mutex is held.
+ */
+static void drain_rings(vcservice_tracer* tracer)
+{
+    vcservice_trace_ring** link = &tracer->rings;
+    vcservice_trace_ring* ring;
+    uint64_t head, tail;
+    bool retired;
+    status retval;
+
+    while (NULL != (ring = *link))
+    {
+        /* read retired first, so a retired ring's last events are seen. */
+        retired = __atomic_load_n(&ring->retired, __ATOMIC_ACQUIRE);
+        head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        for (tail = ring->tail; tail != head; ++tail)
+        {
+            format_event(tracer, ring, &ring->events[tail & ring->mask]);
+
+            /* hand the slot back to the thread. */
+            __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+        }
+
+        if (retired)
+        {
+            *link = ring->next;
+            tracer->retired_dropped +=
+                __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+            retval = rcpr_allocator_reclaim(tracer->alloc, ring);
+            (void)retval;
+        }
+        else
+        {
+            link = &ring->next;
+        }
+    }
+}
+
+/**
+ * \brief Append one event to the output as a JSON object.
+ *
+ * \param tracer            The tracer.
+ * \param ring              The ring holding the event.
+ * \param event             The event.
+ */
+static void format_event(
+    vcservice_tracer* tracer, const vcservice_trace_ring* ring,
+    const vcservice_trace_event* event)
+{
+    uint64_t ts = event->timestamp - tracer->epoch;
+    char* out;
+    size_t name_size;
+
+    if (tracer->output_size + TRACE_MAX_EVENT_SIZE > TRACE_OUTPUT_SIZE)
+    {
+        write_output(tracer);
+    }
+
+    out = tracer->output + tracer->output_size;
+
+    if (!tracer->first_event)
+    {
+        *out++ = ',';
+        *out++ = '\n';
+    }
+
+    tracer->first_event = false;
+
+    memcpy(out, "{\"ph\":\"", 7);
+    out += 7;
+    *out++ = (char)event->phase;
+
+    /* names are expected to be identifiers, so only quotes, backslashes, and
+     * control characters are escaped, and long names are truncated. */
+    if (NULL != event->name)
+    {
+        memcpy(out, "\",\"name\":\"", 10);
+        out += 10;
+
+        name_size = 0;
+        for (const char* in = event->name; *in && name_size < 128;
+             ++in, ++name_size)
+        {
+            if ('"' == *in || '\\' == *in)
+            {
+                *out++ = '\\';
+                *out++ = *in;
+            }
+            else if ((unsigned char)*in < 0x20)
+            {
+                *out++ = '?';
+            }
+            else
+            {
+                *out++ = *in;
+            }
+        }
+    }
+
+    /* timestamps are in microseconds, with nanosecond precision. */
+    memcpy(out, "\",\"ts\":", 7);
+    out += 7;
+    out += format_uint(out, ts / 1000);
+    *out++ = '.';
+    out[0] = (char)('0' + ts % 1000 / 100);
+    out[1] = (char)('0' + ts % 100 / 10);
+    out[2] = (char)('0' + ts % 10);
+    out += 3;
+
+    memcpy(out, ",\"pid\":", 7);
+    out += 7;
+    out += format_uint(out, (uint64_t)tracer->pid);
+    memcpy(out, ",\"tid\":", 7);
+    out += 7;
+    out += format_uint(out, ring->tid);
+    *out++ = '}';
+
+    tracer->output_size = (size_t)(out - tracer->output);
+}
+
+/**
+ * \brief Write an unsigned value in decimal.
+ *
+ * \param out               The output buffer, which must hold 20 bytes.
+ * \param value             The value to write.
+ *
+ * \returns the number of digits written.
+ */
+static size_t format_uint(char* out, uint64_t value)
+{
+    char digits[20];
+    size_t count = 0;
+
+    do
+    {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = digits[count - 1 - i];
+    }
+
+    return count;
+}
+
+/**
+ * \brief Write the output buffer to the descriptor.
+ *
+ * \param tracer            The tracer.
+ */
+static void write_output(vcservice_tracer* tracer)
+{
+    size_t offset = 0;
+    ssize_t written;
+
+    while (offset < tracer->output_size)
+    {
+        written =
+            write(
+                tracer->desc, tracer->output + offset,
+                tracer->output_size - offset);
+        if (written < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        else if (written <= 0)
+        {
+            /* report the failure on release. */
+            tracer->write_failed = true;
+            break;
+        }
+
+        offset += (size_t)written;
+    }
+
+    tracer->output_size = 0;
+}
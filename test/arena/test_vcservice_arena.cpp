@@ -0,0 +1,308 @@
+/**
+ * \file arena/test_vcservice_arena.cpp
+ *
+ * Test the vcservice_arena methods.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <cstdint>
+#include <cstring>
+#include <vcservice/arena.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+#include <vcservice/path.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_psock;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcservice_arena);
+
+/**
+ * \brief Allocations are aligned, distinct, and counted.
+ */
+TEST(allocate)
+{
+    rcpr_allocator* alloc;
+    vcservice_arena* arena;
+    void* first;
+    void* second;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the arena. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_arena_create(&arena, alloc, 0, 0));
+    TEST_EXPECT(0U == vcservice_arena_bytes_used(arena));
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_arena_allocate(arena, &first, 3));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_arena_allocate(arena, &second, 20));
+    TEST_EXPECT(0U == (uintptr_t)first % VCSERVICE_ARENA_ALIGNMENT);
+    TEST_EXPECT(0U == (uintptr_t)second % VCSERVICE_ARENA_ALIGNMENT);
+    TEST_EXPECT((char*)first + 16 == (char*)second);
+    TEST_EXPECT(48U == vcservice_arena_bytes_used(arena));
+
+    /* the memory is writable. */
+    memset(first, 0xa5, 3);
+    memset(second, 0x5a, 20);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_arena_resource_handle(arena)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A reset hands out the same memory again, including from blocks
+ * chained after the first.
+ */
+TEST(reset)
+{
+    rcpr_allocator* alloc;
+    vcservice_arena* arena;
+    void* first[3];
+    void* second[3];
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the arena with small blocks. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_arena_create(&arena, alloc, 4096, 0));
+
+    /* each allocation fills most of a block. */
+    for (int i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS == vcservice_arena_allocate(arena, &first[i], 3000));
+        memset(first[i], i, 3000);
+    }
+
+    vcservice_arena_reset(arena);
+    TEST_EXPECT(0U == vcservice_arena_bytes_used(arena));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcservice_arena_allocate(arena, &second[i], 3000));
+        TEST_EXPECT(first[i] == second[i]);
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_arena_resource_handle(arena)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief An allocation larger than a block gets a block of its own, and the
+ * current block remains usable after a reset.
+ */
+TEST(large)
+{
+    rcpr_allocator* alloc;
+    vcservice_arena* arena;
+    void* small;
+    void* large;
+    void* after;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the arena with small blocks. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_arena_create(&arena, alloc, 4096, 0));
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_arena_allocate(arena, &small, 16));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_arena_allocate(arena, &large, 100000));
+    memset(large, 0xff, 100000);
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_arena_allocate(arena, &after, 16));
+
+    vcservice_arena_reset(arena);
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_arena_allocate(arena, &after, 16));
+    TEST_EXPECT(small == after);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_arena_resource_handle(arena)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Arena memory can back the path buffer interfaces.
+ */
+TEST(strdup_and_paths)
+{
+    rcpr_allocator* alloc;
+    vcservice_arena* arena;
+    char* str;
+    char* buffer;
+    size_t length;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the arena, asking for huge pages if there are any. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_arena_create(
+                    &arena, alloc, 0, VCSERVICE_ARENA_FLAG_HUGE_PAGES));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_arena_strdup(&str, arena, "/usr/./bin"));
+    TEST_EXPECT(!strcmp("/usr/./bin", str));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_arena_allocate(arena, (void**)&buffer, 64));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_normalize_to_buffer(buffer, 64, &length, str));
+    TEST_EXPECT(!strcmp("/usr/bin", buffer));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_arena_resource_handle(arena)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The allocator view can be passed to the path and log interfaces.
+ */
+TEST(allocator_view)
+{
+    rcpr_allocator* alloc;
+    rcpr_allocator* view;
+    vcservice_arena* arena;
+    psock* sock;
+    vcservice_log* log;
+    char* normalized;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the arena. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_arena_create(&arena, alloc, 0, 0));
+    view = vcservice_arena_allocator(arena);
+
+    /* normalize a path with memory from the arena. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == path_normalize(&normalized, view, "/usr/./bin/.."));
+    TEST_EXPECT(!strcmp("/usr", normalized));
+    TEST_EXPECT(0U < vcservice_arena_bytes_used(arena));
+
+    /* reclaiming the most recent allocation gives it back. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(view, normalized));
+    TEST_EXPECT(0U == vcservice_arena_bytes_used(arena));
+
+    /* create a logger in the arena and log a message. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, view, NULL, 0));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, view, sock, VCSERVICE_LOGLEVEL_INFO));
+    vcservice_log_message_start(log);
+    vcservice_log_append_string(log, "arena");
+    vcservice_log_message_commit(log);
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+
+    /* releasing the view does nothing. */
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(view)));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_arena_resource_handle(arena)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Reallocating through the view resizes the most recent allocation in
+ * place, and copies any other.
+ */
+TEST(allocator_view_reallocate)
+{
+    rcpr_allocator* alloc;
+    rcpr_allocator* view;
+    vcservice_arena* arena;
+    void* first;
+    void* second;
+    void* moved;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the arena. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_arena_create(&arena, alloc, 0, 0));
+    view = vcservice_arena_allocator(arena);
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_allocate(view, &first, 8));
+    memcpy(first, "abcdefg", 8);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_allocate(view, &second, 8));
+
+    /* the most recent allocation grows in place. */
+    moved = second;
+    TEST_ASSERT(
+        STATUS_SUCCESS == rcpr_allocator_reallocate(view, &moved, 100));
+    TEST_EXPECT(second == moved);
+
+    /* an older allocation is copied. */
+    moved = first;
+    TEST_ASSERT(
+        STATUS_SUCCESS == rcpr_allocator_reallocate(view, &moved, 100));
+    TEST_EXPECT(first != moved);
+    TEST_EXPECT(!strcmp("abcdefg", (const char*)moved));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_arena_resource_handle(arena)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Unknown flags are rejected.
+ */
+TEST(bad_flags)
+{
+    rcpr_allocator* alloc;
+    vcservice_arena* arena;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_ARENA_INVALID_PARAMETER
+            == vcservice_arena_create(&arena, alloc, 0, 0x80));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
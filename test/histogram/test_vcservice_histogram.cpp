@@ -0,0 +1,380 @@
+/**
+ * \file histogram/test_vcservice_histogram.cpp
+ *
+ * Test the vcservice_histogram methods.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/histogram.h>
+
+#include "../log/log_capture.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcservice_histogram);
+
+#define THREAD_COUNT 4
+#define VALUE_COUNT 100000
+
+/**
+ * \brief Check that a percentile is within the histogram's relative error.
+ */
+static bool near(uint64_t actual, uint64_t expected)
+{
+    uint64_t error = expected / 64 + 1;
+
+    return actual + error >= expected && actual <= expected + error;
+}
+
+/**
+ * \brief Record values from several threads at once.
+ */
+static void* record_thread(void* context)
+{
+    vcservice_histogram* histogram = (vcservice_histogram*)context;
+
+    for (uint64_t i = 1; i <= VALUE_COUNT; ++i)
+    {
+        vcservice_histogram_record(histogram, i);
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Parameters are checked.
+ */
+TEST(invalid_parameters)
+{
+    rcpr_allocator* alloc;
+    vcservice_histogram* histogram;
+    vcservice_histogram_reporter* reporter;
+    vcservice_log* log;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER
+            == vcservice_histogram_create(NULL, alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_histogram_create(&histogram, alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER
+            == vcservice_histogram_reporter_create(
+                    &reporter, alloc, histogram, "latency", log,
+                    VCSERVICE_LOGLEVEL_NORMAL, 0));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_HISTOGRAM_INVALID_PARAMETER
+            == vcservice_histogram_reporter_create(
+                    &reporter, alloc, histogram, NULL, log,
+                    VCSERVICE_LOGLEVEL_NORMAL, 1000));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_resource_handle(histogram)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Small values are counted exactly, and large values are within the
+ * relative error.
+ */
+TEST(percentiles)
+{
+    rcpr_allocator* alloc;
+    vcservice_histogram* histogram;
+    vcservice_histogram_snapshot* snapshot =
+        (vcservice_histogram_snapshot*)malloc(sizeof(*snapshot));
+
+    TEST_ASSERT(NULL != snapshot);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_histogram_create(&histogram, alloc));
+
+    /* an empty histogram has no percentiles. */
+    vcservice_histogram_snapshot_take(snapshot, histogram, false);
+    TEST_EXPECT(0 == snapshot->count);
+    TEST_EXPECT(0 == vcservice_histogram_snapshot_percentile(snapshot, 50.0));
+
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        vcservice_histogram_record(histogram, i);
+    }
+
+    vcservice_histogram_snapshot_take(snapshot, histogram, false);
+    TEST_EXPECT(100 == snapshot->count);
+    TEST_EXPECT(5050 == snapshot->sum);
+    TEST_EXPECT(1 == snapshot->min);
+    TEST_EXPECT(100 == snapshot->max);
+    TEST_EXPECT(50 == vcservice_histogram_snapshot_percentile(snapshot, 50.0));
+    TEST_EXPECT(99 == vcservice_histogram_snapshot_percentile(snapshot, 99.0));
+    TEST_EXPECT(
+        100 == vcservice_histogram_snapshot_percentile(snapshot, 100.0));
+
+    /* spread values over many magnitudes. */
+    for (uint64_t i = 1; i <= 1000000; ++i)
+    {
+        vcservice_histogram_record(histogram, i * 1000);
+    }
+
+    vcservice_histogram_snapshot_take(snapshot, histogram, false);
+    TEST_EXPECT(1000100 == snapshot->count);
+    TEST_EXPECT(1000000000 == snapshot->max);
+    TEST_EXPECT(
+        near(
+            vcservice_histogram_snapshot_percentile(snapshot, 50.0),
+            500050 * 1000));
+    TEST_EXPECT(
+        near(
+            vcservice_histogram_snapshot_percentile(snapshot, 99.0),
+            990099 * 1000));
+    TEST_EXPECT(
+        near(
+            vcservice_histogram_snapshot_percentile(snapshot, 99.9),
+            999099 * 1000));
+
+    /* the largest values land in the top bucket. */
+    vcservice_histogram_record(histogram, UINT64_MAX);
+    vcservice_histogram_snapshot_take(snapshot, histogram, false);
+    TEST_EXPECT(UINT64_MAX == snapshot->max);
+    TEST_EXPECT(
+        UINT64_MAX == vcservice_histogram_snapshot_percentile(snapshot, 100.0));
+
+    free(snapshot);
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_resource_handle(histogram)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Taking a snapshot with reset clears the histogram, and snapshots can
+ * be merged.
+ */
+TEST(reset_and_merge)
+{
+    rcpr_allocator* alloc;
+    vcservice_histogram* histogram;
+    vcservice_histogram_snapshot* first =
+        (vcservice_histogram_snapshot*)malloc(sizeof(*first));
+    vcservice_histogram_snapshot* second =
+        (vcservice_histogram_snapshot*)malloc(sizeof(*second));
+
+    TEST_ASSERT(NULL != first && NULL != second);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_histogram_create(&histogram, alloc));
+
+    for (uint64_t i = 1; i <= 10; ++i)
+    {
+        vcservice_histogram_record(histogram, i);
+    }
+
+    vcservice_histogram_snapshot_take(first, histogram, true);
+    TEST_EXPECT(10 == first->count);
+
+    /* the histogram starts over after a reset. */
+    vcservice_histogram_snapshot_take(second, histogram, false);
+    TEST_EXPECT(0 == second->count);
+    TEST_EXPECT(UINT64_MAX == second->min);
+    TEST_EXPECT(0 == second->max);
+
+    for (uint64_t i = 11; i <= 20; ++i)
+    {
+        vcservice_histogram_record(histogram, i);
+    }
+
+    vcservice_histogram_snapshot_take(second, histogram, true);
+    TEST_EXPECT(10 == second->count);
+    TEST_EXPECT(11 == second->min);
+
+    vcservice_histogram_snapshot_merge(first, second);
+    TEST_EXPECT(20 == first->count);
+    TEST_EXPECT(210 == first->sum);
+    TEST_EXPECT(1 == first->min);
+    TEST_EXPECT(20 == first->max);
+    TEST_EXPECT(10 == vcservice_histogram_snapshot_percentile(first, 50.0));
+
+    free(first);
+    free(second);
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_resource_handle(histogram)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief No value is lost when several threads record at once.
+ */
+TEST(concurrent_record)
+{
+    rcpr_allocator* alloc;
+    vcservice_histogram* histogram;
+    pthread_t threads[THREAD_COUNT];
+    vcservice_histogram_snapshot* snapshot =
+        (vcservice_histogram_snapshot*)malloc(sizeof(*snapshot));
+
+    TEST_ASSERT(NULL != snapshot);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_histogram_create(&histogram, alloc));
+
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        TEST_ASSERT(
+            0 == pthread_create(&threads[i], NULL, &record_thread, histogram));
+    }
+
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    vcservice_histogram_snapshot_take(snapshot, histogram, false);
+    TEST_EXPECT(THREAD_COUNT * VALUE_COUNT == snapshot->count);
+    TEST_EXPECT(
+        (uint64_t)THREAD_COUNT * VALUE_COUNT * (VALUE_COUNT + 1) / 2
+            == snapshot->sum);
+    TEST_EXPECT(1 == snapshot->min);
+    TEST_EXPECT(VALUE_COUNT == snapshot->max);
+
+    free(snapshot);
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_resource_handle(histogram)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A report is one message summarizing the snapshot.
+ */
+TEST(report)
+{
+    rcpr_allocator* alloc;
+    vcservice_histogram* histogram;
+    vcservice_log* log;
+    vcservice_histogram_snapshot* snapshot =
+        (vcservice_histogram_snapshot*)malloc(sizeof(*snapshot));
+
+    TEST_ASSERT(NULL != snapshot);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_histogram_create(&histogram, alloc));
+
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        vcservice_histogram_record(histogram, i);
+    }
+
+    vcservice_histogram_snapshot_take(snapshot, histogram, false);
+    vcservice_histogram_report(
+        log, VCSERVICE_LOGLEVEL_NORMAL, "latency", snapshot);
+
+    TEST_ASSERT(1 == written.size());
+    TEST_EXPECT(
+        std::string(
+            "NORMAL   latency: count=100 min=1 mean=50 p50=50 p90=90 p99=99 "
+            "p999=100 max=100\n")
+            == written[0]);
+
+    /* reports above the threshold are not logged. */
+    vcservice_histogram_report(
+        log, VCSERVICE_LOGLEVEL_DEBUG, "latency", snapshot);
+    TEST_EXPECT(1 == written.size());
+
+    free(snapshot);
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_resource_handle(histogram)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The reporter logs what was recorded, and nothing for an empty
+ * interval.
+ */
+TEST(reporter)
+{
+    rcpr_allocator* alloc;
+    vcservice_histogram* histogram;
+    vcservice_histogram_reporter* reporter;
+    vcservice_log* log;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_histogram_create(&histogram, alloc));
+
+    /* nothing is recorded, so nothing is reported. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_histogram_reporter_create(
+                    &reporter, alloc, histogram, "idle", log,
+                    VCSERVICE_LOGLEVEL_NORMAL, 10));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_reporter_resource_handle(reporter)));
+    TEST_EXPECT(0 == written.size());
+
+    /* the last interval is reported when the reporter is released. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_histogram_reporter_create(
+                    &reporter, alloc, histogram, "latency", log,
+                    VCSERVICE_LOGLEVEL_NORMAL, 60000));
+    vcservice_histogram_record(histogram, 42);
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_reporter_resource_handle(reporter)));
+
+    TEST_ASSERT(1 == written.size());
+    TEST_EXPECT(
+        std::string(
+            "NORMAL   latency: count=1 min=42 mean=42 p50=42 p90=42 p99=42 "
+            "p999=42 max=42\n")
+            == written[0]);
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_resource_handle(histogram)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,80 @@
+/**
+ * \file log/log_capture.h
+ *
+ * \brief Helpers for tests that check the messages a logger writes.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../../src/log/log_internal.h"
+
+/**
+ * \brief The messages written by the capturing sink.
+ */
+static std::vector<std::string> written;
+
+/**
+ * \brief A sink that captures each written message without its date prefix.
+ */
+static inline void capture_write(
+    vcservice_log* log, unsigned int, RCPR_SYM(resource)*)
+{
+    written.push_back(std::string(log->log_message + 20, log->log_idx - 20));
+}
+
+/**
+ * \brief A sink that captures each whole written message.
+ */
+static inline void capture_whole_write(
+    vcservice_log* log, unsigned int, RCPR_SYM(resource)*)
+{
+    written.push_back(std::string(log->log_message, log->log_idx));
+}
+
+/**
+ * \brief Log a message with the given level and text.
+ */
+static inline void log_message(
+    vcservice_log* log, unsigned int level, const char* text)
+{
+    /* the log macros check the level, so do the same here. */
+    if (vcservice_log_level_enabled(log, level))
+    {
+        vcservice_log_message_start(log);
+        vcservice_log_append_log_level(log, level);
+        vcservice_log_append_string(log, text);
+        vcservice_log_message_commit(log);
+    }
+}
+
+/**
+ * \brief Create a logger with the given threshold level writing to the
+ * capturing sink.
+ */
+static inline bool create_log(
+    RCPR_SYM(allocator)* alloc, vcservice_log** log, unsigned int level)
+{
+    RCPR_SYM(psock)* sock;
+
+    if (STATUS_SUCCESS
+            != RCPR_SYM(psock_create_from_buffer)(&sock, alloc, NULL, 0))
+    {
+        return false;
+    }
+
+    if (STATUS_SUCCESS
+            != vcservice_log_create_from_psock(log, alloc, sock, level))
+    {
+        return false;
+    }
+
+    (*log)->log_write_cb = &capture_write;
+    written.clear();
+
+    return true;
+}
@@ -0,0 +1,103 @@
+/**
+ * \file log/test_vcservice_log_append_double.cpp
+ *
+ * Test the floating point append methods.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "../../src/log/log_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_psock;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_append_double);
+
+/**
+ * \brief Append a double to an empty message, and return the result.
+ */
+static string append_double(vcservice_log* log, double val)
+{
+    log->log_idx = 0;
+    vcservice_log_append_double(log, val);
+
+    return string(log->log_message, log->log_idx);
+}
+
+/**
+ * \brief Append a float to an empty message, and return the result.
+ */
+static string append_float(vcservice_log* log, float val)
+{
+    log->log_idx = 0;
+    vcservice_log_append_float(log, val);
+
+    return string(log->log_message, log->log_idx);
+}
+
+/**
+ * \brief Doubles and floats are written using their shortest round-trip
+ * representation.
+ */
+TEST(shortest_representation)
+{
+    rcpr_allocator* alloc;
+    psock* sock;
+    vcservice_log* log;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a buffer backed psock. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, alloc, NULL, 0));
+
+    /* create a logger instance. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, alloc, sock, VCSERVICE_LOGLEVEL_INFO));
+
+    TEST_EXPECT("0.1" == append_double(log, 0.1));
+    TEST_EXPECT("1.0825" == append_double(log, 1.0825));
+    TEST_EXPECT("100.0" == append_double(log, 100.0));
+    TEST_EXPECT("-2.5" == append_double(log, -2.5));
+    TEST_EXPECT("0.0" == append_double(log, 0.0));
+    TEST_EXPECT("-0.0" == append_double(log, -0.0));
+    TEST_EXPECT("1e-05" == append_double(log, 1e-5));
+    TEST_EXPECT("5e-324" == append_double(log, 5e-324));
+    TEST_EXPECT(
+        "1.7976931348623157e+308"
+            == append_double(log, 1.7976931348623157e308));
+    TEST_EXPECT("inf" == append_double(log, 1.0 / 0.0));
+    TEST_EXPECT("nan" == append_double(log, 0.0 / 0.0));
+
+    /* floats use the shortest representation that round-trips as a float. */
+    TEST_EXPECT("0.1" == append_float(log, 0.1f));
+    TEST_EXPECT("3.14159" == append_float(log, 3.14159f));
+
+    /* a value round-trips through strtod. */
+    string pi = append_double(log, 3.141592653589793);
+    TEST_EXPECT(3.141592653589793 == strtod(pi.c_str(), nullptr));
+
+    /* a value is truncated at the end of the message buffer. */
+    log->log_idx = MAX_LOG_MESSAGE_SIZE - 3;
+    vcservice_log_append_double(log, 123.25);
+    TEST_EXPECT(MAX_LOG_MESSAGE_SIZE == log->log_idx);
+    TEST_EXPECT(0 == memcmp("123", log->log_message + log->log_idx - 3, 3));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
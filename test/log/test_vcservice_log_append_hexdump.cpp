@@ -0,0 +1,220 @@
+/**
+ * \file log/test_vcservice_log_append_hexdump.cpp
+ *
+ * Test the hex dump append method.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "../../src/log/log_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_psock;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_append_hexdump);
+
+/**
+ * \brief Without flags, every byte value is appended as two hex digits.
+ */
+TEST(run)
+{
+    rcpr_allocator* alloc;
+    psock* sock;
+    vcservice_log* log;
+    uint8_t data[256];
+    string expected;
+    char digits[3];
+
+    /* build the input and the expected output. */
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = (uint8_t)i;
+        snprintf(digits, sizeof(digits), "%02x", (unsigned int)i);
+        expected += digits;
+    }
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a buffer backed psock. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, alloc, NULL, 0));
+
+    /* create a logger instance. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, alloc, sock, VCSERVICE_LOGLEVEL_INFO));
+
+    /* dump every length, so both the vector and the scalar tail run. */
+    for (size_t size = 0; size <= sizeof(data); ++size)
+    {
+        log->log_idx = 0;
+        TEST_EXPECT(0 == vcservice_log_append_hexdump(log, data, size, 0));
+        TEST_EXPECT(
+            expected.substr(0, 2 * size)
+                == string(log->log_message, log->log_idx));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The offset and ascii flags lay the dump out in rows.
+ */
+TEST(layout)
+{
+    rcpr_allocator* alloc;
+    psock* sock;
+    vcservice_log* log;
+    const char data[] = "0123456789abcdef\x01xyz";
+    const size_t size = sizeof(data) - 1;
+    string expected =
+        "\n00000000  30 31 32 33 34 35 36 37  38 39 61 62 63 64 65 66 "
+            " |0123456789abcdef|"
+        "\n00000010  01 78 79 7a                                      "
+            " |.xyz|";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a buffer backed psock. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, alloc, NULL, 0));
+
+    /* create a logger instance. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, alloc, sock, VCSERVICE_LOGLEVEL_INFO));
+
+    /* dump with offsets and characters. */
+    log->log_idx = 0;
+    TEST_EXPECT(
+        0
+            == vcservice_log_append_hexdump(
+                    log, data, size,
+                    VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET
+                        | VCSERVICE_LOG_HEXDUMP_FLAG_ASCII));
+    TEST_EXPECT(expected == string(log->log_message, log->log_idx));
+
+    /* dump through the log argument, trimming the offset column. */
+    vcservice_log_hexdump arg = { data, size, 0 };
+    arg.flags = VCSERVICE_LOG_HEXDUMP_FLAG_ASCII;
+    log->log_idx = 0;
+    vcservice_log_append_hexdump_arg(log, &arg);
+    TEST_EXPECT(
+        "\n30 31 32 33 34 35 36 37  38 39 61 62 63 64 65 66  "
+        "|0123456789abcdef|"
+        "\n01 78 79 7a                                       |.xyz|"
+            == string(log->log_message, log->log_idx));
+
+    /* a row layout without characters is not padded. */
+    log->log_idx = 0;
+    vcservice_log_append_hexdump(
+        log, data, size, VCSERVICE_LOG_HEXDUMP_FLAG_OFFSET);
+    TEST_EXPECT(
+        "\n00000000  30 31 32 33 34 35 36 37  38 39 61 62 63 64 65 66 "
+        "\n00000010  01 78 79 7a "
+            == string(log->log_message, log->log_idx));
+
+    /* unknown flags do not select a row layout. */
+    log->log_idx = 0;
+    vcservice_log_append_hexdump(log, data, size, 0x0100);
+    TEST_EXPECT(
+        "303132333435363738396162636465660178797a"
+            == string(log->log_message, log->log_idx));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A dump that does not fit is cut short and the elided bytes counted.
+ */
+TEST(elided)
+{
+    rcpr_allocator* alloc;
+    psock* sock;
+    vcservice_log* log;
+    uint8_t data[4096];
+    size_t elided;
+    char marker[64];
+
+    memset(data, 0xAB, sizeof(data));
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a buffer backed psock. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, alloc, NULL, 0));
+
+    /* create a logger instance. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, alloc, sock, VCSERVICE_LOGLEVEL_INFO));
+
+    /* a run of hex digits ends with the marker. */
+    log->log_idx = 0;
+    elided = vcservice_log_append_hexdump(log, data, sizeof(data), 0);
+    TEST_EXPECT(elided > 0 && elided < sizeof(data));
+    snprintf(marker, sizeof(marker), " ... (%zu bytes elided)", elided);
+    TEST_ASSERT(log->log_idx <= MAX_LOG_MESSAGE_SIZE);
+    TEST_EXPECT(
+        string(marker)
+            == string(
+                log->log_message + log->log_idx - strlen(marker),
+                strlen(marker)));
+    TEST_EXPECT(
+        log->log_idx
+            == 2 * (sizeof(data) - elided) + strlen(marker));
+
+    /* rows are never split. */
+    log->log_idx = 0;
+    elided =
+        vcservice_log_append_hexdump(
+            log, data, sizeof(data), VCSERVICE_LOG_HEXDUMP_FLAG_ASCII);
+    TEST_EXPECT(0 == elided % 16);
+    snprintf(marker, sizeof(marker), " ... (%zu bytes elided)", elided);
+    TEST_ASSERT(log->log_idx <= MAX_LOG_MESSAGE_SIZE);
+    TEST_EXPECT(
+        string(marker)
+            == string(
+                log->log_message + log->log_idx - strlen(marker),
+                strlen(marker)));
+
+    /* a short dump that exactly fits is not marked. */
+    log->log_idx = MAX_LOG_MESSAGE_SIZE - 4;
+    TEST_EXPECT(0 == vcservice_log_append_hexdump(log, data, 2, 0));
+    TEST_EXPECT(MAX_LOG_MESSAGE_SIZE == log->log_idx);
+
+    /* a full buffer elides everything. */
+    TEST_EXPECT(2 == vcservice_log_append_hexdump(log, data, 2, 0));
+    TEST_EXPECT(MAX_LOG_MESSAGE_SIZE == log->log_idx);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
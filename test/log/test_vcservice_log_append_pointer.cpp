@@ -0,0 +1,71 @@
+/**
+ * \file log/test_vcservice_log_append_pointer.cpp
+ *
+ * Test the pointer, bool, and char append methods.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <string>
+
+#include "../../src/log/log_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_psock;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_append_pointer);
+
+/**
+ * \brief Pointers, bools, and chars are appended to the message.
+ */
+TEST(basics)
+{
+    rcpr_allocator* alloc;
+    psock* sock;
+    vcservice_log* log;
+    string expected =
+        sizeof(void*) == 8
+            ? "0x00000000deadbeef true false x" : "0xdeadbeef true false x";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a buffer backed psock. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, alloc, NULL, 0));
+
+    /* create a logger instance. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, alloc, sock, VCSERVICE_LOGLEVEL_INFO));
+
+    /* build a message. */
+    log->log_idx = 0;
+    vcservice_log_append_pointer(log, (const void*)0xdeadbeef);
+    vcservice_log_append_char(log, ' ');
+    vcservice_log_append_bool(log, true);
+    vcservice_log_append_char(log, ' ');
+    vcservice_log_append_bool(log, false);
+    vcservice_log_append_char(log, ' ');
+    vcservice_log_append_char(log, 'x');
+
+    TEST_EXPECT(expected == string(log->log_message, log->log_idx));
+
+    /* a char is dropped if the message buffer is full. */
+    log->log_idx = MAX_LOG_MESSAGE_SIZE;
+    vcservice_log_append_char(log, 'x');
+    TEST_EXPECT(MAX_LOG_MESSAGE_SIZE == log->log_idx);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,195 @@
+/**
+ * \file log/test_vcservice_log_audit.cpp
+ *
+ * Test the hash-chained audit log sink and its verifier.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_audit);
+
+/**
+ * \brief Write an audit log with the given number of records to a temporary
+ * file, returning a descriptor for reading it back.
+ */
+static int write_audit_log(
+    rcpr_allocator* alloc, int records, unsigned int checkpoint_interval)
+{
+    char filename[] = "/tmp/test_vcservice_log_audit_XXXXXX";
+    vcservice_log* log;
+
+    int desc = mkstemp(filename);
+    if (desc < 0)
+    {
+        return -1;
+    }
+
+    unlink(filename);
+
+    int read_desc = dup(desc);
+    if (read_desc < 0)
+    {
+        close(desc);
+        return -1;
+    }
+
+    if (STATUS_SUCCESS
+            != vcservice_log_create_audit(
+                    &log, alloc, desc, checkpoint_interval,
+                    VCSERVICE_LOGLEVEL_DEBUG))
+    {
+        close(desc);
+        close(read_desc);
+        return -1;
+    }
+
+    for (int i = 0; i < records; ++i)
+    {
+        vcservice_log_message_start(log);
+        vcservice_log_append_string(log, "transfer ");
+        vcservice_log_append_int32(log, i);
+        vcservice_log_append_string(log, " settled.");
+        vcservice_log_message_commit(log);
+    }
+
+    if (STATUS_SUCCESS != resource_release(vcservice_log_resource_handle(log)))
+    {
+        close(read_desc);
+        return -1;
+    }
+
+    return read_desc;
+}
+
+/**
+ * \brief Records written to the audit sink verify, with periodic checkpoints
+ * and a final seal.
+ */
+TEST(write_and_verify)
+{
+    rcpr_allocator* alloc;
+    vcservice_log_audit_summary summary;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int desc = write_audit_log(alloc, 10, 4);
+    TEST_ASSERT(desc >= 0);
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_log_audit_verify(&summary, desc));
+    TEST_EXPECT(10 == summary.records);
+    /* checkpoints after records 4 and 8, then the seal. */
+    TEST_EXPECT(3 == summary.checkpoints);
+    TEST_EXPECT(summary.sealed);
+
+    close(desc);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief An empty audit log is sealed and verifies.
+ */
+TEST(empty_log)
+{
+    rcpr_allocator* alloc;
+    vcservice_log_audit_summary summary;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int desc = write_audit_log(alloc, 0, 0);
+    TEST_ASSERT(desc >= 0);
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_log_audit_verify(&summary, desc));
+    TEST_EXPECT(0 == summary.records);
+    TEST_EXPECT(1 == summary.checkpoints);
+    TEST_EXPECT(summary.sealed);
+
+    close(desc);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Changing a single byte of a record breaks the chain at that record.
+ */
+TEST(tampered_record)
+{
+    rcpr_allocator* alloc;
+    vcservice_log_audit_summary summary;
+    char contents[16384];
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int desc = write_audit_log(alloc, 5, 0);
+    TEST_ASSERT(desc >= 0);
+
+    ssize_t size = pread(desc, contents, sizeof(contents), 0);
+    TEST_ASSERT(size > 0);
+
+    /* change the amount of the third transfer. */
+    char* third = (char*)memmem(contents, size, "transfer 2 ", 11);
+    TEST_ASSERT(NULL != third);
+    TEST_ASSERT(1 == pwrite(desc, "7", 1, (third - contents) + 9));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_AUDIT_CHAIN_MISMATCH
+            == vcservice_log_audit_verify(&summary, desc));
+    TEST_EXPECT(2 == summary.records);
+
+    close(desc);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A log truncated at an entry boundary verifies but is not sealed;
+ * one truncated mid-entry is malformed.
+ */
+TEST(truncated_log)
+{
+    rcpr_allocator* alloc;
+    vcservice_log_audit_summary summary;
+    char contents[16384];
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int desc = write_audit_log(alloc, 3, 0);
+    TEST_ASSERT(desc >= 0);
+
+    ssize_t size = pread(desc, contents, sizeof(contents), 0);
+    TEST_ASSERT(size > 0);
+
+    /* drop the seal, which is the last line. */
+    char* seal = (char*)memrchr(contents, '\n', size - 1) + 1;
+    TEST_ASSERT('S' == *seal);
+    TEST_ASSERT(0 == ftruncate(desc, seal - contents));
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_log_audit_verify(&summary, desc));
+    TEST_EXPECT(3 == summary.records);
+    TEST_EXPECT(!summary.sealed);
+
+    /* cut into the last record. */
+    TEST_ASSERT(0 == ftruncate(desc, seal - contents - 4));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_AUDIT_MALFORMED
+            == vcservice_log_audit_verify(&summary, desc));
+    TEST_EXPECT(2 == summary.records);
+
+    close(desc);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
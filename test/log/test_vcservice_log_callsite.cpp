@@ -0,0 +1,74 @@
+/**
+ * \file log/test_vcservice_log_callsite.cpp
+ *
+ * Test enabling and disabling logging call sites.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <vcservice/log.h>
+
+TEST_SUITE(test_vcservice_log_callsite);
+
+/* the log macros aren't available in C++, so declare a call site by hand. */
+static vcservice_log_callsite test_callsite
+    __attribute__((
+        section(VCSERVICE_LOG_CALLSITE_SECTION), used,
+        aligned(__alignof__(vcservice_log_callsite)))) =
+    { __FILE__, "test_function", 1234, VCSERVICE_LOGLEVEL_DEBUG, 0 };
+
+/**
+ * \brief Our call site shows up in the call site list.
+ */
+TEST(list)
+{
+    const vcservice_log_callsite* sites;
+    bool found = false;
+
+    size_t count = vcservice_log_callsite_list(&sites);
+    TEST_ASSERT(count > 0);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (&test_callsite == sites + i)
+        {
+            found = true;
+        }
+    }
+
+    TEST_EXPECT(found);
+}
+
+/**
+ * \brief We can enable and disable our call site by file, function, and line.
+ */
+TEST(set_enabled)
+{
+    /* PRECONDITION: the call site is disabled. */
+    TEST_ASSERT(0 == test_callsite.enabled);
+
+    /* a non-matching line does not enable the call site. */
+    TEST_EXPECT(
+        0 == vcservice_log_callsite_set_enabled(
+                "test_vcservice_log_callsite.cpp", nullptr, 1, true));
+    TEST_EXPECT(0 == test_callsite.enabled);
+
+    /* a non-matching function does not enable the call site. */
+    TEST_EXPECT(
+        0 == vcservice_log_callsite_set_enabled(
+                nullptr, "other_*", 0, true));
+    TEST_EXPECT(0 == test_callsite.enabled);
+
+    /* the base name, function pattern, and line match. */
+    TEST_EXPECT(
+        1 == vcservice_log_callsite_set_enabled(
+                "test_vcservice_log_callsite.cpp", "test_*", 1234, true));
+    TEST_EXPECT(1 == test_callsite.enabled);
+
+    /* the full path glob matches, and disables the call site. */
+    TEST_EXPECT(
+        1 <= vcservice_log_callsite_set_enabled(
+                "*/test_vcservice_log_callsite.cpp", nullptr, 0, false));
+    TEST_EXPECT(0 == test_callsite.enabled);
+}
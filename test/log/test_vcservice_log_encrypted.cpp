@@ -0,0 +1,284 @@
+/**
+ * \file log/test_vcservice_log_encrypted.cpp
+ *
+ * Test the encrypted log sink and decryption.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_encrypted);
+
+#define TEST_LOG_SIZE 65536
+
+/**
+ * \brief Create an unlinked temporary file.
+ */
+static int temp_file()
+{
+    char filename[] = "/tmp/test_vcservice_log_encrypted_XXXXXX";
+
+    int desc = mkstemp(filename);
+    if (desc >= 0)
+    {
+        unlink(filename);
+    }
+
+    return desc;
+}
+
+/**
+ * \brief Write an encrypted log of the given number of records, returning a
+ * descriptor for reading it back.
+ */
+static int write_encrypted_log(
+    rcpr_allocator* alloc, const uint8_t* key, int records)
+{
+    vcservice_log* log;
+
+    int desc = temp_file();
+    if (desc < 0)
+    {
+        return -1;
+    }
+
+    int read_desc = dup(desc);
+
+    if (STATUS_SUCCESS
+            != vcservice_log_create_encrypted(
+                    &log, alloc, desc, key, 32, 64, 3,
+                    VCSERVICE_LOGLEVEL_DEBUG))
+    {
+        close(desc);
+        close(read_desc);
+        return -1;
+    }
+
+    for (int i = 0; i < records; ++i)
+    {
+        vcservice_log_message_start(log);
+        vcservice_log_append_log_level(log, VCSERVICE_LOGLEVEL_INFO);
+        vcservice_log_append_string(log, "encrypted record ");
+        vcservice_log_append_int32(log, i);
+        vcservice_log_message_commit(log);
+    }
+
+    if (STATUS_SUCCESS != resource_release(vcservice_log_resource_handle(log)))
+    {
+        close(read_desc);
+        return -1;
+    }
+
+    return read_desc;
+}
+
+/**
+ * \brief Decrypt the log into a buffer, returning the decryption status.
+ */
+static status decrypt_log(
+    rcpr_allocator* alloc, int desc, const uint8_t* key, char* out,
+    ssize_t* out_size)
+{
+    int out_desc = temp_file();
+
+    lseek(desc, 0, SEEK_SET);
+    status retval =
+        vcservice_log_encrypted_decrypt(alloc, out_desc, desc, key, 32);
+
+    *out_size = pread(out_desc, out, TEST_LOG_SIZE - 1, 0);
+    out[*out_size > 0 ? *out_size : 0] = 0;
+    close(out_desc);
+
+    return retval;
+}
+
+/**
+ * \brief Poll the log being written until its plaintext contains the given
+ * text, giving up after the given number of milliseconds.
+ */
+static bool wait_for_plaintext(
+    rcpr_allocator* alloc, int desc, const uint8_t* key, const char* text,
+    int timeout_ms)
+{
+    static char plaintext[TEST_LOG_SIZE];
+    ssize_t plaintext_size;
+
+    for (int waited = 0; waited <= timeout_ms; waited += 10)
+    {
+        /* a block may be caught half written, so ignore the status. */
+        decrypt_log(alloc, desc, key, plaintext, &plaintext_size);
+        if (NULL != strstr(plaintext, text))
+        {
+            return true;
+        }
+
+        usleep(10 * 1000);
+    }
+
+    return false;
+}
+
+/**
+ * \brief Records written through the encrypted sink decrypt back in order,
+ * and never appear in the clear.
+ */
+TEST(round_trip)
+{
+    rcpr_allocator* alloc;
+    uint8_t key[32];
+    static char contents[TEST_LOG_SIZE];
+    static char plaintext[TEST_LOG_SIZE];
+    char expected[64];
+    ssize_t size, plaintext_size;
+
+    memset(key, 0x5A, sizeof(key));
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int desc = write_encrypted_log(alloc, key, 200);
+    TEST_ASSERT(desc >= 0);
+
+    size = pread(desc, contents, sizeof(contents), 0);
+    TEST_ASSERT(size > 0);
+    TEST_EXPECT(NULL == memmem(contents, size, "encrypted record", 16));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == decrypt_log(alloc, desc, key, plaintext, &plaintext_size));
+
+    /* every record is present, in order. */
+    const char* cursor = plaintext;
+    for (int i = 0; i < 200; ++i)
+    {
+        snprintf(expected, sizeof(expected), "encrypted record %d\n", i);
+        cursor = strstr(cursor, expected);
+        TEST_ASSERT(NULL != cursor);
+    }
+
+    close(desc);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Logs encrypted with the same key use different per-file keys.
+ */
+TEST(per_file_key)
+{
+    rcpr_allocator* alloc;
+    uint8_t key[32];
+    char first[256], second[256];
+
+    memset(key, 0x5A, sizeof(key));
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int first_desc = write_encrypted_log(alloc, key, 5);
+    int second_desc = write_encrypted_log(alloc, key, 5);
+    TEST_ASSERT(first_desc >= 0);
+    TEST_ASSERT(second_desc >= 0);
+
+    TEST_ASSERT(sizeof(first) == pread(first_desc, first, sizeof(first), 0));
+    TEST_ASSERT(
+        sizeof(second) == pread(second_desc, second, sizeof(second), 0));
+
+    /* skip the magic, then compare the salt and first block. */
+    TEST_EXPECT(0 != memcmp(first + 8, second + 8, sizeof(first) - 8));
+
+    close(first_desc);
+    close(second_desc);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A truncated log, or a log with a bad key size, is rejected.
+ */
+TEST(malformed)
+{
+    rcpr_allocator* alloc;
+    uint8_t key[32];
+    static char plaintext[TEST_LOG_SIZE];
+    ssize_t plaintext_size;
+    vcservice_log* log;
+
+    memset(key, 0x5A, sizeof(key));
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY
+            == vcservice_log_create_encrypted(
+                    &log, alloc, 1, key, 7, 0, 0, VCSERVICE_LOGLEVEL_DEBUG));
+
+    int desc = write_encrypted_log(alloc, key, 20);
+    TEST_ASSERT(desc >= 0);
+
+    off_t size = lseek(desc, 0, SEEK_END);
+    TEST_ASSERT(0 == ftruncate(desc, size - 3));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED
+            == decrypt_log(alloc, desc, key, plaintext, &plaintext_size));
+
+    close(desc);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief An ERROR message reaches the descriptor straight away, and a quieter
+ * message within the flush interval, before the logger is released.
+ */
+TEST(flush)
+{
+    rcpr_allocator* alloc;
+    uint8_t key[32];
+    vcservice_log* log;
+
+    memset(key, 0x5A, sizeof(key));
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int desc = temp_file();
+    TEST_ASSERT(desc >= 0);
+    int read_desc = dup(desc);
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_encrypted(
+                    &log, alloc, desc, key, 32, 4096, 2,
+                    VCSERVICE_LOGLEVEL_DEBUG));
+
+    vcservice_log_message_start(log);
+    vcservice_log_append_log_level(log, VCSERVICE_LOGLEVEL_ERROR);
+    vcservice_log_append_string(log, "an error");
+    vcservice_log_message_commit(log);
+
+    TEST_EXPECT(wait_for_plaintext(alloc, read_desc, key, "an error", 500));
+
+    vcservice_log_message_start(log);
+    vcservice_log_append_log_level(log, VCSERVICE_LOGLEVEL_INFO);
+    vcservice_log_append_string(log, "some info");
+    vcservice_log_message_commit(log);
+
+    TEST_EXPECT(!wait_for_plaintext(alloc, read_desc, key, "some info", 0));
+    TEST_EXPECT(wait_for_plaintext(alloc, read_desc, key, "some info", 3000));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+
+    close(read_desc);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,205 @@
+/**
+ * \file log/test_vcservice_log_layout.cpp
+ *
+ * Test compiled log layouts.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <ctype.h>
+#include <minunit/minunit.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+
+#include "log_capture.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+TEST_SUITE(test_vcservice_log_layout);
+
+/**
+ * \brief Check that a string matches a shape, where '9' stands for any
+ * digit.
+ */
+static bool matches(const std::string& text, const char* shape)
+{
+    if (text.size() != strlen(shape))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if ('9' == shape[i] ? !isdigit((unsigned char)text[i])
+                            : shape[i] != text[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \brief Bad patterns are rejected and leave the layout unchanged.
+ */
+TEST(invalid_patterns)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    std::string longest(VCSERVICE_LOG_LAYOUT_MAX_SIZE, 'x');
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+    log->log_write_cb = &capture_whole_write;
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_LAYOUT_INVALID
+            == vcservice_log_set_layout(log, "%L %q %m"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_LAYOUT_INVALID
+            == vcservice_log_set_layout(log, "%m %"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_LAYOUT_INVALID
+            == vcservice_log_set_layout(log, "%L only"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_LAYOUT_INVALID
+            == vcservice_log_set_layout(log, (longest + "%m").c_str()));
+    TEST_EXPECT(NULL == log->layout);
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Literals, the level, the thread, and percent signs are laid out in
+ * pattern order.
+ */
+TEST(fields)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    std::string thread = std::to_string((long)syscall(SYS_gettid));
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+    log->log_write_cb = &capture_whole_write;
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_set_layout(log, "%L [%C] %t 100%% %m!"));
+
+    /* runs of literal text are merged into one op each. */
+    TEST_EXPECT(8 == log->layout->op_count);
+
+    log_message(log, VCSERVICE_LOGLEVEL_ERROR, "failed");
+    log_message(log, VCSERVICE_LOGLEVEL_NORMAL, "ok");
+
+    TEST_ASSERT(2 == written.size());
+    TEST_EXPECT(
+        written[0] == "ERROR    [] " + thread + " 100% failed!\n");
+    TEST_EXPECT(written[1] == "NORMAL   [] " + thread + " 100% ok!\n");
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The date, time, and trace context fields, and restoring the
+ * default layout.
+ */
+TEST(time_and_context)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    rcpr_uuid trace_id;
+    vcservice_log_trace_context ctx;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+    log->log_write_cb = &capture_whole_write;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == rcpr_uuid_parse_string(
+                    &trace_id, "b8e4e3a2-7c1f-4b7e-9d2c-0a1b2c3d4e5f"));
+    vcservice_log_trace_context_init(&ctx, &trace_id, 0xdeadbeef);
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_set_layout(log, "%D %T.%u <%C> %m"));
+
+    log_message(log, VCSERVICE_LOGLEVEL_NORMAL, "plain");
+    vcservice_log_trace_context_swap(&ctx);
+    log_message(log, VCSERVICE_LOGLEVEL_NORMAL, "traced");
+    vcservice_log_trace_context_swap(NULL);
+
+    /* back to the default layout. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_log_set_layout(log, NULL));
+    log_message(log, VCSERVICE_LOGLEVEL_NORMAL, "default");
+
+    TEST_ASSERT(3 == written.size());
+    TEST_EXPECT(matches(written[0], "9999-99-99 99:99:99.999999 <> plain\n"));
+    TEST_EXPECT(
+        matches(
+            written[1],
+            "9999-99-99 99:99:99.999999 "
+            "<trace=b8e4e3a2-7c1f-4b7e-9d2c-0a1b2c3d4e5f "
+            "span=00000000deadbeef> traced\n"));
+    TEST_EXPECT(matches(written[2], "9999-99-99 99:99:99 NORMAL   default\n"));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief "%L %m" lays out every level in the same columns as the default
+ * line does after its date.
+ */
+TEST(level_column)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_DEBUG));
+
+    for (unsigned int level = VCSERVICE_LOGLEVEL_CRITICAL;
+         level <= VCSERVICE_LOGLEVEL_DEBUG; ++level)
+    {
+        written.clear();
+
+        /* the capturing sink drops the default line's date. */
+        log->log_write_cb = &capture_write;
+        log_message(log, level, "text");
+
+        log->log_write_cb = &capture_whole_write;
+        TEST_ASSERT(STATUS_SUCCESS == vcservice_log_set_layout(log, "%L %m"));
+        log_message(log, level, "text");
+        TEST_ASSERT(STATUS_SUCCESS == vcservice_log_set_layout(log, NULL));
+
+        TEST_ASSERT(2 == written.size());
+        TEST_EXPECT(written[0] == written[1]);
+    }
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,130 @@
+/**
+ * \file log/test_vcservice_log_message_emit.cpp
+ *
+ * Test the vcservice_log_message_emit method.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <string>
+
+#include "../../src/log/log_internal.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_psock;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_message_emit);
+
+/**
+ * \brief Each typed argument is formatted in order after the log level.
+ */
+TEST(basics)
+{
+    rcpr_allocator* alloc;
+    psock* sock;
+    vcservice_log* log;
+    uint8_t types[6];
+    vcservice_log_arg_value values[6];
+    const char* expected = "INFO     x = 0x0a, y = -271\n";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a buffer backed psock. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, alloc, NULL, 0));
+
+    /* create a logger instance. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, alloc, sock, VCSERVICE_LOGLEVEL_INFO));
+
+    /* build the argument list. */
+    types[0] = VCSERVICE_LOG_ARG_STRING;
+    values[0].str = "x = ";
+    types[1] = VCSERVICE_LOG_ARG_FORMAT_HEX;
+    values[1].u64 = 0;
+    types[2] = VCSERVICE_LOG_ARG_UINT8;
+    values[2].u64 = 10;
+    types[3] = VCSERVICE_LOG_ARG_FORMAT_DEFAULT;
+    values[3].u64 = 0;
+    types[4] = VCSERVICE_LOG_ARG_STRING;
+    values[4].str = ", y = ";
+    types[5] = VCSERVICE_LOG_ARG_INT32;
+    values[5].i64 = -271;
+
+    /* emit the message. */
+    vcservice_log_message_emit(
+        log, VCSERVICE_LOGLEVEL_INFO, types, values, 6);
+
+    /* the message follows the 20 character date prefix. */
+    TEST_ASSERT(strlen(expected) + 20 == log->log_idx);
+    TEST_EXPECT(
+        0 == memcmp(expected, log->log_message + 20, strlen(expected)));
+
+    /* the level was saved. */
+    TEST_EXPECT(VCSERVICE_LOGLEVEL_INFO == log->log_level);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Arguments past the first VCSERVICE_LOG_MAX_ARGS are truncated.
+ */
+TEST(truncated)
+{
+    rcpr_allocator* alloc;
+    psock* sock;
+    vcservice_log* log;
+    const size_t count = VCSERVICE_LOG_MAX_ARGS + 10;
+    uint8_t types[count];
+    vcservice_log_arg_value values[count];
+    std::string expected =
+        "INFO     " + std::string(VCSERVICE_LOG_MAX_ARGS, 'x')
+      + " (truncated)\n";
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a buffer backed psock. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, alloc, NULL, 0));
+
+    /* create a logger instance. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, alloc, sock, VCSERVICE_LOGLEVEL_INFO));
+
+    /* build an argument list that is too long. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        types[i] = VCSERVICE_LOG_ARG_STRING;
+        values[i].str = "x";
+    }
+
+    /* emit the message. */
+    vcservice_log_message_emit(
+        log, VCSERVICE_LOGLEVEL_INFO, types, values, count);
+
+    /* the first VCSERVICE_LOG_MAX_ARGS values are followed by the marker. */
+    TEST_ASSERT(expected.size() + 20 == log->log_idx);
+    TEST_EXPECT(
+        0 == memcmp(expected.data(), log->log_message + 20, expected.size()));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,151 @@
+/**
+ * \file log/test_vcservice_log_metrics.cpp
+ *
+ * Test the logger stats and their metrics registration.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/metrics.h>
+
+#include "../../src/metrics/metrics_internal.h"
+#include "log_capture.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_metrics);
+
+/**
+ * \brief Read a logger counter the way another thread would.
+ */
+static uint64_t load(const uint64_t& counter)
+{
+    return __atomic_load_n(&counter, __ATOMIC_RELAXED);
+}
+
+/**
+ * \brief Written messages are counted by level, along with their bytes, and
+ * scope buffer overflows are counted as drops.
+ */
+TEST(counts)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+
+    const vcservice_log_stats* stats = vcservice_log_stats_get(log);
+
+    log_message(log, VCSERVICE_LOGLEVEL_NORMAL, "one");
+    log_message(log, VCSERVICE_LOGLEVEL_NORMAL, "two");
+    log_message(log, VCSERVICE_LOGLEVEL_ERROR, "three");
+
+    /* a message below the threshold is never written. */
+    log_message(log, VCSERVICE_LOGLEVEL_DEBUG, "four");
+
+    TEST_EXPECT(2 == load(stats->messages[VCSERVICE_LOGLEVEL_NORMAL]));
+    TEST_EXPECT(1 == load(stats->messages[VCSERVICE_LOGLEVEL_ERROR]));
+    TEST_EXPECT(0 == load(stats->messages[VCSERVICE_LOGLEVEL_DEBUG]));
+
+    /* each message is a date, a level, the text, and a newline. */
+    TEST_EXPECT(3 * (20 + 9 + 1) + 3 + 3 + 5 == load(stats->bytes));
+    TEST_EXPECT(0 == load(stats->dropped));
+
+    /* overflowing the request scope buffer drops its oldest messages. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_scope_begin(log, VCSERVICE_LOGLEVEL_DEBUG));
+    for (int i = 0; i < 1000; ++i)
+    {
+        log_message(log, VCSERVICE_LOGLEVEL_DEBUG, "detail");
+    }
+
+    vcservice_log_scope_end(log);
+    TEST_EXPECT(0 < load(stats->dropped));
+    TEST_EXPECT(0 == load(stats->messages[VCSERVICE_LOGLEVEL_DEBUG]));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A registered logger's counters are read when the registry is
+ * rendered, and a logger name is registered once.
+ */
+TEST(register)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    vcservice_log* other;
+    vcservice_metrics_registry* registry;
+    vcservice_metrics_buffer buffer;
+    static vcservice_histogram_snapshot snapshot;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_metrics_registry_create(&registry, alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+    TEST_ASSERT(create_log(alloc, &other, VCSERVICE_LOGLEVEL_NORMAL));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_METRICS_INVALID_PARAMETER
+            == vcservice_metrics_log_register(registry, log, "a\"b"));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_metrics_log_register(registry, log, "app"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_METRICS_DUPLICATE
+            == vcservice_metrics_log_register(registry, other, "app"));
+
+    /* the counters are read at render time. */
+    log_message(log, VCSERVICE_LOGLEVEL_ERROR, "failed");
+
+    memset(&buffer, 0, sizeof(buffer));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_render(&buffer, alloc, registry, &snapshot));
+    std::string text(buffer.data, buffer.size);
+
+    TEST_EXPECT(
+        std::string::npos
+            != text.find("# TYPE vcservice_log_messages_total counter\n"));
+    TEST_EXPECT(
+        std::string::npos
+            != text.find(
+                    "vcservice_log_messages_total"
+                    "{logger=\"app\",level=\"error\"} 1\n"));
+    TEST_EXPECT(
+        std::string::npos
+            != text.find(
+                    "vcservice_log_messages_total"
+                    "{logger=\"app\",level=\"normal\"} 0\n"));
+    TEST_EXPECT(
+        std::string::npos
+            != text.find("vcservice_log_bytes_total{logger=\"app\"} 36\n"));
+    TEST_EXPECT(
+        std::string::npos
+            != text.find("vcservice_log_dropped_total{logger=\"app\"} 0\n"));
+
+    TEST_EXPECT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, buffer.data));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_metrics_registry_resource_handle(registry)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(other)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
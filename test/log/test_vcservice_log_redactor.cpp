@@ -0,0 +1,260 @@
+/**
+ * \file log/test_vcservice_log_redactor.cpp
+ *
+ * Test the log redactor.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <vcservice/error_codes.h>
+
+#include "log_capture.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_redactor);
+
+/**
+ * \brief Run the redactor over the given string, returning the result.
+ */
+static string redact(
+    const vcservice_log_redactor* redactor, const string& input,
+    size_t* count = NULL)
+{
+    string output = input;
+    size_t redactions =
+        vcservice_log_redactor_apply(redactor, &output[0], output.size());
+
+    if (NULL != count)
+    {
+        *count = redactions;
+    }
+
+    return output;
+}
+
+/**
+ * \brief Luhn-valid card numbers are masked, except for the last four digits.
+ */
+TEST(card_numbers)
+{
+    rcpr_allocator* alloc;
+    vcservice_log_redactor* redactor;
+    size_t count;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a redactor. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_redactor_create(&redactor, alloc));
+
+    /* card numbers, with and without separators. */
+    TEST_EXPECT(
+        "pan=************1111."
+            == redact(redactor, "pan=4111111111111111.", &count));
+    TEST_EXPECT(1 == count);
+    TEST_EXPECT(
+        "**** **** **** 1111 and ****-******-*0005"
+            == redact(
+                redactor, "4111 1111 1111 1111 and 3782-822463-10005", &count));
+    TEST_EXPECT(2 == count);
+
+    /* a card number past the first sixteen bytes of the message. */
+    TEST_EXPECT(
+        "a long prefix without any digits: ************5556"
+            == redact(
+                redactor, "a long prefix without any digits: 4000056655665556",
+                &count));
+    TEST_EXPECT(1 == count);
+
+    /* card numbers joined by a single separator are masked separately. */
+    TEST_EXPECT(
+        "************1111 ************4444"
+            == redact(redactor, "4111111111111111 5555555555554444", &count));
+    TEST_EXPECT(2 == count);
+
+    /* numbers that fail the Luhn check, or are too short or too long, are
+     * left alone. */
+    TEST_EXPECT(
+        "4111111111111112" == redact(redactor, "4111111111111112", &count));
+    TEST_EXPECT(0 == count);
+    TEST_EXPECT("411111111111" == redact(redactor, "411111111111"));
+    TEST_EXPECT(
+        "41111111111111111111111"
+            == redact(redactor, "41111111111111111111111"));
+
+    /* a double separator ends the run. */
+    TEST_EXPECT(
+        "4111 1111  1111 1111" == redact(redactor, "4111 1111  1111 1111"));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_log_redactor_resource_handle(redactor)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Tokens starting with a registered prefix are masked after the prefix.
+ */
+TEST(token_prefixes)
+{
+    rcpr_allocator* alloc;
+    vcservice_log_redactor* redactor;
+    size_t count;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a redactor. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_redactor_create(&redactor, alloc));
+
+    /* empty prefixes are rejected. */
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_REDACTOR_INVALID_PATTERN
+            == vcservice_log_redactor_add_pattern(redactor, ""));
+
+    /* add some prefixes, including overlapping ones. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_redactor_add_pattern(redactor, "sk_live_"));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_redactor_add_pattern(redactor, "Bearer "));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_redactor_add_pattern(redactor, "ive_key="));
+
+    TEST_EXPECT(
+        "key sk_live_****, auth=\"Bearer ******\" end"
+            == redact(
+                redactor, "key sk_live_abcd, auth=\"Bearer xyz123\" end",
+                &count));
+    TEST_EXPECT(2 == count);
+
+    /* the first prefix to end wins. */
+    TEST_EXPECT(
+        "sk_live_*******;" == redact(redactor, "sk_live_key=abc;", &count));
+    TEST_EXPECT(1 == count);
+
+    /* a prefix found through a failure link is still matched. */
+    TEST_EXPECT("sk_liveive_key=***" == redact(redactor, "sk_liveive_key=abc"));
+
+    /* a prefix with nothing after it is not counted. */
+    TEST_EXPECT("Bearer " == redact(redactor, "Bearer ", &count));
+    TEST_EXPECT(0 == count);
+
+    /* card numbers are still masked. */
+    TEST_EXPECT(
+        "sk_live_**************** ************1111"
+            == redact(redactor, "sk_live_4111111111111111 4111111111111111"));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_log_redactor_resource_handle(redactor)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Many prefixes, and single byte prefixes, are matched.
+ */
+TEST(many_prefixes)
+{
+    rcpr_allocator* alloc;
+    vcservice_log_redactor* redactor;
+    const char* prefixes[] = {
+        "k0=", "k1=", "k2=", "k3=", "k4=", "k5=", "k6=", "k7=", "k8=", "k9=" };
+    string input, expected;
+    size_t count;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a redactor. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_redactor_create(&redactor, alloc));
+
+    /* add more prefixes than can be scanned for sixteen bytes at a time. */
+    for (const char* prefix : prefixes)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcservice_log_redactor_add_pattern(redactor, prefix));
+        input += string("some text ") + prefix + "value ";
+        expected += string("some text ") + prefix + "***** ";
+    }
+
+    TEST_EXPECT(expected == redact(redactor, input, &count));
+    TEST_EXPECT(10 == count);
+
+    /* a single byte prefix. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_redactor_add_pattern(redactor, "#"));
+    TEST_EXPECT(
+        "a long message with a hash tag #*** in the middle"
+            == redact(
+                redactor, "a long message with a hash tag #tag in the middle"));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_log_redactor_resource_handle(redactor)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A logger applies its redactor before writing a message.
+ */
+TEST(logger)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    vcservice_log_redactor* redactor;
+
+    /* create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create a logger instance writing to the capturing sink. */
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_INFO));
+    log->log_write_cb = &capture_whole_write;
+
+    /* create a redactor and give it to the logger. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_redactor_create(&redactor, alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_redactor_add_pattern(redactor, "secret="));
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_log_set_redactor(log, redactor));
+
+    /* commit a message. */
+    log->log_idx = 0;
+    vcservice_log_append_string(log, "card 5555555555554444 secret=hunter2");
+    vcservice_log_message_commit(log);
+
+    TEST_ASSERT(1 == written.size());
+    TEST_EXPECT("card ************4444 secret=*******\n" == written[0]);
+
+    /* clean up; the logger releases the redactor. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,253 @@
+/**
+ * \file log/test_vcservice_log_scope.cpp
+ *
+ * Test request scope buffering.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log_capture.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_scope);
+
+/* the log macros aren't available in C++, so declare a call site by hand. */
+static vcservice_log_callsite test_callsite
+    __attribute__((
+        section(VCSERVICE_LOG_CALLSITE_SECTION), used,
+        aligned(__alignof__(vcservice_log_callsite)))) =
+    { __FILE__, "scope_callsite", 4321, VCSERVICE_LOGLEVEL_DEBUG, 0 };
+
+/**
+ * \brief Log a message from the test call site, as the log macros do.
+ */
+static void log_callsite_message(vcservice_log* log, const char* text)
+{
+    const bool callsite_on =
+        __atomic_load_n(&test_callsite.enabled, __ATOMIC_RELAXED);
+
+    if (callsite_on
+     || vcservice_log_level_enabled(log, test_callsite.level))
+    {
+        if (callsite_on)
+        {
+            vcservice_log_message_callsite_enabled(log);
+        }
+
+        vcservice_log_message_start(log);
+        vcservice_log_append_log_level(log, test_callsite.level);
+        vcservice_log_append_string(log, text);
+        vcservice_log_message_commit(log);
+    }
+}
+
+/**
+ * \brief Detail logged in a successful scope is discarded.
+ */
+TEST(success_discards_detail)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_scope_begin(log, VCSERVICE_LOGLEVEL_DEBUG));
+    TEST_EXPECT(
+        VCSERVICE_LOGLEVEL_NORMAL == vcservice_log_threshold_level(log));
+    TEST_EXPECT(vcservice_log_level_enabled(log, VCSERVICE_LOGLEVEL_DEBUG));
+
+    log_message(log, VCSERVICE_LOGLEVEL_DEBUG, "detail 1");
+    log_message(log, VCSERVICE_LOGLEVEL_NORMAL, "accepted");
+    log_message(log, VCSERVICE_LOGLEVEL_INFO, "detail 2");
+    vcservice_log_scope_end(log);
+
+    TEST_EXPECT(!vcservice_log_level_enabled(log, VCSERVICE_LOGLEVEL_DEBUG));
+    TEST_ASSERT(1 == written.size());
+    TEST_EXPECT(written[0] == "NORMAL   accepted\n");
+
+    /* the next scope starts empty. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_scope_begin(log, VCSERVICE_LOGLEVEL_DEBUG));
+    log_message(log, VCSERVICE_LOGLEVEL_ERROR, "failed");
+    vcservice_log_scope_end(log);
+
+    TEST_ASSERT(2 == written.size());
+    TEST_EXPECT(written[1] == "ERROR    failed\n");
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief An error flushes the buffered detail ahead of the error line.
+ */
+TEST(error_flushes_detail)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_scope_begin(log, VCSERVICE_LOGLEVEL_VERBOSE));
+
+    log_message(log, VCSERVICE_LOGLEVEL_VERBOSE, "detail 1");
+    log_message(log, VCSERVICE_LOGLEVEL_DEBUG, "not captured");
+    log_message(log, VCSERVICE_LOGLEVEL_INFO, "detail 2");
+    log_message(log, VCSERVICE_LOGLEVEL_CRITICAL, "failed");
+    log_message(log, VCSERVICE_LOGLEVEL_INFO, "detail 3");
+    vcservice_log_scope_end(log);
+
+    TEST_ASSERT(3 == written.size());
+    TEST_EXPECT(written[0] == "VERBOSE  detail 1\n");
+    TEST_EXPECT(written[1] == "INFO     detail 2\n");
+    TEST_EXPECT(written[2] == "CRITICAL failed\n");
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief When the buffer fills, the oldest detail is dropped and the most
+ * recent is kept, in order.
+ */
+TEST(overflow_keeps_recent)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    char text[32];
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_scope_begin(log, VCSERVICE_LOGLEVEL_DEBUG));
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        snprintf(text, sizeof(text), "detail %d", i);
+        log_message(log, VCSERVICE_LOGLEVEL_DEBUG, text);
+    }
+
+    log_message(log, VCSERVICE_LOGLEVEL_ERROR, "failed");
+    vcservice_log_scope_end(log);
+
+    TEST_ASSERT(written.size() > 100);
+    TEST_EXPECT(written.back() == "ERROR    failed\n");
+    TEST_EXPECT(written[written.size() - 2] == "DEBUG    detail 9999\n");
+
+    /* every kept line is in order. */
+    int first = atoi(written[0].c_str() + strlen("DEBUG    detail "));
+    for (size_t i = 0; i + 1 < written.size(); ++i)
+    {
+        snprintf(text, sizeof(text), "DEBUG    detail %d\n", first + (int)i);
+        TEST_EXPECT(written[i] == text);
+    }
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Nested scopes share the buffer until the outermost scope ends.
+ */
+TEST(nested_scopes)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_scope_begin(log, VCSERVICE_LOGLEVEL_INFO));
+    log_message(log, VCSERVICE_LOGLEVEL_INFO, "outer");
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_scope_begin(log, VCSERVICE_LOGLEVEL_DEBUG));
+    log_message(log, VCSERVICE_LOGLEVEL_DEBUG, "inner");
+    vcservice_log_scope_end(log);
+
+    TEST_EXPECT(0 == written.size());
+    log_message(log, VCSERVICE_LOGLEVEL_ERROR, "failed");
+    vcservice_log_scope_end(log);
+
+    TEST_ASSERT(3 == written.size());
+    TEST_EXPECT(written[0] == "INFO     outer\n");
+    TEST_EXPECT(written[1] == "DEBUG    inner\n");
+    TEST_EXPECT(written[2] == "ERROR    failed\n");
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A message from an enabled call site is written inside a scope,
+ * instead of being buffered and discarded with the scope's detail.
+ */
+TEST(enabled_callsite_is_written)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_NORMAL));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_scope_begin(log, VCSERVICE_LOGLEVEL_DEBUG));
+
+    /* while disabled, the call site's message is buffered as detail. */
+    log_callsite_message(log, "captured");
+    TEST_EXPECT(0 == written.size());
+
+    TEST_ASSERT(
+        1 == vcservice_log_callsite_set_enabled(
+                nullptr, "scope_callsite", 4321, true));
+    log_callsite_message(log, "enabled");
+    TEST_ASSERT(1 == written.size());
+    TEST_EXPECT(written[0] == "DEBUG    enabled\n");
+
+    /* the mark does not carry over to the next message. */
+    log_message(log, VCSERVICE_LOGLEVEL_DEBUG, "detail");
+    vcservice_log_scope_end(log);
+    TEST_EXPECT(1 == written.size());
+
+    TEST_ASSERT(
+        1 == vcservice_log_callsite_set_enabled(
+                nullptr, "scope_callsite", 4321, false));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,232 @@
+/**
+ * \file log/test_vcservice_log_signal_safe.cpp
+ *
+ * Test the async-signal-safe logging path.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <minunit/minunit.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+
+TEST_SUITE(test_vcservice_log_signal_safe);
+
+/**
+ * \brief Read everything currently in the pipe.
+ */
+static std::string read_pipe(int desc)
+{
+    char buffer[4096];
+    ssize_t size = read(desc, buffer, sizeof(buffer));
+
+    return size > 0 ? std::string(buffer, (size_t)size) : std::string();
+}
+
+/**
+ * \brief Check that a line has the shape of a timestamp and level prefix.
+ */
+static bool prefix_matches(const std::string& line, const char* level)
+{
+    const char* shape = "9999-99-99 99:99:99Z ";
+
+    if (line.size() < strlen(shape) + strlen(level))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < strlen(shape); ++i)
+    {
+        if ('9' == shape[i] ? !isdigit(line[i]) : shape[i] != line[i])
+        {
+            return false;
+        }
+    }
+
+    return 0 == line.compare(strlen(shape), strlen(level), level);
+}
+
+/**
+ * \brief The write end of the pipe used by the signal handler.
+ */
+static int handler_desc = -1;
+
+/**
+ * \brief Log from a signal handler.
+ */
+static void handler(int sig)
+{
+    vcservice_log_signal_safe_message msg;
+
+    vcservice_log_signal_safe_start(&msg, VCSERVICE_LOGLEVEL_CRITICAL);
+    vcservice_log_signal_safe_append_string(&msg, "caught signal ");
+    vcservice_log_signal_safe_append_int64(&msg, sig);
+    vcservice_log_signal_safe_write(handler_desc, &msg);
+}
+
+/**
+ * \brief A message is written as one line with a timestamp and level.
+ */
+TEST(write_message)
+{
+    vcservice_log_signal_safe_message msg;
+    int fds[2];
+
+    TEST_ASSERT(0 == pipe(fds));
+
+    vcservice_log_signal_safe_start(&msg, VCSERVICE_LOGLEVEL_NORMAL);
+    vcservice_log_signal_safe_append_string(&msg, "pid ");
+    vcservice_log_signal_safe_append_uint64(&msg, 1234);
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_signal_safe_write(fds[1], &msg));
+
+    std::string line = read_pipe(fds[0]);
+    TEST_EXPECT(prefix_matches(line, "NORMAL   "));
+    TEST_EXPECT(line.substr(line.size() - 9) == "pid 1234\n");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * \brief Integers are formatted across their full range.
+ */
+TEST(integer_limits)
+{
+    vcservice_log_signal_safe_message msg;
+    int fds[2];
+
+    TEST_ASSERT(0 == pipe(fds));
+
+    vcservice_log_signal_safe_start(&msg, VCSERVICE_LOGLEVEL_DEBUG);
+    vcservice_log_signal_safe_append_int64(&msg, INT64_MIN);
+    vcservice_log_signal_safe_append_string(&msg, " ");
+    vcservice_log_signal_safe_append_int64(&msg, INT64_MAX);
+    vcservice_log_signal_safe_append_string(&msg, " ");
+    vcservice_log_signal_safe_append_uint64(&msg, UINT64_MAX);
+    vcservice_log_signal_safe_append_string(&msg, " ");
+    vcservice_log_signal_safe_append_uint64(&msg, 0);
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_signal_safe_write(fds[1], &msg));
+
+    std::string line = read_pipe(fds[0]);
+    TEST_EXPECT(prefix_matches(line, "DEBUG    "));
+    TEST_EXPECT(
+        line.substr(30)
+            == "-9223372036854775808 9223372036854775807 "
+               "18446744073709551615 0\n");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * \brief A long message is truncated but still ends with a newline.
+ */
+TEST(truncate_long_message)
+{
+    vcservice_log_signal_safe_message msg;
+    std::string text(2 * VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE, 'x');
+    int fds[2];
+
+    TEST_ASSERT(0 == pipe(fds));
+
+    vcservice_log_signal_safe_start(&msg, 99);
+    vcservice_log_signal_safe_append_string(&msg, text.c_str());
+    vcservice_log_signal_safe_append_uint64(&msg, 42);
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_signal_safe_write(fds[1], &msg));
+
+    std::string line = read_pipe(fds[0]);
+    TEST_EXPECT(VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE == line.size());
+    TEST_EXPECT(prefix_matches(line, "UNKNOWN  "));
+    TEST_EXPECT('\n' == line[line.size() - 1]);
+    TEST_EXPECT('x' == line[line.size() - 2]);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * \brief Writing a full message twice writes the same line twice, with one
+ * newline each.
+ */
+TEST(write_twice)
+{
+    vcservice_log_signal_safe_message msg;
+    std::string text(VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE, 'x');
+    int fds[2];
+
+    TEST_ASSERT(0 == pipe(fds));
+
+    vcservice_log_signal_safe_start(&msg, VCSERVICE_LOGLEVEL_ERROR);
+    vcservice_log_signal_safe_append_string(&msg, text.c_str());
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_signal_safe_write(fds[1], &msg));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_log_signal_safe_write(fds[1], &msg));
+    TEST_EXPECT(VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE == msg.size);
+
+    std::string lines = read_pipe(fds[0]);
+    TEST_ASSERT(2 * VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE == lines.size());
+    TEST_EXPECT(
+        0 == lines.compare(
+                0, VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE,
+                lines, VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE,
+                VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE));
+    TEST_EXPECT('\n' == lines[VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE - 1]);
+    TEST_EXPECT('x' == lines[VCSERVICE_LOG_SIGNAL_SAFE_MESSAGE_SIZE - 2]);
+    TEST_EXPECT('\n' == lines[lines.size() - 1]);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+/**
+ * \brief errno is preserved, and a failed write is reported.
+ */
+TEST(write_preserves_errno)
+{
+    vcservice_log_signal_safe_message msg;
+
+    vcservice_log_signal_safe_start(&msg, VCSERVICE_LOGLEVEL_ERROR);
+    errno = ERANGE;
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_SIGNAL_SAFE_WRITE
+            == vcservice_log_signal_safe_write(-1, &msg));
+    TEST_EXPECT(ERANGE == errno);
+}
+
+/**
+ * \brief A message can be logged from inside a signal handler.
+ */
+TEST(log_from_signal_handler)
+{
+    struct sigaction action, old_action;
+    int fds[2];
+
+    TEST_ASSERT(0 == pipe(fds));
+    handler_desc = fds[1];
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = &handler;
+    sigemptyset(&action.sa_mask);
+    TEST_ASSERT(0 == sigaction(SIGUSR1, &action, &old_action));
+    TEST_ASSERT(0 == raise(SIGUSR1));
+    TEST_ASSERT(0 == sigaction(SIGUSR1, &old_action, NULL));
+
+    std::string line = read_pipe(fds[0]);
+    std::string expected = "caught signal " + std::to_string(SIGUSR1) + "\n";
+    TEST_EXPECT(prefix_matches(line, "CRITICAL "));
+    TEST_EXPECT(line.substr(30) == expected);
+
+    close(fds[0]);
+    close(fds[1]);
+}
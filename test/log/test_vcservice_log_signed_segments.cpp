@@ -0,0 +1,274 @@
+/**
+ * \file log/test_vcservice_log_signed_segments.cpp
+ *
+ * Test the signed segment log sink and its verifier.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <fcntl.h>
+#include <minunit/minunit.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vccrypt/suite.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+#include <vpr/allocator/malloc_allocator.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_signed_segments);
+
+/**
+ * \brief A signing keypair for the default crypto suite.
+ */
+struct test_keypair
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_digital_signature_context_t sign;
+    vccrypt_buffer_t private_key;
+    vccrypt_buffer_t public_key;
+
+    test_keypair()
+    {
+        malloc_allocator_options_init(&alloc_opts);
+        vccrypt_suite_register_velo_v1();
+        vccrypt_suite_options_init(
+            &suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1);
+        vccrypt_suite_digital_signature_init(&suite, &sign);
+        vccrypt_suite_buffer_init_for_signature_private_key(
+            &suite, &private_key);
+        vccrypt_suite_buffer_init_for_signature_public_key(
+            &suite, &public_key);
+        vccrypt_digital_signature_keypair_create(
+            &sign, &private_key, &public_key);
+    }
+
+    ~test_keypair()
+    {
+        dispose((disposable_t*)&public_key);
+        dispose((disposable_t*)&private_key);
+        dispose((disposable_t*)&sign);
+        dispose((disposable_t*)&suite);
+        dispose((disposable_t*)&alloc_opts);
+    }
+};
+
+/**
+ * \brief Log the given number of messages to signed segments with the given
+ * prefix.
+ */
+static bool write_segments(
+    rcpr_allocator* alloc, const char* prefix, const test_keypair& keys,
+    int records)
+{
+    vcservice_log* log;
+
+    if (STATUS_SUCCESS
+            != vcservice_log_create_signed_segments(
+                    &log, alloc, prefix, 256, keys.private_key.data,
+                    keys.private_key.size, VCSERVICE_LOGLEVEL_DEBUG))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < records; ++i)
+    {
+        vcservice_log_message_start(log);
+        vcservice_log_append_string(log, "segment record ");
+        vcservice_log_append_int32(log, i);
+        vcservice_log_message_commit(log);
+    }
+
+    return
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log));
+}
+
+/**
+ * \brief Verify the numbered segment, returning the verification status.
+ */
+static status verify_segment(
+    const char* prefix, int number, const vccrypt_buffer_t& public_key,
+    uint64_t* index, size_t* size)
+{
+    char name[256];
+
+    snprintf(name, sizeof(name), "%s.%08d", prefix, number);
+    int desc = open(name, O_RDONLY);
+    if (desc < 0)
+    {
+        return -1;
+    }
+
+    status retval =
+        vcservice_log_segment_verify(
+            index, size, desc, public_key.data, public_key.size);
+    close(desc);
+
+    return retval;
+}
+
+/**
+ * \brief Count the lines in the contents of the numbered segment.
+ */
+static size_t count_lines(const char* prefix, int number, size_t size)
+{
+    char name[256];
+    char contents[512];
+    size_t lines = 0;
+
+    snprintf(name, sizeof(name), "%s.%08d", prefix, number);
+    int desc = open(name, O_RDONLY);
+    if (desc < 0)
+    {
+        return 0;
+    }
+
+    ssize_t read_size = pread(desc, contents, sizeof(contents), 0);
+    close(desc);
+
+    for (ssize_t i = 0; i < read_size && (size_t)i < size; ++i)
+    {
+        if ('\n' == contents[i])
+        {
+            ++lines;
+        }
+    }
+
+    return lines;
+}
+
+/**
+ * \brief Remove the numbered segments and the directory holding them.
+ */
+static void remove_segments(const char* dir, const char* prefix)
+{
+    char name[256];
+
+    for (int i = 0; ; ++i)
+    {
+        snprintf(name, sizeof(name), "%s.%08d", prefix, i);
+        if (0 != unlink(name))
+        {
+            break;
+        }
+    }
+
+    rmdir(dir);
+}
+
+/**
+ * \brief Messages are split into signed segments no larger than the segment
+ * size, each of which verifies with its own index.
+ */
+TEST(write_and_verify)
+{
+    rcpr_allocator* alloc;
+    test_keypair keys;
+    char dir[] = "/tmp/test_vcservice_log_segments_XXXXXX";
+    char prefix[128];
+    uint64_t index;
+    size_t size, lines = 0;
+    int count = 0;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(NULL != mkdtemp(dir));
+    snprintf(prefix, sizeof(prefix), "%s/audit", dir);
+
+    TEST_ASSERT(write_segments(alloc, prefix, keys, 100));
+
+    while (
+        STATUS_SUCCESS
+            == verify_segment(prefix, count, keys.public_key, &index, &size))
+    {
+        TEST_EXPECT((uint64_t)count == index);
+        TEST_EXPECT(size <= 256);
+        lines += count_lines(prefix, count, size);
+        ++count;
+    }
+
+    /* every record landed in exactly one segment. */
+    TEST_EXPECT(count > 1);
+    TEST_EXPECT(100 == lines);
+
+    remove_segments(dir, prefix);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Tampered segments, and the wrong key, fail verification.
+ */
+TEST(tampered_segment)
+{
+    rcpr_allocator* alloc;
+    test_keypair keys, other_keys;
+    char dir[] = "/tmp/test_vcservice_log_segments_XXXXXX";
+    char prefix[128];
+    char name[256];
+    uint64_t index;
+    size_t size;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(NULL != mkdtemp(dir));
+    snprintf(prefix, sizeof(prefix), "%s/audit", dir);
+
+    TEST_ASSERT(write_segments(alloc, prefix, keys, 30));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == verify_segment(prefix, 1, keys.public_key, &index, &size));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_SEGMENT_BAD_SIGNATURE
+            == verify_segment(
+                    prefix, 1, other_keys.public_key, &index, &size));
+
+    /* change one byte of the second segment. */
+    snprintf(name, sizeof(name), "%s.%08d", prefix, 1);
+    int desc = open(name, O_RDWR);
+    TEST_ASSERT(desc >= 0);
+    TEST_ASSERT(1 == pwrite(desc, "X", 1, 3));
+    close(desc);
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_SEGMENT_BAD_SIGNATURE
+            == verify_segment(prefix, 1, keys.public_key, &index, &size));
+
+    /* renaming a segment does not change the index it was signed with. */
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == verify_segment(prefix, 0, keys.public_key, &index, &size));
+    TEST_EXPECT(0 == index);
+
+    remove_segments(dir, prefix);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A key of the wrong size is rejected.
+ */
+TEST(invalid_key)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    uint8_t key[7] = { 0 };
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_SEGMENT_INVALID_KEY
+            == vcservice_log_create_signed_segments(
+                    &log, alloc, "/tmp/unused", 0, key, sizeof(key),
+                    VCSERVICE_LOGLEVEL_DEBUG));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
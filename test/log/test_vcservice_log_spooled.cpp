@@ -0,0 +1,360 @@
+/**
+ * \file log/test_vcservice_log_spooled.cpp
+ *
+ * Test the store-and-forward spool sink.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(test_vcservice_log_spooled);
+
+/**
+ * \brief A temporary directory holding the collector socket and the spool.
+ */
+struct spool_paths
+{
+    char dir[64];
+    std::string socket_path;
+    std::string spool_path;
+
+    spool_paths()
+    {
+        strcpy(dir, "/tmp/test_vcservice_log_spool_XXXXXX");
+        if (NULL == mkdtemp(dir))
+        {
+            dir[0] = 0;
+        }
+
+        socket_path = std::string(dir) + "/collector";
+        spool_path = std::string(dir) + "/spool";
+    }
+
+    ~spool_paths()
+    {
+        unlink(socket_path.c_str());
+        unlink(spool_path.c_str());
+        rmdir(dir);
+    }
+};
+
+/**
+ * \brief Start listening on the given path, returning the listen socket.
+ */
+static int listen_on(const std::string& path)
+{
+    struct sockaddr_un addr;
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0)
+    {
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path.c_str());
+    if (0 != bind(sock, (struct sockaddr*)&addr, sizeof(addr))
+     || 0 != listen(sock, 4))
+    {
+        close(sock);
+        return -1;
+    }
+
+    return sock;
+}
+
+/**
+ * \brief Accept one connection and read it to the end.
+ */
+static std::string collect(int listen_sock)
+{
+    std::string out;
+    char buffer[4096];
+    ssize_t size;
+
+    int sock = accept(listen_sock, NULL, NULL);
+    if (sock < 0)
+    {
+        return out;
+    }
+
+    while ((size = read(sock, buffer, sizeof(buffer))) > 0)
+    {
+        out.append(buffer, (size_t)size);
+    }
+
+    close(sock);
+
+    return out;
+}
+
+/**
+ * \brief Log the messages "message <first>" through "message <last - 1>".
+ */
+static void log_messages(vcservice_log* log, int first, int last)
+{
+    for (int i = first; i < last; ++i)
+    {
+        vcservice_log_message_start(log);
+        vcservice_log_append_string(log, "message ");
+        vcservice_log_append_int32(log, i);
+        vcservice_log_message_commit(log);
+    }
+}
+
+/**
+ * \brief Check that the collected output holds exactly the messages "message
+ * 0" through "message <count - 1>", in order.
+ */
+static bool messages_in_order(const std::string& out, int count)
+{
+    size_t offset = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        size_t end = out.find('\n', offset);
+        if (std::string::npos == end)
+        {
+            return false;
+        }
+
+        std::string expected = "message " + std::to_string(i);
+        std::string line = out.substr(offset, end - offset);
+        if (line.size() < expected.size()
+         || 0 != line.compare(
+                    line.size() - expected.size(), expected.size(), expected))
+        {
+            return false;
+        }
+
+        offset = end + 1;
+    }
+
+    return offset == out.size();
+}
+
+/**
+ * \brief Get the size of the given file, or -1 if it does not exist.
+ */
+static off_t file_size(const std::string& path)
+{
+    struct stat st;
+
+    if (0 != stat(path.c_str(), &st))
+    {
+        return -1;
+    }
+
+    return st.st_size;
+}
+
+/**
+ * \brief While the collector is up, messages go straight to it.
+ */
+TEST(collector_up)
+{
+    rcpr_allocator* alloc = nullptr;
+    vcservice_log* log = nullptr;
+    spool_paths paths;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int listen_sock = listen_on(paths.socket_path);
+    TEST_ASSERT(listen_sock >= 0);
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_spooled(
+                    &log, alloc, paths.socket_path.c_str(),
+                    paths.spool_path.c_str(), 0, VCSERVICE_LOGLEVEL_DEBUG));
+
+    log_messages(log, 0, 10);
+    TEST_EXPECT(0 == file_size(paths.spool_path));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(messages_in_order(collect(listen_sock), 10));
+
+    close(listen_sock);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Messages logged while the collector is down are replayed in order
+ * once it comes back, ahead of newer messages.
+ */
+TEST(collector_down_then_up)
+{
+    rcpr_allocator* alloc = nullptr;
+    vcservice_log* log = nullptr;
+    spool_paths paths;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_spooled(
+                    &log, alloc, paths.socket_path.c_str(),
+                    paths.spool_path.c_str(), 0, VCSERVICE_LOGLEVEL_DEBUG));
+
+    log_messages(log, 0, 10);
+
+    int listen_sock = listen_on(paths.socket_path);
+    TEST_ASSERT(listen_sock >= 0);
+
+    log_messages(log, 10, 20);
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(messages_in_order(collect(listen_sock), 20));
+    TEST_EXPECT(0 == file_size(paths.spool_path));
+
+    close(listen_sock);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A spool left behind by an earlier logger is replayed by the next.
+ */
+TEST(spool_survives_restart)
+{
+    rcpr_allocator* alloc = nullptr;
+    vcservice_log* log = nullptr;
+    spool_paths paths;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_spooled(
+                    &log, alloc, paths.socket_path.c_str(),
+                    paths.spool_path.c_str(), 0, VCSERVICE_LOGLEVEL_DEBUG));
+    log_messages(log, 0, 5);
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(file_size(paths.spool_path) > 0);
+
+    int listen_sock = listen_on(paths.socket_path);
+    TEST_ASSERT(listen_sock >= 0);
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_spooled(
+                    &log, alloc, paths.socket_path.c_str(),
+                    paths.spool_path.c_str(), 0, VCSERVICE_LOGLEVEL_DEBUG));
+    log_messages(log, 5, 8);
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(messages_in_order(collect(listen_sock), 8));
+    TEST_EXPECT(0 == file_size(paths.spool_path));
+
+    close(listen_sock);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Only one logger may use a spool at a time.
+ */
+TEST(spool_in_use)
+{
+    rcpr_allocator* alloc = nullptr;
+    vcservice_log* log = nullptr;
+    vcservice_log* second = nullptr;
+    spool_paths paths;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_spooled(
+                    &log, alloc, paths.socket_path.c_str(),
+                    paths.spool_path.c_str(), 0, VCSERVICE_LOGLEVEL_DEBUG));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_SPOOL_OPEN
+            == vcservice_log_create_spooled(
+                    &second, alloc, paths.socket_path.c_str(),
+                    paths.spool_path.c_str(), 0, VCSERVICE_LOGLEVEL_DEBUG));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The spool does not grow past its limit, and dropped messages are
+ * reported on release.
+ */
+TEST(spool_limit)
+{
+    rcpr_allocator* alloc = nullptr;
+    vcservice_log* log = nullptr;
+    spool_paths paths;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_spooled(
+                    &log, alloc, paths.socket_path.c_str(),
+                    paths.spool_path.c_str(), 256,
+                    VCSERVICE_LOGLEVEL_DEBUG));
+    log_messages(log, 0, 100);
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_SPOOL_WRITE
+            == resource_release(vcservice_log_resource_handle(log)));
+    TEST_EXPECT(file_size(paths.spool_path) <= 256);
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A socket path that does not fit in a Unix socket address is
+ * rejected.
+ */
+TEST(invalid_socket_path)
+{
+    rcpr_allocator* alloc = nullptr;
+    vcservice_log* log = nullptr;
+    std::string socket_path(200, 'x');
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_LOG_SPOOL_INVALID_PATH
+            == vcservice_log_create_spooled(
+                    &log, alloc, socket_path.c_str(), "/tmp/unused", 0,
+                    VCSERVICE_LOGLEVEL_DEBUG));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,116 @@
+/**
+ * \file log/test_vcservice_log_trace_context.cpp
+ *
+ * Test the per-thread trace context.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <string.h>
+#include <thread>
+
+#include "log_capture.h"
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+RCPR_IMPORT_uuid;
+
+TEST_SUITE(test_vcservice_log_trace_context);
+
+/**
+ * \brief The rendered text holds the trace id and the span id.
+ */
+TEST(init)
+{
+    rcpr_uuid trace_id;
+    vcservice_log_trace_context ctx;
+    const char* expected =
+        "trace=b8e4e3a2-7c1f-4b7e-9d2c-0a1b2c3d4e5f span=00000000deadbeef ";
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == rcpr_uuid_parse_string(
+                    &trace_id, "b8e4e3a2-7c1f-4b7e-9d2c-0a1b2c3d4e5f"));
+
+    vcservice_log_trace_context_init(&ctx, &trace_id, 0xdeadbeef);
+
+    TEST_ASSERT(strlen(expected) == sizeof(ctx.text));
+    TEST_EXPECT(0 == memcmp(expected, ctx.text, sizeof(ctx.text)));
+    TEST_EXPECT(0xdeadbeef == ctx.span_id);
+}
+
+/**
+ * \brief Messages started while a context is current carry its text after
+ * the date, and swapping returns the previous context.
+ */
+TEST(message_start)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    rcpr_uuid trace_id;
+    vcservice_log_trace_context ctx;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_INFO));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == rcpr_uuid_parse_string(
+                    &trace_id, "00112233-4455-6677-8899-aabbccddeeff"));
+    vcservice_log_trace_context_init(&ctx, &trace_id, 7);
+
+    /* no context by default. */
+    TEST_EXPECT(NULL == vcservice_log_trace_context_current());
+    vcservice_log_message_start(log);
+    TEST_EXPECT(20 == log->log_idx);
+
+    /* the context follows the date. */
+    TEST_EXPECT(NULL == vcservice_log_trace_context_swap(&ctx));
+    TEST_EXPECT(&ctx == vcservice_log_trace_context_current());
+    vcservice_log_message_start(log);
+    TEST_ASSERT(20 + sizeof(ctx.text) == log->log_idx);
+    TEST_EXPECT(0 == memcmp(ctx.text, log->log_message + 20, sizeof(ctx.text)));
+
+    /* another thread has its own current context. */
+    vcservice_log_trace_context* other = &ctx;
+    std::thread t([&]() { other = vcservice_log_trace_context_current(); });
+    t.join();
+    TEST_EXPECT(NULL == other);
+
+    /* swapping out restores the previous context. */
+    TEST_EXPECT(&ctx == vcservice_log_trace_context_swap(NULL));
+    vcservice_log_message_start(log);
+    TEST_EXPECT(20 == log->log_idx);
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief UUIDs are appended in their canonical text form.
+ */
+TEST(append_uuid)
+{
+    rcpr_allocator* alloc;
+    vcservice_log* log;
+    rcpr_uuid id;
+    const char* text = "0f1e2d3c-4b5a-6978-8796-a5b4c3d2e1f0";
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(create_log(alloc, &log, VCSERVICE_LOGLEVEL_INFO));
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_uuid_parse_string(&id, text));
+
+    vcservice_log_message_start(log);
+    vcservice_log_append_uuid(log, &id);
+    TEST_ASSERT(20 + strlen(text) == log->log_idx);
+    TEST_EXPECT(0 == memcmp(text, log->log_message + 20, strlen(text)));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,306 @@
+/**
+ * \file metrics/test_vcservice_metrics.cpp
+ *
+ * Test the vcservice_metrics methods.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/metrics.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcservice_metrics);
+
+#define THREAD_COUNT 4
+#define ADD_COUNT 100000
+
+/**
+ * \brief Build a socket path unique to this process.
+ */
+static std::string socket_path()
+{
+    return
+        std::string("/tmp/test_vcservice_metrics_")
+            + std::to_string(getpid()) + ".sock";
+}
+
+/**
+ * \brief Scrape the exporter at the given path, returning the whole
+ * response.
+ */
+static std::string scrape(const std::string& path)
+{
+    std::string out;
+    struct sockaddr_un addr;
+    char buffer[4096];
+    ssize_t size;
+
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0)
+    {
+        return out;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path.c_str());
+
+    const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    if (0 == connect(sock, (struct sockaddr*)&addr, sizeof(addr))
+     && (ssize_t)strlen(request) == write(sock, request, strlen(request)))
+    {
+        while ((size = read(sock, buffer, sizeof(buffer))) > 0)
+        {
+            out.append(buffer, (size_t)size);
+        }
+    }
+
+    close(sock);
+
+    return out;
+}
+
+/**
+ * \brief Add to a counter from several threads at once.
+ */
+static void* add_thread(void* context)
+{
+    vcservice_metrics_counter* counter = (vcservice_metrics_counter*)context;
+
+    for (int i = 0; i < ADD_COUNT; ++i)
+    {
+        vcservice_metrics_counter_add(counter, 1);
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Names are checked, and a name and labels can only be registered
+ * once.
+ */
+TEST(register_checks)
+{
+    rcpr_allocator* alloc;
+    vcservice_metrics_registry* registry;
+    vcservice_metrics_counter* counter;
+    vcservice_metrics_gauge* gauge;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_metrics_registry_create(&registry, alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_METRICS_INVALID_PARAMETER
+            == vcservice_metrics_counter_register(
+                    &counter, registry, "1st_requests", NULL, "Requests."));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_METRICS_INVALID_PARAMETER
+            == vcservice_metrics_counter_register(
+                    &counter, registry, "requests-total", NULL, "Requests."));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_METRICS_INVALID_PARAMETER
+            == vcservice_metrics_counter_register(
+                    &counter, registry, "requests_total", NULL, "Two\nlines"));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_counter_register(
+                    &counter, registry, "requests_total", "route=\"pay\"",
+                    "Requests."));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_METRICS_DUPLICATE
+            == vcservice_metrics_counter_register(
+                    &counter, registry, "requests_total", "route=\"pay\"",
+                    "Requests."));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == vcservice_metrics_counter_register(
+                    &counter, registry, "requests_total", "route=\"refund\"",
+                    "Requests."));
+
+    /* a name has one type. */
+    TEST_EXPECT(
+        VCSERVICE_ERROR_METRICS_INVALID_PARAMETER
+            == vcservice_metrics_gauge_register(
+                    &gauge, registry, "requests_total", NULL, "Requests."));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_metrics_registry_resource_handle(registry)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief No count is lost when several threads add at once, and gauges go
+ * both ways.
+ */
+TEST(values)
+{
+    rcpr_allocator* alloc;
+    vcservice_metrics_registry* registry;
+    vcservice_metrics_counter* counter;
+    vcservice_metrics_gauge* gauge;
+    pthread_t threads[THREAD_COUNT];
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_metrics_registry_create(&registry, alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_counter_register(
+                    &counter, registry, "requests_total", NULL, "Requests."));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_gauge_register(
+                    &gauge, registry, "connections", NULL, "Connections."));
+
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        TEST_ASSERT(
+            0 == pthread_create(&threads[i], NULL, &add_thread, counter));
+    }
+
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    TEST_EXPECT(
+        THREAD_COUNT * ADD_COUNT == vcservice_metrics_counter_value(counter));
+
+    vcservice_metrics_gauge_set(gauge, 5);
+    vcservice_metrics_gauge_add(gauge, -7);
+    TEST_EXPECT(-2 == vcservice_metrics_gauge_value(gauge));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_metrics_registry_resource_handle(registry)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The exporter serves every metric in the Prometheus text format.
+ */
+TEST(exporter)
+{
+    rcpr_allocator* alloc;
+    vcservice_metrics_registry* registry;
+    vcservice_metrics_exporter* exporter;
+    vcservice_metrics_counter* pay;
+    vcservice_metrics_counter* refund;
+    vcservice_metrics_gauge* gauge;
+    vcservice_histogram* histogram;
+    std::string path = socket_path();
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_metrics_registry_create(&registry, alloc));
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_histogram_create(&histogram, alloc));
+
+    /* the families stay together whatever the registration order. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_counter_register(
+                    &pay, registry, "requests_total", "route=\"pay\"",
+                    "Requests served."));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_gauge_register(
+                    &gauge, registry, "connections", NULL, "Connections."));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_counter_register(
+                    &refund, registry, "requests_total", "route=\"refund\"",
+                    "Requests served."));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_histogram_register(
+                    registry, histogram, "latency_ns", NULL,
+                    "Request latency."));
+
+    vcservice_metrics_counter_add(pay, 3);
+    vcservice_metrics_counter_add(refund, 1);
+    vcservice_metrics_gauge_set(gauge, -4);
+    for (uint64_t i = 1; i <= 100; ++i)
+    {
+        vcservice_histogram_record(histogram, i);
+    }
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_metrics_exporter_create(
+                    &exporter, alloc, registry, path.c_str()));
+
+    std::string response = scrape(path);
+    std::string expected =
+        "# HELP requests_total Requests served.\n"
+        "# TYPE requests_total counter\n"
+        "requests_total{route=\"pay\"} 3\n"
+        "requests_total{route=\"refund\"} 1\n"
+        "# HELP connections Connections.\n"
+        "# TYPE connections gauge\n"
+        "connections -4\n"
+        "# HELP latency_ns Request latency.\n"
+        "# TYPE latency_ns summary\n"
+        "latency_ns{quantile=\"0.5\"} 50\n"
+        "latency_ns{quantile=\"0.9\"} 90\n"
+        "latency_ns{quantile=\"0.99\"} 99\n"
+        "latency_ns{quantile=\"0.999\"} 100\n"
+        "latency_ns_sum 5050\n"
+        "latency_ns_count 100\n";
+
+    TEST_EXPECT(0 == response.find("HTTP/1.0 200 OK\r\n"));
+    TEST_EXPECT(
+        std::string::npos
+            != response.find(
+                    "Content-Length: " + std::to_string(expected.size())));
+    TEST_EXPECT(
+        response.size() > expected.size()
+     && 0 == response.compare(
+                response.size() - expected.size(), expected.size(),
+                expected));
+
+    /* a second scrape sees new values. */
+    vcservice_metrics_counter_add(pay, 1);
+    TEST_EXPECT(
+        std::string::npos
+            != scrape(path).find("requests_total{route=\"pay\"} 4\n"));
+
+    /* releasing the exporter removes its socket. */
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_metrics_exporter_resource_handle(exporter)));
+    TEST_EXPECT(0 != access(path.c_str(), F_OK));
+
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_metrics_registry_resource_handle(registry)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(
+                    vcservice_histogram_resource_handle(histogram)));
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,198 @@
+/**
+ * \file path/test_path_batch.cpp
+ *
+ * Test the batch path methods.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <cstring>
+#include <string>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+#include <vector>
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(path_batch);
+
+/**
+ * \brief Build a set of paths covering the interesting cases.
+ */
+static vector<string> sample_paths(size_t count)
+{
+    static const char* samples[] = {
+        "", "/", "//", "a", "a/", "/a", "/a/b", "a/b/c", "a//b///c",
+        "/usr/./local/../bin/", "../x/..", "//usr//lib//", ".", "..",
+    };
+    size_t sample_count = sizeof(samples) / sizeof(samples[0]);
+    vector<string> paths;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        string path = samples[i % sample_count];
+        if (i >= sample_count)
+        {
+            path += "/" + to_string(i);
+        }
+
+        paths.push_back(path);
+    }
+
+    return paths;
+}
+
+/**
+ * \brief Get pointers to a set of strings.
+ */
+static vector<const char*> pointers(const vector<string>& strings)
+{
+    vector<const char*> out;
+
+    for (const auto& s : strings)
+    {
+        out.push_back(s.c_str());
+    }
+
+    return out;
+}
+
+/**
+ * \brief Verify that the batch methods check their parameters.
+ */
+TEST(parameter_checks)
+{
+    rcpr_allocator* alloc = nullptr;
+    path_batch* batch = nullptr;
+    const char* paths[] = { "/a", nullptr };
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_dirname_batch(nullptr, alloc, paths, 1, 1));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_dirname_batch(&batch, nullptr, paths, 1, 1));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_normalize_batch(&batch, alloc, paths, 2, 1));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_join_batch(&batch, alloc, paths, nullptr, 1, 1));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Batch results match the single path methods, with and without
+ * threads.
+ */
+TEST(matches_single_path_methods)
+{
+    rcpr_allocator* alloc = nullptr;
+    vector<string> paths = sample_paths(20000);
+    vector<string> names = sample_paths(20001);
+    vector<const char*> path_ptrs = pointers(paths);
+    vector<const char*> name_ptrs = pointers(names);
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    for (unsigned int threads : { 1U, 4U })
+    {
+        path_batch* dirnames = nullptr;
+        path_batch* normalized = nullptr;
+        path_batch* joined = nullptr;
+        size_t mismatches = 0;
+
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == path_dirname_batch(
+                        &dirnames, alloc, path_ptrs.data(), paths.size(),
+                        threads));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == path_normalize_batch(
+                        &normalized, alloc, path_ptrs.data(), paths.size(),
+                        threads));
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == path_join_batch(
+                        &joined, alloc, path_ptrs.data(),
+                        name_ptrs.data() + 1, paths.size(), threads));
+        TEST_ASSERT(paths.size() == dirnames->count);
+
+        for (size_t i = 0; i < paths.size(); ++i)
+        {
+            char* single;
+
+            TEST_ASSERT(
+                STATUS_SUCCESS == path_dirname(&single, alloc, path_ptrs[i]));
+            mismatches += strcmp(single, path_batch_get(dirnames, i)) != 0;
+            mismatches += strlen(single) != dirnames->lengths[i];
+            TEST_ASSERT(
+                STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, single));
+
+            TEST_ASSERT(
+                STATUS_SUCCESS
+                    == path_normalize(&single, alloc, path_ptrs[i]));
+            mismatches += strcmp(single, path_batch_get(normalized, i)) != 0;
+            mismatches += strlen(single) != normalized->lengths[i];
+            TEST_ASSERT(
+                STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, single));
+
+            TEST_ASSERT(
+                STATUS_SUCCESS
+                    == path_join(
+                            &single, alloc, path_ptrs[i], name_ptrs[i + 1],
+                            NULL));
+            mismatches += strcmp(single, path_batch_get(joined, i)) != 0;
+            mismatches += strlen(single) != joined->lengths[i];
+            TEST_ASSERT(
+                STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, single));
+        }
+
+        TEST_EXPECT(0U == mismatches);
+
+        TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, dirnames));
+        TEST_ASSERT(
+            STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, normalized));
+        TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, joined));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief An empty batch has no results.
+ */
+TEST(empty)
+{
+    rcpr_allocator* alloc = nullptr;
+    path_batch* batch = nullptr;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == path_dirname_batch(&batch, alloc, nullptr, 0, 4));
+    TEST_EXPECT(0U == batch->count);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, batch));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -242,3 +242,43 @@ TEST(explicit_curdir)
         STATUS_SUCCESS
             == resource_release(rcpr_allocator_resource_handle(alloc)));
 }
+
+/**
+ * \brief Repeated and trailing separators are handled as before.
+ */
+TEST(repeated_and_trailing_separators)
+{
+    rcpr_allocator* alloc = nullptr;
+    const char* cases[][2] = {
+        { "build//host///foo.txt", "build/host" },
+        { "//build/host/foo.txt", "/build/host" },
+        { "/build/host/", "/build" },
+        { "build/host//", "build" },
+        { "/foo.txt", "." },
+        { "/", "." },
+        { "//", "." },
+        { "foo/", "." },
+    };
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    for (auto& test_case : cases)
+    {
+        char* dirname = nullptr;
+
+        /* calling path_dirname should succeed. */
+        TEST_ASSERT(
+            STATUS_SUCCESS == path_dirname(&dirname, alloc, test_case[0]));
+
+        /* the dirname string matches the expected directory. */
+        TEST_EXPECT(0 == strcmp(test_case[1], dirname));
+
+        TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, dirname));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
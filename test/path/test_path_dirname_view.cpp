@@ -0,0 +1,65 @@
+/**
+ * \file path/test_path_dirname_view.cpp
+ *
+ * Test the path_dirname_view method.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <string>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+using namespace std;
+
+TEST_SUITE(path_dirname_view);
+
+/**
+ * \brief Verify that path_dirname_view checks its parameters.
+ */
+TEST(parameter_checks)
+{
+    size_t offset, length;
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_dirname_view(nullptr, &length, "foo"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_dirname_view(&offset, nullptr, "foo"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_dirname_view(&offset, &length, nullptr));
+}
+
+/**
+ * \brief The view is a span of the caller's string.
+ */
+TEST(spans)
+{
+    const char* cases[][2] = {
+        { "", "" },
+        { "foo.txt", "" },
+        { "./foo.txt", "." },
+        { "build/foo.txt", "build" },
+        { "/build/host/foo.txt", "/build/host" },
+        { "///build/host/foo.txt", "/build/host" },
+        { "build//host///foo.txt", "build//host" },
+        { "/build/host//", "/build" },
+        { "/foo.txt", "" },
+        { "/", "" },
+    };
+
+    for (auto& test_case : cases)
+    {
+        size_t offset = 99, length = 99;
+        string filename(test_case[0]);
+
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == path_dirname_view(&offset, &length, filename.c_str()));
+        TEST_ASSERT(offset + length <= filename.size());
+        TEST_EXPECT(test_case[1] == filename.substr(offset, length));
+    }
+}
@@ -0,0 +1,219 @@
+/**
+ * \file path/test_path_intern.cpp
+ *
+ * Test the path_intern_table methods.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <cstring>
+#include <pthread.h>
+#include <string>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+#include "../../src/path/path_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(path_intern);
+
+#define THREAD_COUNT 4
+#define PATH_COUNT 500
+
+/**
+ * \brief Arguments for the concurrent interning test.
+ */
+struct intern_thread
+{
+    path_intern_table* table;
+    const path_handle* handles[PATH_COUNT];
+    bool ok;
+};
+
+/**
+ * \brief Intern the same set of paths as every other thread.
+ */
+static void* intern_paths(void* arg)
+{
+    intern_thread* ctx = (intern_thread*)arg;
+
+    ctx->ok = true;
+    for (int i = 0; i < PATH_COUNT; ++i)
+    {
+        string path = "/shared/" + to_string(i);
+        if (STATUS_SUCCESS
+                != path_intern(&ctx->handles[i], ctx->table, path.c_str()))
+        {
+            ctx->ok = false;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Interning a path returns a handle with its hash, length, and a copy
+ * of the path.
+ */
+TEST(basics)
+{
+    rcpr_allocator* alloc;
+    path_intern_table* table;
+    const path_handle* handle;
+    char path[] = "/usr/bin";
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the table. */
+    TEST_ASSERT(STATUS_SUCCESS == path_intern_table_create(&table, alloc));
+
+    /* nothing is interned yet. */
+    TEST_EXPECT(NULL == path_intern_lookup(table, path));
+
+    /* intern the path. */
+    TEST_ASSERT(STATUS_SUCCESS == path_intern(&handle, table, path));
+    TEST_EXPECT(path_hash(path, strlen(path)) == handle->hash);
+    TEST_EXPECT(strlen(path) == handle->length);
+    TEST_EXPECT(!strcmp(path, handle->path));
+    TEST_EXPECT(path != handle->path);
+
+    /* the handle does not depend on the caller's string. */
+    path[1] = 'x';
+    TEST_EXPECT(!strcmp("/usr/bin", handle->path));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(path_intern_table_resource_handle(table)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Equal paths share a handle; different paths do not.
+ */
+TEST(equal_paths_share_a_handle)
+{
+    rcpr_allocator* alloc;
+    path_intern_table* table;
+    const path_handle* first;
+    const path_handle* second;
+    const path_handle* other;
+    string copy = "/usr/bin";
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the table. */
+    TEST_ASSERT(STATUS_SUCCESS == path_intern_table_create(&table, alloc));
+
+    TEST_ASSERT(STATUS_SUCCESS == path_intern(&first, table, "/usr/bin"));
+    TEST_ASSERT(STATUS_SUCCESS == path_intern(&second, table, copy.c_str()));
+    TEST_ASSERT(STATUS_SUCCESS == path_intern(&other, table, "/usr/bin/"));
+    TEST_EXPECT(first == second);
+    TEST_EXPECT(first != other);
+    TEST_EXPECT(first == path_intern_lookup(table, "/usr/bin"));
+    TEST_EXPECT(other == path_intern_lookup(table, "/usr/bin/"));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(path_intern_table_resource_handle(table)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Handles stay valid and unique as the table grows.
+ */
+TEST(grow)
+{
+    rcpr_allocator* alloc;
+    path_intern_table* table;
+    const path_handle* handles[1000];
+    const path_handle* handle;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the table. */
+    TEST_ASSERT(STATUS_SUCCESS == path_intern_table_create(&table, alloc));
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        string path = "/var/lib/" + to_string(i);
+        TEST_ASSERT(
+            STATUS_SUCCESS == path_intern(&handles[i], table, path.c_str()));
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        string path = "/var/lib/" + to_string(i);
+        TEST_ASSERT(
+            STATUS_SUCCESS == path_intern(&handle, table, path.c_str()));
+        TEST_EXPECT(handles[i] == handle);
+        TEST_EXPECT(handles[i] == path_intern_lookup(table, path.c_str()));
+        TEST_EXPECT(!strcmp(path.c_str(), handles[i]->path));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(path_intern_table_resource_handle(table)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Threads interning the same paths receive the same handles.
+ */
+TEST(concurrent)
+{
+    rcpr_allocator* alloc;
+    path_intern_table* table;
+    pthread_t threads[THREAD_COUNT];
+    static intern_thread ctx[THREAD_COUNT];
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the table. */
+    TEST_ASSERT(STATUS_SUCCESS == path_intern_table_create(&table, alloc));
+
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        ctx[i].table = table;
+        TEST_ASSERT(
+            0 == pthread_create(&threads[i], NULL, &intern_paths, &ctx[i]));
+    }
+
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        TEST_ASSERT(0 == pthread_join(threads[i], NULL));
+        TEST_EXPECT(ctx[i].ok);
+    }
+
+    for (int i = 1; i < THREAD_COUNT; ++i)
+    {
+        TEST_EXPECT(
+            0 == memcmp(
+                    ctx[0].handles, ctx[i].handles, sizeof(ctx[0].handles)));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(path_intern_table_resource_handle(table)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,128 @@
+/**
+ * \file path/test_path_join.cpp
+ *
+ * Test the path_join and path_join_to_buffer methods.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <cstring>
+#include <string>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(path_join);
+
+/**
+ * \brief Verify that path_join checks its parameters.
+ */
+TEST(parameter_checks)
+{
+    rcpr_allocator* alloc = nullptr;
+    char* out = nullptr;
+    char buffer[16];
+    size_t length;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_join(nullptr, alloc, "a", nullptr));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_join(&out, nullptr, "a", nullptr));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_join_to_buffer(nullptr, 16, &length, "a", nullptr));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_join_to_buffer(buffer, 16, nullptr, "a", nullptr));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Join components with the allocating version.
+ */
+TEST(join)
+{
+    rcpr_allocator* alloc = nullptr;
+    char* out = nullptr;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* simple components are separated. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_join(&out, alloc, "/var", "lib", "vcservice", nullptr));
+    TEST_EXPECT(string("/var/lib/vcservice") == out);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, out));
+
+    /* repeated separators are collapsed, and empty components skipped. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_join(
+                    &out, alloc, "spool/", "", "/", "//data//", "x", nullptr));
+    TEST_EXPECT(string("/data/x") == out);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, out));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_join(&out, alloc, "spool//", "", "in//box/", nullptr));
+    TEST_EXPECT(string("spool/in/box/") == out);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, out));
+
+    /* an absolute component resets the path. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_join(
+                    &out, alloc, "a", "b", "/run", "vcservice.sock", nullptr));
+    TEST_EXPECT(string("/run/vcservice.sock") == out);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, out));
+
+    /* no components give an empty path. */
+    TEST_ASSERT(STATUS_SUCCESS == path_join(&out, alloc, "", nullptr));
+    TEST_EXPECT(string("") == out);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, out));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Join components into a buffer.
+ */
+TEST(join_to_buffer)
+{
+    char buffer[12];
+    size_t length;
+
+    /* the result fits exactly. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_join_to_buffer(
+                    buffer, sizeof(buffer), &length, "a//b", "cd",
+                    "/tmp", "x.sock", nullptr));
+    TEST_EXPECT(string("/tmp/x.sock") == buffer);
+    TEST_EXPECT(11 == length);
+
+    /* the result is one byte too long. */
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL
+            == path_join_to_buffer(
+                    buffer, sizeof(buffer), &length, "/tmp", "xy.sock",
+                    nullptr));
+}
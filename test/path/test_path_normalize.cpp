@@ -0,0 +1,153 @@
+/**
+ * \file path/test_path_normalize.cpp
+ *
+ * Test the path_normalize and path_normalize_to_buffer methods.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <cstring>
+#include <string>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(path_normalize);
+
+/**
+ * \brief Verify that path_normalize checks its parameters.
+ */
+TEST(parameter_checks)
+{
+    rcpr_allocator* alloc = nullptr;
+    char* normalized = nullptr;
+    char buffer[16];
+    size_t length;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* passing a null pointer causes path_normalize to fail. */
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_normalize(nullptr, alloc, "foo"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_normalize(&normalized, nullptr, "foo"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_normalize(&normalized, alloc, nullptr));
+
+    /* passing a null pointer causes path_normalize_to_buffer to fail. */
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_normalize_to_buffer(nullptr, 16, &length, "foo"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_normalize_to_buffer(buffer, 16, nullptr, "foo"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER ==
+            path_normalize_to_buffer(buffer, 16, &length, nullptr));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Paths are normalized lexically.
+ */
+TEST(normalize)
+{
+    rcpr_allocator* alloc = nullptr;
+    const char* cases[][2] = {
+        { "", "." },
+        { ".", "." },
+        { "./", "." },
+        { "/", "/" },
+        { "//", "/" },
+        { "foo", "foo" },
+        { "foo/", "foo" },
+        { "foo//bar///baz", "foo/bar/baz" },
+        { "./foo/./bar/.", "foo/bar" },
+        { "foo/../bar", "bar" },
+        { "foo/bar/../..", "." },
+        { "foo/bar/../../..", ".." },
+        { "../foo/../../bar", "../../bar" },
+        { "/..", "/" },
+        { "/../foo/..", "/" },
+        { "//etc/./vcservice//../vcservice.conf", "/etc/vcservice.conf" },
+        { "/var/run/.../sock/", "/var/run/.../sock" },
+    };
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    for (auto& test_case : cases)
+    {
+        char* normalized = nullptr;
+        char buffer[64];
+        size_t length;
+
+        /* the allocating version. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == path_normalize(&normalized, alloc, test_case[0]));
+        TEST_EXPECT(0 == strcmp(test_case[1], normalized));
+        TEST_ASSERT(
+            STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, normalized));
+
+        /* the buffer version. */
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == path_normalize_to_buffer(
+                        buffer, sizeof(buffer), &length, test_case[0]));
+        TEST_EXPECT(string(test_case[1]) == buffer);
+        TEST_EXPECT(strlen(test_case[1]) == length);
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A buffer that is too small is reported.
+ */
+TEST(buffer_too_small)
+{
+    char buffer[8];
+    size_t length;
+
+    /* the result needs exactly the buffer. */
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == path_normalize_to_buffer(
+                    buffer, sizeof(buffer), &length, "/a/b/../cdef/"));
+    TEST_EXPECT(string("/a/cdef") == buffer);
+
+    /* the result is one byte too long. */
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL
+            == path_normalize_to_buffer(
+                    buffer, sizeof(buffer), &length, "/a/b/../cdefg"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL
+            == path_normalize_to_buffer(
+                    buffer, sizeof(buffer), &length, "../../../../"));
+
+    /* the current directory needs two bytes. */
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL
+            == path_normalize_to_buffer(buffer, 1, &length, ""));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_BUFFER_TOO_SMALL
+            == path_normalize_to_buffer(buffer, 1, &length, "/"));
+}
@@ -0,0 +1,264 @@
+/**
+ * \file path/test_path_resolver.cpp
+ *
+ * Test the path_resolver methods.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <cstring>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+#include "../../src/path/path_internal.h"
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(path_resolver);
+
+/**
+ * \brief Create a file with the given mode.
+ */
+static bool create_file(const string& path, mode_t mode)
+{
+    int fd = open(path.c_str(), O_CREAT | O_WRONLY | O_TRUNC, mode);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    close(fd);
+    return 0 == chmod(path.c_str(), mode);
+}
+
+/**
+ * \brief Verify that path_resolver_create and path_resolver_resolve check
+ * their parameters.
+ */
+TEST(parameter_checks)
+{
+    rcpr_allocator* alloc = nullptr;
+    path_resolver* resolver = nullptr;
+    char* resolved = nullptr;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_resolver_create(nullptr, alloc, "/bin"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_resolver_create(&resolver, nullptr, "/bin"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_resolver_create(&resolver, alloc, nullptr));
+
+    /* we should be able to create a resolver. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == path_resolver_create(&resolver, alloc, "/bin"));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_resolver_resolve(nullptr, alloc, resolver, "sh"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_resolver_resolve(&resolved, nullptr, resolver, "sh"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_resolver_resolve(&resolved, alloc, nullptr, "sh"));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_resolver_resolve(&resolved, alloc, resolver, nullptr));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_resolver_resolve(&resolved, alloc, resolver, ""));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(path_resolver_resource_handle(resolver)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The search path is split, including empty entries.
+ */
+TEST(split)
+{
+    rcpr_allocator* alloc = nullptr;
+    path_resolver* resolver = nullptr;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_resolver_create(&resolver, alloc, "/bin::/usr/bin:"));
+    TEST_ASSERT(4 == resolver->dir_count);
+    TEST_EXPECT(string("/bin") == resolver->dirs[0].path);
+    TEST_EXPECT(string(".") == resolver->dirs[1].path);
+    TEST_EXPECT(string("/usr/bin") == resolver->dirs[2].path);
+    TEST_EXPECT(string(".") == resolver->dirs[3].path);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(path_resolver_resource_handle(resolver)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Commands are resolved in search path order, and the results are
+ * cached until a directory changes.
+ */
+TEST(resolve_and_cache)
+{
+    rcpr_allocator* alloc = nullptr;
+    path_resolver* resolver = nullptr;
+    char* resolved = nullptr;
+    char root_template[] = "/tmp/test_path_resolver.XXXXXX";
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* build two search directories. */
+    TEST_ASSERT(nullptr != mkdtemp(root_template));
+    string root(root_template);
+    string first = root + "/first";
+    string second = root + "/second";
+    TEST_ASSERT(0 == mkdir(first.c_str(), 0700));
+    TEST_ASSERT(0 == mkdir(second.c_str(), 0700));
+    TEST_ASSERT(create_file(second + "/helper", 0700));
+    TEST_ASSERT(create_file(first + "/data", 0600));
+    TEST_ASSERT(create_file(second + "/data", 0700));
+
+    string search_path = root + "/missing:" + first + ":" + second;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_resolver_create(&resolver, alloc, search_path.c_str()));
+
+    /* the helper is found in the second directory. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_resolver_resolve(&resolved, alloc, resolver, "helper"));
+    TEST_EXPECT(second + "/helper" == resolved);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, resolved));
+
+    /* a file that is not executable is skipped. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_resolver_resolve(&resolved, alloc, resolver, "data"));
+    TEST_EXPECT(second + "/data" == resolved);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, resolved));
+
+    /* a missing command is not found, and this is cached. */
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_NOT_FOUND
+            == path_resolver_resolve(&resolved, alloc, resolver, "later"));
+    TEST_EXPECT(3 == resolver->count);
+
+    /* a command with a separator is not searched for. */
+    string direct = second + "/helper";
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_resolver_resolve(
+                    &resolved, alloc, resolver, direct.c_str()));
+    TEST_EXPECT(direct == resolved);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, resolved));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_NOT_FOUND
+            == path_resolver_resolve(
+                    &resolved, alloc, resolver, "./no/such/helper"));
+
+    /* adding a command is not seen until the directories are checked. */
+    TEST_ASSERT(create_file(first + "/later", 0700));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_NOT_FOUND
+            == path_resolver_resolve(&resolved, alloc, resolver, "later"));
+
+    /* force the next resolve to check the directories. */
+    resolver->last_check -= PATH_RESOLVER_CHECK_INTERVAL_NS;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_resolver_resolve(&resolved, alloc, resolver, "later"));
+    TEST_EXPECT(first + "/later" == resolved);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, resolved));
+    TEST_EXPECT(1 == resolver->count);
+
+    /* creating a missing directory also invalidates the cache. */
+    TEST_ASSERT(0 == mkdir((root + "/missing").c_str(), 0700));
+    TEST_ASSERT(create_file(root + "/missing/helper", 0700));
+    resolver->last_check -= PATH_RESOLVER_CHECK_INTERVAL_NS;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_resolver_resolve(&resolved, alloc, resolver, "helper"));
+    TEST_EXPECT(root + "/missing/helper" == resolved);
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(alloc, resolved));
+
+    /* clean up. */
+    unlink((root + "/missing/helper").c_str());
+    unlink((first + "/later").c_str());
+    unlink((first + "/data").c_str());
+    unlink((second + "/data").c_str());
+    unlink((second + "/helper").c_str());
+    rmdir((root + "/missing").c_str());
+    rmdir(first.c_str());
+    rmdir(second.c_str());
+    rmdir(root.c_str());
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(path_resolver_resource_handle(resolver)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The cache grows to hold many commands.
+ */
+TEST(grow)
+{
+    rcpr_allocator* alloc = nullptr;
+    path_resolver* resolver = nullptr;
+    char* resolved = nullptr;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == path_resolver_create(&resolver, alloc, "/bin"));
+
+    for (int i = 0; i < 200; ++i)
+    {
+        string name = "no-such-command-" + to_string(i);
+        TEST_EXPECT(
+            VCSERVICE_ERROR_PATH_NOT_FOUND
+                == path_resolver_resolve(
+                        &resolved, alloc, resolver, name.c_str()));
+    }
+
+    TEST_EXPECT(200 == resolver->count);
+    TEST_EXPECT(4 * resolver->count <= 3 * resolver->capacity);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(path_resolver_resource_handle(resolver)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,228 @@
+/**
+ * \file path/test_path_walk.cpp
+ *
+ * Test the path_walk method.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <mutex>
+#include <set>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/path.h>
+
+using namespace std;
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(path_walk);
+
+/**
+ * \brief Entries collected by a walk.
+ */
+struct walk_result
+{
+    mutex lock;
+    set<string> paths;
+    set<string> dirs;
+    set<string> links;
+    bool names_ok = true;
+};
+
+/**
+ * \brief Collect each entry of a walk.
+ */
+static status collect(const path_walk_entry* entry, void* context)
+{
+    walk_result* result = (walk_result*)context;
+    string path(entry->path, entry->length);
+    lock_guard<mutex> guard(result->lock);
+
+    result->paths.insert(path);
+    if (DT_DIR == entry->type)
+    {
+        result->dirs.insert(path);
+    }
+    else if (DT_LNK == entry->type)
+    {
+        result->links.insert(path);
+    }
+
+    if (path.substr(path.rfind('/') + 1) != entry->name)
+    {
+        result->names_ok = false;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+/**
+ * \brief Stop the walk at the first entry.
+ */
+static status stop(const path_walk_entry*, void*)
+{
+    return VCSERVICE_ERROR_PATH_NOT_FOUND + 100;
+}
+
+/**
+ * \brief Build a tree of directories and files under root.
+ */
+static bool build_tree(const string& root, set<string>& expected)
+{
+    for (int i = 0; i < 5; ++i)
+    {
+        string dir = root + "/d" + to_string(i);
+        mkdir(dir.c_str(), 0700);
+        expected.insert(dir);
+
+        for (int j = 0; j < 5; ++j)
+        {
+            string sub = dir + "/s" + to_string(j);
+            mkdir(sub.c_str(), 0700);
+            expected.insert(sub);
+
+            for (int k = 0; k < 10; ++k)
+            {
+                string file = sub + "/f" + to_string(k);
+                close(open(file.c_str(), O_CREAT | O_WRONLY, 0600));
+                expected.insert(file);
+            }
+        }
+    }
+
+    /* a link back to the root must not be followed. */
+    string link = root + "/d0/up";
+    expected.insert(link);
+
+    return 0 == symlink(root.c_str(), link.c_str());
+}
+
+/**
+ * \brief Remove the tree built by build_tree.
+ */
+static void remove_tree(const string& root, const set<string>& expected)
+{
+    /* deeper paths sort after their parents, so remove in reverse. */
+    for (auto i = expected.rbegin(); i != expected.rend(); ++i)
+    {
+        if (0 != unlink(i->c_str()))
+        {
+            rmdir(i->c_str());
+        }
+    }
+
+    rmdir(root.c_str());
+}
+
+/**
+ * \brief Verify that path_walk checks its parameters.
+ */
+TEST(parameter_checks)
+{
+    rcpr_allocator* alloc = nullptr;
+    walk_result result;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_walk(nullptr, "/tmp", 1, &collect, &result));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_walk(alloc, nullptr, 1, &collect, &result));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_INVALID_PARAMETER
+            == path_walk(alloc, "/tmp", 1, nullptr, &result));
+    TEST_EXPECT(
+        VCSERVICE_ERROR_PATH_NOT_FOUND
+            == path_walk(
+                    alloc, "/nonexistent/path/walk", 1, &collect, &result));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Every entry is visited once, with one thread or several.
+ */
+TEST(walk)
+{
+    rcpr_allocator* alloc = nullptr;
+    char root_template[] = "/tmp/test_path_walk.XXXXXX";
+    set<string> expected;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(nullptr != mkdtemp(root_template));
+    string root(root_template);
+    TEST_ASSERT(build_tree(root, expected));
+
+    for (unsigned int threads : { 0U, 1U, 4U })
+    {
+        walk_result result;
+
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == path_walk(alloc, root.c_str(), threads, &collect, &result));
+        TEST_EXPECT(expected == result.paths);
+        TEST_EXPECT(30U == result.dirs.size());
+        TEST_EXPECT(1U == result.links.size());
+        TEST_EXPECT(result.names_ok);
+    }
+
+    /* a trailing separator on the root is not doubled. */
+    walk_result result;
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == path_walk(
+                    alloc, (root + "/").c_str(), 2, &collect, &result));
+    TEST_EXPECT(expected == result.paths);
+
+    /* clean up. */
+    remove_tree(root, expected);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief A callback failure stops the walk and is returned.
+ */
+TEST(callback_stops_walk)
+{
+    rcpr_allocator* alloc = nullptr;
+    char root_template[] = "/tmp/test_path_walk.XXXXXX";
+    set<string> expected;
+
+    /* we should be able to create a malloc allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_ASSERT(nullptr != mkdtemp(root_template));
+    string root(root_template);
+    TEST_ASSERT(build_tree(root, expected));
+
+    for (unsigned int threads : { 1U, 4U })
+    {
+        TEST_EXPECT(
+            VCSERVICE_ERROR_PATH_NOT_FOUND + 100
+                == path_walk(alloc, root.c_str(), threads, &stop, nullptr));
+    }
+
+    /* clean up. */
+    remove_tree(root, expected);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
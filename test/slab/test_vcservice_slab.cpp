@@ -0,0 +1,365 @@
+/**
+ * \file slab/test_vcservice_slab.cpp
+ *
+ * Test the vcservice_slab methods.
+ *
+ * \copyright 2023 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <cstdint>
+#include <cstring>
+#include <pthread.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+#include <vcservice/path.h>
+#include <vcservice/slab.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_psock;
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcservice_slab);
+
+#define OBJECT_COUNT 1000
+
+/**
+ * \brief Arguments for the cross-thread reclaim test.
+ */
+struct reclaim_thread
+{
+    vcservice_slab* slab;
+    void* objects[OBJECT_COUNT];
+    bool ok;
+};
+
+/**
+ * \brief Reclaim objects that another thread allocated.
+ */
+static void* reclaim_objects(void* arg)
+{
+    reclaim_thread* ctx = (reclaim_thread*)arg;
+
+    ctx->ok = true;
+    for (int i = 0; i < OBJECT_COUNT; ++i)
+    {
+        if (STATUS_SUCCESS
+                != vcservice_slab_reclaim(ctx->slab, ctx->objects[i]))
+        {
+            ctx->ok = false;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Allocate and reclaim objects from the calling thread.
+ */
+static void* churn(void* arg)
+{
+    reclaim_thread* ctx = (reclaim_thread*)arg;
+
+    ctx->ok = true;
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < OBJECT_COUNT; ++i)
+        {
+            if (STATUS_SUCCESS
+                    != vcservice_slab_allocate(
+                            ctx->slab, &ctx->objects[i], 8 + i % 512))
+            {
+                ctx->ok = false;
+                return NULL;
+            }
+
+            memset(ctx->objects[i], round, 8 + i % 512);
+        }
+
+        for (int i = 0; i < OBJECT_COUNT; ++i)
+        {
+            if (STATUS_SUCCESS
+                    != vcservice_slab_reclaim(ctx->slab, ctx->objects[i]))
+            {
+                ctx->ok = false;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Allocations are aligned, reused after a reclaim, and counted.
+ */
+TEST(allocate_reclaim)
+{
+    rcpr_allocator* alloc;
+    vcservice_slab* slab;
+    vcservice_slab_stats stats;
+    void* first;
+    void* second;
+    void* other;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the slab. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_create(&slab, alloc));
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_allocate(slab, &first, 40));
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_allocate(slab, &other, 100));
+    TEST_EXPECT(0U == (uintptr_t)first % 16);
+    TEST_EXPECT(0U == (uintptr_t)other % 16);
+    memset(first, 0xa5, 40);
+    memset(other, 0x5a, 100);
+
+    /* 40 bytes is served from the 48 byte class, 100 from the 128. */
+    vcservice_slab_stats_get(&stats, slab);
+    TEST_EXPECT(48U == stats.class_size[2]);
+    TEST_EXPECT(1U == stats.class_in_use[2]);
+    TEST_EXPECT(128U == stats.class_size[5]);
+    TEST_EXPECT(1U == stats.class_in_use[5]);
+    TEST_EXPECT(2U == stats.spans);
+
+    /* a reclaimed object is the next one handed out in its class. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_reclaim(slab, first));
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_allocate(slab, &second, 33));
+    TEST_EXPECT(first == second);
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_reclaim(slab, second));
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_reclaim(slab, other));
+    vcservice_slab_stats_get(&stats, slab);
+    TEST_EXPECT(0U == stats.class_in_use[2]);
+    TEST_EXPECT(0U == stats.class_in_use[5]);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_slab_resource_handle(slab)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Allocations larger than the largest class are mapped on their own.
+ */
+TEST(large)
+{
+    rcpr_allocator* alloc;
+    vcservice_slab* slab;
+    vcservice_slab_stats stats;
+    void* large;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the slab. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_create(&slab, alloc));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_slab_allocate(slab, &large, 200000));
+    memset(large, 0xff, 200000);
+
+    vcservice_slab_stats_get(&stats, slab);
+    TEST_EXPECT(1U == stats.large_in_use);
+    TEST_EXPECT(200000U < stats.bytes_mapped);
+    TEST_EXPECT(0U == stats.spans);
+
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_reclaim(slab, large));
+    vcservice_slab_stats_get(&stats, slab);
+    TEST_EXPECT(0U == stats.large_in_use);
+    TEST_EXPECT(0U == stats.bytes_mapped);
+
+    /* a large allocation still live at release is unmapped with the slab. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_slab_allocate(slab, &large, 5000));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_slab_resource_handle(slab)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The allocator view can be passed to the path and log interfaces.
+ */
+TEST(allocator_view)
+{
+    rcpr_allocator* alloc;
+    rcpr_allocator* view;
+    vcservice_slab* slab;
+    vcservice_slab_stats stats;
+    psock* sock;
+    vcservice_log* log;
+    char* normalized;
+    void* mem;
+    void* moved;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the slab. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_create(&slab, alloc));
+    view = vcservice_slab_allocator(slab);
+
+    /* normalize a path with memory from the slab. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == path_normalize(&normalized, view, "/usr/./bin/.."));
+    TEST_EXPECT(!strcmp("/usr", normalized));
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(view, normalized));
+
+    /* create a logger in the slab and log a message. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == psock_create_from_buffer(&sock, view, NULL, 0));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == vcservice_log_create_from_psock(
+                    &log, view, sock, VCSERVICE_LOGLEVEL_INFO));
+    vcservice_log_message_start(log);
+    vcservice_log_append_string(log, "slab");
+    vcservice_log_message_commit(log);
+    TEST_ASSERT(
+        STATUS_SUCCESS == resource_release(vcservice_log_resource_handle(log)));
+
+    /* reallocating within the size class keeps the memory in place. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_allocate(view, &mem, 20));
+    memcpy(mem, "slab view", 10);
+    moved = mem;
+    TEST_ASSERT(
+        STATUS_SUCCESS == rcpr_allocator_reallocate(view, &moved, 30));
+    TEST_EXPECT(mem == moved);
+
+    /* reallocating past it copies the contents. */
+    TEST_ASSERT(
+        STATUS_SUCCESS == rcpr_allocator_reallocate(view, &moved, 5000));
+    TEST_EXPECT(mem != moved);
+    TEST_EXPECT(!strcmp("slab view", (const char*)moved));
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_allocator_reclaim(view, moved));
+
+    /* everything allocated through the view was reclaimed. */
+    vcservice_slab_stats_get(&stats, slab);
+    for (int i = 0; i < VCSERVICE_SLAB_CLASS_COUNT; ++i)
+    {
+        TEST_EXPECT(0U == stats.class_in_use[i]);
+    }
+    TEST_EXPECT(0U == stats.large_in_use);
+
+    /* releasing the view does nothing. */
+    TEST_EXPECT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(view)));
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_slab_resource_handle(slab)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Memory can be reclaimed by a thread other than the one that
+ * allocated it.
+ */
+TEST(cross_thread_reclaim)
+{
+    rcpr_allocator* alloc;
+    vcservice_slab* slab;
+    vcservice_slab_stats stats;
+    pthread_t thread;
+    static reclaim_thread ctx;
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the slab. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_create(&slab, alloc));
+
+    ctx.slab = slab;
+    for (int i = 0; i < OBJECT_COUNT; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcservice_slab_allocate(slab, &ctx.objects[i], 64));
+    }
+
+    vcservice_slab_stats_get(&stats, slab);
+    TEST_EXPECT((size_t)OBJECT_COUNT == stats.class_in_use[3]);
+
+    TEST_ASSERT(0 == pthread_create(&thread, NULL, &reclaim_objects, &ctx));
+    TEST_ASSERT(0 == pthread_join(thread, NULL));
+    TEST_EXPECT(ctx.ok);
+
+    /* the exiting thread flushed its magazine back to the central list. */
+    vcservice_slab_stats_get(&stats, slab);
+    TEST_EXPECT(0U == stats.class_in_use[3]);
+    size_t spans = stats.spans;
+
+    for (int i = 0; i < OBJECT_COUNT; ++i)
+    {
+        TEST_ASSERT(
+            STATUS_SUCCESS
+                == vcservice_slab_allocate(slab, &ctx.objects[i], 64));
+    }
+
+    vcservice_slab_stats_get(&stats, slab);
+    TEST_EXPECT(spans == stats.spans);
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_slab_resource_handle(slab)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Several threads can allocate and reclaim at once.
+ */
+TEST(concurrent)
+{
+    rcpr_allocator* alloc;
+    vcservice_slab* slab;
+    vcservice_slab_stats stats;
+    pthread_t threads[4];
+    static reclaim_thread ctx[4];
+
+    /* create the allocator. */
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    /* create the slab. */
+    TEST_ASSERT(STATUS_SUCCESS == vcservice_slab_create(&slab, alloc));
+
+    for (int i = 0; i < 4; ++i)
+    {
+        ctx[i].slab = slab;
+        TEST_ASSERT(0 == pthread_create(&threads[i], NULL, &churn, &ctx[i]));
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        TEST_ASSERT(0 == pthread_join(threads[i], NULL));
+        TEST_EXPECT(ctx[i].ok);
+    }
+
+    vcservice_slab_stats_get(&stats, slab);
+    for (int i = 0; i < VCSERVICE_SLAB_CLASS_COUNT; ++i)
+    {
+        TEST_EXPECT(0U == stats.class_in_use[i]);
+    }
+
+    /* clean up. */
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_slab_resource_handle(slab)));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
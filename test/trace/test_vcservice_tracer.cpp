@@ -0,0 +1,215 @@
+/**
+ * \file trace/test_vcservice_tracer.cpp
+ *
+ * Test the vcservice_tracer methods.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <minunit/minunit.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/trace.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+TEST_SUITE(vcservice_tracer);
+
+#define THREAD_COUNT 4
+#define SPAN_COUNT 1000
+
+/**
+ * \brief Open an unlinked temporary file, returning a second descriptor for
+ * reading it back.
+ */
+static int open_trace_file(int* read_desc)
+{
+    char filename[] = "/tmp/test_vcservice_tracer_XXXXXX";
+
+    int desc = mkstemp(filename);
+    if (desc < 0)
+    {
+        return -1;
+    }
+
+    unlink(filename);
+
+    *read_desc = dup(desc);
+    if (*read_desc < 0)
+    {
+        close(desc);
+        return -1;
+    }
+
+    return desc;
+}
+
+/**
+ * \brief Read a file from the start.
+ */
+static std::string read_all(int desc)
+{
+    std::string out;
+    char buffer[4096];
+    ssize_t size;
+    off_t offset = 0;
+
+    while ((size = pread(desc, buffer, sizeof(buffer), offset)) > 0)
+    {
+        out.append(buffer, (size_t)size);
+        offset += size;
+    }
+
+    return out;
+}
+
+/**
+ * \brief Count the occurrences of a string.
+ */
+static size_t count(const std::string& haystack, const char* needle)
+{
+    size_t total = 0;
+
+    for (size_t pos = haystack.find(needle); std::string::npos != pos;
+         pos = haystack.find(needle, pos + 1))
+    {
+        ++total;
+    }
+
+    return total;
+}
+
+/**
+ * \brief Record nested spans from a thread.
+ */
+static void* record_spans(void* arg)
+{
+    vcservice_tracer* tracer = (vcservice_tracer*)arg;
+
+    for (int i = 0; i < SPAN_COUNT; ++i)
+    {
+        vcservice_trace_begin(tracer, "request");
+        vcservice_trace_begin(tracer, "db \"query\"");
+        vcservice_trace_end(tracer);
+        vcservice_trace_end(tracer);
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Events from several threads are written as a JSON array.
+ */
+TEST(threads)
+{
+    rcpr_allocator* alloc;
+    vcservice_tracer* tracer;
+    pthread_t threads[THREAD_COUNT];
+    int read_desc;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int desc = open_trace_file(&read_desc);
+    TEST_ASSERT(desc >= 0);
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_tracer_create(&tracer, alloc, desc, 0));
+
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        TEST_ASSERT(
+            0 == pthread_create(&threads[i], NULL, &record_spans, tracer));
+    }
+
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* each thread's events fit in its ring, so none are dropped. */
+    TEST_EXPECT(0 == vcservice_tracer_dropped(tracer));
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_tracer_resource_handle(tracer)));
+
+    std::string trace = read_all(read_desc);
+    close(read_desc);
+
+    TEST_EXPECT(0 == trace.compare(0, 2, "[\n"));
+    TEST_EXPECT(0 == trace.compare(trace.size() - 3, 3, "\n]\n"));
+    TEST_EXPECT(
+        2 * THREAD_COUNT * SPAN_COUNT == count(trace, "{\"ph\":\"B\""));
+    TEST_EXPECT(
+        2 * THREAD_COUNT * SPAN_COUNT == count(trace, "{\"ph\":\"E\""));
+    TEST_EXPECT(
+        THREAD_COUNT * SPAN_COUNT == count(trace, "\"name\":\"request\""));
+    TEST_EXPECT(
+        THREAD_COUNT * SPAN_COUNT
+            == count(trace, "\"name\":\"db \\\"query\\\"\""));
+    TEST_EXPECT(4 * THREAD_COUNT * SPAN_COUNT - 1 == count(trace, "},\n{"));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief Events are dropped, and counted, when a ring is full.
+ */
+TEST(dropped)
+{
+    rcpr_allocator* alloc;
+    vcservice_tracer* tracer;
+    int read_desc;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    int desc = open_trace_file(&read_desc);
+    TEST_ASSERT(desc >= 0);
+
+    TEST_ASSERT(
+        STATUS_SUCCESS == vcservice_tracer_create(&tracer, alloc, desc, 4));
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        vcservice_trace_begin(tracer, "span");
+    }
+
+    uint64_t dropped = vcservice_tracer_dropped(tracer);
+    TEST_EXPECT(dropped > 0);
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(vcservice_tracer_resource_handle(tracer)));
+
+    std::string trace = read_all(read_desc);
+    close(read_desc);
+    TEST_EXPECT(1000 - dropped == count(trace, "{\"ph\":\"B\""));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
+
+/**
+ * \brief The ring size must be a power of two.
+ */
+TEST(invalid_ring_size)
+{
+    rcpr_allocator* alloc;
+    vcservice_tracer* tracer;
+
+    TEST_ASSERT(STATUS_SUCCESS == rcpr_malloc_allocator_create(&alloc));
+
+    TEST_EXPECT(
+        VCSERVICE_ERROR_TRACE_INVALID_PARAMETER
+            == vcservice_tracer_create(&tracer, alloc, 1, 1000));
+
+    TEST_ASSERT(
+        STATUS_SUCCESS
+            == resource_release(rcpr_allocator_resource_handle(alloc)));
+}
@@ -0,0 +1,98 @@
+/**
+ * \file tools/audit_verify/main.c
+ *
+ * \brief Main entry point for the audit_verify tool.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+
+static const char* failure_reason(status retval);
+
+/**
+ * \brief Main entry point for the audit_verify tool.
+ *
+ * Verify the hash chain of each audit log named on the command line.
+ *
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns 0 if every log verified, 1 if any log failed, or 2 on a usage
+ * error.
+ */
+int main(int argc, char* argv[])
+{
+    status retval;
+    bool error = false;
+    vcservice_log_audit_summary summary;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s audit-log...\n", argv[0]);
+        return 2;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        int desc = open(argv[i], O_RDONLY);
+        if (desc < 0)
+        {
+            perror(argv[i]);
+            error = true;
+            continue;
+        }
+
+        retval = vcservice_log_audit_verify(&summary, desc);
+        close(desc);
+
+        if (STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "%s: FAILED at offset %zu: %s.\n", argv[i],
+                summary.failure_offset, failure_reason(retval));
+            error = true;
+            continue;
+        }
+
+        printf(
+            "%s: OK, %" PRIu64 " records, %" PRIu64 " checkpoints, %s.\n",
+            argv[i], summary.records, summary.checkpoints,
+            summary.sealed ? "sealed" : "NOT sealed");
+    }
+
+    if (error)
+        return 1;
+    else
+        return 0;
+}
+
+/**
+ * \brief Describe a verification failure.
+ *
+ * \param retval        The status returned by the verifier.
+ *
+ * \returns a description of the failure.
+ */
+static const char* failure_reason(status retval)
+{
+    switch (retval)
+    {
+        case VCSERVICE_ERROR_LOG_AUDIT_MALFORMED:
+            return "malformed entry";
+
+        case VCSERVICE_ERROR_LOG_AUDIT_CHAIN_MISMATCH:
+            return "chain mismatch";
+
+        case VCSERVICE_ERROR_LOG_AUDIT_READ:
+            return "read error";
+
+        default:
+            return "verification error";
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * \file tools/log_decrypt/main.c
+ *
+ * \brief Main entry point for the log_decrypt tool.
+ *
+ * \copyright 2023 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <vcservice/error_codes.h>
+#include <vcservice/log.h>
+
+RCPR_IMPORT_allocator_as(rcpr);
+RCPR_IMPORT_resource;
+
+#define MAX_KEY_SIZE 256
+
+static ssize_t read_key(const char* filename, uint8_t* key, size_t size);
+
+/**
+ * \brief Main entry point for the log_decrypt tool.
+ *
+ * Decrypt an encrypted log to standard output, reading the log from the
+ * named file or from standard input.  The key file holds the raw key.
+ *
+ * \param argc          The argument count.
+ * \param argv          The argument vector.
+ *
+ * \returns 0 on success, 1 on failure, or 2 on a usage error.
+ */
+int main(int argc, char* argv[])
+{
+    status retval, release_retval;
+    bool error = false;
+    rcpr_allocator* alloc;
+    uint8_t key[MAX_KEY_SIZE];
+    ssize_t key_size;
+    int in_desc = 0;
+
+    if (argc < 2 || argc > 3)
+    {
+        fprintf(stderr, "Usage: %s key-file [encrypted-log]\n", argv[0]);
+        return 2;
+    }
+
+    key_size = read_key(argv[1], key, sizeof(key));
+    if (key_size < 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    if (3 == argc)
+    {
+        in_desc = open(argv[2], O_RDONLY);
+        if (in_desc < 0)
+        {
+            perror(argv[2]);
+            error = true;
+            goto cleanup_key;
+        }
+    }
+
+    /* create a malloc allocator. */
+    retval = rcpr_malloc_allocator_create(&alloc);
+    if (STATUS_SUCCESS != retval)
+    {
+        error = true;
+        goto cleanup_in_desc;
+    }
+
+    retval =
+        vcservice_log_encrypted_decrypt(
+            alloc, 1, in_desc, key, (size_t)key_size);
+    if (VCSERVICE_ERROR_LOG_ENCRYPTED_INVALID_KEY == retval)
+    {
+        fprintf(stderr, "%s: key has the wrong size.\n", argv[1]);
+        error = true;
+    }
+    else if (VCSERVICE_ERROR_LOG_ENCRYPTED_MALFORMED == retval)
+    {
+        fprintf(stderr, "Encrypted log is malformed or truncated.\n");
+        error = true;
+    }
+    else if (STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Decryption failed (0x%x).\n", (unsigned int)retval);
+        error = true;
+    }
+
+    release_retval = resource_release(rcpr_allocator_resource_handle(alloc));
+    if (STATUS_SUCCESS != release_retval)
+    {
+        error = true;
+    }
+
+cleanup_in_desc:
+    if (in_desc > 0)
+    {
+        close(in_desc);
+    }
+
+cleanup_key:
+    memset(key, 0, sizeof(key));
+
+    if (error)
+        return 1;
+    else
+        return 0;
+}
+
+/**
+ * \brief Read the raw key from a file.
+ *
+ * \param filename      The key file.
+ * \param key           The buffer to receive the key.
+ * \param size          The size of the buffer.
+ *
+ * \returns the size of the key, or -1 on failure.
+ */
+static ssize_t read_key(const char* filename, uint8_t* key, size_t size)
+{
+    int desc = open(filename, O_RDONLY);
+    if (desc < 0)
+    {
+        return -1;
+    }
+
+    ssize_t key_size = read(desc, key, size);
+    close(desc);
+
+    return key_size;
+}